@@ -187,6 +187,7 @@ ClangdServer::ClangdServer(const GlobalCompilationDatabase &CDB,
       return createProcessingContext(P);
     };
     BGOpts.CollectMainFileRefs = Opts.CollectMainFileRefs;
+    BGOpts.PreamblePoolSize = Opts.BackgroundPreamblePoolSize;
     BackgroundIdx = std::make_unique<BackgroundIndex>(
         TFS, CDB,
         BackgroundIndexStorage::createDiskBackedStorageFactory(
@@ -105,6 +105,11 @@ public:
     /// on background threads. The index is stored in the project root.
     bool BackgroundIndex = false;
 
+    /// Number of preambles the background index may pool and share between
+    /// translation units with matching preamble regions. Zero means every
+    /// translation unit is parsed from scratch.
+    size_t BackgroundPreamblePoolSize = 0;
+
     /// Store refs to main-file symbols in the index.
     bool CollectMainFileRefs = true;
 
@@ -811,6 +811,18 @@ private:
   const ParsedAST &AST;
 };
 
+// Returns the top-level decl of the main file that lexically encloses \p D,
+// or null if there is no such decl (e.g. D is already at the top level, or
+// inside an implicit construct like a lambda class).
+const Decl *enclosingTopLevelDecl(const NamedDecl *D,
+                                  llvm::ArrayRef<Decl *> TopLevelDecls) {
+  const Decl *Enclosing = D;
+  for (const DeclContext *DC = D->getLexicalDeclContext();
+       DC && !DC->isTranslationUnit(); DC = DC->getLexicalParent())
+    Enclosing = Decl::castFromDeclContext(DC);
+  return llvm::is_contained(TopLevelDecls, Enclosing) ? Enclosing : nullptr;
+}
+
 std::vector<ReferenceFinder::Reference>
 findRefs(const std::vector<const NamedDecl *> &Decls, ParsedAST &AST) {
   ReferenceFinder RefFinder(AST, Decls);
@@ -820,8 +832,28 @@ findRefs(const std::vector<const NamedDecl *> &Decls, ParsedAST &AST) {
   IndexOpts.IndexFunctionLocals = true;
   IndexOpts.IndexParametersInDeclarations = true;
   IndexOpts.IndexTemplateParameters = true;
-  indexTopLevelDecls(AST.getASTContext(), AST.getPreprocessor(),
-                     AST.getLocalTopLevelDecls(), RefFinder, IndexOpts);
+  // References to a function-local symbol can only occur inside the top-level
+  // decl that contains the function, so it is enough to traverse the
+  // containing decls instead of every top-level decl of the main file. This
+  // matters for requests issued on each cursor move, like documentHighlight.
+  llvm::ArrayRef<const Decl *> Indexed = AST.getLocalTopLevelDecls();
+  llvm::SmallVector<const Decl *, 4> ContainingDecls;
+  for (const NamedDecl *D : Decls) {
+    const Decl *Enclosing = D->getParentFunctionOrMethod()
+                                ? enclosingTopLevelDecl(
+                                      D, AST.getLocalTopLevelDecls())
+                                : nullptr;
+    if (!Enclosing) {
+      ContainingDecls.clear();
+      break;
+    }
+    if (!llvm::is_contained(ContainingDecls, Enclosing))
+      ContainingDecls.push_back(Enclosing);
+  }
+  if (!ContainingDecls.empty())
+    Indexed = ContainingDecls;
+  indexTopLevelDecls(AST.getASTContext(), AST.getPreprocessor(), Indexed,
+                     RefFinder, IndexOpts);
   return std::move(RefFinder).take();
 }
 
@@ -11,6 +11,7 @@
 #include "Config.h"
 #include "Headers.h"
 #include "ParsedAST.h"
+#include "Preamble.h"
 #include "SourceCode.h"
 #include "Symbol.h"
 #include "URI.h"
@@ -32,11 +33,13 @@
 #include "clang/Basic/SourceLocation.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Driver/Types.h"
+#include "clang/Frontend/PrecompiledPreamble.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
@@ -97,6 +100,7 @@ BackgroundIndex::BackgroundIndex(
     : SwapIndex(std::make_unique<MemIndex>()), TFS(TFS), CDB(CDB),
       ContextProvider(std::move(Opts.ContextProvider)),
       CollectMainFileRefs(Opts.CollectMainFileRefs),
+      PreamblePoolSize(Opts.PreamblePoolSize),
       Rebuilder(this, &IndexedSymbols, Opts.ThreadPoolSize),
       IndexStorageFactory(std::move(IndexStorageFactory)),
       Queue(std::move(Opts.OnProgress)),
@@ -248,6 +252,82 @@ void BackgroundIndex::update(
   }
 }
 
+std::shared_ptr<const PreambleData>
+BackgroundIndex::getPooledPreamble(PathRef AbsolutePath,
+                                   const ParseInputs &Inputs,
+                                   const CompilerInvocation &CI,
+                                   llvm::vfs::FileSystem &FS) {
+  auto ContentsBuffer =
+      llvm::MemoryBuffer::getMemBuffer(Inputs.Contents, AbsolutePath);
+  auto Bounds = ComputePreambleBounds(*CI.getLangOpts(), *ContentsBuffer, 0);
+
+  // Key the pool on the preamble region and the compile flags, leaving out the
+  // main file name so that TUs with a common header prefix share an entry.
+  // Collisions are harmless: CanReuse() verifies the preamble bytes and the
+  // headers behind them before an entry is actually reused.
+  const tooling::CompileCommand &Cmd = Inputs.CompileCommand;
+  llvm::hash_code KeyHash(0);
+  for (llvm::StringRef Arg : Cmd.CommandLine)
+    if (Arg != Cmd.Filename && Arg != AbsolutePath)
+      KeyHash = llvm::hash_combine(KeyHash, Arg);
+  KeyHash = llvm::hash_combine(
+      KeyHash, llvm::StringRef(Cmd.Directory),
+      llvm::StringRef(Inputs.Contents).take_front(Bounds.Size));
+  std::string Key = llvm::utostr(size_t(KeyHash));
+
+  // Pool entries with a null preamble mark keys seen exactly once, so that
+  // families with a single TU never pay for a preamble build.
+  std::shared_ptr<const PreambleData> Hit;
+  bool SeenBefore = false;
+  {
+    std::lock_guard<std::mutex> Lock(PreamblePoolMu);
+    for (auto It = PreamblePool.begin(); It != PreamblePool.end(); ++It) {
+      if (It->first != Key)
+        continue;
+      SeenBefore = true;
+      Hit = It->second;
+      // Mark as most recently used.
+      std::rotate(PreamblePool.begin(), It, It + 1);
+      break;
+    }
+    if (!SeenBefore) {
+      PreamblePool.emplace(PreamblePool.begin(), Key, nullptr);
+      while (PreamblePool.size() > PreamblePoolSize)
+        PreamblePool.pop_back();
+      return nullptr;
+    }
+  }
+  // Validate outside the lock, CanReuse() stats the included headers. Success
+  // also means those headers are unchanged since the TU that built the entry
+  // parsed them in full, so their shards are already up to date.
+  if (Hit && Hit->Preamble.CanReuse(CI, ContentsBuffer.get(), Bounds, &FS)) {
+    vlog("Reusing pooled preamble for {0}", AbsolutePath);
+    return Hit;
+  }
+
+  auto Preamble = buildPreamble(AbsolutePath, CI, Inputs,
+                                /*StoreInMemory=*/false,
+                                /*PreambleCallback=*/nullptr);
+  if (!Preamble)
+    return nullptr;
+  {
+    std::lock_guard<std::mutex> Lock(PreamblePoolMu);
+    // Evict any marker or stale preamble for the same key, then any
+    // least-recently-used entries beyond the pool limit. On-disk PCH files are
+    // deleted when the last reference to an entry goes away.
+    llvm::erase_if(PreamblePool,
+                   [&](const auto &Entry) { return Entry.first == Key; });
+    PreamblePool.emplace(PreamblePool.begin(), std::move(Key),
+                         std::move(Preamble));
+    while (PreamblePool.size() > PreamblePoolSize)
+      PreamblePool.pop_back();
+  }
+  // Decls read back from a preamble PCH are invisible to the indexer, so the
+  // TU that seeds the pool must still parse its headers in full to populate
+  // their shards. Only TUs arriving after this one reuse the preamble.
+  return nullptr;
+}
+
 llvm::Error BackgroundIndex::index(tooling::CompileCommand Cmd) {
   trace::Span Tracer("BackgroundIndex");
   SPAN_ATTACH(Tracer, "file", Cmd.Filename);
@@ -275,9 +355,18 @@ llvm::Error BackgroundIndex::index(tooling::CompileCommand Cmd) {
   if (!CI)
     return error("Couldn't build compiler invocation");
 
-  auto Clang =
-      prepareCompilerInstance(std::move(CI), /*Preamble=*/nullptr,
-                              std::move(*Buf), std::move(FS), IgnoreDiags);
+  // Parse on top of a pooled preamble where possible. TUs in the same project
+  // tend to have near-identical preamble regions, sharing a preamble saves
+  // reparsing the headers behind it for every TU.
+  std::shared_ptr<const PreambleData> Preamble;
+  if (PreamblePoolSize > 0) {
+    Inputs.Contents = Buf->get()->getBuffer().str();
+    Preamble = getPooledPreamble(AbsolutePath, Inputs, *CI, *FS);
+  }
+
+  auto Clang = prepareCompilerInstance(
+      std::move(CI), Preamble ? &Preamble->Preamble : nullptr, std::move(*Buf),
+      std::move(FS), IgnoreDiags);
   if (!Clang)
     return error("Couldn't build compiler instance");
 
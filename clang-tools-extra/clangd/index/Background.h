@@ -34,7 +34,10 @@
 #include <vector>
 
 namespace clang {
+class CompilerInvocation;
 namespace clangd {
+struct ParseInputs;
+struct PreambleData;
 
 // Handles storage and retrieval of index shards. Both store and load
 // operations can be called from multiple-threads concurrently.
@@ -141,6 +144,11 @@ public:
     std::function<Context(PathRef)> ContextProvider = nullptr;
     // Whether to collect references to main-file-only symbols.
     bool CollectMainFileRefs = false;
+    // Number of preambles shared between translation units during indexing.
+    // TUs whose preamble region and compile flags match reuse a pooled
+    // preamble instead of reparsing all of their headers. Zero disables
+    // pooling, every TU is then parsed from scratch.
+    size_t PreamblePoolSize = 0;
   };
 
   /// Creates a new background index and starts its threads.
@@ -198,6 +206,23 @@ private:
 
   llvm::Error index(tooling::CompileCommand);
 
+  /// Returns a pooled preamble that can be reused to parse \p Inputs, or null
+  /// if this TU has to be parsed from scratch. Seeds the pool as a side
+  /// effect: a preamble is built once a second TU with the same preamble
+  /// region and compile flags shows up, and handed out from the third on. The
+  /// seeding TUs still parse their headers in full so the headers' shards get
+  /// populated; decls read back from a preamble PCH bypass the indexer.
+  std::shared_ptr<const PreambleData>
+  getPooledPreamble(PathRef AbsolutePath, const ParseInputs &Inputs,
+                    const CompilerInvocation &CI, llvm::vfs::FileSystem &FS);
+
+  const size_t PreamblePoolSize;
+  std::mutex PreamblePoolMu;
+  /// Keyed by a digest of the preamble region and compile flags, in
+  /// most-recently-used order. At most PreamblePoolSize entries.
+  std::vector<std::pair<std::string, std::shared_ptr<const PreambleData>>>
+      PreamblePool; /* GUARDED_BY(PreamblePoolMu) */
+
   FileSymbols IndexedSymbols;
   BackgroundIndexRebuilder Rebuilder;
   llvm::StringMap<ShardVersion> ShardVersions; // Key is absolute file path.
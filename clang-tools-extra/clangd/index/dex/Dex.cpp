@@ -234,23 +234,24 @@ bool Dex::fuzzyFind(const FuzzyFindRequest &Req,
   vlog("Dex query tree: {0}", *Root);
 
   using IDAndScore = std::pair<DocID, float>;
-  std::vector<IDAndScore> IDAndScores = consume(*Root);
-
   auto Compare = [](const IDAndScore &LHS, const IDAndScore &RHS) {
     return LHS.second > RHS.second;
   };
   TopN<IDAndScore, decltype(Compare)> Top(
       Req.Limit ? *Req.Limit : std::numeric_limits<size_t>::max(), Compare);
-  for (const auto &IDAndScore : IDAndScores) {
-    const DocID SymbolDocID = IDAndScore.first;
+  // Stream the retrieved symbols directly into the top-N heap instead of
+  // materializing all (document, boost) pairs first: for broad queries the
+  // intermediate vector can cover a large part of the corpus.
+  for (; !Root->reachedEnd(); Root->advance()) {
+    const DocID SymbolDocID = Root->peek();
+    const float Boost = Root->consume();
     const auto *Sym = Symbols[SymbolDocID];
     const llvm::Optional<float> Score = Filter.match(Sym->Name);
     if (!Score)
       continue;
     // Combine Fuzzy Matching score, precomputed symbol quality and boosting
     // score for a cumulative final symbol score.
-    const float FinalScore =
-        (*Score) * SymbolQuality[SymbolDocID] * IDAndScore.second;
+    const float FinalScore = (*Score) * SymbolQuality[SymbolDocID] * Boost;
     // If Top.push(...) returns true, it means that it had to pop an item. In
     // this case, it is possible to retrieve more symbols.
     if (Top.push({SymbolDocID, FinalScore}))
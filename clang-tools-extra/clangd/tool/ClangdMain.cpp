@@ -148,6 +148,17 @@ opt<bool> EnableBackgroundIndex{
     init(true),
 };
 
+opt<unsigned> BackgroundPreamblePoolSize{
+    "background-index-preamble-pool",
+    cat(Features),
+    desc("Number of preambles the background index may share between "
+         "translation units with identical preamble regions. "
+         "Trades disk space in the temporary directory for faster indexing. "
+         "0 means no sharing."),
+    init(0),
+    Hidden,
+};
+
 opt<bool> EnableClangTidy{
     "clang-tidy",
     cat(Features),
@@ -784,6 +795,7 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
   }
 #endif
   Opts.BackgroundIndex = EnableBackgroundIndex;
+  Opts.BackgroundPreamblePoolSize = BackgroundPreamblePoolSize;
   auto PAI = createProjectAwareIndex(loadExternalIndex);
   if (StaticIdx) {
     IdxStack.emplace_back(std::move(StaticIdx));
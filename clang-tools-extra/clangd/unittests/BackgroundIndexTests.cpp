@@ -232,6 +232,42 @@ TEST_F(BackgroundIndexTest, IndexTwoFiles) {
                        FileURI("unittest:///root/B.cc")}));
 }
 
+TEST_F(BackgroundIndexTest, PreamblePool) {
+  MockFS FS;
+  FS.Files[testPath("root/A.h")] = R"cpp(
+      void common();
+      )cpp";
+  // All three TUs share an identical preamble region, so the last one is
+  // indexed on top of a pooled preamble instead of reparsing A.h.
+  FS.Files[testPath("root/A.cc")] = "#include \"A.h\"\nvoid a_sym() {}";
+  FS.Files[testPath("root/B.cc")] = "#include \"A.h\"\nvoid b_sym() {}";
+  FS.Files[testPath("root/C.cc")] = "#include \"A.h\"\nvoid c_sym() {}";
+  llvm::StringMap<std::string> Storage;
+  size_t CacheHits = 0;
+  MemoryShardStorage MSS(Storage, CacheHits);
+  OverlayCDB CDB(/*Base=*/nullptr);
+  BackgroundIndex::Options Opts;
+  Opts.PreamblePoolSize = 4;
+  BackgroundIndex Idx(
+      FS, CDB, [&](llvm::StringRef) { return &MSS; }, Opts);
+
+  for (llvm::StringRef Name : {"A.cc", "B.cc", "C.cc"}) {
+    tooling::CompileCommand Cmd;
+    Cmd.Filename = testPath(("root/" + Name).str());
+    Cmd.Directory = testPath("root");
+    Cmd.CommandLine = {"clang++", Cmd.Filename};
+    CDB.setCompileCommand(Cmd.Filename, Cmd);
+    // Index TUs one at a time so later ones see the pooled preamble.
+    ASSERT_TRUE(Idx.blockUntilIdleForTest());
+  }
+
+  // Symbols from the shared header must survive preamble reuse, their shards
+  // were stored by the TUs that seeded the pool.
+  EXPECT_THAT(runFuzzyFind(Idx, ""),
+              UnorderedElementsAre(Named("common"), Named("a_sym"),
+                                   Named("b_sym"), Named("c_sym")));
+}
+
 TEST_F(BackgroundIndexTest, MainFileRefs) {
   MockFS FS;
   FS.Files[testPath("root/A.h")] = R"cpp(
@@ -199,6 +199,9 @@ private:
 
   void lazyInitImporterSharedSt(TranslationUnitDecl *ToTU);
   ASTImporter &getOrCreateASTImporter(ASTUnit *Unit);
+  /// Drop the importer of \p Unit and the imported FileID mappings that point
+  /// into it. Called by the ASTUnitStorage right before \p Unit is unloaded.
+  void removeASTUnitData(ASTUnit *Unit);
   template <typename T>
   llvm::Expected<const T *> getCrossTUDefinitionImpl(const T *D,
                                                      StringRef CrossTUDir,
@@ -288,7 +291,7 @@ private:
   /// are the concerns of ASTUnitStorage class.
   class ASTUnitStorage {
   public:
-    ASTUnitStorage(CompilerInstance &CI);
+    ASTUnitStorage(CrossTranslationUnitContext &CTU, CompilerInstance &CI);
     /// Loads an ASTUnit for a function.
     ///
     /// \param FunctionName USR name of the function.
@@ -322,6 +325,15 @@ private:
     llvm::Error ensureCTUIndexLoaded(StringRef CrossTUDir, StringRef IndexName);
     llvm::Expected<ASTUnit *> getASTUnitForFile(StringRef FileName,
                                                 bool DisplayCTUProgress);
+    /// Marks the cache entry of \p FileName as the most recently used one.
+    void markAsMostRecentlyUsed(StringRef FileName);
+    /// Unloads least recently used ASTs until the number of loaded ASTs
+    /// respects the limit set by the 'ctu-max-loaded-asts' analyzer option.
+    void evictLeastRecentlyUsedUnits();
+
+    /// The enclosing context. Consulted on eviction to drop the per-unit
+    /// state (importer, imported FileIDs) that refers to the unloaded AST.
+    CrossTranslationUnitContext &CTU;
 
     template <typename... T> using BaseMapTy = llvm::StringMap<T...>;
     using OwningMapTy = BaseMapTy<std::unique_ptr<clang::ASTUnit>>;
@@ -330,6 +342,11 @@ private:
     OwningMapTy FileASTUnitMap;
     NonOwningMapTy NameASTUnitMap;
 
+    /// File names of the loaded ASTs in usage order, least recently used
+    /// first. Used to pick the eviction victim when MaxLoadedASTs is
+    /// exceeded.
+    std::vector<std::string> LoadOrder;
+
     using IndexMapTy = BaseMapTy<std::string>;
     IndexMapTy NameFileMap;
 
@@ -341,6 +358,12 @@ private:
     /// information whether the AST to load is actually loaded or returned from
     /// cache. This information is needed to maintain the counter.
     ASTLoadGuard LoadGuard;
+
+    /// Bound on the number of ASTs kept loaded at a time, 0 meaning no
+    /// bound. Unlike LoadGuard, which limits the total number of loads,
+    /// this limits the number of ASTs held in memory simultaneously; an
+    /// evicted AST is reloaded when a definition is imported from it again.
+    const unsigned MaxLoadedASTs;
   };
 
   ASTUnitStorage ASTStorage;
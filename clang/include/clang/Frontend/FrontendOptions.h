@@ -245,6 +245,9 @@ public:
   /// Output time trace profile.
   unsigned TimeTrace : 1;
 
+  /// Record hardware performance counters in the time trace profile.
+  unsigned TimeTraceHWCounters : 1;
+
   /// Show the -version text.
   unsigned ShowVersion : 1;
 
@@ -450,7 +453,8 @@ public:
 public:
   FrontendOptions()
       : DisableFree(false), RelocatablePCH(false), ShowHelp(false),
-        ShowStats(false), TimeTrace(false), ShowVersion(false),
+        ShowStats(false), TimeTrace(false), TimeTraceHWCounters(false),
+        ShowVersion(false),
         FixWhatYouCan(false), FixOnlyWarnings(false), FixAndRecompile(false),
         FixToTemporaries(false), ARCMTMigrateEmitARCErrors(false),
         SkipFunctionBodies(false), UseGlobalModuleIndex(true),
@@ -15,7 +15,9 @@
 #ifndef LLVM_CLANG_SERIALIZATION_GLOBALMODULEINDEX_H
 #define LLVM_CLANG_SERIALIZATION_GLOBALMODULEINDEX_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
@@ -169,6 +171,28 @@ public:
   /// module file, and true otherwise.
   bool loadedModuleFile(ModuleFile *File);
 
+  /// Metadata about a module file as recorded when the index was built,
+  /// used to carry unchanged module files over into a rebuilt index.
+  struct ModuleFileRecord {
+    llvm::StringRef FileName;
+    off_t Size;
+    time_t ModTime;
+    llvm::ArrayRef<unsigned> Dependencies;
+  };
+
+  /// The number of module file records in the index. Module IDs are dense,
+  /// but a record may be a gap with an empty file name.
+  unsigned getNumModuleFileRecords() const;
+
+  /// Retrieve the recorded metadata for the module file with the given ID.
+  ModuleFileRecord getModuleFileRecord(unsigned ID) const;
+
+  /// Invoke \p Callback for every identifier known to the index, together
+  /// with the IDs of the module files in which it is interesting.
+  void visitIdentifiers(
+      llvm::function_ref<void(llvm::StringRef, llvm::ArrayRef<unsigned>)>
+          Callback) const;
+
   /// Print statistics to standard error.
   void printStats();
 
@@ -29,6 +29,7 @@
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
 #include <algorithm>
@@ -39,6 +40,14 @@
 
 using namespace clang;
 
+#define DEBUG_TYPE "template-decls"
+
+STATISTIC(NumSpecializationsLookedUp,
+          "Number of template specialization lookups");
+STATISTIC(NumSpecializationsFound,
+          "Number of template specialization lookups that found an existing "
+          "declaration");
+
 //===----------------------------------------------------------------------===//
 // TemplateParameterList Implementation
 //===----------------------------------------------------------------------===//
@@ -278,6 +287,9 @@ RedeclarableTemplateDecl::findSpecializationImpl(
   EntryType::Profile(ID, std::forward<ProfileArguments>(ProfileArgs)...,
                      getASTContext());
   EntryType *Entry = Specs.FindNodeOrInsertPos(ID, InsertPos);
+  ++NumSpecializationsLookedUp;
+  if (Entry)
+    ++NumSpecializationsFound;
   return Entry ? SETraits::getDecl(Entry)->getMostRecentDecl() : nullptr;
 }
 
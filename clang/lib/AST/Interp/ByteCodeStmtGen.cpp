@@ -120,6 +120,16 @@ bool ByteCodeStmtGen<Emitter>::visitStmt(const Stmt *S) {
     return visitReturnStmt(cast<ReturnStmt>(S));
   case Stmt::IfStmtClass:
     return visitIfStmt(cast<IfStmt>(S));
+  case Stmt::WhileStmtClass:
+    return visitWhileStmt(cast<WhileStmt>(S));
+  case Stmt::DoStmtClass:
+    return visitDoStmt(cast<DoStmt>(S));
+  case Stmt::ForStmtClass:
+    return visitForStmt(cast<ForStmt>(S));
+  case Stmt::BreakStmtClass:
+    return visitBreakStmt(cast<BreakStmt>(S));
+  case Stmt::ContinueStmtClass:
+    return visitContinueStmt(cast<ContinueStmt>(S));
   case Stmt::NullStmtClass:
     return true;
   default: {
@@ -224,6 +234,110 @@ bool ByteCodeStmtGen<Emitter>::visitIfStmt(const IfStmt *IS) {
   return true;
 }
 
+template <class Emitter>
+bool ByteCodeStmtGen<Emitter>::visitWhileStmt(const WhileStmt *WS) {
+  BlockScope<Emitter> WhileScope(this);
+
+  LabelTy LabelCond = this->getLabel();
+  LabelTy LabelEnd = this->getLabel();
+  LoopScope<Emitter> LS(this, LabelEnd, LabelCond);
+
+  this->emitLabel(LabelCond);
+  // The condition variable, if any, is re-created on every iteration.
+  if (const DeclStmt *CondDecl = WS->getConditionVariableDeclStmt())
+    if (!visitDeclStmt(CondDecl))
+      return false;
+  if (!this->visitBool(WS->getCond()))
+    return false;
+  if (!this->jumpFalse(LabelEnd))
+    return false;
+
+  if (!visitStmt(WS->getBody()))
+    return false;
+  if (!this->jump(LabelCond))
+    return false;
+
+  this->emitLabel(LabelEnd);
+  return true;
+}
+
+template <class Emitter>
+bool ByteCodeStmtGen<Emitter>::visitDoStmt(const DoStmt *DS) {
+  LabelTy LabelStart = this->getLabel();
+  LabelTy LabelCond = this->getLabel();
+  LabelTy LabelEnd = this->getLabel();
+  LoopScope<Emitter> LS(this, LabelEnd, LabelCond);
+
+  this->emitLabel(LabelStart);
+  if (!visitStmt(DS->getBody()))
+    return false;
+
+  this->emitLabel(LabelCond);
+  if (!this->visitBool(DS->getCond()))
+    return false;
+  if (!this->jumpTrue(LabelStart))
+    return false;
+
+  this->emitLabel(LabelEnd);
+  return true;
+}
+
+template <class Emitter>
+bool ByteCodeStmtGen<Emitter>::visitForStmt(const ForStmt *FS) {
+  // The init statement and any variable declared by the condition live in
+  // their own scope enclosing the whole loop.
+  BlockScope<Emitter> ForScope(this);
+
+  LabelTy LabelCond = this->getLabel();
+  LabelTy LabelInc = this->getLabel();
+  LabelTy LabelEnd = this->getLabel();
+  // 'continue' jumps to the increment, not the condition.
+  LoopScope<Emitter> LS(this, LabelEnd, LabelInc);
+
+  if (const Stmt *Init = FS->getInit())
+    if (!visitStmt(Init))
+      return false;
+
+  this->emitLabel(LabelCond);
+  if (const DeclStmt *CondDecl = FS->getConditionVariableDeclStmt())
+    if (!visitDeclStmt(CondDecl))
+      return false;
+  if (const Expr *Cond = FS->getCond()) {
+    if (!this->visitBool(Cond))
+      return false;
+    if (!this->jumpFalse(LabelEnd))
+      return false;
+  }
+
+  if (const Stmt *Body = FS->getBody())
+    if (!visitStmt(Body))
+      return false;
+
+  this->emitLabel(LabelInc);
+  if (const Expr *Inc = FS->getInc())
+    if (!this->discard(Inc))
+      return false;
+  if (!this->jump(LabelCond))
+    return false;
+
+  this->emitLabel(LabelEnd);
+  return true;
+}
+
+template <class Emitter>
+bool ByteCodeStmtGen<Emitter>::visitBreakStmt(const BreakStmt *BS) {
+  if (!BreakLabel)
+    return this->bail(BS);
+  return this->jump(*BreakLabel);
+}
+
+template <class Emitter>
+bool ByteCodeStmtGen<Emitter>::visitContinueStmt(const ContinueStmt *CS) {
+  if (!ContinueLabel)
+    return this->bail(CS);
+  return this->jump(*ContinueLabel);
+}
+
 template <class Emitter>
 bool ByteCodeStmtGen<Emitter>::visitVarDecl(const VarDecl *VD) {
   auto DT = VD->getType();
@@ -62,6 +62,11 @@ private:
   bool visitDeclStmt(const DeclStmt *DS);
   bool visitReturnStmt(const ReturnStmt *RS);
   bool visitIfStmt(const IfStmt *IS);
+  bool visitWhileStmt(const WhileStmt *WS);
+  bool visitDoStmt(const DoStmt *DS);
+  bool visitForStmt(const ForStmt *FS);
+  bool visitBreakStmt(const BreakStmt *BS);
+  bool visitContinueStmt(const ContinueStmt *CS);
 
   /// Compiles a variable declaration.
   bool visitVarDecl(const VarDecl *VD);
@@ -20,6 +20,7 @@
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Index/USRGeneration.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/Option/ArgList.h"
@@ -53,6 +54,8 @@ STATISTIC(NumNameConflicts, "The # of imports when the ASTImporter "
 STATISTIC(NumTripleMismatch, "The # of triple mismatches");
 STATISTIC(NumLangMismatch, "The # of language mismatches");
 STATISTIC(NumLangDialectMismatch, "The # of language dialect mismatches");
+STATISTIC(NumASTUnitsEvicted, "The # of ASTs unloaded to respect the "
+                              "maximum number of loaded ASTs");
 STATISTIC(NumASTLoadThresholdReached,
           "The # of ASTs not loaded because of threshold");
 
@@ -209,7 +212,7 @@ template <typename T> static bool hasBodyOrInit(const T *D) {
 }
 
 CrossTranslationUnitContext::CrossTranslationUnitContext(CompilerInstance &CI)
-    : Context(CI.getASTContext()), ASTStorage(CI) {}
+    : Context(CI.getASTContext()), ASTStorage(*this, CI) {}
 
 CrossTranslationUnitContext::~CrossTranslationUnitContext() {}
 
@@ -363,12 +366,46 @@ void CrossTranslationUnitContext::emitCrossTUDiagnostics(const IndexError &IE) {
 }
 
 CrossTranslationUnitContext::ASTUnitStorage::ASTUnitStorage(
-    CompilerInstance &CI)
-    : Loader(CI, CI.getAnalyzerOpts()->CTUDir,
-             CI.getAnalyzerOpts()->CTUInvocationList),
+    CrossTranslationUnitContext &CTU, CompilerInstance &CI)
+    : CTU(CTU), Loader(CI, CI.getAnalyzerOpts()->CTUDir,
+                       CI.getAnalyzerOpts()->CTUInvocationList),
       LoadGuard(CI.getASTContext().getLangOpts().CPlusPlus
                     ? CI.getAnalyzerOpts()->CTUImportCppThreshold
-                    : CI.getAnalyzerOpts()->CTUImportThreshold) {}
+                    : CI.getAnalyzerOpts()->CTUImportThreshold),
+      MaxLoadedASTs(CI.getAnalyzerOpts()->CTUMaxLoadedASTs) {}
+
+void CrossTranslationUnitContext::ASTUnitStorage::markAsMostRecentlyUsed(
+    StringRef FileName) {
+  auto It = llvm::find(LoadOrder, FileName);
+  assert(It != LoadOrder.end() && "Used an AST that was never loaded.");
+  std::rotate(It, std::next(It), LoadOrder.end());
+}
+
+void CrossTranslationUnitContext::ASTUnitStorage::
+    evictLeastRecentlyUsedUnits() {
+  if (!MaxLoadedASTs)
+    return;
+  while (LoadOrder.size() > MaxLoadedASTs) {
+    assert(LoadOrder.size() == FileASTUnitMap.size());
+    auto Entry = FileASTUnitMap.find(LoadOrder.front());
+    assert(Entry != FileASTUnitMap.end());
+    ASTUnit *Unit = Entry->second.get();
+
+    // Drop the function name entries resolved to this unit, so that a later
+    // lookup reloads the AST instead of returning a dangling pointer.
+    std::vector<std::string> NamesToRemove;
+    for (const auto &NameEntry : NameASTUnitMap)
+      if (NameEntry.getValue() == Unit)
+        NamesToRemove.push_back(NameEntry.getKey().str());
+    for (const std::string &Name : NamesToRemove)
+      NameASTUnitMap.erase(Name);
+
+    CTU.removeASTUnitData(Unit);
+    FileASTUnitMap.erase(Entry);
+    LoadOrder.erase(LoadOrder.begin());
+    ++NumASTUnitsEvicted;
+  }
+}
 
 llvm::Expected<ASTUnit *>
 CrossTranslationUnitContext::ASTUnitStorage::getASTUnitForFile(
@@ -396,6 +433,8 @@ CrossTranslationUnitContext::ASTUnitStorage::getASTUnitForFile(
 
     // Update the cache.
     FileASTUnitMap[FileName] = std::move(LoadedUnit);
+    LoadOrder.push_back(FileName.str());
+    evictLeastRecentlyUsedUnits();
 
     LoadGuard.indicateLoadSuccess();
 
@@ -406,6 +445,7 @@ CrossTranslationUnitContext::ASTUnitStorage::getASTUnitForFile(
 
   } else {
     // Found in the cache.
+    markAsMostRecentlyUsed(FileName);
     return ASTCacheEntry->second.get();
   }
 }
@@ -443,7 +483,9 @@ CrossTranslationUnitContext::ASTUnitStorage::getASTUnitForFunction(
       return FoundForFile.takeError();
     }
   } else {
-    // Found in the cache.
+    // Found in the cache. The corresponding file entry is still loaded,
+    // otherwise the name entry would have been dropped on eviction.
+    markAsMostRecentlyUsed(NameFileMap[FunctionName]);
     return ASTCacheEntry->second;
   }
 }
@@ -763,6 +805,24 @@ CrossTranslationUnitContext::getOrCreateASTImporter(ASTUnit *Unit) {
   return *NewImporter;
 }
 
+void CrossTranslationUnitContext::removeASTUnitData(ASTUnit *Unit) {
+  // The importer holds references into the unit, drop it together with the
+  // unit. Definitions already imported into the main AST are deep copies and
+  // remain valid; a later import from the same file recreates the importer.
+  ASTUnitImporterMap.erase(
+      Unit->getASTContext().getTranslationUnitDecl());
+
+  // Remove the FileID mappings that point into the unit, so that
+  // getImportedFromSourceLocation does not hand out an unloaded unit. Macro
+  // expansion information for locations imported from the unit is lost.
+  llvm::SmallVector<FileID, 8> ImportedIDs;
+  for (const auto &Entry : ImportedFileIDs)
+    if (Entry.second.second == Unit)
+      ImportedIDs.push_back(Entry.first);
+  for (FileID ID : ImportedIDs)
+    ImportedFileIDs.erase(ID);
+}
+
 llvm::Optional<std::pair<SourceLocation, ASTUnit *>>
 CrossTranslationUnitContext::getImportedFromSourceLocation(
     const clang::SourceLocation &ToLoc) const {
@@ -3933,9 +3933,16 @@ void Driver::BuildJobs(Compilation &C) const {
   if (C.getArgs().hasArg(options::OPT_fproc_stat_report))
     PrintProcessStat = true;
 
-  // If we have more than one job, then disable integrated-cc1 for now. Do this
-  // also when we need to report process execution statistics.
-  if (C.getJobs().size() > 1 || !StatReportFile.empty() || PrintProcessStat)
+  // Only run one job in-process per driver invocation. Running several cc1
+  // invocations in one process would accumulate memory leaked by each
+  // invocation and global state such as LLVM options across TUs. A single
+  // in-process cc1 followed by out-of-process jobs (typically the linker) is
+  // fine, and saves the process startup cost for the most expensive job.
+  // Also disable integrated-cc1 when we need to report process execution
+  // statistics, which are only available for child processes.
+  unsigned NumInProcessJobs = llvm::count_if(
+      C.getJobs(), [](const Command &J) { return J.InProcess; });
+  if (NumInProcessJobs > 1 || !StatReportFile.empty() || PrintProcessStat)
     for (auto &J : C.getJobs())
       J.InProcess = false;
 
@@ -375,7 +375,7 @@ void CC1Command::Print(raw_ostream &OS, const char *Terminator, bool Quote,
 
 int CC1Command::Execute(ArrayRef<llvm::Optional<StringRef>> Redirects,
                         std::string *ErrMsg, bool *ExecutionFailed) const {
-  // FIXME: Currently, if there're more than one job, we disable
+  // FIXME: Currently, if there's more than one in-process job, we disable
   // -fintegrate-cc1. If we're no longer a integrated-cc1 job, fallback to
   // out-of-process execution. See discussion in https://reviews.llvm.org/D74447
   if (!InProcess)
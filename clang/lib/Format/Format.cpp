@@ -2694,6 +2694,13 @@ reformat(const FormatStyle &Style, StringRef Code,
   unsigned Penalty = 0;
   for (size_t I = 0, E = Passes.size(); I < E; ++I) {
     std::pair<tooling::Replacements, unsigned> PassFixes = Passes[I](*Env);
+    // A pass without fixes leaves the code and the affected ranges unchanged,
+    // so the next pass can reuse the environment instead of copying the file
+    // and rebuilding the source manager.
+    if (PassFixes.first.empty()) {
+      Penalty += PassFixes.second;
+      continue;
+    }
     auto NewCode = applyAllReplacements(
         CurrentCode ? StringRef(*CurrentCode) : Code, PassFixes.first);
     if (NewCode) {
@@ -1639,9 +1639,13 @@ bool Lexer::tryConsumeIdentifierUTF8Char(const char *&CurPtr) {
   return true;
 }
 
+static const char *scanPastIdentifierBody(const char *CurPtr,
+                                          const char *BufferEnd);
+
 bool Lexer::LexIdentifier(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched [_A-Za-z$]
   unsigned Size;
+  CurPtr = scanPastIdentifierBody(CurPtr, BufferEnd);
   unsigned char C = *CurPtr++;
   while (isIdentifierBody(C))
     C = *CurPtr++;
@@ -1966,6 +1970,147 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
   return true;
 }
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/// Advance \p CurPtr to the start of the first 16-byte chunk in
+/// [CurPtr, BufferEnd) that contains one of the bytes \p B0, \p B1 or \p B2,
+/// or to within 16 bytes of \p BufferEnd, whichever comes first. The caller's
+/// byte-at-a-time loop finishes the scan; this only bulk-skips chunks that
+/// are certainly uninteresting, so it is safe to call with CurPtr anywhere.
+static const char *scanForBytes(const char *CurPtr, const char *BufferEnd,
+                                unsigned char B0, unsigned char B1,
+                                unsigned char B2) {
+#ifdef __SSE2__
+  const __m128i N0 = _mm_set1_epi8(B0);
+  const __m128i N1 = _mm_set1_epi8(B1);
+  const __m128i N2 = _mm_set1_epi8(B2);
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(CurPtr));
+    __m128i Hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Chunk, N0),
+                                             _mm_cmpeq_epi8(Chunk, N1)),
+                                _mm_cmpeq_epi8(Chunk, N2));
+    if (_mm_movemask_epi8(Hits) != 0)
+      break;
+    CurPtr += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t N0 = vdupq_n_u8(B0);
+  const uint8x16_t N1 = vdupq_n_u8(B1);
+  const uint8x16_t N2 = vdupq_n_u8(B2);
+  while (CurPtr + 16 <= BufferEnd) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(CurPtr));
+    uint8x16_t Hits = vorrq_u8(
+        vorrq_u8(vceqq_u8(Chunk, N0), vceqq_u8(Chunk, N1)),
+        vceqq_u8(Chunk, N2));
+    if (vmaxvq_u8(Hits) != 0)
+      break;
+    CurPtr += 16;
+  }
+#else
+  (void)BufferEnd;
+  (void)B0;
+  (void)B1;
+  (void)B2;
+#endif
+  return CurPtr;
+}
+
+/// Advance \p CurPtr past 16-byte chunks consisting entirely of horizontal
+/// whitespace (' ', '\t', '\f', '\v'). As with scanForBytes, the caller's
+/// byte-at-a-time loop handles whatever is left.
+static const char *scanPastHorizontalWhitespace(const char *CurPtr,
+                                                const char *BufferEnd) {
+#ifdef __SSE2__
+  const __m128i Space = _mm_set1_epi8(' ');
+  const __m128i Tab = _mm_set1_epi8('\t');
+  const __m128i FF = _mm_set1_epi8('\f');
+  const __m128i VT = _mm_set1_epi8('\v');
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(CurPtr));
+    __m128i WS = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, Space), _mm_cmpeq_epi8(Chunk, Tab)),
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, FF), _mm_cmpeq_epi8(Chunk, VT)));
+    if (_mm_movemask_epi8(WS) != 0xFFFF)
+      break;
+    CurPtr += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t Space = vdupq_n_u8(' ');
+  const uint8x16_t Tab = vdupq_n_u8('\t');
+  const uint8x16_t FF = vdupq_n_u8('\f');
+  const uint8x16_t VT = vdupq_n_u8('\v');
+  while (CurPtr + 16 <= BufferEnd) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(CurPtr));
+    uint8x16_t WS = vorrq_u8(
+        vorrq_u8(vceqq_u8(Chunk, Space), vceqq_u8(Chunk, Tab)),
+        vorrq_u8(vceqq_u8(Chunk, FF), vceqq_u8(Chunk, VT)));
+    if (vminvq_u8(WS) == 0)
+      break;
+    CurPtr += 16;
+  }
+#else
+  (void)BufferEnd;
+#endif
+  return CurPtr;
+}
+
+/// Advance \p CurPtr past 16-byte chunks consisting entirely of bytes that
+/// are identifier-body characters under every language mode ([0-9A-Za-z_]).
+/// '$', '\\', '?' and non-ASCII bytes stop the bulk scan and are left to the
+/// caller's byte-at-a-time loop, which knows about the language options.
+static const char *scanPastIdentifierBody(const char *CurPtr,
+                                          const char *BufferEnd) {
+#ifdef __SSE2__
+  const __m128i CaseBit = _mm_set1_epi8(0x20);
+  const __m128i BelowA = _mm_set1_epi8('a' - 1);
+  const __m128i AboveZ = _mm_set1_epi8('z' + 1);
+  const __m128i Below0 = _mm_set1_epi8('0' - 1);
+  const __m128i Above9 = _mm_set1_epi8('9' + 1);
+  const __m128i Underscore = _mm_set1_epi8('_');
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(CurPtr));
+    // Fold letters to lower case. Non-ASCII bytes stay negative under the
+    // signed compares below and so correctly fail every test.
+    __m128i Lower = _mm_or_si128(Chunk, CaseBit);
+    __m128i IsAlpha =
+        _mm_and_si128(_mm_cmpgt_epi8(Lower, BelowA), _mm_cmplt_epi8(Lower, AboveZ));
+    __m128i IsDigit =
+        _mm_and_si128(_mm_cmpgt_epi8(Chunk, Below0), _mm_cmplt_epi8(Chunk, Above9));
+    __m128i IsBody = _mm_or_si128(_mm_or_si128(IsAlpha, IsDigit),
+                                  _mm_cmpeq_epi8(Chunk, Underscore));
+    if (_mm_movemask_epi8(IsBody) != 0xFFFF)
+      break;
+    CurPtr += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t CaseBit = vdupq_n_u8(0x20);
+  const uint8x16_t Underscore = vdupq_n_u8('_');
+  while (CurPtr + 16 <= BufferEnd) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(CurPtr));
+    uint8x16_t Lower = vorrq_u8(Chunk, CaseBit);
+    uint8x16_t IsAlpha = vandq_u8(vcgeq_u8(Lower, vdupq_n_u8('a')),
+                                  vcleq_u8(Lower, vdupq_n_u8('z')));
+    uint8x16_t IsDigit = vandq_u8(vcgeq_u8(Chunk, vdupq_n_u8('0')),
+                                  vcleq_u8(Chunk, vdupq_n_u8('9')));
+    uint8x16_t IsBody =
+        vorrq_u8(vorrq_u8(IsAlpha, IsDigit), vceqq_u8(Chunk, Underscore));
+    if (vminvq_u8(IsBody) == 0)
+      break;
+    CurPtr += 16;
+  }
+#else
+  (void)BufferEnd;
+#endif
+  return CurPtr;
+}
+
 /// LexRawStringLiteral - Lex the remainder of a raw string literal, after
 /// having lexed R", LR", u8R", uR", or UR".
 bool Lexer::LexRawStringLiteral(Token &Result, const char *CurPtr,
@@ -2018,6 +2163,9 @@ bool Lexer::LexRawStringLiteral(Token &Result, const char *CurPtr,
   CurPtr += PrefixLen + 1; // skip over prefix and '('
 
   while (true) {
+    // Raw string bodies are often large; bulk-skip to the next ')' or a
+    // possible end-of-buffer NUL.
+    CurPtr = scanForBytes(CurPtr, BufferEnd, 0, ')', ')');
     char C = *CurPtr++;
 
     if (C == ')') {
@@ -2210,9 +2358,14 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
 
   // Skip consecutive spaces efficiently.
   while (true) {
-    // Skip horizontal whitespace very aggressively.
-    while (isHorizontalWhitespace(Char))
-      Char = *++CurPtr;
+    // Skip horizontal whitespace very aggressively, in bulk where whole
+    // chunks of the buffer are whitespace (deeply indented code).
+    if (isHorizontalWhitespace(Char)) {
+      CurPtr = scanPastHorizontalWhitespace(CurPtr, BufferEnd);
+      Char = *CurPtr;
+      while (isHorizontalWhitespace(Char))
+        Char = *++CurPtr;
+    }
 
     // Otherwise if we have something other than whitespace, we're done.
     if (!isVerticalWhitespace(Char))
@@ -2288,6 +2441,9 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
   // character that ends the line comment.
   char C;
   while (true) {
+    // Bulk-skip the comment body to the vicinity of the next newline or a
+    // possible end-of-buffer NUL.
+    CurPtr = scanForBytes(CurPtr, BufferEnd, 0, '\n', '\r');
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (C != 0 &&                // Potentially EOF.
@@ -2495,13 +2651,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
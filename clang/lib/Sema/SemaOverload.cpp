@@ -7002,6 +7002,37 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
 /// Add a C++ member function template as a candidate to the candidate
 /// set, using template argument deduction to produce an appropriate member
 /// function template specialization.
+/// Check whether a function template candidate can be rejected for having the
+/// wrong number of arguments without attempting template argument deduction.
+///
+/// Deduction cannot change the arity of a template whose parameter list
+/// contains no packs, so for such templates an unsalvageable argument count
+/// lets us skip deduction entirely. Returns the failure kind to record, or
+/// None if deduction is required to decide.
+static Optional<OverloadFailureKind>
+checkArityForTemplateCandidate(FunctionDecl *FD, unsigned NumArgs,
+                               bool PartialOverloading) {
+  if (PartialOverloading)
+    return None;
+
+  const auto *Proto = FD->getType()->castAs<FunctionProtoType>();
+  if (NumArgs > Proto->getNumParams() && !Proto->isVariadic()) {
+    // A parameter pack can absorb any number of extra arguments.
+    bool HasPack = llvm::any_of(FD->parameters(), [](const ParmVarDecl *P) {
+      return P->isParameterPack();
+    });
+    if (!HasPack)
+      return ovl_fail_too_many_arguments;
+  }
+
+  // Parameter packs and defaulted parameters are already excluded from the
+  // minimum, so too few arguments is non-viable no matter what is deduced.
+  if (NumArgs < FD->getMinRequiredArguments())
+    return ovl_fail_too_few_arguments;
+
+  return None;
+}
+
 void Sema::AddMethodTemplateCandidate(
     FunctionTemplateDecl *MethodTmpl, DeclAccessPair FoundDecl,
     CXXRecordDecl *ActingContext,
@@ -7012,6 +7043,31 @@ void Sema::AddMethodTemplateCandidate(
   if (!CandidateSet.isNewCandidate(MethodTmpl, PO))
     return;
 
+  // If the candidate cannot be made viable for this number of arguments no
+  // matter what is deduced, record the arity failure without deducing. With
+  // explicit template arguments, deduce anyway so that problems with them are
+  // diagnosed in preference to the argument count.
+  if (Optional<OverloadFailureKind> FK =
+          ExplicitTemplateArgs
+              ? None
+              : checkArityForTemplateCandidate(MethodTmpl->getTemplatedDecl(),
+                                               Args.size(),
+                                               PartialOverloading)) {
+    OverloadCandidate &Candidate = CandidateSet.addCandidate();
+    Candidate.FoundDecl = FoundDecl;
+    Candidate.Function = MethodTmpl->getTemplatedDecl();
+    Candidate.Viable = false;
+    Candidate.RewriteKind =
+        CandidateSet.getRewriteInfo().getRewriteKind(Candidate.Function, PO);
+    Candidate.IsSurrogate = false;
+    Candidate.IgnoreObjectArgument =
+        cast<CXXMethodDecl>(Candidate.Function)->isStatic() ||
+        ObjectType.isNull();
+    Candidate.ExplicitCallArguments = Args.size();
+    Candidate.FailureKind = *FK;
+    return;
+  }
+
   // C++ [over.match.funcs]p7:
   //   In each case where a candidate is a function template, candidate
   //   function template specializations are generated using template argument
@@ -7095,6 +7151,32 @@ void Sema::AddTemplateOverloadCandidate(
     return;
   }
 
+  // If the candidate cannot be made viable for this number of arguments no
+  // matter what is deduced, record the arity failure without deducing. With
+  // explicit template arguments, deduce anyway so that problems with them are
+  // diagnosed in preference to the argument count.
+  if (Optional<OverloadFailureKind> FK =
+          ExplicitTemplateArgs
+              ? None
+              : checkArityForTemplateCandidate(
+                    FunctionTemplate->getTemplatedDecl(), Args.size(),
+                    PartialOverloading)) {
+    OverloadCandidate &Candidate = CandidateSet.addCandidate();
+    Candidate.FoundDecl = FoundDecl;
+    Candidate.Function = FunctionTemplate->getTemplatedDecl();
+    Candidate.Viable = false;
+    Candidate.RewriteKind =
+        CandidateSet.getRewriteInfo().getRewriteKind(Candidate.Function, PO);
+    Candidate.IsSurrogate = false;
+    Candidate.IsADLCandidate = IsADLCandidate;
+    Candidate.IgnoreObjectArgument =
+        isa<CXXMethodDecl>(Candidate.Function) &&
+        !isa<CXXConstructorDecl>(Candidate.Function);
+    Candidate.ExplicitCallArguments = Args.size();
+    Candidate.FailureKind = *FK;
+    return;
+  }
+
   // C++ [over.match.funcs]p7:
   //   In each case where a candidate is a function template, candidate
   //   function template specializations are generated using template argument
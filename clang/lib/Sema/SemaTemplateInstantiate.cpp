@@ -29,11 +29,17 @@
 #include "clang/Sema/Template.h"
 #include "clang/Sema/TemplateDeduction.h"
 #include "clang/Sema/TemplateInstCallback.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/TimeProfiler.h"
 
 using namespace clang;
 using namespace sema;
 
+#define DEBUG_TYPE "template-instantiation"
+
+STATISTIC(NumClassDefinitionsInstantiated,
+          "Number of class definitions instantiated from a template pattern");
+
 //===----------------------------------------------------------------------===/
 // Template Instantiation Support
 //===----------------------------------------------------------------------===/
@@ -2641,6 +2647,7 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
   });
 
   Pattern = PatternDef;
+  ++NumClassDefinitionsInstantiated;
 
   // Record the point of instantiation.
   if (MemberSpecializationInfo *MSInfo
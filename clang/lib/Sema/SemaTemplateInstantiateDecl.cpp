@@ -26,10 +26,17 @@
 #include "clang/Sema/SemaInternal.h"
 #include "clang/Sema/Template.h"
 #include "clang/Sema/TemplateInstCallback.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/TimeProfiler.h"
 
 using namespace clang;
 
+#define DEBUG_TYPE "template-instantiation"
+
+STATISTIC(NumFunctionDefinitionsInstantiated,
+          "Number of function definitions instantiated from a template "
+          "pattern");
+
 static bool isDeclWithinFunction(const Decl *D) {
   const DeclContext *DC = D->getDeclContext();
   if (DC->isFunctionOrMethod())
@@ -4764,6 +4771,7 @@ void Sema::InstantiateFunctionDefinition(SourceLocation PointOfInstantiation,
                                    /*Qualified=*/true);
     return Name;
   });
+  ++NumFunctionDefinitionsInstantiated;
 
   // If we're performing recursive template instantiation, create our own
   // queue of pending implicit instantiations that we will instantiate later,
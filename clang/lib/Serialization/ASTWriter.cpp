@@ -4422,6 +4422,15 @@ ASTFileSignature ASTWriter::WriteASTCore(Sema &SemaRef, StringRef isysroot,
   ASTContext &Context = SemaRef.Context;
   Preprocessor &PP = SemaRef.PP;
 
+  // Pre-size the type and declaration side tables. The number of types is
+  // known exactly; declarations are estimated from it, which is close enough
+  // to avoid most of the rehashing while the declaration chains are emitted.
+  unsigned NumTypes = Context.getTypes().size();
+  TypeIdxs.reserve(NumTypes);
+  TypeOffsets.reserve(NumTypes);
+  DeclIDs.reserve(NumTypes * 2);
+  DeclOffsets.reserve(NumTypes * 2);
+
   // Set up predefined declaration IDs.
   auto RegisterPredefDecl = [&] (Decl *D, PredefinedDeclIDs ID) {
     if (D) {
@@ -1024,11 +1024,23 @@ void ASTDeclWriter::VisitVarDecl(VarDecl *D) {
       // definition in the module interface is provided by the compilation of
       // that module interface unit, not by its users. (Inline variables are
       // still emitted in module users.)
-      ModulesCodegen =
-          (Writer.WritingModule->Kind == Module::ModuleInterfaceUnit ||
-           (D->hasAttr<DLLExportAttr>() &&
-            Writer.Context->getLangOpts().BuildingPCHWithObjectFile)) &&
-          Writer.Context->GetGVALinkageForVariable(D) == GVA_StrongExternal;
+      Optional<GVALinkage> Linkage;
+      if (Writer.WritingModule->Kind == Module::ModuleInterfaceUnit ||
+          (D->hasAttr<DLLExportAttr>() &&
+           Writer.Context->getLangOpts().BuildingPCHWithObjectFile)) {
+        Linkage = Writer.Context->GetGVALinkageForVariable(D);
+        ModulesCodegen = *Linkage == GVA_StrongExternal;
+      }
+      // Under -fmodules-codegen, the module object additionally provides the
+      // definition of every non-internal variable, mirroring what
+      // AddFunctionDefinition does for functions, so that importers can treat
+      // inline variables as available externally.
+      if (!ModulesCodegen && Writer.Context->getLangOpts().ModulesCodegen) {
+        if (!Linkage)
+          Linkage = Writer.Context->GetGVALinkageForVariable(D);
+        ModulesCodegen =
+            *Linkage != GVA_Internal && *Linkage != GVA_AvailableExternally;
+      }
     }
     Record.push_back(ModulesCodegen);
     if (ModulesCodegen)
@@ -334,6 +334,33 @@ bool GlobalModuleIndex::lookupIdentifier(StringRef Name, HitSet &Hits) {
   return true;
 }
 
+unsigned GlobalModuleIndex::getNumModuleFileRecords() const {
+  return Modules.size();
+}
+
+GlobalModuleIndex::ModuleFileRecord
+GlobalModuleIndex::getModuleFileRecord(unsigned ID) const {
+  const ModuleInfo &Info = Modules[ID];
+  return {Info.FileName, Info.Size, Info.ModTime, Info.Dependencies};
+}
+
+void GlobalModuleIndex::visitIdentifiers(
+    llvm::function_ref<void(StringRef, ArrayRef<unsigned>)> Callback) const {
+  if (!IdentifierIndex)
+    return;
+
+  IdentifierIndexTable &Table =
+      *static_cast<IdentifierIndexTable *>(IdentifierIndex);
+  // The key and data iterators walk the items of the table in lockstep.
+  IdentifierIndexTable::key_iterator Key = Table.key_begin(),
+                                     KeyEnd = Table.key_end();
+  IdentifierIndexTable::data_iterator Data = Table.data_begin();
+  for (; Key != KeyEnd; ++Key, ++Data) {
+    SmallVector<unsigned, 2> ModuleIDs = *Data;
+    Callback(*Key, ModuleIDs);
+  }
+}
+
 bool GlobalModuleIndex::loadedModuleFile(ModuleFile *File) {
   // Look for the module in the global module index based on the module name.
   StringRef Name = File->ModuleName;
@@ -435,6 +462,10 @@ namespace {
     /// files in which those identifiers are considered interesting.
     InterestingIdentifierMap InterestingIdentifiers;
 
+    /// Mapping from module file IDs in a previous index to the IDs assigned
+    /// by this builder, for module files carried over without reloading.
+    llvm::DenseMap<unsigned, unsigned> PrevIDToNewID;
+
     /// Write the block-info block for the global module index file.
     void emitBlockInfoBlock(llvm::BitstreamWriter &Stream);
 
@@ -459,6 +490,17 @@ namespace {
     /// Load the contents of the given module file into the builder.
     llvm::Error loadModuleFile(const FileEntry *File);
 
+    /// Carry the given module file over from a previous index without
+    /// reloading it, if both the file and all of its recorded dependencies
+    /// are unchanged on disk.
+    /// \returns true if the module file was carried over.
+    bool tryReuseFromPreviousIndex(const GlobalModuleIndex &PrevIndex,
+                                   unsigned PrevID, const FileEntry *File);
+
+    /// Import the identifier table entries of all carried-over module files
+    /// from the previous index.
+    void copyIdentifiersFromPreviousIndex(const GlobalModuleIndex &PrevIndex);
+
     /// Write the index to the given bitstream.
     /// \returns true if an error occurred, false otherwise.
     bool writeIndex(llvm::BitstreamWriter &Stream);
@@ -713,6 +755,70 @@ llvm::Error GlobalModuleIndexBuilder::loadModuleFile(const FileEntry *File) {
   return llvm::Error::success();
 }
 
+bool GlobalModuleIndexBuilder::tryReuseFromPreviousIndex(
+    const GlobalModuleIndex &PrevIndex, unsigned PrevID,
+    const FileEntry *File) {
+  GlobalModuleIndex::ModuleFileRecord Record =
+      PrevIndex.getModuleFileRecord(PrevID);
+  if (File->getSize() != Record.Size ||
+      File->getModificationTime() != Record.ModTime)
+    return false;
+
+  // Reuse is only sound if every dependency is unchanged as well: the
+  // imports of this module file were validated when the previous index was
+  // built, so unchanged dependencies are still coherent. If a dependency
+  // did change, reload this module file instead; the imports check in
+  // writeIndex() then catches any incoherence, as it always has.
+  SmallVector<const FileEntry *, 4> DependsOnFiles;
+  for (unsigned DepID : Record.Dependencies) {
+    GlobalModuleIndex::ModuleFileRecord DepRecord =
+        PrevIndex.getModuleFileRecord(DepID);
+    if (DepRecord.FileName.empty())
+      return false;
+    auto DepFile = FileMgr.getFile(DepRecord.FileName, /*OpenFile=*/false,
+                                   /*CacheFailure=*/false);
+    if (!DepFile || (*DepFile)->getSize() != DepRecord.Size ||
+        (*DepFile)->getModificationTime() != DepRecord.ModTime)
+      return false;
+    DependsOnFiles.push_back(*DepFile);
+  }
+
+  // Assign the dependency IDs before taking a reference into the module
+  // files map; creating entries may invalidate earlier references.
+  SmallVector<unsigned, 4> Dependencies;
+  for (const FileEntry *DependsOnFile : DependsOnFiles)
+    Dependencies.push_back(getModuleFileInfo(DependsOnFile).ID);
+
+  ModuleFileInfo &Info = getModuleFileInfo(File);
+  Info.Dependencies.append(Dependencies.begin(), Dependencies.end());
+  PrevIDToNewID[PrevID] = Info.ID;
+  return true;
+}
+
+void GlobalModuleIndexBuilder::copyIdentifiersFromPreviousIndex(
+    const GlobalModuleIndex &PrevIndex) {
+  if (PrevIDToNewID.empty())
+    return;
+
+  PrevIndex.visitIdentifiers([&](StringRef Name, ArrayRef<unsigned> PrevIDs) {
+    SmallVector<unsigned, 2> NewIDs;
+    for (unsigned PrevID : PrevIDs) {
+      auto Known = PrevIDToNewID.find(PrevID);
+      if (Known != PrevIDToNewID.end())
+        NewIDs.push_back(Known->second);
+    }
+    // Identifiers whose hits all belong to reloaded or removed module files
+    // are dropped here; the reloaded files contribute their identifiers
+    // through loadModuleFile(). Lookups of identifiers that end up absent
+    // from the index fall back to searching every module, so this only
+    // costs time, never correctness.
+    if (NewIDs.empty())
+      return;
+    SmallVector<unsigned, 2> &IDs = InterestingIdentifiers[Name];
+    IDs.append(NewIDs.begin(), NewIDs.end());
+  });
+}
+
 namespace {
 
 /// Trait used to generate the identifier index as an on-disk hash
@@ -877,6 +983,26 @@ GlobalModuleIndex::writeIndex(FileManager &FileMgr,
   // The module index builder.
   GlobalModuleIndexBuilder Builder(FileMgr, PCHContainerRdr);
 
+  // Read the existing index, if there is one, so module files that have not
+  // changed since it was built can be carried over without reloading them.
+  std::unique_ptr<GlobalModuleIndex> PrevIndex;
+  {
+    auto Existing = GlobalModuleIndex::readIndex(Path);
+    if (Existing.first)
+      PrevIndex.reset(Existing.first);
+    else
+      llvm::consumeError(std::move(Existing.second));
+  }
+  llvm::StringMap<unsigned> PrevIDByFileName;
+  if (PrevIndex) {
+    for (unsigned ID = 0, N = PrevIndex->getNumModuleFileRecords(); ID != N;
+         ++ID) {
+      StringRef FileName = PrevIndex->getModuleFileRecord(ID).FileName;
+      if (!FileName.empty())
+        PrevIDByFileName[FileName] = ID;
+    }
+  }
+
   // Load each of the module files.
   std::error_code EC;
   for (llvm::sys::fs::directory_iterator D(Path, EC), DEnd;
@@ -899,11 +1025,24 @@ GlobalModuleIndex::writeIndex(FileManager &FileMgr,
     if (!ModuleFile)
       continue;
 
+    // Carry the module file over from the existing index if it is unchanged.
+    if (PrevIndex) {
+      auto Known = PrevIDByFileName.find((*ModuleFile)->getName());
+      if (Known != PrevIDByFileName.end() &&
+          Builder.tryReuseFromPreviousIndex(*PrevIndex, Known->second,
+                                            *ModuleFile))
+        continue;
+    }
+
     // Load this module file.
     if (llvm::Error Err = Builder.loadModuleFile(*ModuleFile))
       return Err;
   }
 
+  // Import the identifier tables of the carried-over module files.
+  if (PrevIndex)
+    Builder.copyIdentifiersFromPreviousIndex(*PrevIndex);
+
   // The output buffer, into which the global index will be written.
   SmallString<16> OutputBuffer;
   {
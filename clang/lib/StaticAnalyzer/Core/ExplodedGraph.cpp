@@ -28,6 +28,7 @@
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Casting.h"
 #include <cassert>
 #include <memory>
@@ -35,6 +36,13 @@
 using namespace clang;
 using namespace ento;
 
+#define DEBUG_TYPE "ExplodedGraph"
+
+STATISTIC(NumNodesReclaimed,
+          "The # of nodes reclaimed from the exploded graph");
+STATISTIC(NumNodesRecycled,
+          "The # of node allocations served from reclaimed nodes");
+
 //===----------------------------------------------------------------------===//
 // Cleanup.
 //===----------------------------------------------------------------------===//
@@ -164,6 +172,7 @@ void ExplodedGraph::collectNode(ExplodedNode *node) {
   FreeNodes.push_back(node);
   Nodes.RemoveNode(node);
   --NumNodes;
+  ++NumNodesReclaimed;
   node->~ExplodedNode();
 }
 
@@ -406,6 +415,7 @@ ExplodedNode *ExplodedGraph::getNode(const ProgramPoint &L,
     if (!FreeNodes.empty()) {
       V = FreeNodes.back();
       FreeNodes.pop_back();
+      ++NumNodesRecycled;
     }
     else {
       // Allocate a new node.
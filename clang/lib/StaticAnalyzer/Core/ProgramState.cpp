@@ -18,11 +18,17 @@
 #include "clang/StaticAnalyzer/Core/PathSensitive/DynamicType.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ExprEngine.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ProgramStateTrait.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace clang;
 using namespace ento;
 
+#define DEBUG_TYPE "ProgramState"
+
+STATISTIC(NumStatesRecycled,
+          "The # of state allocations served from released states");
+
 namespace clang { namespace  ento {
 /// Increments the number of times this state is referenced.
 
@@ -418,6 +424,7 @@ ProgramStateRef ProgramStateManager::getPersistentState(ProgramState &State) {
   if (!freeStates.empty()) {
     newState = freeStates.back();
     freeStates.pop_back();
+    ++NumStatesRecycled;
   }
   else {
     newState = (ProgramState*) Alloc.Allocate<ProgramState>();
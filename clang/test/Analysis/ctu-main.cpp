@@ -15,6 +15,16 @@
 // RUN:   -analyzer-config experimental-enable-naive-ctu-analysis=true \
 // RUN:   -analyzer-config ctu-dir=%t/ctudir \
 // RUN:   -analyzer-config display-ctu-progress=true 2>&1 %s | FileCheck %s
+//
+// Eviction and reload of the least recently used AST must not change the
+// analysis results.
+// RUN: %clang_analyze_cc1 -std=c++14 -triple x86_64-pc-linux-gnu \
+// RUN:   -analyzer-checker=core,debug.ExprInspection \
+// RUN:   -analyzer-config experimental-enable-naive-ctu-analysis=true \
+// RUN:   -analyzer-config ctu-dir=%t/ctudir \
+// RUN:   -analyzer-config ctu-max-loaded-asts=1 \
+// RUN:   -analyzer-config ctu-import-cpp-threshold=100 \
+// RUN:   -verify %s
 
 // CHECK: CTU loaded AST file: {{.*}}ctu-other.cpp.ast
 // CHECK: CTU loaded AST file: {{.*}}ctu-chain.cpp.ast
@@ -31,14 +31,15 @@
 // Only one TU, one job, thus integrated-cc1 is enabled.
 // RUN: %clang -fintegrated-cc1 -fintegrated-as -c %s -### 2>&1 | FileCheck %s --check-prefix=YES
 
-// Only one TU, but we're linking, two jobs, thus integrated-cc1 is disabled.
-// RUN: %clang -fintegrated-cc1 %s -### 2>&1 | FileCheck %s --check-prefix=NO
+// Only one TU, but we're linking. The linker runs out-of-process, so the
+// single cc1 job still runs in-process.
+// RUN: %clang -fintegrated-cc1 -fintegrated-as %s -### 2>&1 | FileCheck %s --check-prefix=YES
 
 // RUN: echo 'int main() { return f() + g(); }' > %t1.cpp
 // RUN: echo 'int f() { return 1; }' > %t2.cpp
 // RUN: echo 'int g() { return 2; }' > %t3.cpp
 
-// Three jobs, thus integrated-cc1 is disabled.
+// Three cc1 jobs, thus integrated-cc1 is disabled.
 // RUN: %clang -fintegrated-cc1 -c %t1.cpp %t2.cpp %t3.cpp -### 2>&1 | FileCheck %s --check-prefix=NO
 
 // -fintegrated-cc1 works with cc1as.
@@ -492,39 +492,32 @@ int main(int argc, const char **argv) {
     WorkerTools.push_back(std::make_unique<DependencyScanningTool>(Service));
 
   std::vector<SingleCommandCompilationDatabase> Inputs;
-  for (tooling::CompileCommand Cmd :
+  for (tooling::CompileCommand &Cmd :
        AdjustingCompilations->getAllCompileCommands())
-    Inputs.emplace_back(Cmd);
+    Inputs.emplace_back(std::move(Cmd));
 
   std::atomic<bool> HadErrors(false);
   FullDeps FD;
-  std::mutex Lock;
-  size_t Index = 0;
+  std::atomic<size_t> Index(0);
 
   if (Verbose) {
     llvm::outs() << "Running clang-scan-deps on " << Inputs.size()
                  << " files using " << Pool.getThreadCount() << " workers\n";
   }
   for (unsigned I = 0; I < Pool.getThreadCount(); ++I) {
-    Pool.async([I, &Lock, &Index, &Inputs, &HadErrors, &FD, &WorkerTools,
+    Pool.async([I, &Index, &Inputs, &HadErrors, &FD, &WorkerTools,
                 &DependencyOS, &Errs]() {
       llvm::StringSet<> AlreadySeenModules;
       while (true) {
-        const SingleCommandCompilationDatabase *Input;
-        std::string Filename;
-        std::string CWD;
-        size_t LocalIndex;
-        // Take the next input.
-        {
-          std::unique_lock<std::mutex> LockGuard(Lock);
-          if (Index >= Inputs.size())
-            return;
-          LocalIndex = Index;
-          Input = &Inputs[Index++];
-          tooling::CompileCommand Cmd = Input->getAllCompileCommands()[0];
-          Filename = std::move(Cmd.Filename);
-          CWD = std::move(Cmd.Directory);
-        }
+        // Take the next input. The inputs are only read from here on, so no
+        // lock is needed beyond the claiming of an index.
+        size_t LocalIndex = Index++;
+        if (LocalIndex >= Inputs.size())
+          return;
+        const SingleCommandCompilationDatabase *Input = &Inputs[LocalIndex];
+        tooling::CompileCommand Cmd = Input->getAllCompileCommands()[0];
+        std::string Filename = std::move(Cmd.Filename);
+        std::string CWD = std::move(Cmd.Directory);
         // Run the tool on it.
         if (Format == ScanningOutputFormat::Make) {
           auto MaybeFile = WorkerTools[I]->getDependencyFile(*Input, CWD);
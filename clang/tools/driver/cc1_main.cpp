@@ -207,6 +207,8 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
                                                     Argv, Diags, Argv0);
 
   if (Clang->getFrontendOpts().TimeTrace) {
+    if (Clang->getFrontendOpts().TimeTraceHWCounters)
+      llvm::timeTraceProfilerEnableHardwareCounters();
     llvm::timeTraceProfilerInitialize(
         Clang->getFrontendOpts().TimeTraceGranularity, Argv0);
   }
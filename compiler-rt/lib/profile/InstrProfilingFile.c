@@ -315,6 +315,36 @@ static FILE *openFileForMerging(const char *ProfileFileName, int *MergeDone) {
   return ProfileFile;
 }
 
+/* Return 1 if no counter in this image has been incremented, in which case
+ * merging the in-memory profile into an existing compatible profile on disk
+ * would not change it. Value profile data can only be collected by executing
+ * instrumented code, which increments the enclosing function's counters, so
+ * all counters being zero implies there is no value profile data either. */
+static int profileDataIsEmpty(void) {
+  const uint64_t *I = __llvm_profile_begin_counters();
+  const uint64_t *E = __llvm_profile_end_counters();
+  for (; I < E; ++I)
+    if (*I)
+      return 0;
+  return 1;
+}
+
+/* Return the size of the file \p Filename, or 0 if it cannot be opened. */
+static long getFileSizeByName(const char *Filename) {
+  FILE *File = fopen(Filename, "rb");
+  long Size;
+
+  if (!File)
+    return 0;
+  if (fseek(File, 0L, SEEK_END) == -1) {
+    fclose(File);
+    return 0;
+  }
+  Size = ftell(File);
+  fclose(File);
+  return Size < 0 ? 0 : Size;
+}
+
 static FILE *getFileObject(const char *OutputName) {
   FILE *File;
   File = getProfileFile();
@@ -332,10 +362,19 @@ static int writeFile(const char *OutputName) {
 
   int MergeDone = 0;
   VPMergeHook = &lprofMergeValueProfData;
-  if (doMerging())
+  if (doMerging()) {
+    /* A process that did not execute any instrumented code contributes
+     * nothing to an existing profile: skip the lock/merge/rewrite cycle so
+     * that farms of short-lived forked workers do not serialize on the pool
+     * file. The write still happens when the target file is missing or empty
+     * so that a profile is produced even if no counter ever fired. */
+    if (!getProfileFile() && !__llvm_profile_is_continuous_mode_enabled() &&
+        profileDataIsEmpty() && getFileSizeByName(OutputName) > 0)
+      return 0;
     OutputFile = openFileForMerging(OutputName, &MergeDone);
-  else
+  } else {
     OutputFile = getFileObject(OutputName);
+  }
 
   if (!OutputFile)
     return -1;
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "sanitizer_allocator_internal.h"
+#include "sanitizer_flags.h"
 #include "sanitizer_platform.h"
 #include "sanitizer_internal_defs.h"
 #include "sanitizer_libc.h"
@@ -39,6 +40,22 @@ void AddressInfo::FillModuleInfo(const char *mod_name, uptr mod_offset,
   module_arch = mod_arch;
 }
 
+void AddressInfo::CopyFrom(const AddressInfo &other) {
+  Clear();
+  address = other.address;
+  if (other.module)
+    module = internal_strdup(other.module);
+  module_offset = other.module_offset;
+  module_arch = other.module_arch;
+  if (other.function)
+    function = internal_strdup(other.function);
+  function_offset = other.function_offset;
+  if (other.file)
+    file = internal_strdup(other.file);
+  line = other.line;
+  column = other.column;
+}
+
 SymbolizedStack::SymbolizedStack() : next(nullptr), info() {}
 
 SymbolizedStack *SymbolizedStack::New(uptr addr) {
@@ -55,6 +72,14 @@ void SymbolizedStack::ClearAll() {
   InternalFree(this);
 }
 
+SymbolizedStack *SymbolizedStack::Duplicate() const {
+  SymbolizedStack *res = New(info.address);
+  res->info.CopyFrom(info);
+  if (next)
+    res->next = next->Duplicate();
+  return res;
+}
+
 DataInfo::DataInfo() {
   internal_memset(this, 0, sizeof(DataInfo));
 }
@@ -112,8 +137,45 @@ const char *Symbolizer::ModuleNameOwner::GetOwnedCopy(const char *str) {
 }
 
 Symbolizer::Symbolizer(IntrusiveList<SymbolizerTool> tools)
-    : module_names_(&mu_), modules_(), modules_fresh_(false), tools_(tools),
-      start_hook_(0), end_hook_(0) {}
+    : module_names_(&mu_), modules_(), modules_fresh_(false),
+      pc_cache_(nullptr), pc_cache_size_(0), tools_(tools), start_hook_(0),
+      end_hook_(0) {}
+
+SymbolizedStack *Symbolizer::LookupPCCache(uptr addr) {
+  if (!pc_cache_)
+    return nullptr;
+  const PCCacheEntry &entry = pc_cache_[addr % pc_cache_size_];
+  if (entry.addr != addr || !entry.frames)
+    return nullptr;
+  // Return a copy that the caller owns and frees with ClearAll().
+  return entry.frames->Duplicate();
+}
+
+void Symbolizer::UpdatePCCache(uptr addr, const SymbolizedStack *frames) {
+  uptr size = common_flags()->symbolizer_cache_size;
+  if (!size)
+    return;
+  if (!pc_cache_) {
+    pc_cache_size_ = size;
+    pc_cache_ =
+        (PCCacheEntry *)InternalAlloc(pc_cache_size_ * sizeof(PCCacheEntry));
+    internal_memset(pc_cache_, 0, pc_cache_size_ * sizeof(PCCacheEntry));
+  }
+  PCCacheEntry &entry = pc_cache_[addr % pc_cache_size_];
+  if (entry.frames)
+    entry.frames->ClearAll();
+  entry.addr = addr;
+  entry.frames = frames->Duplicate();
+}
+
+void Symbolizer::FlushPCCache() {
+  if (!pc_cache_)
+    return;
+  for (uptr i = 0; i < pc_cache_size_; i++)
+    if (pc_cache_[i].frames)
+      pc_cache_[i].frames->ClearAll();
+  internal_memset(pc_cache_, 0, pc_cache_size_ * sizeof(PCCacheEntry));
+}
 
 Symbolizer::SymbolizerScope::SymbolizerScope(const Symbolizer *sym)
     : sym_(sym) {
@@ -45,6 +45,9 @@ struct AddressInfo {
   // Deletes all strings and resets all fields.
   void Clear();
   void FillModuleInfo(const char *mod_name, uptr mod_offset, ModuleArch arch);
+  // Deep-copies all fields from another AddressInfo, duplicating the owned
+  // strings.
+  void CopyFrom(const AddressInfo &other);
 };
 
 // Linked list of symbolized frames (each frame is described by AddressInfo).
@@ -55,6 +58,8 @@ struct SymbolizedStack {
   // Deletes current, and all subsequent frames in the linked list.
   // The object cannot be accessed after the call to this function.
   void ClearAll();
+  // Returns a deep copy of the whole list that the caller owns.
+  SymbolizedStack *Duplicate() const;
 
  private:
   SymbolizedStack();
@@ -178,6 +183,21 @@ class Symbolizer final {
   bool FindModuleNameAndOffsetForAddress(uptr address, const char **module_name,
                                          uptr *module_offset,
                                          ModuleArch *module_arch);
+
+  // Direct-mapped cache of deep copies of the most recently symbolized PCs,
+  // used to avoid querying the symbolizer tools again when frequent reports
+  // repeatedly hit the same addresses. All accesses are protected by |mu_|.
+  struct PCCacheEntry {
+    uptr addr;
+    SymbolizedStack *frames;
+  };
+  // Returns a copy of the cached frames for |addr| that the caller owns, or
+  // nullptr on a cache miss.
+  SymbolizedStack *LookupPCCache(uptr addr);
+  void UpdatePCCache(uptr addr, const SymbolizedStack *frames);
+  void FlushPCCache();
+  PCCacheEntry *pc_cache_;
+  uptr pc_cache_size_;
   ListOfModules modules_;
   ListOfModules fallback_modules_;
   // If stale, need to reload the modules before looking up addresses.
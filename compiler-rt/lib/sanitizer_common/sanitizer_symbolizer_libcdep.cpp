@@ -84,6 +84,10 @@ const char *ExtractTokenUpToDelimiter(const char *str, const char *delimiter,
 
 SymbolizedStack *Symbolizer::SymbolizePC(uptr addr) {
   BlockingMutexLock l(&mu_);
+  // Serve repeated addresses from the cache so that frequent reports do not
+  // query the symbolizer tools again and again for the same frames.
+  if (SymbolizedStack *cached = LookupPCCache(addr))
+    return cached;
   const char *module_name = nullptr;
   uptr module_offset;
   ModuleArch arch;
@@ -96,6 +100,7 @@ SymbolizedStack *Symbolizer::SymbolizePC(uptr addr) {
   for (auto &tool : tools_) {
     SymbolizerScope sym_scope(this);
     if (tool.SymbolizePC(addr, res)) {
+      UpdatePCCache(addr, res);
       return res;
     }
   }
@@ -155,6 +160,7 @@ bool Symbolizer::GetModuleNameAndOffsetForPC(uptr pc, const char **module_name,
 
 void Symbolizer::Flush() {
   BlockingMutexLock l(&mu_);
+  FlushPCCache();
   for (auto &tool : tools_) {
     SymbolizerScope sym_scope(this);
     tool.Flush();
@@ -189,6 +195,9 @@ void Symbolizer::RefreshModules() {
   fallback_modules_.fallbackInit();
   RAW_CHECK(modules_.size() > 0);
   modules_fresh_ = true;
+  // The module list has changed, so cached frames may refer to unloaded or
+  // relocated code.
+  FlushPCCache();
 }
 
 static const LoadedModule *SearchForModule(const ListOfModules &modules,
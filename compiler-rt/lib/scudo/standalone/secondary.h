@@ -113,6 +113,8 @@ public:
           Entries[0].MapSize = H->MapSize;
           Entries[0].Data = H->Data;
           Entries[0].Time = Time;
+          if (OldestTime == 0)
+            OldestTime = Time;
           EntriesCount++;
           EntryCached = true;
           break;
@@ -207,23 +209,34 @@ private:
       }
       EntriesCount = 0;
       IsFullEvents = 0;
+      OldestTime = 0;
     }
     for (uptr I = 0; I < N; I++)
       unmap(MapInfo[I].MapBase, MapInfo[I].MapSize, UNMAP_ALL,
             &MapInfo[I].Data);
   }
 
+  // OldestTime tracks the time of the oldest entry whose pages have not been
+  // released yet, so that the (eg) per-store release attempts can bail out
+  // without taking the mutex and scanning the entries when no entry has aged
+  // past the release interval.
   void releaseOlderThan(u64 Time) {
     ScopedLock L(Mutex);
-    if (!EntriesCount)
+    if (!EntriesCount || OldestTime == 0 || OldestTime > Time)
       return;
+    OldestTime = 0;
     for (uptr I = 0; I < EntriesArraySize; I++) {
-      if (!Entries[I].Block || !Entries[I].Time || Entries[I].Time > Time)
+      CachedBlock &Entry = Entries[I];
+      if (!Entry.Block || !Entry.Time)
         continue;
-      releasePagesToOS(Entries[I].Block, 0,
-                       Entries[I].BlockEnd - Entries[I].Block,
-                       &Entries[I].Data);
-      Entries[I].Time = 0;
+      if (Entry.Time > Time) {
+        if (OldestTime == 0 || Entry.Time < OldestTime)
+          OldestTime = Entry.Time;
+        continue;
+      }
+      releasePagesToOS(Entry.Block, 0, Entry.BlockEnd - Entry.Block,
+                       &Entry.Data);
+      Entry.Time = 0;
     }
   }
 
@@ -243,6 +256,7 @@ private:
   atomic_uptr MaxEntrySize;
   uptr LargestSize;
   u32 IsFullEvents;
+  u64 OldestTime;
   atomic_s32 ReleaseToOsIntervalMs;
 };
 
@@ -23,6 +23,10 @@
 # define TSAN_NO_HISTORY 0
 #endif
 
+#ifndef TSAN_COMPACT_SHADOW
+# define TSAN_COMPACT_SHADOW 0
+#endif
+
 #ifndef TSAN_COLLECT_STATS
 # define TSAN_COLLECT_STATS 0
 #endif
@@ -74,7 +78,15 @@ const unsigned kMaxTidInClock = kMaxTid;  // Go does not track freed memory.
 const uptr kShadowStackSize = 64 * 1024;
 
 // Count of shadow values in a shadow cell.
+#if TSAN_COMPACT_SHADOW
+// Compact shadow keeps two shadow values per application word instead of
+// four, halving the shadow-to-application memory ratio. Races are still
+// detected, but fewer previous accesses are remembered per word, so a racy
+// access is more likely to be evicted before the racing thread gets to it.
+const uptr kShadowCnt = 2;
+#else
 const uptr kShadowCnt = 4;
+#endif
 
 // That many user bytes are mapped onto a single shadow cell.
 const uptr kShadowCell = 8;
@@ -681,7 +681,7 @@ void MemoryAccessImpl1(ThreadState *thr, uptr addr,
   // consumes almost 4K of stack. Gtest gives only 4K of stack to death test
   // threads, which is not enough for the unrolled loop.
 #if SANITIZER_DEBUG
-  for (int idx = 0; idx < 4; idx++) {
+  for (int idx = 0; idx < (int)kShadowCnt; idx++) {
 #include "tsan_update_shadow_word_inl.h"
   }
 #else
@@ -693,6 +693,7 @@ void MemoryAccessImpl1(ThreadState *thr, uptr addr,
   } else {
 #include "tsan_update_shadow_word_inl.h"
   }
+#if !TSAN_COMPACT_SHADOW
   idx = 2;
   if (stored) {
 #include "tsan_update_shadow_word_inl.h"
@@ -705,6 +706,7 @@ void MemoryAccessImpl1(ThreadState *thr, uptr addr,
   } else {
 #include "tsan_update_shadow_word_inl.h"
   }
+#endif
 #endif
 
   // we did not find any races and had already stored
@@ -771,9 +773,16 @@ bool ContainsSameAccessFast(u64 *s, u64 a, u64 sync_epoch, bool is_write) {
   // addr0[64:95]       = access[32:63]
   // addr0[96:127]      = access[32:63]
   const m128 addr0      = SHUF(access, access, 1, 1, 1, 1);
+#if TSAN_COMPACT_SHADOW
+  // load the 2 shadow slots and process them twice; the duplicated lanes
+  // produce the same comparison results, so the code below works unchanged
+  const m128 shadow0    = _mm_load_si128((__m128i*)s);
+  const m128 shadow1    = shadow0;
+#else
   // load 4 shadow slots
   const m128 shadow0    = _mm_load_si128((__m128i*)s);
   const m128 shadow1    = _mm_load_si128((__m128i*)s + 1);
+#endif
   // load high parts of 4 shadow slots into addr_vect:
   // addr_vect[0:31]    = shadow0[32:63]
   // addr_vect[32:63]   = shadow0[96:127]
@@ -832,12 +841,20 @@ ALWAYS_INLINE USED
 void MemoryAccess(ThreadState *thr, uptr pc, uptr addr,
     int kAccessSizeLog, bool kAccessIsWrite, bool kIsAtomic) {
   u64 *shadow_mem = (u64*)MemToShadow(addr);
+#if TSAN_COMPACT_SHADOW
+  DPrintf2("#%d: MemoryAccess: @%p %p size=%d"
+      " is_write=%d shadow_mem=%p {%zx, %zx}\n",
+      (int)thr->fast_state.tid(), (void*)pc, (void*)addr,
+      (int)(1 << kAccessSizeLog), kAccessIsWrite, shadow_mem,
+      (uptr)shadow_mem[0], (uptr)shadow_mem[1]);
+#else
   DPrintf2("#%d: MemoryAccess: @%p %p size=%d"
       " is_write=%d shadow_mem=%p {%zx, %zx, %zx, %zx}\n",
       (int)thr->fast_state.tid(), (void*)pc, (void*)addr,
       (int)(1 << kAccessSizeLog), kAccessIsWrite, shadow_mem,
       (uptr)shadow_mem[0], (uptr)shadow_mem[1],
       (uptr)shadow_mem[2], (uptr)shadow_mem[3]);
+#endif
 #if SANITIZER_DEBUG
   if (!IsAppMem(addr)) {
     Printf("Access to non app mem %zx\n", addr);
@@ -189,6 +189,10 @@ private:
   bool debugModuleWriter_{false};
   const evaluate::IntrinsicProcTable intrinsics_;
   Scope globalScope_;
+  // The scope most recently returned by FindScope(); consecutive lookups
+  // nearly always land in the same program unit, so searching near it first
+  // avoids scanning every unit in the file per lookup.
+  Scope *lastFoundScope_{nullptr};
   parser::Messages messages_;
   evaluate::FoldingContext foldingContext_;
   ConstructStack constructStack_;
@@ -250,7 +250,21 @@ const Scope &SemanticsContext::FindScope(parser::CharBlock source) const {
 }
 
 Scope &SemanticsContext::FindScope(parser::CharBlock source) {
+  // Try the enclosing scopes of the last result first. Checks visit the
+  // statements of one program unit at a time, while a search from the global
+  // scope must scan the ranges of every unit in the file, which is quadratic
+  // on files with many subprograms.
+  if (lastFoundScope_) {
+    for (Scope *scope{lastFoundScope_}; !scope->IsGlobal();
+         scope = &scope->parent()) {
+      if (scope->sourceRange().Contains(source)) {
+        lastFoundScope_ = scope->FindScope(source);
+        return DEREF(lastFoundScope_);
+      }
+    }
+  }
   if (auto *scope{globalScope_.FindScope(source)}) {
+    lastFoundScope_ = scope;
     return *scope;
   } else {
     common::die("SemanticsContext::FindScope(): invalid source location");
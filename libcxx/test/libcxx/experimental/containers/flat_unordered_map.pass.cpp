@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11
+
+// <experimental/flat_unordered_map>
+
+// Basic coverage for the open-addressing map: insertion, lookup, erasure
+// with tombstone reuse, iteration, copy/move/swap, and rehashing.
+
+#include <experimental/flat_unordered_map>
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test_macros.h"
+
+using std::experimental::flat_unordered_map;
+
+int main(int, char**)
+{
+    flat_unordered_map<int, int> m;
+    assert(m.empty());
+    assert(m.find(3) == m.end());
+
+    // Insert enough to force several rehashes.
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::pair<flat_unordered_map<int, int>::iterator, bool> r =
+            m.insert({i, i * 2});
+        assert(r.second);
+        assert(r.first->first == i);
+    }
+    assert(m.size() == 1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        assert(m.count(i) == 1);
+        assert(m.find(i)->second == i * 2);
+    }
+    assert(!m.insert({5, 99}).second);
+    m[5] = 42;
+    assert(m.at(5) == 42);
+#ifndef TEST_HAS_NO_EXCEPTIONS
+    {
+        bool threw = false;
+        try { m.at(5000); } catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+    }
+#endif
+
+    // Erased slots become tombstones and are reused on reinsertion.
+    for (int i = 0; i < 500; ++i)
+        assert(m.erase(i) == 1);
+    assert(m.erase(123) == 0);
+    assert(m.size() == 500);
+    for (int i = 0; i < 500; ++i)
+        assert(m.find(i) == m.end());
+    for (int i = 0; i < 500; ++i)
+        m[i] = -i;
+    assert(m.size() == 1000);
+    assert(m.at(100) == -100);
+
+    // Iteration visits every element exactly once.
+    std::vector<bool> seen(1000, false);
+    std::size_t n = 0;
+    for (flat_unordered_map<int, int>::iterator it = m.begin(); it != m.end();
+         ++it, ++n)
+    {
+        assert(!seen[it->first]);
+        seen[it->first] = true;
+    }
+    assert(n == 1000);
+
+    // try_emplace and emplace with non-trivial keys.
+    flat_unordered_map<std::string, std::string> sm;
+    sm.emplace("hello", "world");
+    sm.try_emplace("foo", 3, 'x');
+    assert(sm.at("hello") == "world");
+    assert(sm.at("foo") == "xxx");
+    assert(!sm.try_emplace("foo", "y").second);
+
+    // Copy, move, swap, assignment, comparison.
+    flat_unordered_map<std::string, std::string> sm2 = sm;
+    assert(sm2 == sm);
+    sm2["extra"] = "1";
+    assert(sm2 != sm);
+    flat_unordered_map<std::string, std::string> sm3 = std::move(sm2);
+    assert(sm3.size() == 3);
+    assert(sm3.at("extra") == "1");
+    sm3.swap(sm);
+    assert(sm.size() == 3);
+    assert(sm3.size() == 2);
+    sm3 = {{"a", "1"}, {"b", "2"}};
+    assert(sm3.size() == 2);
+    sm3.erase(sm3.find("a"));
+    assert(!sm3.contains("a"));
+    sm3.clear();
+    assert(sm3.empty());
+
+    // reserve avoids rehashing below the requested size; rehash preserves
+    // the contents.
+    flat_unordered_map<int, int> rm;
+    rm.reserve(100);
+    std::size_t cap = rm.bucket_count();
+    for (int i = 0; i < 80; ++i)
+        rm[i] = i;
+    assert(rm.bucket_count() == cap);
+    rm.rehash(1024);
+    assert(rm.bucket_count() >= 1024);
+    for (int i = 0; i < 80; ++i)
+        assert(rm.at(i) == i);
+
+    return 0;
+}
@@ -664,7 +664,16 @@ static std::string createResponseFile(const opt::InputArgList &args,
   return std::string(data.str());
 }
 
-enum class DebugKind { Unknown, None, Full, FastLink, GHash, Dwarf, Symtab };
+enum class DebugKind {
+  Unknown,
+  None,
+  Full,
+  FastLink,
+  GHash,
+  NoGHash,
+  Dwarf,
+  Symtab
+};
 
 static DebugKind parseDebugKind(const opt::InputArgList &args) {
   auto *a = args.getLastArg(OPT_debug, OPT_debug_opt);
@@ -679,6 +688,7 @@ static DebugKind parseDebugKind(const opt::InputArgList &args) {
                      .CaseLower("fastlink", DebugKind::FastLink)
                      // LLD extensions
                      .CaseLower("ghash", DebugKind::GHash)
+                     .CaseLower("noghash", DebugKind::NoGHash)
                      .CaseLower("dwarf", DebugKind::Dwarf)
                      .CaseLower("symtab", DebugKind::Symtab)
                      .Default(DebugKind::Unknown);
@@ -1339,7 +1349,7 @@ void LinkerDriver::link(ArrayRef<const char *> argsArr) {
   // Handle /debug
   DebugKind debug = parseDebugKind(args);
   if (debug == DebugKind::Full || debug == DebugKind::Dwarf ||
-      debug == DebugKind::GHash) {
+      debug == DebugKind::GHash || debug == DebugKind::NoGHash) {
     config->debug = true;
     config->incremental = true;
   }
@@ -1362,7 +1372,8 @@ void LinkerDriver::link(ArrayRef<const char *> argsArr) {
 
   // Handle /pdb
   bool shouldCreatePDB =
-      (debug == DebugKind::Full || debug == DebugKind::GHash);
+      (debug == DebugKind::Full || debug == DebugKind::GHash ||
+       debug == DebugKind::NoGHash);
   if (shouldCreatePDB) {
     if (auto *arg = args.getLastArg(OPT_pdb))
       config->pdbPath = arg->getValue();
@@ -1694,7 +1705,10 @@ void LinkerDriver::link(ArrayRef<const char *> argsArr) {
   config->terminalServerAware =
       !config->dll && args.hasFlag(OPT_tsaware, OPT_tsaware_no, true);
   config->debugDwarf = debug == DebugKind::Dwarf;
-  config->debugGHashes = debug == DebugKind::GHash;
+  // Type merging with global type hashing shards the work per object file
+  // and runs in parallel, so make it the default for /debug; /debug:noghash
+  // selects the old single-threaded TypeStreamMerger pipeline.
+  config->debugGHashes = debug == DebugKind::GHash || debug == DebugKind::Full;
   config->debugSymtab = debug == DebugKind::Symtab;
   config->autoImport =
       args.hasFlag(OPT_auto_import, OPT_auto_import_no, config->mingw);
@@ -1857,6 +1857,22 @@ void Writer::writeSections() {
   }
 }
 
+// Computes a hash of the output file contents. Hashing all bytes in a single
+// xxHash64 call is serial and shows up on the critical path for large
+// binaries, so we split the file into 1MB chunks, hash them in parallel, and
+// then hash the concatenation of the chunk hashes. Chunk hashes are stored in
+// little-endian order so that the result does not depend on the host.
+static uint64_t computeOutputHash(StringRef data) {
+  const size_t chunkSize = 1024 * 1024;
+  size_t numChunks = (data.size() + chunkSize - 1) / chunkSize;
+  std::vector<uint8_t> hashes(numChunks * sizeof(uint64_t));
+  parallelForEachN(0, numChunks, [&](size_t i) {
+    support::endian::write64le(hashes.data() + i * sizeof(uint64_t),
+                               xxHash64(data.substr(i * chunkSize, chunkSize)));
+  });
+  return xxHash64(toStringRef(hashes));
+}
+
 void Writer::writeBuildId() {
   // There are two important parts to the build ID.
   // 1) If building with debug info, the COFF debug directory contains a
@@ -1883,7 +1899,7 @@ void Writer::writeBuildId() {
       config->mingw && config->debug && config->pdbPath.empty();
 
   if (config->repro || generateSyntheticBuildId)
-    hash = xxHash64(outputFileData);
+    hash = computeOutputHash(outputFileData);
 
   if (config->repro)
     timestamp = static_cast<uint32_t>(hash);
@@ -12,6 +12,7 @@
 
 #include "lld/Common/Filesystem.h"
 #include "llvm/Config/llvm-config.h"
+#include "llvm/Support/CachePruning.h"
 #include "llvm/Support/FileOutputBuffer.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Parallel.h"
@@ -108,6 +109,39 @@ void lld::unlinkAsync(StringRef path) {
 #endif
 }
 
+// Prunes the ThinLTO cache directory on a background thread. Walking the
+// cache stats every entry, which on network filesystems can take longer than
+// the rest of the link; nothing downstream depends on the result, so there is
+// no reason to keep it on the critical path. If the process exits before the
+// prune finishes the thread is simply torn down; each removal is an
+// independent atomic operation, so the cache stays valid and the next prune
+// picks up where this one stopped.
+void lld::pruneCacheAsync(StringRef path,
+                          const llvm::CachePruningPolicy &policy) {
+  if (parallel::strategy.ThreadsRequested == 1) {
+    pruneCache(path, policy);
+    return;
+  }
+
+  // Wait until the thread has started before detaching it, for the same
+  // reason as in unlinkAsync: older GLIBC versions crash if the main thread
+  // calls exit(2) while another thread is starting up.
+  std::mutex m;
+  std::condition_variable cv;
+  bool started = false;
+  std::thread([&, pathCopy = path.str(), policy] {
+    {
+      std::lock_guard<std::mutex> l(m);
+      started = true;
+      cv.notify_all();
+    }
+    pruneCache(pathCopy, policy);
+  }).detach();
+
+  std::unique_lock<std::mutex> l(m);
+  cv.wait(l, [&] { return started; });
+}
+
 // Simulate file creation to see if Path is writable.
 //
 // Determining whether a file is writable or not is amazingly hard,
@@ -85,12 +85,54 @@ private:
   std::vector<const InputSectionBase *> sections;
 };
 
+// Implementation of --call-graph-profile-order=bisection: recursive balanced
+// graph bisection. The section set is repeatedly split into two size-balanced
+// halves so that as much call graph edge weight as possible stays within a
+// half, then each half is laid out recursively. Unlike C3, which grows chains
+// greedily from the hottest section and can place two sections that call each
+// other in clusters that end up far apart, bisection bounds the distance
+// between related sections at every level, which helps both iTLB reach and
+// the number of pages faulted in during startup.
+class CallGraphBisect {
+public:
+  CallGraphBisect();
+
+  DenseMap<const InputSectionBase *, int> run();
+
+private:
+  struct Neighbor {
+    int node;
+    uint64_t weight;
+  };
+
+  void bisect(MutableArrayRef<int> nodes, int depth);
+
+  std::vector<const InputSectionBase *> sections;
+  std::vector<uint64_t> sizes;
+  std::vector<uint64_t> weights;
+  std::vector<std::vector<Neighbor>> neighbors;
+
+  // Scratch state for bisect(): which nodes belong to the working range,
+  // which half of the current cut each one is on, and its current move gain.
+  std::vector<int> rangeId;
+  std::vector<uint8_t> half;
+  std::vector<int64_t> gain;
+  int curRangeId = 0;
+};
+
 // Maximum amount the combined cluster density can be worse than the original
 // cluster to consider merging.
 constexpr int MAX_DENSITY_DEGRADATION = 8;
 
 // Maximum cluster size in bytes.
 constexpr uint64_t MAX_CLUSTER_SIZE = 1024 * 1024;
+
+// Stop bisecting once a range is this small; sections within a leaf share a
+// page or two no matter how they are permuted.
+constexpr size_t BISECT_LEAF_SIZE = 16;
+
+// Maximum number of swap-refinement passes per cut.
+constexpr int MAX_BISECT_PASSES = 10;
 } // end anonymous namespace
 
 using SectionPair =
@@ -176,6 +218,26 @@ static void mergeClusters(std::vector<Cluster> &cs, Cluster &into, int intoIdx,
   from.weight = 0;
 }
 
+// Print the symbols of the given sections, in layout order, into the file
+// specified by --print-symbol-order.
+static void printSymbolOrder(ArrayRef<const InputSectionBase *> ordered) {
+  std::error_code ec;
+  raw_fd_ostream os(config->printSymbolOrder, ec, sys::fs::OF_None);
+  if (ec) {
+    error("cannot open " + config->printSymbolOrder + ": " + ec.message());
+    return;
+  }
+
+  // Search all the symbols in the file of each section and find out Defined
+  // symbols with names that are within the section.
+  for (const InputSectionBase *sec : ordered)
+    for (Symbol *sym : sec->file->getSymbols())
+      if (!sym->isSection()) // Filter out section-type symbols here.
+        if (auto *d = dyn_cast<Defined>(sym))
+          if (sec == d->section)
+            os << sym->getName() << "\n";
+}
+
 // Group InputSections into clusters using the Call-Chain Clustering heuristic
 // then sort the clusters by density.
 DenseMap<const InputSectionBase *, int> CallGraphSort::run() {
@@ -222,48 +284,189 @@ DenseMap<const InputSectionBase *, int> CallGraphSort::run() {
   });
 
   DenseMap<const InputSectionBase *, int> orderMap;
+  std::vector<const InputSectionBase *> ordered;
   int curOrder = 1;
   for (int leader : sorted) {
     for (int i = leader;;) {
       orderMap[sections[i]] = curOrder++;
+      ordered.push_back(sections[i]);
       i = clusters[i].next;
       if (i == leader)
         break;
     }
   }
-  if (!config->printSymbolOrder.empty()) {
-    std::error_code ec;
-    raw_fd_ostream os(config->printSymbolOrder, ec, sys::fs::OF_None);
-    if (ec) {
-      error("cannot open " + config->printSymbolOrder + ": " + ec.message());
-      return orderMap;
+  if (!config->printSymbolOrder.empty())
+    printSymbolOrder(ordered);
+  return orderMap;
+}
+
+// Take the edge list in Config->CallGraphProfile and build an undirected
+// weighted graph between InputSections, with the same cross-output-section
+// filtering as CallGraphSort.
+CallGraphBisect::CallGraphBisect() {
+  MapVector<SectionPair, uint64_t> &profile = config->callGraphProfile;
+  DenseMap<const InputSectionBase *, int> secToNode;
+
+  auto getOrCreateNode = [&](const InputSectionBase *isec) -> int {
+    auto res = secToNode.try_emplace(isec, sections.size());
+    if (res.second) {
+      sections.push_back(isec);
+      sizes.push_back(isec->getSize());
+      weights.push_back(0);
+      neighbors.emplace_back();
     }
+    return res.first->second;
+  };
 
-    // Print the symbols ordered by C3, in the order of increasing curOrder
-    // Instead of sorting all the orderMap, just repeat the loops above.
-    for (int leader : sorted)
-      for (int i = leader;;) {
-        // Search all the symbols in the file of the section
-        // and find out a Defined symbol with name that is within the section.
-        for (Symbol *sym : sections[i]->file->getSymbols())
-          if (!sym->isSection()) // Filter out section-type symbols here.
-            if (auto *d = dyn_cast<Defined>(sym))
-              if (sections[i] == d->section)
-                os << sym->getName() << "\n";
-        i = clusters[i].next;
-        if (i == leader)
-          break;
+  for (std::pair<SectionPair, uint64_t> &c : profile) {
+    const auto *fromSB = cast<InputSectionBase>(c.first.first->repl);
+    const auto *toSB = cast<InputSectionBase>(c.first.second->repl);
+    uint64_t weight = c.second;
+
+    // See the comment in CallGraphSort::CallGraphSort.
+    if (fromSB->getOutputSection() != toSB->getOutputSection())
+      continue;
+
+    int from = getOrCreateNode(fromSB);
+    int to = getOrCreateNode(toSB);
+
+    // Use the incoming edge weight as the hotness proxy, as C3 does.
+    weights[to] += weight;
+
+    if (from == to)
+      continue;
+
+    neighbors[from].push_back({to, weight});
+    neighbors[to].push_back({from, weight});
+  }
+
+  rangeId.assign(sections.size(), -1);
+  half.assign(sections.size(), 0);
+  gain.assign(sections.size(), 0);
+}
+
+// Reorder nodes so that the two roughly size-balanced halves of the range
+// keep as much edge weight internal as possible, then recurse into each half.
+void CallGraphBisect::bisect(MutableArrayRef<int> nodes, int depth) {
+  if (nodes.size() <= BISECT_LEAF_SIZE || depth > 25) {
+    // Within a leaf the permutation no longer matters for paging; put the
+    // hottest sections first to keep the global hot-to-cold gradient.
+    llvm::stable_sort(nodes,
+                      [&](int a, int b) { return weights[a] > weights[b]; });
+    return;
+  }
+
+  // Start with the element midpoint as the cut. Halves may drift apart in
+  // size during refinement, but only up to the slack below, so both halves
+  // keep covering a similar number of pages.
+  uint64_t totalSize = 0, maxNodeSize = 0;
+  for (int n : nodes) {
+    totalSize += sizes[n];
+    maxNodeSize = std::max(maxNodeSize, sizes[n]);
+  }
+  uint64_t slack = std::max(totalSize / 10, maxNodeSize);
+
+  int id = ++curRangeId;
+  uint64_t halfSize[2] = {0, 0};
+  for (size_t i = 0, e = nodes.size(); i != e; ++i) {
+    int n = nodes[i];
+    rangeId[n] = id;
+    half[n] = i < e / 2;
+    halfSize[half[n]] += sizes[n];
+  }
+
+  // Refine the cut with single-node moves. The gain of moving a node is the
+  // edge weight it has to the far half minus the weight to its own half.
+  // Each pass recomputes all gains, visits nodes from the (initially) most
+  // misplaced down, and greedily moves every node whose up-to-date gain is
+  // still positive and whose move keeps the halves within the size slack.
+  // Gains of the neighbors are updated incrementally after each move so that
+  // two connected nodes do not chase each other across the cut.
+  std::vector<int> candidates(nodes.begin(), nodes.end());
+  for (int pass = 0; pass != MAX_BISECT_PASSES; ++pass) {
+    for (int n : nodes) {
+      int64_t g = 0;
+      for (const Neighbor &nb : neighbors[n]) {
+        if (rangeId[nb.node] != id)
+          continue;
+        if (half[nb.node] == half[n])
+          g -= nb.weight;
+        else
+          g += nb.weight;
+      }
+      gain[n] = g;
+    }
+    llvm::stable_sort(candidates,
+                      [&](int a, int b) { return gain[a] > gain[b]; });
+
+    bool changed = false;
+    for (int n : candidates) {
+      if (gain[n] <= 0)
+        continue;
+      uint8_t to = !half[n];
+      if (halfSize[to] + sizes[n] > totalSize / 2 + slack)
+        continue;
+      halfSize[half[n]] -= sizes[n];
+      halfSize[to] += sizes[n];
+      half[n] = to;
+      gain[n] = -gain[n];
+      for (const Neighbor &nb : neighbors[n]) {
+        if (rangeId[nb.node] != id)
+          continue;
+        if (half[nb.node] == to)
+          gain[nb.node] -= 2 * (int64_t)nb.weight;
+        else
+          gain[nb.node] += 2 * (int64_t)nb.weight;
       }
+      changed = true;
+    }
+    if (!changed)
+      break;
   }
 
+  // Partition the range according to the refined cut, keeping the relative
+  // order within each half stable, and recurse.
+  size_t mid = std::stable_partition(nodes.begin(), nodes.end(),
+                                     [&](int n) { return half[n]; }) -
+               nodes.begin();
+  if (mid == 0 || mid == nodes.size())
+    mid = nodes.size() / 2;
+  bisect(nodes.slice(0, mid), depth + 1);
+  bisect(nodes.slice(mid), depth + 1);
+}
+
+DenseMap<const InputSectionBase *, int> CallGraphBisect::run() {
+  // Start from a hot-to-cold order so the first cut separates the startup
+  // and steady-state working set from rarely executed code.
+  std::vector<int> order(sections.size());
+  std::iota(order.begin(), order.end(), 0);
+  llvm::stable_sort(order,
+                    [&](int a, int b) { return weights[a] > weights[b]; });
+
+  bisect(order, 0);
+
+  DenseMap<const InputSectionBase *, int> orderMap;
+  std::vector<const InputSectionBase *> ordered;
+  int curOrder = 1;
+  for (int n : order) {
+    orderMap[sections[n]] = curOrder++;
+    ordered.push_back(sections[n]);
+  }
+  if (!config->printSymbolOrder.empty())
+    printSymbolOrder(ordered);
   return orderMap;
 }
 
-// Sort sections by the profile data provided by -callgraph-profile-file
+// Sort sections by the profile data provided by --call-graph-ordering-file or
+// .llvm.call-graph-profile sections.
 //
-// This first builds a call graph based on the profile data then merges sections
-// according to the C³ heuristic. All clusters are then sorted by a density
-// metric to further improve locality.
+// By default this builds a call graph based on the profile data, merges
+// sections according to the C³ heuristic, and sorts the resulting clusters by
+// a density metric to further improve locality. With
+// --call-graph-profile-order=bisection the sections are instead laid out by
+// recursive balanced graph bisection.
 DenseMap<const InputSectionBase *, int> elf::computeCallGraphProfileOrder() {
+  if (config->callGraphProfileOrder == CGProfileOrderKind::Bisection)
+    return CallGraphBisect().run();
   return CallGraphSort().run();
 }
@@ -40,6 +40,9 @@ enum ELFKind {
 // For --build-id.
 enum class BuildIdKind { None, Fast, Md5, Sha1, Hexstring, Uuid };
 
+// For --call-graph-profile-order={c3,bisection}.
+enum class CGProfileOrderKind { C3, Bisection };
+
 // For --discard-{all,locals,none}.
 enum class DiscardPolicy { Default, All, Locals, None };
 
@@ -241,6 +244,7 @@ struct Configuration {
   bool zText;
   bool zRetpolineplt;
   bool zWxneeded;
+  CGProfileOrderKind callGraphProfileOrder;
   DiscardPolicy discard;
   GnuStackKind zGnustack;
   ICFLevel icf;
@@ -673,6 +673,15 @@ static DiscardPolicy getDiscard(opt::InputArgList &args) {
   return DiscardPolicy::None;
 }
 
+static CGProfileOrderKind getCGProfileOrder(opt::InputArgList &args) {
+  StringRef s = args.getLastArgValue(OPT_call_graph_profile_order, "c3");
+  if (s == "bisection")
+    return CGProfileOrderKind::Bisection;
+  if (s != "c3")
+    error("unknown --call-graph-profile-order: " + s);
+  return CGProfileOrderKind::C3;
+}
+
 static StringRef getDynamicLinker(opt::InputArgList &args) {
   auto *arg = args.getLastArg(OPT_dynamic_linker, OPT_no_dynamic_linker);
   if (!arg)
@@ -958,6 +967,7 @@ static void readConfigs(opt::InputArgList &args) {
   config->emitRelocs = args.hasArg(OPT_emit_relocs);
   config->callGraphProfileSort = args.hasFlag(
       OPT_call_graph_profile_sort, OPT_no_call_graph_profile_sort, true);
+  config->callGraphProfileOrder = getCGProfileOrder(args);
   config->enableNewDtags =
       args.hasFlag(OPT_enable_new_dtags, OPT_disable_new_dtags, true);
   config->entry = args.getLastArgValue(OPT_entry);
@@ -1559,8 +1569,11 @@ static void excludeLibs(opt::InputArgList &args) {
   auto visit = [&](InputFile *file) {
     if (!file->archiveName.empty())
       if (all || libs.count(path::filename(file->archiveName)))
+        // Local symbols may not have been created yet; they are irrelevant
+        // here anyway.
         for (Symbol *sym : file->getSymbols())
-          if (!sym->isUndefined() && !sym->isLocal() && sym->file == file)
+          if (sym && !sym->isUndefined() && !sym->isLocal() &&
+              sym->file == file)
             sym->versionId = VER_NDX_LOCAL;
   };
 
@@ -2192,6 +2205,14 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
       !config->thinLTOModulesToCompile.empty())
     return;
 
+  // Symbol resolution is done, so local symbols can now be created without
+  // any serial bottleneck. This is done after compileBitcodeFiles() so that
+  // object files created by LTO are covered as well.
+  {
+    llvm::TimeTraceScope timeScope("Initialize local symbols");
+    parallelForEach(objectFiles, initializeLocalSymbols);
+  }
+
   // Apply symbol renames for -wrap and combine foo@v1 and foo@@v1.
   redirectSymbols(wrapped);
 
@@ -412,10 +412,10 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   current = cnt % 2;
   next = (cnt + 1) % 2;
 
-  // Shard into non-overlapping intervals, and call Fn in parallel.
-  // The sharding must be completed before any calls to Fn are made
-  // so that Fn can modify the Chunks in its shard without causing data
-  // races.
+  // Shard into non-overlapping intervals so that the class ranges within
+  // them can be enumerated in parallel. The sharding must be completed
+  // before any calls to Fn are made so that Fn can modify the Chunks in its
+  // shard without causing data races.
   const size_t numShards = 256;
   size_t step = sections.size() / numShards;
   size_t boundaries[numShards + 1];
@@ -426,9 +426,39 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
     boundaries[i] = findBoundary((i - 1) * step, sections.size());
   });
 
-  parallelForEachN(1, numShards + 1, [&](size_t i) {
-    if (boundaries[i - 1] < boundaries[i])
-      forEachClassRange(boundaries[i - 1], boundaries[i], fn);
+  // Enumerate the class ranges in each shard, calling Fn immediately on
+  // trivial single-section classes (Fn must still see them so that their
+  // next-slot class IDs get written) and collecting the rest.
+  std::vector<std::pair<size_t, size_t>> shardClasses[numShards];
+  parallelForEachN(0, numShards, [&](size_t i) {
+    size_t begin = boundaries[i];
+    size_t end = boundaries[i + 1];
+    while (begin < end) {
+      size_t mid = findBoundary(begin, end);
+      if (mid - begin == 1)
+        fn(begin, mid);
+      else
+        shardClasses[i].push_back({begin, mid});
+      begin = mid;
+    }
+  });
+
+  // Process the non-trivial classes largest-first, distributing whole
+  // classes rather than fixed intervals. Classes are disjoint, so Fn can run
+  // on each of them independently, and a huge equivalence class (common with
+  // --icf=all on statically linked binaries, where early iterations keep
+  // most of .text in one class) no longer serializes the entire interval it
+  // happens to land in.
+  std::vector<std::pair<size_t, size_t>> classes;
+  for (size_t i = 0; i != numShards; ++i)
+    classes.insert(classes.end(), shardClasses[i].begin(),
+                   shardClasses[i].end());
+  parallelSort(classes.begin(), classes.end(),
+               [](std::pair<size_t, size_t> a, std::pair<size_t, size_t> b) {
+                 return a.second - a.first > b.second - b.first;
+               });
+  parallelForEach(classes, [&](std::pair<size_t, size_t> c) {
+    fn(c.first, c.second);
   });
   ++cnt;
 }
@@ -232,6 +232,28 @@ void elf::parseFile(InputFile *file) {
   }
 }
 
+// Create Symbol objects for an object file's local symbols. This is deferred
+// until after symbol resolution so that it can run in parallel; see
+// ObjFile<ELFT>::initializeLocalSymbols().
+void elf::initializeLocalSymbols(InputFile *file) {
+  switch (config->ekind) {
+  case ELF32LEKind:
+    cast<ObjFile<ELF32LE>>(file)->initializeLocalSymbols();
+    return;
+  case ELF32BEKind:
+    cast<ObjFile<ELF32BE>>(file)->initializeLocalSymbols();
+    return;
+  case ELF64LEKind:
+    cast<ObjFile<ELF64LE>>(file)->initializeLocalSymbols();
+    return;
+  case ELF64BEKind:
+    cast<ObjFile<ELF64BE>>(file)->initializeLocalSymbols();
+    return;
+  default:
+    llvm_unreachable("unknown ELFT");
+  }
+}
+
 // Concatenates arguments to construct a string representing an error location.
 static std::string createFileLineMsg(StringRef path, unsigned line) {
   std::string filename = std::string(path::filename(path));
@@ -1105,32 +1127,20 @@ template <class ELFT> void ObjFile<ELFT>::initializeSymbols() {
       continue;
     }
 
-    // Handle local symbols. Local symbols are not added to the symbol
-    // table because they are not visible from other object files. We
-    // allocate symbol instances and add their pointers to symbols.
+    // Check local symbols here, but defer creating their Symbol instances
+    // to initializeLocalSymbols(), which runs in parallel across object
+    // files once symbol resolution is done. Local symbols are not added to
+    // the symbol table because they are not visible from other object
+    // files, so nothing during resolution needs them.
     if (i >= firstGlobal)
       errorOrWarn(toString(this) + ": STB_LOCAL symbol (" + Twine(i) +
                   ") found at index >= .symtab's sh_info (" +
                   Twine(firstGlobal) + ")");
 
-    InputSectionBase *sec = this->sections[secIdx];
-    uint8_t type = eSym.getType();
-    if (type == STT_FILE)
+    if (eSym.getType() == STT_FILE)
       sourceFile = CHECK(eSym.getName(this->stringTable), this);
     if (this->stringTable.size() <= eSym.st_name)
       fatal(toString(this) + ": invalid symbol name offset");
-    StringRefZ name = this->stringTable.data() + eSym.st_name;
-
-    if (eSym.st_shndx == SHN_UNDEF)
-      this->symbols[i] =
-          make<Undefined>(this, name, STB_LOCAL, eSym.st_other, type);
-    else if (sec == &InputSection::discarded)
-      this->symbols[i] =
-          make<Undefined>(this, name, STB_LOCAL, eSym.st_other, type,
-                          /*discardedSecIdx=*/secIdx);
-    else
-      this->symbols[i] = make<Defined>(this, name, STB_LOCAL, eSym.st_other,
-                                       type, eSym.st_value, eSym.st_size, sec);
   }
 
   // Symbol resolution of non-local symbols.
@@ -1200,6 +1210,46 @@ template <class ELFT> void ObjFile<ELFT>::initializeSymbols() {
   }
 }
 
+// Create Symbol instances for local symbols. initializeSymbols() has already
+// diagnosed malformed entries, so this only materializes objects. Locals are
+// stored in a per-file array instead of going through make<> because this
+// runs in parallel across object files and the global arena allocators are
+// not thread-safe. The string table is mmapped and names are captured as
+// StringRefZ, so no bytes are copied here.
+template <class ELFT> void ObjFile<ELFT>::initializeLocalSymbols() {
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+
+  size_t numLocals = 0;
+  for (size_t i = 0, end = eSyms.size(); i != end; ++i)
+    if (eSyms[i].getBinding() == STB_LOCAL && !this->symbols[i])
+      ++numLocals;
+  if (numLocals == 0)
+    return;
+  localSymStorage = std::make_unique<SymbolUnion[]>(numLocals);
+
+  SymbolUnion *locals = localSymStorage.get();
+  for (size_t i = 0, end = eSyms.size(); i != end; ++i) {
+    const Elf_Sym &eSym = eSyms[i];
+    if (eSym.getBinding() != STB_LOCAL || this->symbols[i])
+      continue;
+
+    InputSectionBase *sec = this->sections[getSectionIndex(eSym)];
+    uint8_t type = eSym.getType();
+    StringRefZ name = this->stringTable.data() + eSym.st_name;
+
+    Symbol *sym = reinterpret_cast<Symbol *>(locals++);
+    if (eSym.st_shndx == SHN_UNDEF)
+      new (sym) Undefined(this, name, STB_LOCAL, eSym.st_other, type);
+    else if (sec == &InputSection::discarded)
+      new (sym) Undefined(this, name, STB_LOCAL, eSym.st_other, type,
+                          /*discardedSecIdx=*/getSectionIndex(eSym));
+    else
+      new (sym) Defined(this, name, STB_LOCAL, eSym.st_other, type,
+                        eSym.st_value, eSym.st_size, sec);
+    this->symbols[i] = sym;
+  }
+}
+
 ArchiveFile::ArchiveFile(std::unique_ptr<Archive> &&file)
     : InputFile(ArchiveKind, file->getMemoryBufferRef()),
       file(std::move(file)) {}
@@ -1261,42 +1311,42 @@ void ArchiveFile::fetch(const Archive::Symbol &sym) {
 //
 //  The following functions search archive members for defintions to replace
 //  tentative defintions (implementing behavior 2).
-static bool isBitcodeNonCommonDef(MemoryBufferRef mb, StringRef symName,
-                                  StringRef archiveName) {
+static StringMap<bool> getBitcodeNonCommonDefs(MemoryBufferRef mb) {
   IRSymtabFile symtabFile = check(readIRSymtab(mb));
+  StringMap<bool> defs;
   for (const irsymtab::Reader::SymbolRef &sym :
-       symtabFile.TheReader.symbols()) {
-    if (sym.isGlobal() && sym.getName() == symName)
-      return !sym.isUndefined() && !sym.isCommon();
-  }
-  return false;
+       symtabFile.TheReader.symbols())
+    if (sym.isGlobal())
+      defs.try_emplace(sym.getName(), !sym.isUndefined() && !sym.isCommon());
+  return defs;
 }
 
 template <class ELFT>
-static bool isNonCommonDef(MemoryBufferRef mb, StringRef symName,
-                           StringRef archiveName) {
+static StringMap<bool> getNonCommonDefs(MemoryBufferRef mb,
+                                        StringRef archiveName) {
   ObjFile<ELFT> *obj = make<ObjFile<ELFT>>(mb, archiveName);
   StringRef stringtable = obj->getStringTable();
 
+  StringMap<bool> defs;
   for (auto sym : obj->template getGlobalELFSyms<ELFT>()) {
     Expected<StringRef> name = sym.getName(stringtable);
-    if (name && name.get() == symName)
-      return sym.isDefined() && !sym.isCommon();
+    if (name)
+      defs.try_emplace(name.get(), sym.isDefined() && !sym.isCommon());
   }
-  return false;
+  return defs;
 }
 
-static bool isNonCommonDef(MemoryBufferRef mb, StringRef symName,
-                           StringRef archiveName) {
+static StringMap<bool> getNonCommonDefs(MemoryBufferRef mb,
+                                        StringRef archiveName) {
   switch (getELFKind(mb, archiveName)) {
   case ELF32LEKind:
-    return isNonCommonDef<ELF32LE>(mb, symName, archiveName);
+    return getNonCommonDefs<ELF32LE>(mb, archiveName);
   case ELF32BEKind:
-    return isNonCommonDef<ELF32BE>(mb, symName, archiveName);
+    return getNonCommonDefs<ELF32BE>(mb, archiveName);
   case ELF64LEKind:
-    return isNonCommonDef<ELF64LE>(mb, symName, archiveName);
+    return getNonCommonDefs<ELF64LE>(mb, archiveName);
   case ELF64BEKind:
-    return isNonCommonDef<ELF64BE>(mb, symName, archiveName);
+    return getNonCommonDefs<ELF64BE>(mb, archiveName);
   default:
     llvm_unreachable("getELFKind");
   }
@@ -1307,16 +1357,24 @@ bool ArchiveFile::shouldFetchForCommon(const Archive::Symbol &sym) {
       CHECK(sym.getMember(), toString(this) +
                                  ": could not get the member for symbol " +
                                  toELFString(sym));
-  MemoryBufferRef mb =
-      CHECK(c.getMemoryBufferRef(),
-            toString(this) +
-                ": could not get the buffer for the member defining symbol " +
-                toELFString(sym));
 
-  if (isBitcode(mb))
-    return isBitcodeNonCommonDef(mb, sym.getName(), getName());
-
-  return isNonCommonDef(mb, sym.getName(), getName());
+  // A member may be queried once per COMMON symbol it could override. Scan
+  // it only on the first query and remember which of its global symbols are
+  // non-common definitions.
+  auto it = nonCommonDefsCache.find(c.getChildOffset());
+  if (it == nonCommonDefsCache.end()) {
+    MemoryBufferRef mb =
+        CHECK(c.getMemoryBufferRef(),
+              toString(this) +
+                  ": could not get the buffer for the member defining symbol " +
+                  toELFString(sym));
+
+    StringMap<bool> defs = isBitcode(mb) ? getBitcodeNonCommonDefs(mb)
+                                         : getNonCommonDefs(mb, getName());
+    it = nonCommonDefsCache.try_emplace(c.getChildOffset(), std::move(defs))
+             .first;
+  }
+  return it->second.lookup(sym.getName());
 }
 
 size_t ArchiveFile::getMemberCount() const {
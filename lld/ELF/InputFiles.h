@@ -14,8 +14,10 @@
 #include "lld/Common/LLVM.h"
 #include "lld/Common/Reproduce.h"
 #include "llvm/ADT/CachedHashString.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/IR/Comdat.h"
 #include "llvm/Object/Archive.h"
 #include "llvm/Object/ELF.h"
@@ -42,6 +44,7 @@ namespace elf {
 using llvm::object::Archive;
 
 class Symbol;
+union SymbolUnion;
 
 // If -reproduce option is given, all input files are written
 // to this tar archive.
@@ -53,6 +56,10 @@ llvm::Optional<MemoryBufferRef> readFile(StringRef path);
 // Add symbols in File to the symbol table.
 void parseFile(InputFile *file);
 
+// Create Symbol objects for local symbols. Safe to call in parallel for
+// different files.
+void initializeLocalSymbols(InputFile *file);
+
 // The root class of input files.
 class InputFile {
 public:
@@ -208,6 +215,10 @@ public:
 
   void parse(bool ignoreComdats = false);
 
+  // Constructs Symbol objects for this file's local symbols. Called after
+  // symbol resolution, in parallel across object files.
+  void initializeLocalSymbols();
+
   StringRef getShtGroupSignature(ArrayRef<Elf_Shdr> sections,
                                  const Elf_Shdr &sec);
 
@@ -267,6 +278,10 @@ private:
 
   bool shouldMerge(const Elf_Shdr &sec, StringRef name);
 
+  // Backing storage for local symbols. make<> is not used because it is not
+  // thread-safe and initializeLocalSymbols() runs in parallel.
+  std::unique_ptr<SymbolUnion[]> localSymStorage;
+
   // Each ELF symbol contains a section index which the symbol belongs to.
   // However, because the number of bits dedicated for that is limited, a
   // symbol can directly point to a section only when the section index is
@@ -347,6 +362,13 @@ public:
 private:
   std::unique_ptr<Archive> file;
   llvm::DenseSet<uint64_t> seen;
+
+  // Results of scanning a member for shouldFetchForCommon(), keyed by the
+  // member's offset in the archive. Maps each global symbol name in the
+  // member to whether it is a non-common definition. A member may be
+  // queried once per COMMON symbol it could override; without the cache
+  // each query parses the member from scratch.
+  llvm::DenseMap<uint64_t, llvm::StringMap<bool>> nonCommonDefsCache;
 };
 
 class BitcodeFile : public InputFile {
@@ -347,9 +347,10 @@ std::string InputSectionBase::getObjMsg(uint64_t off) {
   if (!file->archiveName.empty())
     archive = " in archive " + file->archiveName;
 
-  // Find a symbol that encloses a given location.
+  // Find a symbol that encloses a given location. Local symbols may not
+  // have been created yet if an error is reported during symbol resolution.
   for (Symbol *b : file->getSymbols())
-    if (auto *d = dyn_cast<Defined>(b))
+    if (auto *d = dyn_cast_or_null<Defined>(b))
       if (d->section == this && d->value <= off && off < d->value + d->size)
         return filename + ":(" + toString(*d) + ")" + archive;
 
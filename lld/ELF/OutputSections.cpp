@@ -298,16 +298,46 @@ template <class ELFT> void OutputSection::maybeCompress() {
   // Write section contents to a temporary buffer and compress it.
   std::vector<uint8_t> buf(size);
   writeTo<ELFT>(buf.data());
+
   // We chose 1 as the default compression level because it is the fastest. If
   // -O2 is given, we use level 6 to compress debug info more by ~15%. We found
   // that level 7 to 9 doesn't make much difference (~1% more compression) while
   // they take significant amount of time (~2x), so level 6 seems enough.
-  if (Error e = zlib::compress(toStringRef(buf), compressedData,
-                               config->optimize >= 2 ? 6 : 1))
-    fatal("compress failed: " + llvm::toString(std::move(e)));
+  const int level = config->optimize >= 2 ? 6 : 1;
+
+  // Split the contents into 1 MiB shards and compress them independently on
+  // all available threads. Each shard is a raw deflate stream; concatenated
+  // behind a common zlib header and followed by the combined Adler-32
+  // checksum of the input, they form one ordinary zlib stream, so consumers
+  // see no difference to single-threaded output.
+  constexpr size_t shardSize = 1 << 20;
+  const size_t numShards =
+      std::max<size_t>(1, (size + shardSize - 1) / shardSize);
+  compressed.shards = std::make_unique<SmallVector<char, 0>[]>(numShards);
+  std::vector<StringRef> shardsIn(numShards);
+  std::vector<uint32_t> shardChecksums(numShards);
+  for (size_t i = 0; i != numShards; ++i)
+    shardsIn[i] = toStringRef(makeArrayRef(buf).slice(
+        i * shardSize, std::min<size_t>(shardSize, size - i * shardSize)));
+
+  parallelForEachN(0, numShards, [&](size_t i) {
+    if (Error e = zlib::compressShard(shardsIn[i], compressed.shards[i], level,
+                                      i + 1 == numShards))
+      fatal("compress failed: " + llvm::toString(std::move(e)));
+    shardChecksums[i] = zlib::adler32(shardsIn[i]);
+  });
 
-  // Update section headers.
-  size = sizeof(Elf_Chdr) + compressedData.size();
+  // Update section headers. The zlib header and checksum bytes that frame the
+  // shards are accounted for here and written by writeTo().
+  uint32_t checksum = 1; // Initial Adler-32 value.
+  size = sizeof(Elf_Chdr) + 2 + 4; // Chdr, zlib header (CMF, FLG), Adler-32.
+  for (size_t i = 0; i != numShards; ++i) {
+    size += compressed.shards[i].size();
+    checksum =
+        zlib::adler32Combine(checksum, shardChecksums[i], shardsIn[i].size());
+  }
+  compressed.numShards = numShards;
+  compressed.checksum = checksum;
   flags |= SHF_COMPRESSED;
 }
 
@@ -329,12 +359,25 @@ template <class ELFT> void OutputSection::writeTo(uint8_t *buf) {
     return;
 
   // If -compress-debug-section is specified and if this is a debug section,
-  // we've already compressed section contents. If that's the case,
-  // just write it down.
-  if (!compressedData.empty()) {
+  // we've already compressed section contents. If that's the case, write the
+  // deflate shards framed as a single zlib stream.
+  if (compressed.shards) {
     memcpy(buf, zDebugHeader.data(), zDebugHeader.size());
-    memcpy(buf + zDebugHeader.size(), compressedData.data(),
-           compressedData.size());
+    uint8_t *out = buf + zDebugHeader.size();
+
+    out[0] = 0x78; // CMF: DEFLATE with a 32K window.
+    out[1] = 0x01; // FLG: fastest; (CMF * 256 + FLG) % 31 == 0.
+    size_t pos = 2;
+    std::vector<size_t> shardOffsets(compressed.numShards);
+    for (size_t i = 0; i != compressed.numShards; ++i) {
+      shardOffsets[i] = pos;
+      pos += compressed.shards[i].size();
+    }
+    parallelForEachN(0, compressed.numShards, [&](size_t i) {
+      memcpy(out + shardOffsets[i], compressed.shards[i].data(),
+             compressed.shards[i].size());
+    });
+    write32be(out + pos, compressed.checksum);
     return;
   }
 
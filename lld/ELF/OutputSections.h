@@ -17,6 +17,7 @@
 #include "llvm/MC/StringTableBuilder.h"
 #include "llvm/Object/ELF.h"
 #include <array>
+#include <memory>
 
 namespace lld {
 namespace elf {
@@ -25,6 +26,15 @@ struct PhdrEntry;
 class InputSection;
 class InputSectionBase;
 
+// The compressed payload of a debug section: raw deflate shards produced in
+// parallel by OutputSection::maybeCompress(), reassembled into one ordinary
+// zlib stream by OutputSection::writeTo().
+struct CompressedData {
+  std::unique_ptr<llvm::SmallVector<char, 0>[]> shards;
+  size_t numShards = 0;
+  uint32_t checksum = 0;
+};
+
 // This represents a section in an output file.
 // It is composed of multiple InputSections.
 // The writer creates multiple OutputSections and assign them unique,
@@ -111,7 +121,7 @@ public:
 private:
   // Used for implementation of --compress-debug-sections option.
   std::vector<uint8_t> zDebugHeader;
-  llvm::SmallVector<char, 0> compressedData;
+  CompressedData compressed;
 
   std::array<uint8_t, 4> getFiller();
 };
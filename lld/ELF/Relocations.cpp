@@ -1554,6 +1554,74 @@ template <class ELFT> void elf::scanRelocations(InputSectionBase &s) {
     scanRelocs<ELFT>(s, s.rels<ELFT>());
 }
 
+// Pre-scan a section and, if every relocation in it is a link-time constant
+// against a defined, non-preemptible, non-ifunc, non-TLS symbol, populate
+// sec.relocations directly. Such relocations need none of the stateful
+// handling in scanReloc() (GOT/PLT/TLS slot creation, dynamic relocations,
+// undef diagnostics), so sections consisting only of them can be scanned from
+// multiple threads concurrently. Returns false, leaving the section
+// untouched, as soon as one relocation requires the full serial scan.
+template <class ELFT, class RelTy>
+static bool scanConstantRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels) {
+  std::vector<Relocation> out;
+  out.reserve(rels.size());
+  for (const RelTy &rel : rels) {
+    uint32_t symIndex = rel.getSymbol(config->isMips64EL);
+    // Marker relocations (R_*_NONE, R_ARM_V4BX) use symbol index 0.
+    if (symIndex == 0)
+      return false;
+    Symbol &sym = sec.getFile<ELFT>()->getSymbol(symIndex);
+    if (!sym.isDefined() || sym.isPreemptible || sym.isGnuIFunc() ||
+        sym.isTls())
+      return false;
+
+    RelType type = rel.getType(config->isMips64EL);
+    uint64_t offset = rel.r_offset;
+    RelExpr expr =
+        target->getRelExpr(type, sym, sec.data().begin() + offset);
+    if (expr == R_NONE)
+      return false;
+
+    // scanReloc() would relax a PLT access to the non-preemptible symbol
+    // into a direct access; mirror that, then only accept expressions whose
+    // handling is known to be free of global side effects.
+    if (expr == R_GOT_PC)
+      return false;
+    expr = fromPlt(expr);
+    if (!oneof<R_ABS, R_PC, R_AARCH64_PAGE_PC>(expr))
+      return false;
+
+    if (!isStaticLinkTimeConstant(expr, type, sym, sec, offset))
+      return false;
+    int64_t addend =
+        computeAddend<ELFT>(rel, rels.end(), sec, expr, sym.isLocal());
+    out.push_back({expr, type, offset, addend, &sym});
+  }
+  sec.relocations = std::move(out);
+  return true;
+}
+
+template <class ELFT> bool elf::scanSectionConstantRelocs(InputSectionBase &s) {
+  // Targets with extra per-relocation scan logic (MIPS GOT, PPC TOC and PLT
+  // stub bits, Hexagon GDPLT, RISC-V relocation sorting) always take the
+  // serial path, as do .eh_frame sections, whose offset mapping is stateful.
+  switch (config->emachine) {
+  case EM_MIPS:
+  case EM_PPC:
+  case EM_PPC64:
+  case EM_HEXAGON:
+  case EM_RISCV:
+    return false;
+  default:
+    break;
+  }
+  if (isa<EhInputSection>(s))
+    return false;
+  if (s.areRelocsRela)
+    return scanConstantRelocs<ELFT>(s, s.relas<ELFT>());
+  return scanConstantRelocs<ELFT>(s, s.rels<ELFT>());
+}
+
 static bool mergeCmp(const InputSection *a, const InputSection *b) {
   // std::merge requires a strict weak ordering.
   if (a->outSecOff < b->outSecOff)
@@ -2070,6 +2138,10 @@ template void elf::scanRelocations<ELF32LE>(InputSectionBase &);
 template void elf::scanRelocations<ELF32BE>(InputSectionBase &);
 template void elf::scanRelocations<ELF64LE>(InputSectionBase &);
 template void elf::scanRelocations<ELF64BE>(InputSectionBase &);
+template bool elf::scanSectionConstantRelocs<ELF32LE>(InputSectionBase &);
+template bool elf::scanSectionConstantRelocs<ELF32BE>(InputSectionBase &);
+template bool elf::scanSectionConstantRelocs<ELF64LE>(InputSectionBase &);
+template bool elf::scanSectionConstantRelocs<ELF64BE>(InputSectionBase &);
 template void elf::reportUndefinedSymbols<ELF32LE>();
 template void elf::reportUndefinedSymbols<ELF32BE>();
 template void elf::reportUndefinedSymbols<ELF64LE>();
@@ -124,6 +124,12 @@ struct JumpInstrMod {
 // the diagnostics.
 template <class ELFT> void scanRelocations(InputSectionBase &);
 
+// Thread-safe fast path for scanRelocations(): if every relocation in the
+// section is a link-time constant requiring no global linker state, populate
+// its Relocations vector and return true. Sections for which this returns
+// false must still be handed to scanRelocations() on the main thread.
+template <class ELFT> bool scanSectionConstantRelocs(InputSectionBase &);
+
 template <class ELFT> void reportUndefinedSymbols();
 
 void hexagonTLSSymbolUpdate(ArrayRef<OutputSection *> outputSections);
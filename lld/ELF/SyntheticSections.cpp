@@ -38,6 +38,7 @@
 #include "llvm/Support/MD5.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/xxhash.h"
 #include <cstdlib>
 #include <thread>
 
@@ -54,6 +55,7 @@ using llvm::support::endian::write32le;
 using llvm::support::endian::write64le;
 
 constexpr size_t MergeNoTailSection::numShards;
+constexpr size_t MergeTailSection::numShards;
 
 static uint64_t readUint(uint8_t *buf) {
   return config->is64 ? read64(buf) : read32(buf);
@@ -3197,33 +3199,83 @@ void MergeSyntheticSection::addSection(MergeInputSection *ms) {
   alignment = std::max(alignment, ms->alignment);
 }
 
-MergeTailSection::MergeTailSection(StringRef name, uint32_t type,
-                                   uint64_t flags, uint32_t alignment)
-    : MergeSyntheticSection(name, type, flags, alignment),
-      builder(StringTableBuilder::RAW, alignment) {}
-
-size_t MergeTailSection::getSize() const { return builder.getSize(); }
+void MergeTailSection::writeTo(uint8_t *buf) {
+  for (size_t i = 0; i < numShards; ++i)
+    shards[i].write(buf + shardOffsets[i]);
+}
 
-void MergeTailSection::writeTo(uint8_t *buf) { builder.write(buf); }
+// Returns a shard ID such that all strings that may be tail-merged with each
+// other get the same ID. If S is a suffix of T and both are at least 8 bytes
+// long, then the last 8 bytes of S and T are equal, so hashing only the tail
+// sends them to the same shard, and the in-shard suffix sort can share their
+// storage. Suffix pairs whose shorter string is less than 8 bytes long may
+// end up in different shards and miss a merge, but such a merge saves less
+// than 8 bytes to begin with.
+size_t MergeTailSection::getShardId(StringRef s) {
+  uint32_t hash = xxHash64(s.take_back(8)) & 0x7fffffff;
+  return hash >> (31 - countTrailingZeros(numShards));
+}
 
+// Tail merging is even hotter than plain deduplication because finalize()
+// runs a suffix sort over all unique strings. Sharding by a hash of each
+// string's trailing bytes (see getShardId) lets both the insertion and the
+// suffix sort run in parallel, one shard per task, with the same structure
+// as MergeNoTailSection::finalizeContents.
 void MergeTailSection::finalizeContents() {
-  // Add all string pieces to the string table builder to create section
-  // contents.
-  for (MergeInputSection *sec : sections)
-    for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
-      if (sec->pieces[i].live)
-        builder.add(sec->getData(i));
+  // Initializes string table builders.
+  for (size_t i = 0; i < numShards; ++i)
+    shards.emplace_back(StringTableBuilder::RAW, alignment);
 
-  // Fix the string table content. After this, the contents will never change.
-  builder.finalize();
+  // Concurrency level. Must be a power of 2 to avoid expensive modulo
+  // operations in the following tight loop.
+  size_t concurrency = PowerOf2Floor(
+      std::min<size_t>(hardware_concurrency(parallel::strategy.ThreadsRequested)
+                           .compute_thread_count(),
+                       numShards));
 
-  // finalize() fixed tail-optimized strings, so we can now get
-  // offsets of strings. Get an offset for each string and save it
-  // to a corresponding SectionPiece for easy access.
-  for (MergeInputSection *sec : sections)
-    for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
-      if (sec->pieces[i].live)
-        sec->pieces[i].outputOff = builder.getOffset(sec->getData(i));
+  // Add section pieces to the builders. add() returns no usable offset
+  // before finalize(), so stash each piece's shard ID in outputOff for the
+  // fix-up loop below. Every live piece is visited by exactly one thread.
+  parallelForEachN(0, concurrency, [&](size_t threadId) {
+    for (MergeInputSection *sec : sections) {
+      for (size_t i = 0, e = sec->pieces.size(); i != e; ++i) {
+        if (!sec->pieces[i].live)
+          continue;
+        size_t shardId = getShardId(sec->getData(i).val());
+        if ((shardId & (concurrency - 1)) == threadId) {
+          shards[shardId].add(sec->getData(i));
+          sec->pieces[i].outputOff = shardId;
+        }
+      }
+    }
+  });
+
+  // Fix the string table contents. After this, the contents will never
+  // change. This runs the suffix sort of each shard in parallel.
+  parallelForEachN(0, numShards, [&](size_t i) { shards[i].finalize(); });
+
+  // Compute an in-section offset for each shard.
+  size_t off = 0;
+  for (size_t i = 0; i < numShards; ++i) {
+    if (shards[i].getSize() > 0)
+      off = alignTo(off, alignment);
+    shardOffsets[i] = off;
+    off += shards[i].getSize();
+  }
+  size = off;
+
+  // finalize() fixed tail-optimized strings, so we can now get offsets of
+  // strings. Get an offset for each string and save it to a corresponding
+  // SectionPiece for easy access.
+  parallelForEach(sections, [&](MergeInputSection *sec) {
+    for (size_t i = 0, e = sec->pieces.size(); i != e; ++i) {
+      if (!sec->pieces[i].live)
+        continue;
+      size_t shardId = sec->pieces[i].outputOff;
+      sec->pieces[i].outputOff =
+          shardOffsets[shardId] + shards[shardId].getOffset(sec->getData(i));
+    }
+  });
 }
 
 void MergeNoTailSection::writeTo(uint8_t *buf) {
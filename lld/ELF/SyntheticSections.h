@@ -895,14 +895,29 @@ protected:
 class MergeTailSection final : public MergeSyntheticSection {
 public:
   MergeTailSection(StringRef name, uint32_t type, uint64_t flags,
-                   uint32_t alignment);
+                   uint32_t alignment)
+      : MergeSyntheticSection(name, type, flags, alignment) {}
 
-  size_t getSize() const override;
+  size_t getSize() const override { return size; }
   void writeTo(uint8_t *buf) override;
   void finalizeContents() override;
 
 private:
-  llvm::StringTableBuilder builder;
+  // Unlike MergeNoTailSection, we cannot shard by the whole-string hash
+  // because a string and its proper suffixes hash differently but must end
+  // up in the same string table builder to be tail-merged. Instead we shard
+  // by a hash of each string's trailing bytes, which keeps all strings that
+  // can share storage together. See the comment on getShardId in
+  // SyntheticSections.cpp.
+  size_t getShardId(StringRef s);
+
+  // Section size
+  size_t size;
+
+  // String table contents
+  constexpr static size_t numShards = 32;
+  std::vector<llvm::StringTableBuilder> shards;
+  size_t shardOffsets[numShards];
 };
 
 class MergeNoTailSection final : public MergeSyntheticSection {
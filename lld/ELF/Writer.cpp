@@ -1978,7 +1978,18 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
     // a linker-script-defined symbol is absolute.
     ppc64noTocRelax.clear();
     if (!config->relocatable) {
-      forEachRelSec(scanRelocations<ELFT>);
+      // Sections whose relocations are all link-time constants can be
+      // scanned concurrently; everything else (GOT/PLT/TLS/dynamic
+      // relocations, diagnostics) goes through the serial scan below.
+      std::vector<InputSectionBase *> relSecs;
+      forEachRelSec([&](InputSectionBase &sec) { relSecs.push_back(&sec); });
+      std::vector<uint8_t> scanned(relSecs.size());
+      parallelForEachN(0, relSecs.size(), [&](size_t i) {
+        scanned[i] = scanSectionConstantRelocs<ELFT>(*relSecs[i]);
+      });
+      for (size_t i = 0, e = relSecs.size(); i != e; ++i)
+        if (!scanned[i])
+          scanRelocations<ELFT>(*relSecs[i]);
       reportUndefinedSymbols<ELFT>();
     }
   }
@@ -12,8 +12,13 @@
 #include "lld/Common/LLVM.h"
 #include <system_error>
 
+namespace llvm {
+struct CachePruningPolicy;
+} // namespace llvm
+
 namespace lld {
 void unlinkAsync(StringRef path);
+void pruneCacheAsync(StringRef path, const llvm::CachePruningPolicy &policy);
 std::error_code tryCreateFile(StringRef path);
 } // namespace lld
 
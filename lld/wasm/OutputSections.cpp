@@ -112,9 +112,13 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
-    chunk->writeTo(buf);
+  // Write code section bodies. Each function writes only into its own
+  // [outputOffset, outputOffset + size) slice of the buffer, and relocation
+  // values are pure functions of the final symbol assignments, so the bodies
+  // (including LEB re-encoding under --compress-relocations) can be emitted
+  // in parallel.
+  parallelForEach(functions,
+                  [=](const InputChunk *chunk) { chunk->writeTo(buf); });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -198,9 +202,11 @@ void DataSection::writeTo(uint8_t *buf) {
   // Write data section headers
   memcpy(buf, dataSectionHeader.data(), dataSectionHeader.size());
 
-  for (const OutputSegment *segment : segments) {
+  // Segments occupy disjoint ranges of the buffer, so they can be written
+  // in parallel.
+  parallelForEach(segments, [=](const OutputSegment *segment) {
     if (segment->isBss)
-      continue;
+      return;
     // Write data segment header
     uint8_t *segStart = buf + segment->sectionOffset;
     memcpy(segStart, segment->header.data(), segment->header.size());
@@ -208,7 +214,7 @@ void DataSection::writeTo(uint8_t *buf) {
     // Write segment data payload
     for (const InputChunk *chunk : segment->inputSegments)
       chunk->writeTo(buf);
-  }
+  });
 }
 
 uint32_t DataSection::getNumRelocations() const {
@@ -260,9 +266,10 @@ void CustomSection::writeTo(uint8_t *buf) {
   memcpy(buf, nameData.data(), nameData.size());
   buf += nameData.size();
 
-  // Write custom sections payload
-  for (const InputSection *section : inputSections)
-    section->writeTo(buf);
+  // Write custom sections payload. As in the code section, each chunk only
+  // touches its own slice of the buffer.
+  parallelForEach(inputSections,
+                  [=](const InputSection *section) { section->writeTo(buf); });
 }
 
 uint32_t CustomSection::getNumRelocations() const {
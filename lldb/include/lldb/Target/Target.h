@@ -12,6 +12,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -213,6 +214,8 @@ public:
 
   void SetInjectLocalVariables(ExecutionContext *exe_ctx, bool b);
 
+  bool GetCacheUserExpressions(ExecutionContext *exe_ctx) const;
+
   void SetRequireHardwareBreakpoints(bool b);
 
   bool GetRequireHardwareBreakpoints() const;
@@ -1061,6 +1064,17 @@ public:
                                const EvaluateExpressionOptions &options,
                                ValueObject *ctx_obj, Status &error);
 
+  // Returns the most recently parsed user expression if it was built from an
+  // expression whose hash matches \a hash, an empty shared pointer otherwise.
+  // The caller is responsible for checking that the expression still matches
+  // the current execution context before re-executing it.
+  lldb::UserExpressionSP GetCachedUserExpression(size_t hash);
+
+  // Remembers a successfully parsed user expression so an evaluation of the
+  // same expression at the same stop location can reuse it.
+  void SetCachedUserExpression(size_t hash,
+                               lldb::UserExpressionSP user_expression_sp);
+
   // Creates a FunctionCaller for the given language, the rest of the
   // parameters have the same meaning as for the FunctionCaller constructor.
   // Since a FunctionCaller can't be
@@ -1404,6 +1418,13 @@ protected:
   typedef std::map<lldb::LanguageType, lldb::REPLSP> REPLMap;
   REPLMap m_repl_map;
 
+  /// The most recently parsed user expression and the hash of the expression
+  /// text it was built from, kept so repeated evaluations of the same
+  /// expression at the same stop location can skip the parse and JIT.
+  std::mutex m_cached_expression_mutex;
+  size_t m_cached_expression_hash = 0;
+  lldb::UserExpressionSP m_cached_expression_sp;
+
   std::unique_ptr<ClangModulesDeclVendor> m_clang_modules_decl_vendor_up;
 
   lldb::SourceManagerUP m_source_manager_up;
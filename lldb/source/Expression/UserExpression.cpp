@@ -44,6 +44,8 @@
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
 
+#include "llvm/ADT/Hashing.h"
+
 using namespace lldb_private;
 
 char UserExpression::ID;
@@ -219,22 +221,49 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, ctx_obj,
-                                           error));
-  if (error.Fail()) {
-    LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
-             error.AsCString());
-    return lldb::eExpressionSetupError;
-  }
-
-  LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
-           expr.str());
-
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
 
+  // A compiled expression bakes in the declarations that were visible at the
+  // parse location, so the cached expression may only be reused when
+  // MatchesContext confirms we are stopped at the same code address in the
+  // same process -- the same criterion breakpoint locations use to reuse
+  // their condition expression. Top-level expressions mutate persistent state
+  // when parsed and expressions evaluated in the context of an object bake in
+  // that object's address, so neither is cached.
+  const bool can_cache_expression =
+      target->GetCacheUserExpressions(&exe_ctx) && !ctx_obj &&
+      !generate_debug_info && execution_policy != eExecutionPolicyTopLevel;
+  size_t expr_hash = 0;
+  lldb::UserExpressionSP user_expression_sp;
+  if (can_cache_expression) {
+    expr_hash = llvm::hash_combine(llvm::hash_value(expr),
+                                   llvm::hash_value(full_prefix),
+                                   static_cast<unsigned>(language),
+                                   static_cast<unsigned>(desired_type));
+    user_expression_sp = target->GetCachedUserExpression(expr_hash);
+    if (user_expression_sp && !user_expression_sp->MatchesContext(exe_ctx))
+      user_expression_sp.reset();
+  }
+  const bool reused_expression = (bool)user_expression_sp;
+
+  if (reused_expression) {
+    LLDB_LOG(log,
+             "== [UserExpression::Evaluate] Reusing compiled expression {0} ==",
+             expr.str());
+  } else {
+    user_expression_sp.reset(target->GetUserExpressionForLanguage(
+        expr, full_prefix, language, desired_type, options, ctx_obj, error));
+    if (error.Fail()) {
+      LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
+               error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
+
+    LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
+             expr.str());
+  }
+
   if (options.InvokeCancelCallback(lldb::eExpressionEvaluationParse)) {
     error.SetErrorString("expression interrupted by callback before parse");
     result_valobj_sp = ValueObjectConstResult::Create(
@@ -245,6 +274,7 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
   DiagnosticManager diagnostic_manager;
 
   bool parse_success =
+      reused_expression ||
       user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
                                 keep_expression_in_memory, generate_debug_info);
 
@@ -313,6 +343,9 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
     }
   }
 
+  if (parse_success && can_cache_expression && !reused_expression)
+    target->SetCachedUserExpression(expr_hash, user_expression_sp);
+
   if (parse_success) {
     lldb::ExpressionVariableSP expr_result;
 
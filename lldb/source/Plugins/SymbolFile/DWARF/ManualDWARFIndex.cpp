@@ -13,14 +13,25 @@
 #include "Plugins/SymbolFile/DWARF/LogChannelDWARF.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARFDwo.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Stream.h"
+#include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/Timer.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace lldb_private;
 using namespace lldb;
 
+/// Magic bytes and version of the on-disk index cache format. The version
+/// must be bumped whenever the encoding of the cached index changes.
+static constexpr llvm::StringLiteral g_index_cache_magic("DIDX");
+static constexpr uint32_t g_index_cache_version = 1;
+
 void ManualDWARFIndex::Index() {
   if (!m_dwarf)
     return;
@@ -57,6 +68,12 @@ void ManualDWARFIndex::Index() {
   if (units_to_index.empty())
     return;
 
+  // Try the on-disk index cache before doing any real work. The cache covers
+  // all units of the module, so it cannot be used when some units are
+  // excluded from manual indexing.
+  if (m_units_to_avoid.empty() && LoadFromCache(units_to_index.size()))
+    return;
+
   std::vector<IndexSet> sets(units_to_index.size());
 
   // Keep memory down by clearing DIEs for any units if indexing
@@ -109,6 +126,153 @@ void ManualDWARFIndex::Index() {
   pool.async(finalize_fn, &IndexSet::types);
   pool.async(finalize_fn, &IndexSet::namespaces);
   pool.wait();
+
+  if (m_units_to_avoid.empty())
+    SaveToCache(units_to_index.size());
+}
+
+static void EncodeNameToDIE(const NameToDIE &map, Stream &strm) {
+  strm.PutHex32(map.GetSize());
+  map.ForEach([&strm](ConstString name, const DIERef &die_ref) {
+    strm.PutCString(name.GetStringRef());
+    strm.PutHex8(0); // Terminate the name string.
+    llvm::Optional<uint32_t> dwo_num = die_ref.dwo_num();
+    strm.PutHex8(dwo_num ? 1 : 0);
+    strm.PutHex32(dwo_num.getValueOr(0));
+    strm.PutHex8(die_ref.section());
+    strm.PutHex32(die_ref.die_offset());
+    return true;
+  });
+}
+
+static bool DecodeNameToDIE(const DataExtractor &data, lldb::offset_t &offset,
+                            NameToDIE &map) {
+  const uint32_t count = data.GetU32(&offset);
+  for (uint32_t i = 0; i < count; ++i) {
+    const char *name = data.GetCStr(&offset);
+    if (!name)
+      return false;
+    const bool has_dwo = data.GetU8(&offset) != 0;
+    const uint32_t dwo_num = data.GetU32(&offset);
+    const uint8_t section = data.GetU8(&offset);
+    const dw_offset_t die_offset = data.GetU32(&offset);
+    if (section > DIERef::DebugTypes)
+      return false;
+    map.Insert(ConstString(name),
+               DIERef(has_dwo ? llvm::Optional<uint32_t>(dwo_num) : llvm::None,
+                      static_cast<DIERef::Section>(section), die_offset));
+  }
+  map.Finalize();
+  return true;
+}
+
+llvm::Optional<FileSpec> ManualDWARFIndex::GetCacheFile() const {
+  if (!SymbolFileDWARF::GetEnableIndexCache())
+    return llvm::None;
+  UUID uuid = m_module.GetUUID();
+  if (!uuid.IsValid())
+    return llvm::None;
+  llvm::SmallString<128> path(SymbolFileDWARF::GetIndexCachePath());
+  if (path.empty()) {
+    if (!llvm::sys::path::cache_directory(path))
+      return llvm::None;
+    llvm::sys::path::append(path, "lldb-index-cache");
+  }
+  llvm::sys::path::append(path, uuid.GetAsString() + ".dwarf-index");
+  return FileSpec(path);
+}
+
+bool ManualDWARFIndex::LoadFromCache(size_t num_units) {
+  llvm::Optional<FileSpec> cache_file = GetCacheFile();
+  if (!cache_file)
+    return false;
+
+  auto data_sp = FileSystem::Instance().CreateDataBuffer(*cache_file);
+  if (!data_sp || data_sp->GetByteSize() == 0)
+    return false;
+
+  const DataExtractor data(data_sp, eByteOrderLittle, 4);
+  lldb::offset_t offset = 0;
+  const char *magic = reinterpret_cast<const char *>(
+      data.GetData(&offset, g_index_cache_magic.size()));
+  if (!magic ||
+      g_index_cache_magic != llvm::StringRef(magic, g_index_cache_magic.size()))
+    return false;
+  if (data.GetU32(&offset) != g_index_cache_version)
+    return false;
+
+  // The file is keyed on the UUID already, but verify it in case of hash
+  // collisions in the file name or a modified cache directory.
+  llvm::ArrayRef<uint8_t> uuid_bytes = m_module.GetUUID().GetBytes();
+  if (data.GetU32(&offset) != uuid_bytes.size())
+    return false;
+  const uint8_t *cached_uuid =
+      reinterpret_cast<const uint8_t *>(data.GetData(&offset, uuid_bytes.size()));
+  if (!cached_uuid ||
+      !std::equal(uuid_bytes.begin(), uuid_bytes.end(), cached_uuid))
+    return false;
+
+  // Guard against a stale cache when the set of units changed without
+  // changing the UUID, e.g. when a .dwp file was regenerated.
+  if (data.GetU32(&offset) != num_units)
+    return false;
+
+  bool ok = DecodeNameToDIE(data, offset, m_set.function_basenames) &&
+            DecodeNameToDIE(data, offset, m_set.function_fullnames) &&
+            DecodeNameToDIE(data, offset, m_set.function_methods) &&
+            DecodeNameToDIE(data, offset, m_set.function_selectors) &&
+            DecodeNameToDIE(data, offset, m_set.objc_class_selectors) &&
+            DecodeNameToDIE(data, offset, m_set.globals) &&
+            DecodeNameToDIE(data, offset, m_set.types) &&
+            DecodeNameToDIE(data, offset, m_set.namespaces) &&
+            offset == data.GetByteSize();
+  if (!ok) {
+    // The cache was truncated or corrupted; fall back to indexing.
+    m_set = IndexSet();
+    return false;
+  }
+
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_LOOKUPS);
+  if (log)
+    m_module.LogMessage(log, "ManualDWARFIndex loaded from cache file '%s'",
+                        cache_file->GetPath().c_str());
+  return true;
+}
+
+void ManualDWARFIndex::SaveToCache(size_t num_units) const {
+  llvm::Optional<FileSpec> cache_file = GetCacheFile();
+  if (!cache_file)
+    return;
+
+  StreamString strm(Stream::eBinary, 4, eByteOrderLittle);
+  strm.PutRawBytes(g_index_cache_magic.data(), g_index_cache_magic.size());
+  strm.PutHex32(g_index_cache_version);
+  llvm::ArrayRef<uint8_t> uuid_bytes = m_module.GetUUID().GetBytes();
+  strm.PutHex32(uuid_bytes.size());
+  strm.PutRawBytes(uuid_bytes.data(), uuid_bytes.size());
+  strm.PutHex32(num_units);
+  EncodeNameToDIE(m_set.function_basenames, strm);
+  EncodeNameToDIE(m_set.function_fullnames, strm);
+  EncodeNameToDIE(m_set.function_methods, strm);
+  EncodeNameToDIE(m_set.function_selectors, strm);
+  EncodeNameToDIE(m_set.objc_class_selectors, strm);
+  EncodeNameToDIE(m_set.globals, strm);
+  EncodeNameToDIE(m_set.types, strm);
+  EncodeNameToDIE(m_set.namespaces, strm);
+
+  const std::string path = cache_file->GetPath();
+  if (llvm::sys::fs::create_directories(llvm::sys::path::parent_path(path)))
+    return;
+  std::error_code ec;
+  llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::OF_None);
+  if (ec)
+    return;
+  os << strm.GetString();
+
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_LOOKUPS);
+  if (log)
+    m_module.LogMessage(log, "ManualDWARFIndex saved to cache file '%s'",
+                        path.c_str());
 }
 
 void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, SymbolFileDWARFDwo *dwp,
@@ -11,7 +11,9 @@
 
 #include "Plugins/SymbolFile/DWARF/DWARFIndex.h"
 #include "Plugins/SymbolFile/DWARF/NameToDIE.h"
+#include "lldb/Utility/FileSpec.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/Optional.h"
 
 class DWARFDebugInfo;
 class SymbolFileDWARFDwo;
@@ -69,6 +71,15 @@ private:
   void Index();
   void IndexUnit(DWARFUnit &unit, SymbolFileDWARFDwo *dwp, IndexSet &set);
 
+  /// Returns the file the index of this module is cached in, if index caching
+  /// is enabled and the module has a UUID to key the cache on.
+  llvm::Optional<FileSpec> GetCacheFile() const;
+  /// Try to populate m_set from the on-disk index cache. Returns true if a
+  /// cache entry for this module covering \a num_units units was found.
+  bool LoadFromCache(size_t num_units);
+  /// Store m_set in the on-disk index cache.
+  void SaveToCache(size_t num_units) const;
+
   static void IndexUnitImpl(DWARFUnit &unit,
                             const lldb::LanguageType cu_language,
                             IndexSet &set);
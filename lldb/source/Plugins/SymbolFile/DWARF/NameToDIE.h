@@ -28,6 +28,8 @@ public:
 
   void Insert(lldb_private::ConstString name, const DIERef &die_ref);
 
+  size_t GetSize() const { return m_map.GetSize(); }
+
   void Append(const NameToDIE &other);
 
   void Finalize();
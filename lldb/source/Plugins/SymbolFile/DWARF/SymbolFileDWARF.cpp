@@ -140,6 +140,16 @@ public:
     return m_collection_sp->GetPropertyAtIndexAsBoolean(
         nullptr, ePropertyIgnoreIndexes, false);
   }
+
+  bool EnableIndexCache() const {
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertyEnableIndexCache, false);
+  }
+
+  llvm::StringRef IndexCachePath() const {
+    return m_collection_sp->GetPropertyAtIndexAsString(
+        nullptr, ePropertyIndexCachePath, "");
+  }
 };
 
 typedef std::shared_ptr<PluginProperties> SymbolFileDWARFPropertiesSP;
@@ -151,6 +161,14 @@ static const SymbolFileDWARFPropertiesSP &GetGlobalPluginProperties() {
 
 } // namespace
 
+bool SymbolFileDWARF::GetEnableIndexCache() {
+  return GetGlobalPluginProperties()->EnableIndexCache();
+}
+
+std::string SymbolFileDWARF::GetIndexCachePath() {
+  return GetGlobalPluginProperties()->IndexCachePath().str();
+}
+
 static const llvm::DWARFDebugLine::LineTable *
 ParseLLVMLineTable(lldb_private::DWARFContext &context,
                    llvm::DWARFDebugLine &line, dw_offset_t line_offset,
@@ -90,6 +90,11 @@ public:
   static lldb_private::SymbolFile *
   CreateInstance(lldb::ObjectFileSP objfile_sp);
 
+  /// Global plugin settings controlling the on-disk cache of manually built
+  /// DWARF indexes.
+  static bool GetEnableIndexCache();
+  static std::string GetIndexCachePath();
+
   // Constructors and Destructors
 
   SymbolFileDWARF(lldb::ObjectFileSP objfile_sp,
@@ -13,6 +13,7 @@
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/Utility/State.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <memory>
 
@@ -224,22 +225,44 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
 
       if (bytes_left > 0) {
         assert((curr_addr % cache_line_byte_size) == 0);
-        std::unique_ptr<DataBufferHeap> data_buffer_heap_up(
-            new DataBufferHeap(cache_line_byte_size, 0));
+        // Count how many consecutive cache lines the rest of this read misses
+        // so they can be filled with a single read from the process. For
+        // connections with a high round trip time (e.g. remote debugging over
+        // gdb-remote) one larger read is much cheaper than one read per line.
+        const addr_t last_byte_addr = curr_addr + cache_offset + bytes_left - 1;
+        const addr_t last_line_addr =
+            last_byte_addr - (last_byte_addr % cache_line_byte_size);
+        uint32_t num_lines = 1;
+        for (addr_t line_addr = curr_addr + cache_line_byte_size;
+             line_addr <= last_line_addr &&
+             m_L2_cache.find(line_addr) == m_L2_cache.end() &&
+             !m_invalid_ranges.FindEntryThatContains(line_addr);
+             line_addr += cache_line_byte_size)
+          ++num_lines;
+
+        DataBufferHeap data_buffer(num_lines * cache_line_byte_size, 0);
         size_t process_bytes_read = m_process.ReadMemoryFromInferior(
-            curr_addr, data_buffer_heap_up->GetBytes(),
-            data_buffer_heap_up->GetByteSize(), error);
+            curr_addr, data_buffer.GetBytes(), data_buffer.GetByteSize(),
+            error);
         if (process_bytes_read == 0)
           return dst_len - bytes_left;
 
-        if (process_bytes_read != cache_line_byte_size) {
-          if (process_bytes_read < data_buffer_heap_up->GetByteSize()) {
-            dst_len -= data_buffer_heap_up->GetByteSize() - process_bytes_read;
-            bytes_left = process_bytes_read;
-          }
-          data_buffer_heap_up->SetByteSize(process_bytes_read);
+        // Split what we read into cache line sized chunks. A partial read
+        // produces a short trailing cache line, which caps off the amount the
+        // loop below will serve, just like a short single line read did.
+        addr_t line_addr = curr_addr;
+        const uint8_t *line_bytes = data_buffer.GetBytes();
+        size_t bytes_to_cache = process_bytes_read;
+        while (bytes_to_cache > 0) {
+          const size_t line_size =
+              std::min<size_t>(bytes_to_cache, cache_line_byte_size);
+          std::unique_ptr<DataBufferHeap> line_buffer_up(
+              new DataBufferHeap(line_bytes, line_size));
+          m_L2_cache[line_addr] = DataBufferSP(line_buffer_up.release());
+          line_addr += line_size;
+          line_bytes += line_size;
+          bytes_to_cache -= line_size;
         }
-        m_L2_cache[curr_addr] = DataBufferSP(data_buffer_heap_up.release());
         // We have read data and put it into the cache, continue through the
         // loop again to get the data out of the cache...
       }
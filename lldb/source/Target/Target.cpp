@@ -184,6 +184,9 @@ void Target::CleanupProcess() {
 }
 
 void Target::DeleteCurrentProcess() {
+  // The cached user expression may be JIT'ed into the current process, so it
+  // must not outlive it.
+  SetCachedUserExpression(0, lldb::UserExpressionSP());
   if (m_process_sp) {
     m_section_load_history.Clear();
     if (m_process_sp->IsAlive())
@@ -2273,6 +2276,20 @@ UserExpression *Target::GetUserExpressionForLanguage(
   return user_expr;
 }
 
+lldb::UserExpressionSP Target::GetCachedUserExpression(size_t hash) {
+  std::lock_guard<std::mutex> guard(m_cached_expression_mutex);
+  if (hash != m_cached_expression_hash)
+    return lldb::UserExpressionSP();
+  return m_cached_expression_sp;
+}
+
+void Target::SetCachedUserExpression(size_t hash,
+                                     lldb::UserExpressionSP user_expression_sp) {
+  std::lock_guard<std::mutex> guard(m_cached_expression_mutex);
+  m_cached_expression_hash = hash;
+  m_cached_expression_sp = std::move(user_expression_sp);
+}
+
 FunctionCaller *Target::GetFunctionCallerForLanguage(
     lldb::LanguageType language, const CompilerType &return_type,
     const Address &function_address, const ValueList &arg_value_list,
@@ -3745,6 +3762,19 @@ void TargetProperties::SetInjectLocalVariables(ExecutionContext *exe_ctx,
                                             true);
 }
 
+bool TargetProperties::GetCacheUserExpressions(
+    ExecutionContext *exe_ctx) const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      exe_ctx, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsBoolean(
+        exe_ctx, ePropertyCacheUserExpressions, false);
+  else
+    return false;
+}
+
 ArchSpec TargetProperties::GetDefaultArchitecture() const {
   OptionValueArch *value = m_collection_sp->GetPropertyAtIndexAsOptionValueArch(
       nullptr, ePropertyDefaultArch);
@@ -0,0 +1,52 @@
+"""
+Test that the experimental user-expression cache reuses compiled expressions
+without changing evaluation results.
+"""
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ExpressionCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def evaluate(self, frame, expression):
+        result = frame.EvaluateExpression(expression)
+        self.assertTrue(result.GetError().Success(),
+                        "'%s' evaluated: %s" %
+                        (expression, result.GetError().GetCString()))
+        return result.GetValueAsSigned()
+
+    def test_cached_expression_reuse(self):
+        """Evaluate the same expressions repeatedly with caching enabled."""
+        self.build()
+        (target, process, thread, bkpt) = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.c"))
+
+        self.runCmd(
+            "settings set target.experimental.cache-user-expressions true")
+
+        frame = thread.GetFrameAtIndex(0)
+        count = frame.FindVariable("count").GetValueAsSigned()
+
+        # The second evaluation reuses the compiled expression; both must see
+        # the current value of the global.
+        for _ in range(2):
+            self.assertEqual(self.evaluate(frame, "count + 1"), count + 1)
+
+        # A reused expression must be re-executed, not replayed: each
+        # evaluation of ++count changes the program state.
+        for expected in (count + 1, count + 2):
+            self.assertEqual(self.evaluate(frame, "++count"), expected)
+
+        # The cached expression is reused across hits of the same breakpoint
+        # and must see the updated value of the global.
+        lldbutil.continue_to_breakpoint(process, bkpt)
+        frame = thread.GetFrameAtIndex(0)
+        count = frame.FindVariable("count").GetValueAsSigned()
+        self.assertEqual(self.evaluate(frame, "count + 1"), count + 1)
@@ -0,0 +1,11 @@
+#include <stdio.h>
+
+int count = 0;
+
+int main() {
+  for (int i = 0; i < 3; ++i) {
+    count += 10;
+    printf("count: %d\n", count); // break here
+  }
+  return 0;
+}
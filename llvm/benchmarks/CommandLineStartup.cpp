@@ -0,0 +1,79 @@
+//===- CommandLineStartup.cpp - cl::opt registration benchmarks -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Benchmarks for the startup cost a tool pays for the command line options
+// linked into it. Tools that are invoked many times per build, like llvm-nm,
+// construct and register every cl::opt in every linked library before main()
+// runs, whether or not the invocation ever parses them.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+std::vector<std::string> makeOptionNames(unsigned NumOptions) {
+  std::vector<std::string> Names;
+  Names.reserve(NumOptions);
+  for (unsigned I = 0; I != NumOptions; ++I)
+    Names.push_back("benchmark-opt-" + std::to_string(I));
+  return Names;
+}
+
+// Measures registration and teardown of options, i.e. the part of tool
+// startup that happens whether or not the command line is ever parsed.
+void BM_OptionRegistration(benchmark::State &State) {
+  const unsigned NumOptions = State.range(0);
+  std::vector<std::string> Names = makeOptionNames(NumOptions);
+
+  for (auto _ : State) {
+    std::vector<std::unique_ptr<cl::opt<bool>>> Options;
+    Options.reserve(NumOptions);
+    for (unsigned I = 0; I != NumOptions; ++I)
+      Options.emplace_back(
+          std::make_unique<cl::opt<bool>>(StringRef(Names[I]), cl::Hidden));
+    for (auto &O : Options)
+      O->removeArgument();
+  }
+}
+BENCHMARK(BM_OptionRegistration)->Arg(100)->Arg(1000);
+
+// Measures registration plus the first parse, which is where deferred
+// registration work is allowed to be paid for.
+void BM_OptionRegistrationAndParse(benchmark::State &State) {
+  const unsigned NumOptions = State.range(0);
+  std::vector<std::string> Names = makeOptionNames(NumOptions);
+
+  for (auto _ : State) {
+    std::vector<std::unique_ptr<cl::opt<bool>>> Options;
+    Options.reserve(NumOptions);
+    for (unsigned I = 0; I != NumOptions; ++I)
+      Options.emplace_back(
+          std::make_unique<cl::opt<bool>>(StringRef(Names[I]), cl::Hidden));
+
+    const char *Argv[] = {"bench", "-benchmark-opt-0"};
+    cl::ParseCommandLineOptions(2, Argv, "", &nulls());
+    cl::ResetAllOptionOccurrences();
+
+    for (auto &O : Options)
+      O->removeArgument();
+  }
+}
+BENCHMARK(BM_OptionRegistrationAndParse)->Arg(100)->Arg(1000);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,135 @@
+//===- llvm/ADT/ConcurrentDenseMap.h - Sharded dense map --------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the ConcurrentDenseMap class, a lock-striped wrapper
+// around DenseMap for read-mostly maps shared between threads.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_CONCURRENTDENSEMAP_H
+#define LLVM_ADT_CONCURRENTDENSEMAP_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/ADT/Optional.h"
+#include <mutex>
+#include <utility>
+
+namespace llvm {
+
+/// A DenseMap sharded over independently locked stripes, so that operations
+/// on keys hashing to different stripes proceed in parallel.
+///
+/// This is intended for read-mostly maps shared between threads, where a
+/// single mutex around one DenseMap serializes every access. The usual
+/// DenseMapInfo customization points apply; the stripe for a key is derived
+/// from DenseMapInfo<KeyT>::getHashValue.
+///
+/// The interface is deliberately narrow: there are no iterators and no
+/// reference-returning lookups, since a reference handed out would escape
+/// its stripe's critical section. Values are returned by copy and should be
+/// cheap to copy. Each call is atomic on its own; compound operations over
+/// several keys are not.
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>, unsigned NumStripesLog2 = 5>
+class ConcurrentDenseMap {
+  static_assert(NumStripesLog2 < 16, "unreasonable stripe count");
+  static constexpr size_t NumStripes = size_t(1) << NumStripesLog2;
+
+  struct Stripe {
+    mutable std::mutex M;
+    DenseMap<KeyT, ValueT, KeyInfoT> Map;
+  };
+
+  Stripe Stripes[NumStripes];
+
+  Stripe &getStripe(const KeyT &Key) {
+    return Stripes[KeyInfoT::getHashValue(Key) & (NumStripes - 1)];
+  }
+
+  const Stripe &getStripe(const KeyT &Key) const {
+    return Stripes[KeyInfoT::getHashValue(Key) & (NumStripes - 1)];
+  }
+
+public:
+  ConcurrentDenseMap() = default;
+  ConcurrentDenseMap(const ConcurrentDenseMap &) = delete;
+  ConcurrentDenseMap &operator=(const ConcurrentDenseMap &) = delete;
+
+  /// Return a copy of the value for \p Key, or None if no entry exists.
+  Optional<ValueT> lookup(const KeyT &Key) const {
+    const Stripe &S = getStripe(Key);
+    std::lock_guard<std::mutex> Lock(S.M);
+    auto It = S.Map.find(Key);
+    if (It == S.Map.end())
+      return None;
+    return It->second;
+  }
+
+  /// Return true if an entry for \p Key exists.
+  bool contains(const KeyT &Key) const {
+    const Stripe &S = getStripe(Key);
+    std::lock_guard<std::mutex> Lock(S.M);
+    return S.Map.count(Key);
+  }
+
+  /// Map \p Key to \p Val if no entry for \p Key exists yet. Returns true if
+  /// the value was inserted.
+  bool try_emplace(const KeyT &Key, ValueT Val) {
+    Stripe &S = getStripe(Key);
+    std::lock_guard<std::mutex> Lock(S.M);
+    return S.Map.try_emplace(Key, std::move(Val)).second;
+  }
+
+  /// Map \p Key to \p Val, overwriting any existing entry.
+  void set(const KeyT &Key, ValueT Val) {
+    Stripe &S = getStripe(Key);
+    std::lock_guard<std::mutex> Lock(S.M);
+    S.Map[Key] = std::move(Val);
+  }
+
+  /// Remove the entry for \p Key, if any. Returns true if an entry was
+  /// removed.
+  bool erase(const KeyT &Key) {
+    Stripe &S = getStripe(Key);
+    std::lock_guard<std::mutex> Lock(S.M);
+    return S.Map.erase(Key);
+  }
+
+  /// Return the number of entries. The result is exact only if no
+  /// modifications are in flight concurrently.
+  size_t size() const {
+    size_t N = 0;
+    for (const Stripe &S : Stripes) {
+      std::lock_guard<std::mutex> Lock(S.M);
+      N += S.Map.size();
+    }
+    return N;
+  }
+
+  void clear() {
+    for (Stripe &S : Stripes) {
+      std::lock_guard<std::mutex> Lock(S.M);
+      S.Map.clear();
+    }
+  }
+
+  /// Invoke \p F on a copy of every (key, value) pair. Each stripe is locked
+  /// while its entries are visited, so \p F must not reenter the map.
+  template <typename CallableT> void forEach(CallableT F) const {
+    for (const Stripe &S : Stripes) {
+      std::lock_guard<std::mutex> Lock(S.M);
+      for (const auto &KV : S.Map)
+        F(KV.first, KV.second);
+    }
+  }
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_CONCURRENTDENSEMAP_H
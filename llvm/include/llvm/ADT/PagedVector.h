@@ -0,0 +1,97 @@
+//===- llvm/ADT/PagedVector.h - 'Lazily allocated' vectors -----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the PagedVector class.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_PAGEDVECTOR_H
+#define LLVM_ADT_PAGEDVECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace llvm {
+
+/// A vector that allocates memory in pages and only materializes a page the
+/// first time one of its elements is accessed. Elements of unmaterialized
+/// pages are notionally value-initialized (null pointers, zero, etc.).
+///
+/// This is useful for large index spaces that are known to be touched only
+/// sparsely, such as the global type and declaration tables the AST reader
+/// maintains over all loaded modules: a plain std::vector pays for every slot
+/// up front even though most slots are never deserialized.
+///
+/// Only the operations required by such index tables are provided: the vector
+/// can grow but not shrink, and elements cannot be erased.
+template <typename T, size_t PageSize = 4096 / sizeof(T)> class PagedVector {
+  static_assert(PageSize > 0, "PageSize must not be zero");
+
+  /// Number of elements in the vector, not the number materialized.
+  size_t Size = 0;
+
+  /// Materialized-on-demand storage. A null entry is a page whose elements
+  /// are all still value-initialized. Mutable so that operator[] const can
+  /// materialize a page without changing observable state.
+  mutable std::vector<std::unique_ptr<T[]>> Pages;
+
+  T *materialize(size_t PageIdx) const {
+    std::unique_ptr<T[]> &Page = Pages[PageIdx];
+    if (!Page)
+      Page.reset(new T[PageSize]());
+    return Page.get();
+  }
+
+public:
+  PagedVector() = default;
+
+  size_t size() const { return Size; }
+  bool empty() const { return Size == 0; }
+
+  /// Grow the vector to \p NewSize elements. No page is materialized until
+  /// one of its elements is accessed.
+  void resize(size_t NewSize) {
+    assert(NewSize >= Size && "PagedVector cannot shrink");
+    Size = NewSize;
+    Pages.resize((NewSize + PageSize - 1) / PageSize);
+  }
+
+  T &operator[](size_t Index) const {
+    assert(Index < Size && "Index out of bounds");
+    return materialize(Index / PageSize)[Index % PageSize];
+  }
+
+  /// Return the number of elements equal to \p Value, treating every element
+  /// of an unmaterialized page as value-initialized.
+  size_t count(const T &Value) const {
+    size_t N = 0;
+    for (size_t PageIdx = 0, E = Pages.size(); PageIdx != E; ++PageIdx) {
+      size_t Elems = std::min(PageSize, Size - PageIdx * PageSize);
+      if (const std::unique_ptr<T[]> &Page = Pages[PageIdx]) {
+        for (size_t I = 0; I != Elems; ++I)
+          N += Page[I] == Value;
+      } else if (Value == T()) {
+        N += Elems;
+      }
+    }
+    return N;
+  }
+
+  /// Release all materialized pages and reset to an empty vector.
+  void clear() {
+    Size = 0;
+    Pages.clear();
+  }
+};
+
+} // namespace llvm
+
+#endif // LLVM_ADT_PAGEDVECTOR_H
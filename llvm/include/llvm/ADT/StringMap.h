@@ -52,6 +52,7 @@ protected:
 
   StringMapImpl(unsigned InitSize, unsigned ItemSize);
   unsigned RehashTable(unsigned BucketNo = 0);
+  unsigned rehashTableInto(unsigned NewSize, unsigned BucketNo);
 
   /// LookupBucketFor - Look up the bucket that the specified string should end
   /// up in.  If it already exists as a key in the map, the Item pointer for the
@@ -86,6 +87,11 @@ public:
     return reinterpret_cast<StringMapEntryBase *>(TombstoneIntVal);
   }
 
+  /// Grow the table so that it can hold at least \p NumEntries items before
+  /// it needs to rehash, moving the existing items only once. Useful ahead of
+  /// bulk insertions.
+  void reserve(unsigned NumEntries);
+
   unsigned getNumBuckets() const { return NumBuckets; }
   unsigned getNumItems() const { return NumItems; }
 
@@ -297,6 +303,20 @@ public:
     return try_emplace(KV.first, std::move(KV.second));
   }
 
+  /// insert - Range insertion of pairs. If several elements in the range have
+  /// keys that compare equivalent, only the first one is inserted. The table
+  /// is grown to its final size up front, so the existing items are moved at
+  /// most once instead of on every rehash.
+  template <typename InputIt> void insert(InputIt First, InputIt Last) {
+    reserve(NumItems + std::distance(First, Last));
+    for (InputIt It = First; It != Last; ++It)
+      insert(*It);
+  }
+
+  void insert(std::initializer_list<std::pair<StringRef, ValueTy>> List) {
+    insert(List.begin(), List.end());
+  }
+
   /// Inserts an element or assigns to the current element if the key already
   /// exists. The return type is the same as try_emplace.
   template <typename V>
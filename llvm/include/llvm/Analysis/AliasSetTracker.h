@@ -18,6 +18,7 @@
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/ilist.h"
 #include "llvm/ADT/ilist_node.h"
 #include "llvm/Analysis/MemoryLocation.h"
@@ -355,10 +356,19 @@ class AliasSetTracker {
 
 public:
   /// Create an empty collection of AliasSets, and use the specified alias
-  /// analysis object to disambiguate load and store addresses.
-  explicit AliasSetTracker(AAResults &AA) : AA(AA) {}
-  explicit AliasSetTracker(AAResults &AA, MemorySSA *MSSA, Loop *L)
-      : AA(AA), MSSA(MSSA), L(L) {}
+  /// analysis object to disambiguate load and store addresses. If
+  /// \p SaturationThreshold is given it overrides the global
+  /// -alias-set-saturation-threshold limit on the total size of may-alias
+  /// sets before the tracker degrades to a single "alias anything" set;
+  /// clients willing to pay for precision on large functions can pass a
+  /// larger cap.
+  explicit AliasSetTracker(AAResults &AA,
+                           Optional<unsigned> SaturationThreshold = None)
+      : AA(AA), SaturationThresholdOverride(SaturationThreshold) {}
+  explicit AliasSetTracker(AAResults &AA, MemorySSA *MSSA, Loop *L,
+                           Optional<unsigned> SaturationThreshold = None)
+      : AA(AA), MSSA(MSSA), L(L),
+        SaturationThresholdOverride(SaturationThreshold) {}
   ~AliasSetTracker() { clear(); }
 
   /// These methods are used to add different types of instructions to the alias
@@ -433,6 +443,12 @@ private:
   // all pointers into a single "May" set.
   AliasSet *AliasAnyAS = nullptr;
 
+  // Per-tracker override for the saturation threshold; None means use the
+  // -alias-set-saturation-threshold default.
+  Optional<unsigned> SaturationThresholdOverride;
+
+  unsigned getSaturationThreshold() const;
+
   void removeAliasSet(AliasSet *AS);
 
   /// Just like operator[] on the map, except that it creates an entry for the
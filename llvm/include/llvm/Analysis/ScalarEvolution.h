@@ -2037,6 +2037,10 @@ private:
   std::tuple<SCEV *, FoldingSetNodeID, void *>
   findExistingSCEVInCache(SCEVTypes SCEVType, ArrayRef<const SCEV *> Ops);
 
+  /// Look up \p ID in `UniqueSCEVs`, maintaining statistics on how often the
+  /// expression being built already existed.
+  SCEV *findExistingSCEV(FoldingSetNodeID &ID, void *&IP);
+
   FoldingSet<SCEV> UniqueSCEVs;
   FoldingSet<SCEVPredicate> UniquePreds;
   BumpPtrAllocator SCEVAllocator;
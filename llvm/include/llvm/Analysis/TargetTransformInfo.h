@@ -21,6 +21,9 @@
 #ifndef LLVM_ANALYSIS_TARGETTRANSFORMINFO_H
 #define LLVM_ANALYSIS_TARGETTRANSFORMINFO_H
 
+#include "llvm/ADT/APInt.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/Operator.h"
 #include "llvm/IR/PassManager.h"
@@ -1349,6 +1352,21 @@ private:
   /// Returns -1 if the cost is unknown.
   int getInstructionThroughput(const Instruction *I) const;
 
+  /// Integer immediate materialization costs depend only on the query
+  /// operands and the subtarget this object wraps, and passes such as
+  /// ConstantHoisting issue the same queries many times over, so memoize
+  /// them. The first pair member distinguishes the query kind and packs the
+  /// scalar arguments (cost kind, operand index, opcode or intrinsic ID);
+  /// instruction-aware queries are only cached when no instruction is
+  /// provided, since targets inspect the using instruction and may return
+  /// different costs for the same immediate.
+  using IntImmCostKey = std::pair<uint64_t, std::pair<Type *, APInt>>;
+  mutable DenseMap<IntImmCostKey, int> IntImmCostCache;
+
+  /// Look up or compute a memoized integer immediate cost.
+  int getCachedIntImmCost(uint64_t Discriminator, const APInt &Imm, Type *Ty,
+                          function_ref<int()> Compute) const;
+
   /// The abstract base class used to type erase specific TTI
   /// implementations.
   class Concept;
@@ -14,6 +14,7 @@
 #define LLVM_BITCODE_BITCODEREADER_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Bitstream/BitCodes.h"
 #include "llvm/IR/ModuleSummaryIndex.h"
@@ -115,9 +116,15 @@ typedef llvm::function_ref<Optional<std::string>(StringRef)>
     Expected<std::unique_ptr<ModuleSummaryIndex>> getSummary();
 
     /// Parse the specified bitcode buffer and merge its module summary index
-    /// into CombinedIndex.
+    /// into CombinedIndex. If \p GUIDFilter is non-null, only summaries for
+    /// the GUIDs it contains are materialized; other summary records are
+    /// skipped without allocating anything, which lets clients (e.g.
+    /// incremental thin-links) pay only for the summaries they will look at.
+    /// When reading a per-module index with a filter, aliasee GUIDs must be
+    /// requested along with their aliases.
     Error readSummary(ModuleSummaryIndex &CombinedIndex, StringRef ModulePath,
-                      uint64_t ModuleId);
+                      uint64_t ModuleId,
+                      const DenseSet<GlobalValue::GUID> *GUIDFilter = nullptr);
   };
 
   struct BitcodeFileContents {
@@ -182,9 +189,12 @@ typedef llvm::function_ref<Optional<std::string>(StringRef)>
   getModuleSummaryIndex(MemoryBufferRef Buffer);
 
   /// Parse the specified bitcode buffer and merge the index into CombinedIndex.
-  Error readModuleSummaryIndex(MemoryBufferRef Buffer,
-                               ModuleSummaryIndex &CombinedIndex,
-                               uint64_t ModuleId);
+  /// If \p GUIDFilter is non-null, only summaries for the contained GUIDs are
+  /// materialized (see BitcodeModule::readSummary).
+  Error readModuleSummaryIndex(
+      MemoryBufferRef Buffer, ModuleSummaryIndex &CombinedIndex,
+      uint64_t ModuleId,
+      const DenseSet<GlobalValue::GUID> *GUIDFilter = nullptr);
 
   /// Parse the module summary index out of an IR file and return the module
   /// summary index object if found, or an empty summary if not. If Path refers
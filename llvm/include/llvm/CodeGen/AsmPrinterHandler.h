@@ -66,6 +66,12 @@ public:
                             MCSymbol *Sym = nullptr) {}
   virtual void endFunclet() {}
 
+  /// Return true if this handler needs to be notified of every instruction
+  /// as it is emitted. Handlers that only act on function or block
+  /// boundaries can return false to keep their no-op instruction callbacks
+  /// out of the instruction emission loop.
+  virtual bool needsInstructionCallbacks() const { return true; }
+
   /// Process beginning of an instruction.
   virtual void beginInstruction(const MachineInstr *MI) = 0;
 
@@ -152,6 +152,16 @@ public:
   /// owned by this class.
   DIEAbbrev &uniqueAbbreviation(DIE &Die);
 
+  /// Unique a copy of \p Abbrev into this set and return the abbreviation
+  /// number it is assigned. This is used to merge the abbreviations collected
+  /// into per-unit sets into the final set in a deterministic order.
+  unsigned uniqueAbbreviation(const DIEAbbrev &Abbrev);
+
+  /// The uniqued abbreviations, in numbering (first-use) order.
+  const std::vector<DIEAbbrev *> &getAbbreviations() const {
+    return Abbreviations;
+  }
+
   /// Print all abbreviations using the specified asm printer.
   void Emit(const AsmPrinter *AP, MCSection *Section) const;
 };
@@ -809,6 +819,32 @@ public:
   unsigned computeOffsetsAndAbbrevs(const AsmPrinter *AP,
                                     DIEAbbrevSet &AbbrevSet, unsigned CUOffset);
 
+  /// Unique the abbreviations for this DIE and all its children into
+  /// \p AbbrevSet and fill in the abbreviation numbers, without computing
+  /// offsets or sizes.
+  ///
+  /// This is the first half of \a computeOffsetsAndAbbrevs(); it only touches
+  /// this DIE's subtree and \p AbbrevSet, so it can run for several units
+  /// concurrently as long as each unit uses its own abbreviation set. The
+  /// per-unit numbers are later rewritten to their final values by
+  /// \a remapAbbrevsAndComputeOffsets().
+  void assignAbbrevs(DIEAbbrevSet &AbbrevSet);
+
+  /// Rewrite the abbreviation numbers of this DIE and all its children
+  /// through \p AbbrevRemap and compute offsets and sizes.
+  ///
+  /// This is the second half of \a computeOffsetsAndAbbrevs(). \p AbbrevRemap
+  /// maps the numbers assigned by \a assignAbbrevs() (less one) to the final
+  /// numbers in the shared abbreviation set; sizes cannot be computed before
+  /// the remap because each DIE's size includes the ULEB128 encoding of its
+  /// final abbreviation number.
+  ///
+  /// \returns the offset for the DIE that follows this DIE within the
+  /// current compile/type unit.
+  unsigned remapAbbrevsAndComputeOffsets(const AsmPrinter *AP,
+                                         const std::vector<unsigned> &AbbrevRemap,
+                                         unsigned CUOffset);
+
   /// Climb up the parent chain to get the compile unit or type unit DIE that
   /// this DIE belongs to.
   ///
@@ -357,6 +357,14 @@ private:
   /// state machines that start with a OPC_SwitchOpcode node.
   std::vector<unsigned> OpcodeOffset;
 
+  /// OpcodeVTOffset - Second-level dispatch cache for opcodes whose case in
+  /// the top-level OPC_SwitchOpcode begins with an OPC_SwitchType. Maps
+  /// (opcode << 8) | result type directly to the matcher index of the type's
+  /// case, avoiding a linear scan over the type cases on every selection.
+  /// Opcodes whose type switch contains an iPTR case are not cached, since
+  /// iPTR resolution depends on the pointer type and case order matters.
+  DenseMap<unsigned, unsigned> OpcodeVTOffset;
+
   void UpdateChains(SDNode *NodeToMatch, SDValue InputChain,
                     SmallVectorImpl<SDNode *> &ChainNodesMatched,
                     bool isMorphNodeTo);
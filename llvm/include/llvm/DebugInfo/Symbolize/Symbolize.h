@@ -13,6 +13,7 @@
 #ifndef LLVM_DEBUGINFO_SYMBOLIZE_SYMBOLIZE_H
 #define LLVM_DEBUGINFO_SYMBOLIZE_SYMBOLIZE_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableModule.h"
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/ObjectFile.h"
@@ -49,6 +50,7 @@ public:
     std::string FallbackDebugPath;
     std::string DWPName;
     std::vector<std::string> DebugFileDirectory;
+    std::vector<std::string> GsymFileDirectory;
   };
 
   LLVMSymbolizer() = default;
@@ -65,6 +67,22 @@ public:
   Expected<DIInliningInfo>
   symbolizeInlinedCode(const std::string &ModuleName,
                        object::SectionedAddress ModuleOffset);
+
+  /// A single request for symbolizeInlinedCodeBatch(): an offset within the
+  /// given module.
+  struct Request {
+    std::string ModuleName;
+    object::SectionedAddress ModuleOffset;
+  };
+
+  /// Symbolize a batch of addresses, returning the results in request order.
+  /// The requests are grouped by module, each module's addresses are resolved
+  /// in ascending order for line-table locality, and independent modules are
+  /// processed concurrently. Each result is identical to what a separate
+  /// symbolizeInlinedCode() call would have returned.
+  std::vector<Expected<DIInliningInfo>>
+  symbolizeInlinedCodeBatch(ArrayRef<Request> Requests);
+
   Expected<DIGlobal> symbolizeData(const std::string &ModuleName,
                                    object::SectionedAddress ModuleOffset);
   Expected<std::vector<DILocal>>
@@ -84,6 +102,9 @@ private:
   Expected<DILineInfo>
   symbolizeCodeCommon(SymbolizableModule *Info,
                       object::SectionedAddress ModuleOffset);
+  Expected<DIInliningInfo>
+  symbolizeInlinedCodeCommon(SymbolizableModule *Info,
+                             object::SectionedAddress ModuleOffset);
 
   /// Returns a SymbolizableModule or an error if loading debug info failed.
   /// Only one attempt is made to load a module, and errors during loading are
@@ -107,6 +128,11 @@ private:
                                   const ELFObjectFileBase *Obj,
                                   const std::string &ArchName);
 
+  /// Returns the path to the GSYM file for the given binary, looking next to
+  /// the binary and then in Opts.GsymFileDirectory, or an empty string if
+  /// none is found.
+  std::string lookUpGsymFile(const std::string &Path);
+
   /// Returns pair of pointers to object and debug object.
   Expected<ObjectPair> getOrCreateObjectPair(const std::string &Path,
                                             const std::string &ArchName);
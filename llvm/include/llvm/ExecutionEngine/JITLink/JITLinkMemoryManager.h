@@ -21,6 +21,8 @@
 
 #include <cstdint>
 #include <future>
+#include <mutex>
+#include <vector>
 
 namespace llvm {
 namespace jitlink {
@@ -104,6 +106,72 @@ public:
   allocate(const SegmentsRequestMap &Request) override;
 };
 
+/// A JITLinkMemoryManager that carves in-process allocations out of a pool
+/// of pre-reserved slabs.
+///
+/// InProcessMemoryManager performs one mapping (and, on finalization, one
+/// protection change per segment) for every object loaded, which is costly
+/// for JITs that load many small objects. This manager instead reserves
+/// read-write slabs up front -- 2Mb each by default -- and carves segment
+/// memory out of them, so the map/unmap traffic is amortized over all the
+/// allocations sharing a slab. Slabs are reserved with
+/// sys::Memory::MF_HUGE_HINT so that, where the platform supports it, code
+/// from many objects is packed into a small number of large pages, reducing
+/// iTLB pressure.
+///
+/// Segments with the same protection flags are carved from the same slabs
+/// to keep code (and data) from different objects contiguous. Deallocated
+/// blocks are re-protected to read-write and returned to the pool for reuse;
+/// the underlying slabs are only unmapped when the manager itself is
+/// destroyed, so all allocations must be deallocated before then.
+class PooledMemoryManager : public JITLinkMemoryManager {
+public:
+  /// Create a PooledMemoryManager. \p SlabSize is rounded up to a multiple
+  /// of the page size. Requests larger than the slab size are satisfied
+  /// with a dedicated mapping.
+  static Expected<std::unique_ptr<PooledMemoryManager>>
+  Create(uint64_t SlabSize = 2 * 1024 * 1024);
+
+  ~PooledMemoryManager() override;
+
+  Expected<std::unique_ptr<Allocation>>
+  allocate(const SegmentsRequestMap &Request) override;
+
+private:
+  class PooledAlloc;
+
+  struct Pool {
+    /// Unused tail of the most recently reserved slab for this
+    /// protection-flags key.
+    sys::MemoryBlock Remaining;
+
+    /// Deallocated blocks available for reuse.
+    std::vector<sys::MemoryBlock> FreeBlocks;
+  };
+
+  PooledMemoryManager(uint64_t SlabSize, uint64_t PageSize)
+      : SlabSize(SlabSize), PageSize(PageSize) {}
+
+  /// Carve a block of \p Size bytes (a multiple of the page size) for
+  /// segments that will be finalized with protection flags \p Prot. Must be
+  /// called with PoolMutex held.
+  Expected<sys::MemoryBlock> carve(unsigned Prot, uint64_t Size);
+
+  /// Return a block to the pool for reuse, restoring read-write protection.
+  /// Must be called with PoolMutex held.
+  Error release(unsigned Prot, sys::MemoryBlock Block);
+
+  std::mutex PoolMutex;
+  uint64_t SlabSize;
+  uint64_t PageSize;
+
+  /// All slabs reserved so far. Unmapped on destruction.
+  std::vector<sys::MemoryBlock> Slabs;
+
+  /// Per protection-flags pools that allocations are carved from.
+  DenseMap<unsigned, Pool> Pools;
+};
+
 } // end namespace jitlink
 } // end namespace llvm
 
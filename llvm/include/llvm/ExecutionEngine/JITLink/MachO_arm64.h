@@ -36,6 +36,7 @@ enum MachOARM64RelocationKind : Edge::Kind {
   Delta64,
   NegDelta32,
   NegDelta64,
+  Branch26ToStub,
 };
 
 } // namespace MachO_arm64_Edges
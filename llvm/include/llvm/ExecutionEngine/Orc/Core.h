@@ -1357,6 +1357,29 @@ public:
                              RegisterDependenciesFunction RegisterDependencies =
                                  NoDependenciesToRegister);
 
+  /// An element of a batched lookup: a search order and the set of symbols to
+  /// look up in it.
+  struct BatchLookupQuery {
+    BatchLookupQuery(JITDylibSearchOrder SearchOrder, SymbolLookupSet Symbols)
+        : SearchOrder(std::move(SearchOrder)), Symbols(std::move(Symbols)) {}
+    JITDylibSearchOrder SearchOrder;
+    SymbolLookupSet Symbols;
+  };
+
+  /// Issues a group of independent lookups under a single acquisition of the
+  /// session lock and blocks until all of them have completed. Equivalent to
+  /// calling the blocking lookup above once per query, but amortizes lock
+  /// handoff when many symbol sets are resolved at once: queries whose
+  /// symbols are already materialized complete within the shared lock epoch.
+  /// Results are returned in query order; a failed query does not affect the
+  /// others.
+  std::vector<Expected<SymbolMap>>
+  lookupBatch(std::vector<BatchLookupQuery> Queries,
+              LookupKind K = LookupKind::Static,
+              SymbolState RequiredState = SymbolState::Ready,
+              RegisterDependenciesFunction RegisterDependencies =
+                  NoDependenciesToRegister);
+
   /// Convenience version of blocking lookup.
   /// Searches each of the JITDylibs in the search order in turn for the given
   /// symbol.
@@ -42,6 +42,25 @@ public:
   ResultTy operator()(Function &F);
 };
 
+// Collects every function statically reachable from the caller through
+// direct calls, by bounded breadth-first traversal of the module's call
+// graph. Unlike the CFG-based queries above this ignores block frequencies,
+// so it trades some precision for seeing past the immediate callees:
+// functions several calls deep are enqueued before the first call reaches
+// them.
+class CallGraphReachabilityQuery : public SpeculateQuery {
+public:
+  CallGraphReachabilityQuery(unsigned MaxDepth = 2, size_t MaxCandidates = 32)
+      : MaxDepth(MaxDepth), MaxCandidates(MaxCandidates) {}
+
+  // Find likely next executables in the static call graph rooted at F.
+  ResultTy operator()(Function &F);
+
+private:
+  unsigned MaxDepth;
+  size_t MaxCandidates;
+};
+
 // This Query generates a sequence of basic blocks which follows the order of
 // execution.
 // A handful of BB with higher block frequencies are taken, then path to entry
@@ -13,6 +13,7 @@
 #ifndef LLVM_EXECUTIONENGINE_ORC_SPECULATION_H
 #define LLVM_EXECUTIONENGINE_ORC_SPECULATION_H
 
+#include "llvm/ADT/ConcurrentDenseMap.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ExecutionEngine/Orc/Core.h"
@@ -29,8 +30,8 @@ namespace orc {
 class Speculator;
 
 // Track the Impls (JITDylib,Symbols) of Symbols while lazy call through
-// trampolines are created. Operations are guarded by locks tp ensure that Imap
-// stays in consistent state after read/write
+// trampolines are created. The map is sharded, so lookups racing against
+// registration of unrelated symbols do not serialize.
 
 class ImplSymbolMap {
   friend class Speculator;
@@ -38,22 +39,16 @@ class ImplSymbolMap {
 public:
   using AliaseeDetails = std::pair<SymbolStringPtr, JITDylib *>;
   using Alias = SymbolStringPtr;
-  using ImapTy = DenseMap<Alias, AliaseeDetails>;
+  using ImapTy = ConcurrentDenseMap<Alias, AliaseeDetails>;
   void trackImpls(SymbolAliasMap ImplMaps, JITDylib *SrcJD);
 
 private:
   // FIX ME: find a right way to distinguish the pre-compile Symbols, and update
   // the callsite
   Optional<AliaseeDetails> getImplFor(const SymbolStringPtr &StubSymbol) {
-    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
-    auto Position = Maps.find(StubSymbol);
-    if (Position != Maps.end())
-      return Position->getSecond();
-    else
-      return None;
+    return Maps.lookup(StubSymbol);
   }
 
-  std::mutex ConcurrentAccess;
   ImapTy Maps;
 };
 
@@ -90,6 +85,10 @@ private:
       // try to distinguish already compiled & library symbols
       if (!ImplSymbol.hasValue())
         continue;
+      // Stop enqueueing speculative work once the budget is exhausted; the
+      // remaining candidates simply compile on first call as usual.
+      if (!chargeBudget())
+        break;
       const auto &ImplSymbolName = ImplSymbol.getPointer()->first;
       JITDylib *ImplJD = ImplSymbol.getPointer()->second;
       auto &SymbolsInJD = SpeculativeLookUpImpls[ImplJD];
@@ -119,9 +118,27 @@ private:
           NoDependenciesToRegister);
   }
 
+  // Deduct one speculative compile from the budget, if one was set. Returns
+  // false once the budget is exhausted.
+  bool chargeBudget() {
+    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    if (!SpecBudget.hasValue())
+      return true;
+    if (*SpecBudget == 0)
+      return false;
+    --*SpecBudget;
+    return true;
+  }
+
 public:
-  Speculator(ImplSymbolMap &Impl, ExecutionSession &ref)
-      : AliaseeImplTable(Impl), ES(ref), GlobalSpecMap(0) {}
+  /// If \p SpeculationBudget is given, at most that many functions are
+  /// compiled speculatively over the lifetime of this Speculator; candidates
+  /// beyond the budget are left to compile on first call. With no budget all
+  /// candidates are compiled speculatively.
+  Speculator(ImplSymbolMap &Impl, ExecutionSession &ref,
+             Optional<size_t> SpeculationBudget = None)
+      : AliaseeImplTable(Impl), ES(ref), GlobalSpecMap(0),
+        SpecBudget(SpeculationBudget) {}
   Speculator(const Speculator &) = delete;
   Speculator(Speculator &&) = delete;
   Speculator &operator=(const Speculator &) = delete;
@@ -167,6 +184,7 @@ private:
   ImplSymbolMap &AliaseeImplTable;
   ExecutionSession &ES;
   StubAddrLikelies GlobalSpecMap;
+  Optional<size_t> SpecBudget;
 };
 
 class IRSpeculationLayer : public IRLayer {
@@ -0,0 +1,80 @@
+//===- AnalysisCacheSnapshot.h - Keep analysis caches across runs -*-C++-*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+///
+/// This header defines a helper for clients that keep a
+/// FunctionAnalysisManager alive across multiple pass pipeline invocations
+/// and modify IR in between, such as JITs that re-optimize functions. The
+/// analysis manager only knows about changes reported through
+/// PreservedAnalyses; IR modified behind its back would normally force the
+/// client to clear every cached result. FunctionAnalysisCacheSnapshot
+/// records a content hash per function instead, so that on the next
+/// pipeline run only the functions that actually changed have their cached
+/// analyses invalidated and unchanged functions skip recomputation
+/// entirely.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_IR_ANALYSISCACHESNAPSHOT_H
+#define LLVM_IR_ANALYSISCACHESNAPSHOT_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/PassManager.h"
+#include <cstdint>
+
+namespace llvm {
+
+class Function;
+class Module;
+
+/// Compute a hash of a function's contents: its control flow graph,
+/// instruction opcodes and types, and operand structure. Two calls return the
+/// same value if and only if (up to hash collisions) the function body is
+/// unchanged. The hash is only meaningful for comparisons within a single
+/// LLVMContext and process; it is not stable across runs and must not be
+/// serialized.
+uint64_t computeFunctionContentHash(const Function &F);
+
+/// Tracks per-function content hashes so analysis results cached in a
+/// long-lived FunctionAnalysisManager can survive IR modifications made
+/// outside of any pass manager.
+///
+/// Typical usage in a JIT re-optimization loop:
+///
+/// \code
+///   Snapshot.take(M);           // after a pipeline run, caches are valid
+///   ...                         // client mutates some functions directly
+///   Snapshot.refresh(M, FAM);   // drops caches only for changed functions
+///   MPM.run(M, MAM);            // unchanged functions reuse their analyses
+/// \endcode
+///
+/// Change detection is probabilistic: a hash collision would leave stale
+/// results in the cache. The hash covers the CFG, opcodes, types, and
+/// operands, which is sufficient for the function analyses shipped in tree,
+/// but clients mutating IR in exotic ways (e.g. metadata only) should
+/// invalidate explicitly instead.
+class FunctionAnalysisCacheSnapshot {
+public:
+  /// Record the current content hash of every function definition in \p M,
+  /// replacing any previous snapshot.
+  void take(const Module &M);
+
+  /// Invalidate cached analyses for each function definition in \p M whose
+  /// content hash differs from the recorded one (or that was not recorded),
+  /// and update the snapshot to the current state. Returns the number of
+  /// functions invalidated.
+  unsigned refresh(Module &M, FunctionAnalysisManager &FAM);
+
+private:
+  DenseMap<const Function *, uint64_t> Hashes;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_IR_ANALYSISCACHESNAPSHOT_H
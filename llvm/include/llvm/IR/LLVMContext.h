@@ -146,6 +146,41 @@ public:
   /// especially in release mode.
   void setDiscardValueNames(bool Discard);
 
+  /// Enable arena allocation for Values created on the calling thread.
+  ///
+  /// All User storage subsequently allocated on this thread is carved out of
+  /// a BumpPtrAllocator owned by this context and is reclaimed in bulk when
+  /// the context is destroyed; the individual deallocations normally done by
+  /// Value::deleteValue() and module teardown become no-ops for such Values.
+  /// This trades address-space reuse for allocation/teardown speed and is
+  /// intended for short-lived compile jobs. All IR used with this context
+  /// should be created with the arena enabled; mixing arena and malloc
+  /// allocated Values is supported but forfeits the bulk-free win for the
+  /// latter. Off by default.
+  void enableValueArena();
+
+  /// Stop allocating Value storage from this context's arena on the calling
+  /// thread.
+  ///
+  /// This only affects future allocations. Storage already carved from the
+  /// arena is only recognized during deallocation while the arena is
+  /// installed, so arena-backed Values must be deleted either before the
+  /// arena is disabled or not at all (leaving them to be reclaimed in bulk
+  /// when the context is destroyed); deleting one afterwards frees an
+  /// interior arena pointer and corrupts the heap.
+  void disableValueArena();
+
+  /// Switch DILocation uniquing over to sharded, independently locked
+  /// tables so that multiple threads (e.g. parallel ThinLTO import threads)
+  /// can create and look up debug locations in one shared context. Existing
+  /// DILocations are migrated into the shards, so this must be called before
+  /// handing the context to multiple threads. Uniquing of other metadata
+  /// kinds remains single-threaded; callers are responsible for not mutating
+  /// those tables concurrently. Irreversible for the life of the context.
+  /// Off by default.
+  bool hasConcurrentDILocationUniquing() const;
+  void enableConcurrentDILocationUniquing();
+
   /// Whether there is a string map for uniquing debug info
   /// identifiers across the context.  Off by default.
   bool isODRUniquingDebugTypes() const;
@@ -22,6 +22,7 @@
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/IR/Use.h"
 #include "llvm/IR/Value.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -48,6 +49,20 @@ class User : public Value {
   LLVM_ATTRIBUTE_ALWAYS_INLINE static void *
   allocateFixedOperandUser(size_t, unsigned, unsigned);
 
+public:
+  /// Install \p Arena as the thread-local arena for User allocations.
+  ///
+  /// While an arena is installed, all User (and hung-off use list) storage
+  /// allocated on the calling thread is drawn from the arena and the matching
+  /// operator delete becomes a no-op; the memory is reclaimed in bulk when the
+  /// arena itself is destroyed. Clients normally reach this through
+  /// LLVMContext::enableValueArena() rather than calling it directly. Passing
+  /// nullptr restores malloc-based allocation.
+  static void setThreadLocalValueArena(BumpPtrAllocator *Arena);
+
+  /// Return the arena installed by setThreadLocalValueArena, if any.
+  static BumpPtrAllocator *getThreadLocalValueArena();
+
 protected:
   /// Allocate a User with an operand pointer co-allocated.
   ///
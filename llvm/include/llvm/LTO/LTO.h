@@ -218,9 +218,49 @@ using AddStreamFn =
 using NativeObjectCache =
     std::function<AddStreamFn(unsigned Task, StringRef Key)>;
 
+/// This class defines the interface to the ThinLTO backend. One backend
+/// process is created per link by the ThinBackend function, and it receives
+/// one start() call per backend compile job. Clients with their own execution
+/// environment (e.g. a distributed build farm) may subclass it to run jobs
+/// somewhere other than the local machine; see
+/// createOutOfProcessThinBackend() for a ready-made dispatching
+/// implementation.
+class ThinBackendProc {
+protected:
+  const Config &Conf;
+  ModuleSummaryIndex &CombinedIndex;
+  const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries;
+
+public:
+  ThinBackendProc(const Config &Conf, ModuleSummaryIndex &CombinedIndex,
+                  const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries)
+      : Conf(Conf), CombinedIndex(CombinedIndex),
+        ModuleToDefinedGVSummaries(ModuleToDefinedGVSummaries) {}
+
+  virtual ~ThinBackendProc() {}
+
+  /// Launches the backend job for one module. May run the job to completion
+  /// or merely schedule it; all jobs must be complete when wait() returns.
+  virtual Error start(
+      unsigned Task, BitcodeModule BM,
+      const FunctionImporter::ImportMapTy &ImportList,
+      const FunctionImporter::ExportSetTy &ExportList,
+      const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
+      MapVector<StringRef, BitcodeModule> &ModuleMap) = 0;
+
+  /// Blocks until every started job has delivered its native object.
+  virtual Error wait() = 0;
+
+  /// Degree of parallelism start() can exploit. When this returns 1, jobs are
+  /// started in input order (required by the write-indexes backend); otherwise
+  /// the largest modules are started first.
+  virtual unsigned getThreadCount() = 0;
+};
+
 /// A ThinBackend defines what happens after the thin-link phase during ThinLTO.
-/// The details of this type definition aren't important; clients can only
-/// create a ThinBackend using one of the create*ThinBackend() functions below.
+/// Clients should create a ThinBackend using one of the create*ThinBackend()
+/// functions below, or implement ThinBackendProc and return their own
+/// factory function.
 using ThinBackend = std::function<std::unique_ptr<ThinBackendProc>(
     const Config &C, ModuleSummaryIndex &CombinedIndex,
     StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
@@ -250,6 +290,26 @@ ThinBackend createWriteIndexesThinBackend(std::string OldPrefix,
                                           raw_fd_ostream *LinkedObjectsFile,
                                           IndexWriteCallback OnWrite);
 
+/// The type of the function an out-of-process ThinBackend dispatches each
+/// backend job to. It receives the task number, the module to compile and its
+/// import list, along with the stream callback the native object must be
+/// written to. It may run the job before returning or hand it to a remote
+/// executor and deliver the object asynchronously from another thread.
+using ThinBackendDispatchFn = std::function<Error(
+    unsigned Task, BitcodeModule BM,
+    const FunctionImporter::ImportMapTy &ImportList, AddStreamFn AddStream)>;
+
+/// This ThinBackend hands the individual backend jobs to \p Dispatch instead
+/// of running them on local threads, for clients that farm backend
+/// compilations out to other machines. Jobs are checked against the native
+/// object cache before being dispatched, using the same computeLTOCacheKey()
+/// scheme as the in-process backend, so results are deduplicated and reused
+/// across links. \p Wait is invoked once, after all jobs have been
+/// dispatched, and must block until every outstanding native object has been
+/// delivered; it may be null if \p Dispatch runs jobs synchronously.
+ThinBackend createOutOfProcessThinBackend(ThinBackendDispatchFn Dispatch,
+                                          std::function<Error()> Wait);
+
 /// This class implements a resolution-based interface to LLVM's LTO
 /// functionality. It supports regular LTO, parallel LTO code generation and
 /// ThinLTO. You can use it from a linker in the following way:
@@ -10,7 +10,10 @@
 #define LLVM_LINKER_IRMOVER_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/Optional.h"
+#include <cstdint>
 #include <functional>
 
 namespace llvm {
@@ -51,12 +54,24 @@ public:
     // The set of identified but non opaque structures in the composite module.
     DenseSet<StructType *, StructTypeKeyInfo> NonOpaqueStructTypes;
 
+    // Cache of structural hashes for types in the composite module, used to
+    // cheaply reject non-isomorphic candidate pairs before running the
+    // recursive isomorphism check. Only types whose type graphs contain no
+    // opaque structs get a hash; those graphs cannot be mutated as opaque
+    // types are resolved, so cached entries stay valid across links.
+    DenseMap<StructType *, uint64_t> StructuralHashes;
+
   public:
     void addNonOpaque(StructType *Ty);
     void switchToNonOpaque(StructType *Ty);
     void addOpaque(StructType *Ty);
     StructType *findNonOpaque(ArrayRef<Type *> ETypes, bool IsPacked);
     bool hasType(StructType *Ty);
+
+    /// Return the structural hash for \p Ty, computing and caching it if
+    /// necessary. Returns None if no hash can be assigned to \p Ty (its type
+    /// graph contains an opaque struct, or is too large to walk cheaply).
+    Optional<uint64_t> getStructuralHash(StructType *Ty);
   };
 
   IRMover(Module &M);
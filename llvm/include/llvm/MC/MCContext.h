@@ -23,6 +23,7 @@
 #include "llvm/MC/MCAsmMacro.h"
 #include "llvm/MC/MCDwarf.h"
 #include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/MC/MCSymbolTableEntry.h"
 #include "llvm/MC/MCTargetOptions.h"
 #include "llvm/MC/SectionKind.h"
 #include "llvm/Support/Allocator.h"
@@ -66,7 +67,7 @@ namespace llvm {
   ///
   class MCContext {
   public:
-    using SymbolTable = StringMap<MCSymbol *, BumpPtrAllocator &>;
+    using SymbolTable = StringMap<MCSymbolTableValue, BumpPtrAllocator &>;
 
   private:
     /// The SourceMgr for this object, if any.
@@ -99,7 +100,9 @@ namespace llvm {
     SpecificBumpPtrAllocator<MCSectionXCOFF> XCOFFAllocator;
     SpecificBumpPtrAllocator<MCInst> MCInstAllocator;
 
-    /// Bindings of names to symbols.
+    /// Bindings of names to symbols. An entry also holds the rename counter
+    /// and used flag for the name, so symbol creation needs only one hash
+    /// lookup and stores one copy of each name.
     SymbolTable Symbols;
 
     /// A mapping from a local label number and an instance count to a symbol.
@@ -110,18 +113,8 @@ namespace llvm {
     /// We have three labels represented by the pairs (1, 0), (2, 0) and (1, 1)
     DenseMap<std::pair<unsigned, unsigned>, MCSymbol *> LocalSymbols;
 
-    /// Keeps tracks of names that were used both for used declared and
-    /// artificial symbols. The value is "true" if the name has been used for a
-    /// non-section symbol (there can be at most one of those, plus an unlimited
-    /// number of section symbols with the same name).
-    StringMap<bool, BumpPtrAllocator &> UsedNames;
-
     /// Keeps track of labels that are used in inline assembly.
-    SymbolTable InlineAsmUsedLabelNames;
-
-    /// The next ID to dole out to an unnamed assembler temporary symbol with
-    /// a given prefix.
-    StringMap<unsigned> NextID;
+    StringMap<MCSymbol *, BumpPtrAllocator &> InlineAsmUsedLabelNames;
 
     /// Instances of directional local labels.
     DenseMap<unsigned, MCLabel *> Instances;
@@ -295,10 +288,15 @@ namespace llvm {
 
     bool HadError = false;
 
-    MCSymbol *createSymbolImpl(const StringMapEntry<bool> *Name,
+    /// Get the symbol table entry for \p Name, creating it if necessary.
+    MCSymbolTableEntry &getSymbolTableEntry(StringRef Name);
+
+    MCSymbol *createSymbolImpl(const MCSymbolTableEntry *Name,
                                bool CanBeUnnamed);
     MCSymbol *createSymbol(StringRef Name, bool AlwaysAddSuffix,
                            bool IsTemporary);
+    MCSymbol *createRenamableSymbol(StringRef Name, bool AlwaysAddSuffix,
+                                    bool IsTemporary);
 
     MCSymbol *getOrCreateDirectionalLocalSymbol(unsigned LocalLabelVal,
                                                 unsigned Instance);
@@ -310,7 +308,7 @@ namespace llvm {
                                        unsigned UniqueID,
                                        const MCSymbolELF *LinkedToSym);
 
-    MCSymbolXCOFF *createXCOFFSymbolImpl(const StringMapEntry<bool> *Name,
+    MCSymbolXCOFF *createXCOFFSymbolImpl(const MCSymbolTableEntry *Name,
                                          bool IsTemporary);
 
     /// Map of currently defined macros.
@@ -433,7 +431,8 @@ namespace llvm {
     /// getSymbols - Get a reference for the symbol table for clients that
     /// want to, for example, iterate over all symbols. 'const' because we
     /// still want any modifications to the table itself to use the MCContext
-    /// APIs.
+    /// APIs. Entries without a bound symbol (null MCSymbolTableValue::Symbol)
+    /// only reserve the name and must be skipped.
     const SymbolTable &getSymbols() const { return Symbols; }
 
     /// isInlineAsmLabel - Return true if the name is a label referenced in
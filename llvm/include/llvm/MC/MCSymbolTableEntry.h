@@ -0,0 +1,43 @@
+//===- MCSymbolTableEntry.h - Symbol table entry of MCContext ---*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCSYMBOLTABLEENTRY_H
+#define LLVM_MC_MCSYMBOLTABLEENTRY_H
+
+#include "llvm/ADT/StringMapEntry.h"
+
+namespace llvm {
+
+class MCSymbol;
+
+/// The value for an entry in the symbol table of an MCContext.
+///
+/// This is in a separate file, because MCContext.h and MCSymbol.h both need
+/// the entry type and would otherwise include each other.
+struct MCSymbolTableValue {
+  /// The symbol bound to the name, if any.
+  MCSymbol *Symbol = nullptr;
+
+  /// The next ID to dole out to an unnamed temporary symbol with the name
+  /// (as prefix).
+  unsigned NextUniqueID = 0;
+
+  /// Whether the name is used by a non-section symbol. There can be at most
+  /// one of those, plus an unlimited number of section symbols with the same
+  /// name.
+  bool Used = false;
+};
+
+/// MCContext stores symbols (MCSymbolTableValue) in a string map (see
+/// MCContext::Symbols). The name of a symbol is a reference to the key of the
+/// entry holding it.
+using MCSymbolTableEntry = StringMapEntry<MCSymbolTableValue>;
+
+} // end namespace llvm
+
+#endif // LLVM_MC_MCSYMBOLTABLEENTRY_H
@@ -19,7 +19,7 @@ class MCSectionXCOFF;
 
 class MCSymbolXCOFF : public MCSymbol {
 public:
-  MCSymbolXCOFF(const StringMapEntry<bool> *Name, bool isTemporary)
+  MCSymbolXCOFF(const MCSymbolTableEntry *Name, bool isTemporary)
       : MCSymbol(SymbolKindXCOFF, Name, isTemporary) {}
 
   static bool classof(const MCSymbol *S) { return S->isXCOFF(); }
@@ -275,6 +275,10 @@ protected:
   uint32_t getSymbolAlignment(DataRefImpl Symb) const override;
   uint64_t getCommonSymbolSizeImpl(DataRefImpl Symb) const override;
   Expected<uint32_t> getSymbolFlags(DataRefImpl Symb) const override;
+  uint32_t getSymbolFlags(const Elf_Sym *ESym, const Elf_Sym *SymtabBegin,
+                          const Elf_Sym *DynSymBegin, DataRefImpl Symb) const;
+  Error getSymbolDescriptors(
+      std::vector<BasicSymbolDescriptor> &Descriptors) const override;
   uint8_t getSymbolBinding(DataRefImpl Symb) const override;
   uint8_t getSymbolOther(DataRefImpl Symb) const override;
   uint8_t getSymbolELFType(DataRefImpl Symb) const override;
@@ -667,8 +671,28 @@ ELFObjectFile<ELFT>::getSymbolType(DataRefImpl Symb) const {
 
 template <class ELFT>
 Expected<uint32_t> ELFObjectFile<ELFT>::getSymbolFlags(DataRefImpl Sym) const {
-  const Elf_Sym *ESym = getSymbol(Sym);
+  Expected<typename ELFT::SymRange> SymTabOrErr = EF.symbols(DotSymtabSec);
+  if (!SymTabOrErr)
+    // TODO: Test this error.
+    return SymTabOrErr.takeError();
+
+  Expected<typename ELFT::SymRange> DynSymOrErr = EF.symbols(DotDynSymSec);
+  if (!DynSymOrErr)
+    // TODO: Test this error.
+    return DynSymOrErr.takeError();
+
+  return getSymbolFlags(getSymbol(Sym), SymTabOrErr->begin(),
+                        DynSymOrErr->begin(), Sym);
+}
 
+// Decodes flags given pre-validated symbol table begin pointers. This lets
+// the bulk getSymbolDescriptors path hoist the table validation out of the
+// per-symbol loop.
+template <class ELFT>
+uint32_t ELFObjectFile<ELFT>::getSymbolFlags(const Elf_Sym *ESym,
+                                             const Elf_Sym *SymtabBegin,
+                                             const Elf_Sym *DynSymBegin,
+                                             DataRefImpl Sym) const {
   uint32_t Result = SymbolRef::SF_None;
 
   if (ESym->getBinding() != ELF::STB_LOCAL)
@@ -683,23 +707,10 @@ Expected<uint32_t> ELFObjectFile<ELFT>::getSymbolFlags(DataRefImpl Sym) const {
   if (ESym->getType() == ELF::STT_FILE || ESym->getType() == ELF::STT_SECTION)
     Result |= SymbolRef::SF_FormatSpecific;
 
-  if (Expected<typename ELFT::SymRange> SymbolsOrErr =
-          EF.symbols(DotSymtabSec)) {
-    // Set the SF_FormatSpecific flag for the 0-index null symbol.
-    if (ESym == SymbolsOrErr->begin())
-      Result |= SymbolRef::SF_FormatSpecific;
-  } else
-    // TODO: Test this error.
-    return SymbolsOrErr.takeError();
-
-  if (Expected<typename ELFT::SymRange> SymbolsOrErr =
-          EF.symbols(DotDynSymSec)) {
-    // Set the SF_FormatSpecific flag for the 0-index null symbol.
-    if (ESym == SymbolsOrErr->begin())
-      Result |= SymbolRef::SF_FormatSpecific;
-  } else
-    // TODO: Test this error.
-    return SymbolsOrErr.takeError();
+  // Set the SF_FormatSpecific flag for the 0-index null symbol of either
+  // symbol table.
+  if (ESym == SymtabBegin || ESym == DynSymBegin)
+    Result |= SymbolRef::SF_FormatSpecific;
 
   if (EF.getHeader().e_machine == ELF::EM_ARM) {
     if (Expected<StringRef> NameOrErr = getSymbolName(Sym)) {
@@ -730,6 +741,30 @@ Expected<uint32_t> ELFObjectFile<ELFT>::getSymbolFlags(DataRefImpl Sym) const {
   return Result;
 }
 
+template <class ELFT>
+Error ELFObjectFile<ELFT>::getSymbolDescriptors(
+    std::vector<BasicSymbolDescriptor> &Descriptors) const {
+  // Validate both symbol tables once up front; decoding each symbol then
+  // needs no further table checks and no virtual dispatch.
+  Expected<typename ELFT::SymRange> SymTabOrErr = EF.symbols(DotSymtabSec);
+  if (!SymTabOrErr)
+    return SymTabOrErr.takeError();
+
+  Expected<typename ELFT::SymRange> DynSymOrErr = EF.symbols(DotDynSymSec);
+  if (!DynSymOrErr)
+    return DynSymOrErr.takeError();
+
+  const Elf_Sym *SymtabBegin = SymTabOrErr->begin();
+  const Elf_Sym *DynSymBegin = DynSymOrErr->begin();
+  Descriptors.reserve(Descriptors.size() + SymTabOrErr->size());
+  for (const SymbolRef &Sym : symbols()) {
+    DataRefImpl Raw = Sym.getRawDataRefImpl();
+    Descriptors.push_back(
+        {Sym, getSymbolFlags(getSymbol(Raw), SymtabBegin, DynSymBegin, Raw)});
+  }
+  return Error::success();
+}
+
 template <class ELFT>
 Expected<section_iterator>
 ELFObjectFile<ELFT>::getSymbolSection(const Elf_Sym *ESym,
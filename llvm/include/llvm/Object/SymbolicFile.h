@@ -26,6 +26,7 @@
 #include <iterator>
 #include <memory>
 #include <system_error>
+#include <vector>
 
 namespace llvm {
 namespace object {
@@ -136,6 +137,13 @@ public:
 
 using basic_symbol_iterator = content_iterator<BasicSymbolRef>;
 
+/// A symbol together with its decoded flags, produced in bulk by
+/// SymbolicFile::getSymbolDescriptors().
+struct BasicSymbolDescriptor {
+  BasicSymbolRef Symbol;
+  uint32_t Flags;
+};
+
 class SymbolicFile : public Binary {
 public:
   SymbolicFile(unsigned int Type, MemoryBufferRef Source);
@@ -152,6 +160,13 @@ public:
 
   virtual basic_symbol_iterator symbol_end() const = 0;
 
+  /// Decode the flags of every symbol in one pass and append one descriptor
+  /// per symbol to \p Descriptors. The base implementation walks the symbol
+  /// iterators; formats with densely packed symbol tables override it so
+  /// that a whole table can be decoded without per-symbol virtual dispatch.
+  virtual Error
+  getSymbolDescriptors(std::vector<BasicSymbolDescriptor> &Descriptors) const;
+
   // convenience wrappers.
   using basic_symbol_iterator_range = iterator_range<basic_symbol_iterator>;
   basic_symbol_iterator_range symbols() const {
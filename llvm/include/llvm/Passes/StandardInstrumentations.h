@@ -22,7 +22,10 @@
 #include "llvm/IR/PassTimingInfo.h"
 #include "llvm/IR/ValueHandle.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -259,6 +262,31 @@ public:
   void registerCallbacks(PassInstrumentationCallbacks &PIC);
 };
 
+/// Instrumentation that records the state of the pipeline for offline A/B
+/// bisection, enabled with -ir-snapshot-dir. After every pass that changed
+/// the module a bitcode snapshot is written into the given directory, and
+/// every pass run gets a line in index.txt with its wall time and the
+/// snapshot file it produced (or '-' when it left the IR unchanged, so the
+/// previous snapshot is still current). Tooling can then binary-search the
+/// index for the pass that introduced a regression and resume the pipeline
+/// from any snapshot, instead of re-running the whole pipeline per probe.
+class IRSnapshotInstrumentation {
+public:
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  void recordAfterPass(StringRef PassID, Any IR, bool Invalidated);
+
+  /// Stream for index.txt; null until registerCallbacks() opened it.
+  std::unique_ptr<raw_fd_ostream> IndexOS;
+  /// Start times of in-flight passes; passes nest.
+  SmallVector<std::chrono::steady_clock::time_point, 8> StartTimes;
+  /// Hash of the bitcode of the last written snapshot.
+  uint64_t LastSnapshotHash = 0;
+  /// Number of pass events seen, used to number index lines and snapshots.
+  unsigned EventIndex = 0;
+};
+
 /// This class provides an interface to register all the standard pass
 /// instrumentations and manages their state (if any).
 class StandardInstrumentations {
@@ -269,6 +297,7 @@ class StandardInstrumentations {
   OptBisectInstrumentation OptBisect;
   PreservedCFGCheckerInstrumentation PreservedCFGChecker;
   IRChangedPrinter PrintChangedIR;
+  IRSnapshotInstrumentation IRSnapshots;
   VerifyInstrumentation Verify;
 
   bool VerifyEach;
@@ -312,6 +312,10 @@ class InstrProfLookupTrait {
   // It should be LE by default, but can be changed
   // for testing purpose.
   support::endianness ValueProfDataEndianness = support::little;
+  // If set, value profile data is skipped over instead of being
+  // deserialized. Used by counts-only queries to avoid the allocations the
+  // value profile decoding performs.
+  bool SkipValueProfData = false;
 
 public:
   InstrProfLookupTrait(IndexedInstrProf::HashT HashType, unsigned FormatVersion)
@@ -345,12 +349,16 @@ public:
 
   bool readValueProfilingData(const unsigned char *&D,
                               const unsigned char *const End);
+  bool skipValueProfilingData(const unsigned char *&D,
+                              const unsigned char *const End);
   data_type ReadData(StringRef K, const unsigned char *D, offset_type N);
 
   // Used for testing purpose only.
   void setValueProfDataEndianness(support::endianness Endianness) {
     ValueProfDataEndianness = Endianness;
   }
+
+  void setSkipValueProfData(bool Skip) { SkipValueProfData = Skip; }
 };
 
 struct InstrProfReaderIndexBase {
@@ -366,6 +374,7 @@ struct InstrProfReaderIndexBase {
   virtual void advanceToNextKey() = 0;
   virtual bool atEnd() const = 0;
   virtual void setValueProfDataEndianness(support::endianness Endianness) = 0;
+  virtual void setSkipValueProfData(bool Skip) = 0;
   virtual uint64_t getVersion() const = 0;
   virtual bool isIRLevelProfile() const = 0;
   virtual bool hasCSIRLevelProfile() const = 0;
@@ -408,6 +417,10 @@ public:
     HashTable->getInfoObj().setValueProfDataEndianness(Endianness);
   }
 
+  void setSkipValueProfData(bool Skip) override {
+    HashTable->getInfoObj().setSkipValueProfData(Skip);
+  }
+
   uint64_t getVersion() const override { return GET_VERSION(FormatVersion); }
 
   bool isIRLevelProfile() const override {
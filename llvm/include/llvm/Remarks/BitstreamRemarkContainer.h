@@ -38,6 +38,7 @@ enum class BitstreamRemarkContainerType {
   /// * Container version and type
   /// * String table
   /// * External file
+  /// * Optional remark index
   SeparateRemarksMeta,
   /// The remarks emitted separately.
   /// This will contain the following:
@@ -84,9 +85,12 @@ enum RecordIDs {
   RECORD_REMARK_HOTNESS,
   RECORD_REMARK_ARG_WITH_DEBUGLOC,
   RECORD_REMARK_ARG_WITHOUT_DEBUGLOC,
+  // Note: newer records are appended here to keep the values of the existing
+  // records stable.
+  RECORD_META_REMARK_INDEX,
   // Helpers.
   RECORD_FIRST = RECORD_META_CONTAINER_INFO,
-  RECORD_LAST = RECORD_REMARK_ARG_WITHOUT_DEBUGLOC
+  RECORD_LAST = RECORD_META_REMARK_INDEX
 };
 
 constexpr StringRef MetaContainerInfoName = StringRef("Container info", 14);
@@ -99,6 +103,7 @@ constexpr StringRef RemarkHotnessName = StringRef("Remark hotness", 14);
 constexpr StringRef RemarkArgWithDebugLocName =
     StringRef("Argument with debug location", 28);
 constexpr StringRef RemarkArgWithoutDebugLocName = StringRef("Argument", 8);
+constexpr StringRef MetaRemarkIndexName = StringRef("Remark index", 12);
 
 } // end namespace remarks
 } // end namespace llvm
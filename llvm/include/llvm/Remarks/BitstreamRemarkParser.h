@@ -16,11 +16,13 @@
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Bitstream/BitstreamReader.h"
 #include "llvm/Support/Error.h"
 #include <array>
 #include <cstdint>
+#include <vector>
 
 namespace llvm {
 namespace remarks {
@@ -38,6 +40,10 @@ struct BitstreamMetaParserHelper {
   Optional<StringRef> StrTabBuf;
   Optional<StringRef> ExternalFilePath;
   Optional<uint64_t> RemarkVersion;
+  /// The entries of the optional remark index. Each entry contains the index
+  /// of a function name in the string table, followed by the offsets of the
+  /// remark blocks emitted for that function.
+  std::vector<SmallVector<uint64_t, 4>> RemarkIndexEntries;
 
   /// Continue parsing with \p Stream. \p Stream is expected to contain a
   /// ENTER_SUBBLOCK to the META_BLOCK at the current position.
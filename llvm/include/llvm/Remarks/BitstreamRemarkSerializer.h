@@ -14,6 +14,7 @@
 #ifndef LLVM_REMARKS_BITSTREAM_REMARK_SERIALIZER_H
 #define LLVM_REMARKS_BITSTREAM_REMARK_SERIALIZER_H
 
+#include "llvm/ADT/MapVector.h"
 #include "llvm/Bitstream/BitstreamWriter.h"
 #include "llvm/Remarks/BitstreamRemarkContainer.h"
 #include "llvm/Remarks/RemarkSerializer.h"
@@ -22,6 +23,13 @@
 namespace llvm {
 namespace remarks {
 
+/// The offsets of the remark blocks, in bytes relative to the first remark
+/// block, grouped by the index of the remark's function name in the string
+/// table. This is the in-memory version of the remark index emitted in the
+/// separate metadata, and allows tools to seek directly to the remarks of a
+/// given function instead of parsing the whole remark file.
+using BitstreamRemarkIndex = MapVector<uint64_t, SmallVector<uint64_t, 4>>;
+
 /// Serialize the remarks to LLVM bitstream.
 /// This class provides ways to emit remarks in the LLVM bitstream format and
 /// its associated metadata.
@@ -30,6 +38,7 @@ namespace remarks {
 ///   Separate meta:        | Container info
 ///                         | String table
 ///                         | External file
+///                         | Remark index
 ///
 ///   Separate remarks:     | Container info
 ///                         | Remark version
@@ -65,6 +74,7 @@ struct BitstreamRemarkSerializerHelper {
   uint64_t RecordMetaRemarkVersionAbbrevID = 0;
   uint64_t RecordMetaStrTabAbbrevID = 0;
   uint64_t RecordMetaExternalFileAbbrevID = 0;
+  uint64_t RecordMetaRemarkIndexAbbrevID = 0;
   uint64_t RecordRemarkHeaderAbbrevID = 0;
   uint64_t RecordRemarkDebugLocAbbrevID = 0;
   uint64_t RecordRemarkHotnessAbbrevID = 0;
@@ -98,6 +108,9 @@ struct BitstreamRemarkSerializerHelper {
   /// The external file in the metadata block.
   void setupMetaExternalFile();
   void emitMetaExternalFile(StringRef Filename);
+  /// The remark index in the metadata block.
+  void setupMetaRemarkIndex();
+  void emitMetaRemarkIndex(const BitstreamRemarkIndex &Index);
 
   /// The block info for the remarks block.
   void setupRemarkBlockInfo();
@@ -106,7 +119,8 @@ struct BitstreamRemarkSerializerHelper {
   void emitMetaBlock(uint64_t ContainerVersion,
                      Optional<uint64_t> RemarkVersion,
                      Optional<const StringTable *> StrTab = None,
-                     Optional<StringRef> Filename = None);
+                     Optional<StringRef> Filename = None,
+                     Optional<const BitstreamRemarkIndex *> Index = None);
 
   /// Emit a remark block. The string table is required.
   void emitRemarkBlock(const Remark &Remark, StringTable &StrTab);
@@ -131,6 +145,14 @@ struct BitstreamRemarkSerializer : public RemarkSerializer {
   bool DidSetUp = false;
   /// The helper to emit bitstream.
   BitstreamRemarkSerializerHelper Helper;
+  /// The offset in the stream of the first remark block. Used to compute the
+  /// relative offsets stored in the remark index.
+  uint64_t RemarksStartOffset = 0;
+  /// The offsets of the remark blocks emitted so far, grouped by the string
+  /// table index of the remark's function name. In separate mode, this is
+  /// emitted as a remark index in the metadata so that tools can seek directly
+  /// to the remarks of a given function.
+  BitstreamRemarkIndex FunctionIndex;
 
   /// Construct a serializer that will create its own string table.
   BitstreamRemarkSerializer(raw_ostream &OS, SerializerMode Mode);
@@ -167,14 +189,16 @@ struct BitstreamMetaSerializer : public MetaSerializer {
 
   Optional<const StringTable *> StrTab;
   Optional<StringRef> ExternalFilename;
+  Optional<const BitstreamRemarkIndex *> Index;
 
   /// Create a new meta serializer based on \p ContainerType.
   BitstreamMetaSerializer(raw_ostream &OS,
                           BitstreamRemarkContainerType ContainerType,
                           Optional<const StringTable *> StrTab = None,
-                          Optional<StringRef> ExternalFilename = None)
+                          Optional<StringRef> ExternalFilename = None,
+                          Optional<const BitstreamRemarkIndex *> Index = None)
       : MetaSerializer(OS), TmpHelper(None), Helper(nullptr), StrTab(StrTab),
-        ExternalFilename(ExternalFilename) {
+        ExternalFilename(ExternalFilename), Index(Index) {
     TmpHelper.emplace(ContainerType);
     Helper = &*TmpHelper;
   }
@@ -183,9 +207,10 @@ struct BitstreamMetaSerializer : public MetaSerializer {
   BitstreamMetaSerializer(raw_ostream &OS,
                           BitstreamRemarkSerializerHelper &Helper,
                           Optional<const StringTable *> StrTab = None,
-                          Optional<StringRef> ExternalFilename = None)
+                          Optional<StringRef> ExternalFilename = None,
+                          Optional<const BitstreamRemarkIndex *> Index = None)
       : MetaSerializer(OS), TmpHelper(None), Helper(&Helper), StrTab(StrTab),
-        ExternalFilename(ExternalFilename) {}
+        ExternalFilename(ExternalFilename), Index(Index) {}
 
   void emit() override;
 };
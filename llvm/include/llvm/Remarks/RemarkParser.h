@@ -13,6 +13,8 @@
 #ifndef LLVM_REMARKS_REMARK_PARSER_H
 #define LLVM_REMARKS_REMARK_PARSER_H
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Remarks/Remark.h"
@@ -51,6 +53,19 @@ struct RemarkParser {
   /// The pointer should never be null.
   virtual Expected<std::unique_ptr<Remark>> next() = 0;
 
+  /// If the format provides an index of the remarks, return the offsets of
+  /// all the remarks emitted for \p FunctionName. The offsets can be passed
+  /// to seekToRemark() to parse only the remarks of that function. Returns
+  /// None when no index is available, in which case the caller should fall
+  /// back to scanning the whole stream with next().
+  virtual Expected<Optional<ArrayRef<uint64_t>>>
+  getRemarkOffsetsFor(StringRef FunctionName);
+
+  /// Reposition the parser so that the following call to next() parses the
+  /// remark at \p Offset, as provided by getRemarkOffsetsFor(). Returns an
+  /// error for formats that do not support seeking.
+  virtual Error seekToRemark(uint64_t Offset);
+
   virtual ~RemarkParser() = default;
 };
 
@@ -32,6 +32,25 @@ bool isAvailable();
 Error compress(StringRef InputBuffer, SmallVectorImpl<char> &CompressedBuffer,
                int Level = DefaultCompression);
 
+/// Compress \p InputBuffer as one shard of a larger zlib stream. The output
+/// is a raw deflate stream with no zlib header or trailer, so the compressed
+/// shards of consecutive slices of a buffer, concatenated in order behind a
+/// zlib header and followed by the combined Adler-32 checksum of the slices,
+/// form a valid zlib stream. Exactly the final shard must be compressed with
+/// \p LastShard set.
+Error compressShard(StringRef InputBuffer,
+                    SmallVectorImpl<char> &CompressedBuffer,
+                    int Level = DefaultCompression, bool LastShard = true);
+
+/// Compute the Adler-32 checksum of \p Buffer, as used by the zlib format.
+uint32_t adler32(StringRef Buffer);
+
+/// Combine the Adler-32 checksums of two adjacent buffers, where \p Checksum2
+/// covers the trailing \p Length2 bytes, into the checksum of the
+/// concatenation.
+uint32_t adler32Combine(uint32_t Checksum1, uint32_t Checksum2,
+                        size_t Length2);
+
 Error uncompress(StringRef InputBuffer, char *UncompressedBuffer,
                  size_t &UncompressedSize);
 
@@ -0,0 +1,56 @@
+//===- ThreadBufferedOStream.h - Per-thread buffered stream -----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Defines a raw_ostream adaptor that lets several threads write complete
+// messages to a shared stream without interleaving.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_THREADBUFFEREDOSTREAM_H
+#define LLVM_SUPPORT_THREADBUFFEREDOSTREAM_H
+
+#include "llvm/Support/raw_ostream.h"
+#include <mutex>
+
+namespace llvm {
+
+/// Adapts a raw_ostream shared between several threads so that the threads'
+/// output does not interleave.
+///
+/// Each writer thread owns one thread_buffered_ostream over the shared stream,
+/// and all of them share the same mutex. Output accumulates in a per-thread
+/// buffer and is only forwarded to the shared stream by emitBuffer() (and on
+/// destruction), as a single write performed under the mutex. Everything a
+/// thread writes between two calls to emitBuffer() -- e.g. one complete
+/// diagnostic -- is therefore contiguous in the final output, and threads only
+/// contend on the mutex once per message instead of once per small write.
+class thread_buffered_ostream : public raw_svector_ostream {
+  raw_ostream &OS;
+
+  /// Synchronizes writes to the shared stream. One mutex is shared by all the
+  /// thread_buffered_ostream instances wrapping the same stream.
+  std::mutex &StreamLock;
+
+  SmallVector<char, 0> Buffer;
+
+  void anchor() override;
+
+public:
+  thread_buffered_ostream(raw_ostream &OS, std::mutex &StreamLock)
+      : raw_svector_ostream(Buffer), OS(OS), StreamLock(StreamLock) {}
+
+  ~thread_buffered_ostream() override { emitBuffer(); }
+
+  /// Forward the buffered output to the shared stream as a single write under
+  /// the lock, then clear the buffer.
+  void emitBuffer();
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_THREADBUFFEREDOSTREAM_H
@@ -23,6 +23,15 @@ TimeTraceProfiler *getTimeTraceProfilerInstance();
 void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
                                  StringRef ProcName);
 
+/// Request that time trace entries also record hardware performance
+/// counters (instructions retired and cache misses), so a regression can be
+/// attributed to extra work or to worse cache behavior. Must be called
+/// before \p timeTraceProfilerInitialize. The counters are read through
+/// perf_event on Linux; on other platforms, or when the events cannot be
+/// opened (e.g. a restrictive perf_event_paranoid setting), the request is
+/// ignored and the trace contains plain timings.
+void timeTraceProfilerEnableHardwareCounters();
+
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
 
@@ -18,6 +18,7 @@
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/ErrorOr.h"
@@ -28,6 +29,7 @@
 #include <cstdint>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <stack>
 #include <string>
 #include <system_error>
@@ -405,6 +407,37 @@ private:
   virtual void anchor();
 };
 
+/// A file system that caches the result of \c status() calls to the underlying
+/// file system.
+///
+/// Both successful and failed statuses are cached, keyed by the absolute form
+/// of the queried path. The cache is guarded by a mutex, so a single instance
+/// can be shared across threads and across independent consumers of the same
+/// tree, e.g. multiple compiler invocations statting the same headers.
+///
+/// The cache never expires entries on its own: if the underlying file system
+/// can change behind its back, the creator is responsible for calling
+/// \c invalidateEntry() or \c clearStatCache() at the appropriate points.
+class StatCacheFileSystem : public ProxyFileSystem {
+public:
+  explicit StatCacheFileSystem(IntrusiveRefCntPtr<FileSystem> FS)
+      : ProxyFileSystem(std::move(FS)) {}
+
+  llvm::ErrorOr<Status> status(const Twine &Path) override;
+
+  /// Drop the cached status for \p Path, if any.
+  void invalidateEntry(const Twine &Path);
+
+  /// Drop all cached statuses.
+  void clearStatCache();
+
+private:
+  /// Maps the absolute form of a queried path to the result of statting it in
+  /// the underlying file system.
+  llvm::StringMap<llvm::ErrorOr<Status>> StatCache;
+  std::mutex Mutex;
+};
+
 namespace detail {
 
 class InMemoryDirectory;
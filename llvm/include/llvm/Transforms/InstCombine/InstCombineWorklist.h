@@ -32,6 +32,16 @@ class InstCombineWorklist {
   /// in the order they have been added.
   SmallSetVector<Instruction *, 16> Deferred;
 
+  /// Monotonic counter bumped every time an instruction is known to have
+  /// been modified (operand rewritten, uses replaced, erased, ...).
+  uint64_t Generation = 0;
+  /// Generation at which each instruction was last modified. Instructions
+  /// that are absent have never been modified (stamp 0).
+  DenseMap<Instruction *, uint64_t> ModStamps;
+  /// Generation at which each instruction was last visited without any fold
+  /// applying. Used to skip revisits that provably see the same operands.
+  DenseMap<Instruction *, uint64_t> VisitSnapshots;
+
 public:
   InstCombineWorklist() = default;
 
@@ -72,6 +82,53 @@ public:
       push(I);
   }
 
+  /// Record that \p I has been modified. Any pending no-change visit
+  /// snapshot for \p I or for its users is invalidated by this.
+  void noteModified(Instruction *I) { ModStamps[I] = ++Generation; }
+
+  /// Record a modification of \p V if it is an instruction.
+  void noteModifiedValue(Value *V) {
+    if (Instruction *I = dyn_cast<Instruction>(V))
+      noteModified(I);
+  }
+
+  /// Return the current modification generation. Pass the result to
+  /// noteFailedVisit() to snapshot a visit that applied no fold.
+  uint64_t getGeneration() const { return Generation; }
+
+  /// Record that visiting \p I at generation \p Gen applied no fold.
+  void noteFailedVisit(Instruction *I, uint64_t Gen) {
+    VisitSnapshots[I] = Gen;
+  }
+
+  /// Return true if a visit of \p I is known to be futile: a previous visit
+  /// applied no fold, and neither \p I nor any of its operands has been
+  /// modified since.
+  bool shouldSkipRevisit(Instruction *I) const {
+    auto It = VisitSnapshots.find(I);
+    if (It == VisitSnapshots.end())
+      return false;
+    uint64_t Snapshot = It->second;
+    auto IsUnchanged = [&](Value *V) {
+      auto *OpI = dyn_cast<Instruction>(V);
+      if (!OpI)
+        return true;
+      auto StampIt = ModStamps.find(OpI);
+      return StampIt == ModStamps.end() || StampIt->second <= Snapshot;
+    };
+    if (!IsUnchanged(I))
+      return false;
+    return all_of(I->operands(), IsUnchanged);
+  }
+
+  /// Drop all bookkeeping for \p I. Must be called when \p I is erased so a
+  /// later instruction allocated at the same address starts with a clean
+  /// slate.
+  void forget(Instruction *I) {
+    ModStamps.erase(I);
+    VisitSnapshots.erase(I);
+  }
+
   Instruction *popDeferred() {
     if (Deferred.empty())
       return nullptr;
@@ -118,6 +175,12 @@ public:
 
     // Do an explicit clear, this shrinks the map if needed.
     WorklistMap.clear();
+
+    // The stamp tables are keyed by pointer and must not leak into the next
+    // function, where addresses may be reused.
+    ModStamps.clear();
+    VisitSnapshots.clear();
+    Generation = 0;
   }
 };
 
@@ -417,6 +417,9 @@ public:
     LLVM_DEBUG(dbgs() << "IC: Replacing " << I << "\n"
                       << "    with " << *V << '\n');
 
+    // The users now see V in place of I, and V's use list has grown.
+    Worklist.noteModified(&I);
+    Worklist.noteModifiedValue(V);
     I.replaceAllUsesWith(V);
     return &I;
   }
@@ -424,6 +427,9 @@ public:
   /// Replace operand of instruction and add old operand to the worklist.
   Instruction *replaceOperand(Instruction &I, unsigned OpNum, Value *V) {
     Worklist.addValue(I.getOperand(OpNum));
+    Worklist.noteModified(&I);
+    Worklist.noteModifiedValue(I.getOperand(OpNum));
+    Worklist.noteModifiedValue(V);
     I.setOperand(OpNum, V);
     return &I;
   }
@@ -431,6 +437,10 @@ public:
   /// Replace use and add the previously used value to the worklist.
   void replaceUse(Use &U, Value *NewValue) {
     Worklist.addValue(U);
+    Worklist.noteModifiedValue(U.get());
+    Worklist.noteModifiedValue(NewValue);
+    if (auto *UserI = dyn_cast<Instruction>(U.getUser()))
+      Worklist.noteModified(UserI);
     U = NewValue;
   }
 
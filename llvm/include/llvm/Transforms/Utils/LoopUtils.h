@@ -317,6 +317,19 @@ getLoopEstimatedTripCount(Loop *L,
 bool setLoopEstimatedTripCount(Loop *L, unsigned EstimatedTripCount,
                                unsigned EstimatedLoopInvocationWeight);
 
+/// Try to determine the exact trip count of \p L by pattern-matching the
+/// canonical induction recurrence controlling its latch exit, without
+/// querying ScalarEvolution. Only loops whose sole exiting block is the
+/// latch, governed by a compare of an induction variable with constant
+/// start, step and bound, are handled, and only small trip counts are
+/// computed. Returns None when the trip count is unknown or not small.
+///
+/// This is a fast path in front of
+/// ScalarEvolution::getSmallConstantTripCount for clients that only care
+/// about small constant trip counts; when it produces a value, it is the
+/// exact trip count measured at the latch.
+Optional<unsigned> getSmallConstantTripCountWithoutSCEV(Loop *L);
+
 /// Check inner loop (L) backedge count is known to be invariant on all
 /// iterations of its outer loop. If the loop has no parent, this is trivially
 /// true.
@@ -37,11 +37,14 @@
 
 using namespace llvm;
 
-static cl::opt<unsigned>
-    SaturationThreshold("alias-set-saturation-threshold", cl::Hidden,
-                        cl::init(250),
-                        cl::desc("The maximum number of pointers may-alias "
-                                 "sets may contain before degradation"));
+static cl::opt<unsigned> DefaultSaturationThreshold(
+    "alias-set-saturation-threshold", cl::Hidden, cl::init(250),
+    cl::desc("The maximum number of pointers may-alias "
+             "sets may contain before degradation"));
+
+unsigned AliasSetTracker::getSaturationThreshold() const {
+  return SaturationThresholdOverride.getValueOr(DefaultSaturationThreshold);
+}
 
 /// mergeSetIn - Merge the specified alias set into this alias set.
 ///
@@ -599,14 +602,14 @@ void AliasSetTracker::copyValue(Value *From, Value *To) {
 }
 
 AliasSet &AliasSetTracker::mergeAllAliasSets() {
-  assert(!AliasAnyAS && (TotalMayAliasSetSize > SaturationThreshold) &&
+  assert(!AliasAnyAS && (TotalMayAliasSetSize > getSaturationThreshold()) &&
          "Full merge should happen once, when the saturation threshold is "
          "reached");
 
   // Collect all alias sets, so that we can drop references with impunity
   // without worrying about iterator invalidation.
   std::vector<AliasSet *> ASVector;
-  ASVector.reserve(SaturationThreshold);
+  ASVector.reserve(getSaturationThreshold());
   for (iterator I = begin(), E = end(); I != E; I++)
     ASVector.push_back(&*I);
 
@@ -640,7 +643,7 @@ AliasSet &AliasSetTracker::addPointer(MemoryLocation Loc,
   AliasSet &AS = getAliasSetFor(Loc);
   AS.Access |= E;
 
-  if (!AliasAnyAS && (TotalMayAliasSetSize > SaturationThreshold)) {
+  if (!AliasAnyAS && (TotalMayAliasSetSize > getSaturationThreshold())) {
     // The AST is now saturated. From here on, we conservatively consider all
     // pointers to alias each-other.
     return mergeAllAliasSets();
@@ -15,6 +15,7 @@
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/ConstantFolding.h"
 #include "llvm/Analysis/InstructionSimplify.h"
@@ -174,6 +175,12 @@ namespace {
     /// Set of value handles used to erase values from the cache on deletion.
     DenseSet<LVIValueHandle, DenseMapInfo<Value *>> ValueHandles;
 
+    /// Map of values to the blocks holding cached information for them, so
+    /// that erasing a value only needs to inspect the affected block entries
+    /// instead of scanning the whole block cache. The sets may conservatively
+    /// contain blocks whose entries have since been dropped.
+    DenseMap<Value *, SmallPtrSet<BasicBlock *, 4>> ValueBlocks;
+
     const BlockCacheEntry *getBlockEntry(BasicBlock *BB) const {
       auto It = BlockCache.find_as(BB);
       if (It == BlockCache.end())
@@ -208,6 +215,7 @@ namespace {
       else
         Entry->LatticeElements.insert({ Val, Result });
 
+      ValueBlocks[Val].insert(BB);
       addValueHandle(Val);
     }
 
@@ -233,8 +241,10 @@ namespace {
       BlockCacheEntry *Entry = getOrCreateBlockEntry(BB);
       if (!Entry->NonNullPointers) {
         Entry->NonNullPointers = InitFn(BB);
-        for (Value *V : *Entry->NonNullPointers)
+        for (Value *V : *Entry->NonNullPointers) {
+          ValueBlocks[V].insert(BB);
           addValueHandle(V);
+        }
       }
 
       return Entry->NonNullPointers->count(V);
@@ -244,6 +254,7 @@ namespace {
     void clear() {
       BlockCache.clear();
       ValueHandles.clear();
+      ValueBlocks.clear();
     }
 
     /// Inform the cache that a given value has been deleted.
@@ -261,11 +272,18 @@ namespace {
 }
 
 void LazyValueInfoCache::eraseValue(Value *V) {
-  for (auto &Pair : BlockCache) {
-    Pair.second->LatticeElements.erase(V);
-    Pair.second->OverDefined.erase(V);
-    if (Pair.second->NonNullPointers)
-      Pair.second->NonNullPointers->erase(V);
+  auto BlocksIt = ValueBlocks.find(V);
+  if (BlocksIt != ValueBlocks.end()) {
+    for (BasicBlock *BB : BlocksIt->second) {
+      auto It = BlockCache.find_as(BB);
+      if (It == BlockCache.end())
+        continue;
+      It->second->LatticeElements.erase(V);
+      It->second->OverDefined.erase(V);
+      if (It->second->NonNullPointers)
+        It->second->NonNullPointers->erase(V);
+    }
+    ValueBlocks.erase(BlocksIt);
   }
 
   auto HandleIt = ValueHandles.find_as(V);
@@ -280,7 +298,29 @@ void LVIValueHandle::deleted() {
 }
 
 void LazyValueInfoCache::eraseBlock(BasicBlock *BB) {
-  BlockCache.erase(BB);
+  auto It = BlockCache.find_as(BB);
+  if (It == BlockCache.end())
+    return;
+
+  // Drop the block from the per-value index so the sets do not accumulate
+  // blocks that no longer have cache entries.
+  auto EraseFromIndex = [&](Value *V) {
+    auto BlocksIt = ValueBlocks.find(V);
+    if (BlocksIt == ValueBlocks.end())
+      return;
+    BlocksIt->second.erase(BB);
+    if (BlocksIt->second.empty())
+      ValueBlocks.erase(BlocksIt);
+  };
+  for (const auto &Pair : It->second->LatticeElements)
+    EraseFromIndex(Pair.first);
+  for (const auto &V : It->second->OverDefined)
+    EraseFromIndex(V);
+  if (It->second->NonNullPointers)
+    for (const auto &V : *It->second->NonNullPointers)
+      EraseFromIndex(V);
+
+  BlockCache.erase(It);
 }
 
 void LazyValueInfoCache::threadEdgeImpl(BasicBlock *OldSucc,
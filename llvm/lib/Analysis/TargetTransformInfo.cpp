@@ -581,29 +581,61 @@ int TargetTransformInfo::getIntImmCodeSizeCost(unsigned Opcode, unsigned Idx,
   return Cost;
 }
 
-int TargetTransformInfo::getIntImmCost(const APInt &Imm, Type *Ty,
-                                       TTI::TargetCostKind CostKind) const {
-  int Cost = TTIImpl->getIntImmCost(Imm, Ty, CostKind);
+// Pack the scalar arguments of an immediate cost query into the cache key
+// discriminator. Bits 62-63 identify the query kind so that the three entry
+// points can share one table.
+static uint64_t makeIntImmCostDiscriminator(uint64_t Kind, unsigned CostKind,
+                                            unsigned Idx, unsigned OpcOrIID) {
+  return (Kind << 62) | ((uint64_t)OpcOrIID << 24) | ((uint64_t)Idx << 8) |
+         CostKind;
+}
+
+int TargetTransformInfo::getCachedIntImmCost(uint64_t Discriminator,
+                                             const APInt &Imm, Type *Ty,
+                                             function_ref<int()> Compute) const {
+  IntImmCostKey Key(Discriminator, std::make_pair(Ty, Imm));
+  auto It = IntImmCostCache.find(Key);
+  if (It != IntImmCostCache.end())
+    return It->second;
+  int Cost = Compute();
   assert(Cost >= 0 && "TTI should not produce negative costs!");
+  IntImmCostCache.insert({std::move(Key), Cost});
   return Cost;
 }
 
+int TargetTransformInfo::getIntImmCost(const APInt &Imm, Type *Ty,
+                                       TTI::TargetCostKind CostKind) const {
+  return getCachedIntImmCost(
+      makeIntImmCostDiscriminator(0, CostKind, 0, 0), Imm, Ty,
+      [&] { return TTIImpl->getIntImmCost(Imm, Ty, CostKind); });
+}
+
 int TargetTransformInfo::getIntImmCostInst(unsigned Opcode, unsigned Idx,
                                            const APInt &Imm, Type *Ty,
                                            TTI::TargetCostKind CostKind,
                                            Instruction *Inst) const {
-  int Cost = TTIImpl->getIntImmCostInst(Opcode, Idx, Imm, Ty, CostKind, Inst);
-  assert(Cost >= 0 && "TTI should not produce negative costs!");
-  return Cost;
+  // When a use-site instruction is provided the result may depend on it (for
+  // example ARM recognizes saturation patterns), so only instruction-free
+  // queries are memoized.
+  if (Inst) {
+    int Cost =
+        TTIImpl->getIntImmCostInst(Opcode, Idx, Imm, Ty, CostKind, Inst);
+    assert(Cost >= 0 && "TTI should not produce negative costs!");
+    return Cost;
+  }
+  return getCachedIntImmCost(
+      makeIntImmCostDiscriminator(1, CostKind, Idx, Opcode), Imm, Ty, [&] {
+        return TTIImpl->getIntImmCostInst(Opcode, Idx, Imm, Ty, CostKind);
+      });
 }
 
 int
 TargetTransformInfo::getIntImmCostIntrin(Intrinsic::ID IID, unsigned Idx,
                                          const APInt &Imm, Type *Ty,
                                          TTI::TargetCostKind CostKind) const {
-  int Cost = TTIImpl->getIntImmCostIntrin(IID, Idx, Imm, Ty, CostKind);
-  assert(Cost >= 0 && "TTI should not produce negative costs!");
-  return Cost;
+  return getCachedIntImmCost(
+      makeIntImmCostDiscriminator(2, CostKind, Idx, IID), Imm, Ty,
+      [&] { return TTIImpl->getIntImmCostIntrin(IID, Idx, Imm, Ty, CostKind); });
 }
 
 unsigned TargetTransformInfo::getNumberOfRegisters(unsigned ClassID) const {
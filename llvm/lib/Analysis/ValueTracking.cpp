@@ -15,6 +15,7 @@
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/APInt.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
@@ -120,6 +121,17 @@ struct Query {
   /// If true, it is safe to use metadata during simplification.
   InstrInfoQuery IIQ;
 
+  /// Memoized known-bits results for the current top-level query, keyed by
+  /// value. Each entry records the recursion depth at which it was computed;
+  /// an entry may only be reused at equal or greater depth, so a hit is never
+  /// weaker than what recomputing with the remaining budget would produce.
+  /// The map is owned by the top-level entry point and shared by the copies
+  /// of this query made while excluding assumes; it is null for callers that
+  /// do not set one up.
+  using KnownBitsCacheTy =
+      SmallDenseMap<const Value *, std::pair<KnownBits, unsigned>, 16>;
+  KnownBitsCacheTy *KnownBitsCache = nullptr;
+
   unsigned NumExcluded = 0;
 
   Query(const DataLayout &DL, AssumptionCache *AC, const Instruction *CxtI,
@@ -129,7 +141,7 @@ struct Query {
 
   Query(const Query &Q, const Value *NewExcl)
       : DL(Q.DL), AC(Q.AC), CxtI(Q.CxtI), DT(Q.DT), ORE(Q.ORE), IIQ(Q.IIQ),
-        NumExcluded(Q.NumExcluded) {
+        KnownBitsCache(Q.KnownBitsCache), NumExcluded(Q.NumExcluded) {
     Excluded = Q.Excluded;
     Excluded[NumExcluded++] = NewExcl;
     assert(NumExcluded <= Excluded.size());
@@ -222,8 +234,10 @@ void llvm::computeKnownBits(const Value *V, KnownBits &Known,
                             AssumptionCache *AC, const Instruction *CxtI,
                             const DominatorTree *DT,
                             OptimizationRemarkEmitter *ORE, bool UseInstrInfo) {
-  ::computeKnownBits(V, Known, Depth,
-                     Query(DL, AC, safeCxtI(V, CxtI), DT, UseInstrInfo, ORE));
+  Query Q(DL, AC, safeCxtI(V, CxtI), DT, UseInstrInfo, ORE);
+  Query::KnownBitsCacheTy Cache;
+  Q.KnownBitsCache = &Cache;
+  ::computeKnownBits(V, Known, Depth, Q);
 }
 
 void llvm::computeKnownBits(const Value *V, const APInt &DemandedElts,
@@ -231,8 +245,10 @@ void llvm::computeKnownBits(const Value *V, const APInt &DemandedElts,
                             unsigned Depth, AssumptionCache *AC,
                             const Instruction *CxtI, const DominatorTree *DT,
                             OptimizationRemarkEmitter *ORE, bool UseInstrInfo) {
-  ::computeKnownBits(V, DemandedElts, Known, Depth,
-                     Query(DL, AC, safeCxtI(V, CxtI), DT, UseInstrInfo, ORE));
+  Query Q(DL, AC, safeCxtI(V, CxtI), DT, UseInstrInfo, ORE);
+  Query::KnownBitsCacheTy Cache;
+  Q.KnownBitsCache = &Cache;
+  ::computeKnownBits(V, DemandedElts, Known, Depth, Q);
 }
 
 static KnownBits computeKnownBits(const Value *V, const APInt &DemandedElts,
@@ -247,8 +263,10 @@ KnownBits llvm::computeKnownBits(const Value *V, const DataLayout &DL,
                                  const DominatorTree *DT,
                                  OptimizationRemarkEmitter *ORE,
                                  bool UseInstrInfo) {
-  return ::computeKnownBits(
-      V, Depth, Query(DL, AC, safeCxtI(V, CxtI), DT, UseInstrInfo, ORE));
+  Query Q(DL, AC, safeCxtI(V, CxtI), DT, UseInstrInfo, ORE);
+  Query::KnownBitsCacheTy Cache;
+  Q.KnownBitsCache = &Cache;
+  return ::computeKnownBits(V, Depth, Q);
 }
 
 KnownBits llvm::computeKnownBits(const Value *V, const APInt &DemandedElts,
@@ -257,9 +275,10 @@ KnownBits llvm::computeKnownBits(const Value *V, const APInt &DemandedElts,
                                  const DominatorTree *DT,
                                  OptimizationRemarkEmitter *ORE,
                                  bool UseInstrInfo) {
-  return ::computeKnownBits(
-      V, DemandedElts, Depth,
-      Query(DL, AC, safeCxtI(V, CxtI), DT, UseInstrInfo, ORE));
+  Query Q(DL, AC, safeCxtI(V, CxtI), DT, UseInstrInfo, ORE);
+  Query::KnownBitsCacheTy Cache;
+  Q.KnownBitsCache = &Cache;
+  return ::computeKnownBits(V, DemandedElts, Depth, Q);
 }
 
 bool llvm::haveNoCommonBitsSet(const Value *LHS, const Value *RHS,
@@ -1884,6 +1903,23 @@ void computeKnownBits(const Value *V, const APInt &DemandedElts,
   // assumptions.  Confirm that we've handled them all.
   assert(!isa<ConstantData>(V) && "Unhandled constant data!");
 
+  // Reuse a memoized result for this value if the top-level caller installed
+  // a cache. Only scalar queries are cached (vector queries would also have
+  // to key on DemandedElts), and only when no assumes are excluded, as
+  // results computed under exclusion may be weaker than an unrestricted
+  // query. An entry computed at depth D is valid for any query at depth
+  // >= D because a smaller remaining budget can only produce a subset of
+  // the known bits.
+  const bool UseKnownBitsCache =
+      Q.KnownBitsCache && Q.NumExcluded == 0 && !V->getType()->isVectorTy();
+  if (UseKnownBitsCache) {
+    auto It = Q.KnownBitsCache->find(V);
+    if (It != Q.KnownBitsCache->end() && It->second.second <= Depth) {
+      Known = It->second.first;
+      return;
+    }
+  }
+
   // All recursive calls that increase depth must come after this.
   if (Depth == MaxAnalysisRecursionDepth)
     return;
@@ -1911,6 +1947,11 @@ void computeKnownBits(const Value *V, const APInt &DemandedElts,
   // Check whether a nearby assume intrinsic can determine some known bits.
   computeKnownBitsFromAssume(V, Known, Depth, Q);
 
+  // Remember the result, overwriting any entry computed at a greater depth
+  // with this (at least as strong) one.
+  if (UseKnownBitsCache)
+    (*Q.KnownBitsCache)[V] = std::make_pair(Known, Depth);
+
   assert((Known.Zero & Known.One) == 0 && "Bits known to be one AND zero?");
 }
 
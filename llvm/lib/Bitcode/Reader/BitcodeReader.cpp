@@ -809,10 +809,15 @@ class ModuleSummaryIndexBitcodeReader : public BitcodeReaderBase {
   /// this module by the client.
   unsigned ModuleId;
 
+  /// If non-null, only materialize summaries for these GUIDs; records for
+  /// other GUIDs are decoded but no summary objects are built for them.
+  const DenseSet<GlobalValue::GUID> *GUIDFilter;
+
 public:
-  ModuleSummaryIndexBitcodeReader(BitstreamCursor Stream, StringRef Strtab,
-                                  ModuleSummaryIndex &TheIndex,
-                                  StringRef ModulePath, unsigned ModuleId);
+  ModuleSummaryIndexBitcodeReader(
+      BitstreamCursor Stream, StringRef Strtab, ModuleSummaryIndex &TheIndex,
+      StringRef ModulePath, unsigned ModuleId,
+      const DenseSet<GlobalValue::GUID> *GUIDFilter = nullptr);
 
   Error parseModule();
 
@@ -5432,24 +5437,32 @@ Error BitcodeReader::materialize(GlobalValue *GV) {
   if (StripDebugInfo)
     stripDebugInfo(*F);
 
-  // Upgrade any old intrinsic calls in the function.
-  for (auto &I : UpgradedIntrinsics) {
-    for (auto UI = I.first->materialized_user_begin(), UE = I.first->user_end();
-         UI != UE;) {
-      User *U = *UI;
-      ++UI;
-      if (CallInst *CI = dyn_cast<CallInst>(U))
-        UpgradeIntrinsicCall(CI, I.second);
+  // Upgrade any old intrinsic calls and update calls to remangled intrinsics
+  // in the function. This used to scan the users of every upgraded intrinsic
+  // across the whole module for each materialized function, which made lazy
+  // materialization of N functions quadratic whenever upgrades were needed;
+  // scanning the just-parsed body keeps the cost local to this function. Any
+  // stragglers are caught by the module-level pass in materializeModule().
+  if (!UpgradedIntrinsics.empty() || !RemangledIntrinsics.empty()) {
+    for (Instruction &I : make_early_inc_range(instructions(F))) {
+      auto *CB = dyn_cast<CallBase>(&I);
+      if (!CB)
+        continue;
+      Function *Callee = CB->getCalledFunction();
+      if (!Callee)
+        continue;
+      auto UI = UpgradedIntrinsics.find(Callee);
+      if (UI != UpgradedIntrinsics.end()) {
+        if (CallInst *CI = dyn_cast<CallInst>(CB))
+          UpgradeIntrinsicCall(CI, UI->second);
+        continue;
+      }
+      auto RI = RemangledIntrinsics.find(Callee);
+      if (RI != RemangledIntrinsics.end())
+        CB->setCalledFunction(RI->second);
     }
   }
 
-  // Update calls to the remangled intrinsics
-  for (auto &I : RemangledIntrinsics)
-    for (auto UI = I.first->materialized_user_begin(), UE = I.first->user_end();
-         UI != UE;)
-      // Don't expect any other users than call sites
-      cast<CallBase>(*UI++)->setCalledFunction(I.second);
-
   // Finish fn->subprogram upgrade for materialized functions.
   if (DISubprogram *SP = MDLoader->lookupSubprogramForFunction(F))
     F->setSubprogram(SP);
@@ -5566,9 +5579,10 @@ std::vector<StructType *> BitcodeReader::getIdentifiedStructTypes() const {
 
 ModuleSummaryIndexBitcodeReader::ModuleSummaryIndexBitcodeReader(
     BitstreamCursor Cursor, StringRef Strtab, ModuleSummaryIndex &TheIndex,
-    StringRef ModulePath, unsigned ModuleId)
+    StringRef ModulePath, unsigned ModuleId,
+    const DenseSet<GlobalValue::GUID> *GUIDFilter)
     : BitcodeReaderBase(std::move(Cursor), Strtab), TheIndex(TheIndex),
-      ModulePath(ModulePath), ModuleId(ModuleId) {}
+      ModulePath(ModulePath), ModuleId(ModuleId), GUIDFilter(GUIDFilter) {}
 
 void ModuleSummaryIndexBitcodeReader::addThisModule() {
   TheIndex.addModule(ModulePath, ModuleId);
@@ -6040,6 +6054,32 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
       PendingTypeCheckedLoadConstVCalls;
   std::vector<FunctionSummary::ParamAccess> PendingParamAccesses;
 
+  // Whether the last summary record was dropped by the GUID filter, so that
+  // a trailing FS_COMBINED_ORIGINAL_NAME can be dropped with it.
+  bool SkippedLastSummary = false;
+
+  // When a GUID filter is installed, decide whether the summary record for
+  // \p ValueID should be dropped. Pending per-function metadata collected for
+  // a dropped summary is discarded along with it. Callers are responsible for
+  // including aliasee GUIDs when requesting an alias from a per-module index.
+  auto ShouldSkipSummary = [&](unsigned ValueID) {
+    if (!GUIDFilter ||
+        GUIDFilter->count(getValueInfoFromValueId(ValueID).first.getGUID())) {
+      SkippedLastSummary = false;
+      return false;
+    }
+    PendingTypeTests.clear();
+    PendingTypeTestAssumeVCalls.clear();
+    PendingTypeCheckedLoadVCalls.clear();
+    PendingTypeTestAssumeConstVCalls.clear();
+    PendingTypeCheckedLoadConstVCalls.clear();
+    PendingParamAccesses.clear();
+    LastSeenSummary = nullptr;
+    LastSeenGUID = 0;
+    SkippedLastSummary = true;
+    return true;
+  };
+
   while (true) {
     Expected<BitstreamEntry> MaybeEntry = Stream.advanceSkippingSubblocks();
     if (!MaybeEntry)
@@ -6093,6 +6133,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     case bitc::FS_PERMODULE:
     case bitc::FS_PERMODULE_RELBF:
     case bitc::FS_PERMODULE_PROFILE: {
+      if (ShouldSkipSummary(Record[0]))
+        break;
       unsigned ValueID = Record[0];
       uint64_t RawFlags = Record[1];
       unsigned InstCount = Record[2];
@@ -6149,6 +6191,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     // Aliases must be emitted (and parsed) after all FS_PERMODULE entries, as
     // they expect all aliasee summaries to be available.
     case bitc::FS_ALIAS: {
+      if (ShouldSkipSummary(Record[0]))
+        break;
       unsigned ValueID = Record[0];
       uint64_t RawFlags = Record[1];
       unsigned AliaseeID = Record[2];
@@ -6174,6 +6218,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     }
     // FS_PERMODULE_GLOBALVAR_INIT_REFS: [valueid, flags, varflags, n x valueid]
     case bitc::FS_PERMODULE_GLOBALVAR_INIT_REFS: {
+      if (ShouldSkipSummary(Record[0]))
+        break;
       unsigned ValueID = Record[0];
       uint64_t RawFlags = Record[1];
       unsigned RefArrayStart = 2;
@@ -6200,6 +6246,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     //                        numrefs, numrefs x valueid,
     //                        n x (valueid, offset)]
     case bitc::FS_PERMODULE_VTABLE_GLOBALVAR_INIT_REFS: {
+      if (ShouldSkipSummary(Record[0]))
+        break;
       unsigned ValueID = Record[0];
       uint64_t RawFlags = Record[1];
       GlobalVarSummary::GVarFlags GVF = getDecodedGVarFlags(Record[2]);
@@ -6230,6 +6278,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     //                       numrefs x valueid, n x (valueid, hotness)]
     case bitc::FS_COMBINED:
     case bitc::FS_COMBINED_PROFILE: {
+      if (ShouldSkipSummary(Record[0]))
+        break;
       unsigned ValueID = Record[0];
       uint64_t ModuleId = Record[1];
       uint64_t RawFlags = Record[2];
@@ -6292,6 +6342,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     // Aliases must be emitted (and parsed) after all FS_COMBINED entries, as
     // they expect all aliasee summaries to be available.
     case bitc::FS_COMBINED_ALIAS: {
+      if (ShouldSkipSummary(Record[0]))
+        break;
       unsigned ValueID = Record[0];
       uint64_t ModuleId = Record[1];
       uint64_t RawFlags = Record[2];
@@ -6312,6 +6364,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     }
     // FS_COMBINED_GLOBALVAR_INIT_REFS: [valueid, modid, flags, n x valueid]
     case bitc::FS_COMBINED_GLOBALVAR_INIT_REFS: {
+      if (ShouldSkipSummary(Record[0]))
+        break;
       unsigned ValueID = Record[0];
       uint64_t ModuleId = Record[1];
       uint64_t RawFlags = Record[2];
@@ -6338,6 +6392,8 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     }
     // FS_COMBINED_ORIGINAL_NAME: [original_name]
     case bitc::FS_COMBINED_ORIGINAL_NAME: {
+      if (SkippedLastSummary)
+        break;
       uint64_t OriginalName = Record[0];
       if (!LastSeenSummary)
         return error("Name attachment that does not follow a combined record");
@@ -6732,14 +6788,15 @@ BitcodeModule::getLazyModule(LLVMContext &Context, bool ShouldLazyLoadMetadata,
 // We don't use ModuleIdentifier here because the client may need to control the
 // module path used in the combined summary (e.g. when reading summaries for
 // regular LTO modules).
-Error BitcodeModule::readSummary(ModuleSummaryIndex &CombinedIndex,
-                                 StringRef ModulePath, uint64_t ModuleId) {
+Error BitcodeModule::readSummary(
+    ModuleSummaryIndex &CombinedIndex, StringRef ModulePath, uint64_t ModuleId,
+    const DenseSet<GlobalValue::GUID> *GUIDFilter) {
   BitstreamCursor Stream(Buffer);
   if (Error JumpFailed = Stream.JumpToBit(ModuleBit))
     return JumpFailed;
 
   ModuleSummaryIndexBitcodeReader R(std::move(Stream), Strtab, CombinedIndex,
-                                    ModulePath, ModuleId);
+                                    ModulePath, ModuleId, GUIDFilter);
   return R.parseModule();
 }
 
@@ -6932,14 +6989,15 @@ Expected<std::string> llvm::getBitcodeProducerString(MemoryBufferRef Buffer) {
   return readIdentificationCode(*StreamOrErr);
 }
 
-Error llvm::readModuleSummaryIndex(MemoryBufferRef Buffer,
-                                   ModuleSummaryIndex &CombinedIndex,
-                                   uint64_t ModuleId) {
+Error llvm::readModuleSummaryIndex(
+    MemoryBufferRef Buffer, ModuleSummaryIndex &CombinedIndex,
+    uint64_t ModuleId, const DenseSet<GlobalValue::GUID> *GUIDFilter) {
   Expected<BitcodeModule> BM = getSingleModule(Buffer);
   if (!BM)
     return BM.takeError();
 
-  return BM->readSummary(CombinedIndex, BM->getModuleIdentifier(), ModuleId);
+  return BM->readSummary(CombinedIndex, BM->getModuleIdentifier(), ModuleId,
+                         GUIDFilter);
 }
 
 Expected<std::unique_ptr<ModuleSummaryIndex>>
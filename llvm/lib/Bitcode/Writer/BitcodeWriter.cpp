@@ -4627,11 +4627,15 @@ void llvm::WriteIndexToFile(
   SmallVector<char, 0> Buffer;
   Buffer.reserve(256 * 1024);
 
-  BitcodeWriter Writer(Buffer);
+  // If the output stream is a raw_fd_stream, write directly to it, flushing
+  // completed blocks as they are produced instead of buffering the whole
+  // index; combined indexes for large ThinLTO links can be very large.
+  BitcodeWriter Writer(Buffer, dyn_cast<raw_fd_stream>(&Out));
   Writer.writeIndex(&Index, ModuleToSummariesForIndex);
   Writer.writeStrtab();
 
-  Out.write((char *)&Buffer.front(), Buffer.size());
+  if (!Buffer.empty())
+    Out.write((char *)&Buffer.front(), Buffer.size());
 }
 
 namespace {
@@ -1154,6 +1154,14 @@ void AsmPrinter::emitFunctionBody() {
   bool HasAnyRealCode = false;
   int NumInstsInFunction = 0;
 
+  // Only notify handlers that want per-instruction callbacks; this keeps the
+  // no-op callbacks of the remaining handlers (and the timers around them)
+  // out of the instruction emission loop.
+  SmallVector<const HandlerInfo *, 4> InstructionHandlers;
+  for (const HandlerInfo &HI : Handlers)
+    if (HI.Handler->needsInstructionCallbacks())
+      InstructionHandlers.push_back(&HI);
+
   bool CanDoExtraAnalysis = ORE->allowExtraAnalysis(DEBUG_TYPE);
   for (auto &MBB : *MF) {
     // Print a label for the basic block.
@@ -1171,10 +1179,11 @@ void AsmPrinter::emitFunctionBody() {
       if (MCSymbol *S = MI.getPreInstrSymbol())
         OutStreamer->emitLabel(S);
 
-      for (const HandlerInfo &HI : Handlers) {
-        NamedRegionTimer T(HI.TimerName, HI.TimerDescription, HI.TimerGroupName,
-                           HI.TimerGroupDescription, TimePassesIsEnabled);
-        HI.Handler->beginInstruction(&MI);
+      for (const HandlerInfo *HI : InstructionHandlers) {
+        NamedRegionTimer T(HI->TimerName, HI->TimerDescription,
+                           HI->TimerGroupName, HI->TimerGroupDescription,
+                           TimePassesIsEnabled);
+        HI->Handler->beginInstruction(&MI);
       }
 
       if (isVerbose())
@@ -1235,10 +1244,11 @@ void AsmPrinter::emitFunctionBody() {
       if (MCSymbol *S = MI.getPostInstrSymbol())
         OutStreamer->emitLabel(S);
 
-      for (const HandlerInfo &HI : Handlers) {
-        NamedRegionTimer T(HI.TimerName, HI.TimerDescription, HI.TimerGroupName,
-                           HI.TimerGroupDescription, TimePassesIsEnabled);
-        HI.Handler->endInstruction();
+      for (const HandlerInfo *HI : InstructionHandlers) {
+        NamedRegionTimer T(HI->TimerName, HI->TimerDescription,
+                           HI->TimerGroupName, HI->TimerGroupDescription,
+                           TimePassesIsEnabled);
+        HI->Handler->endInstruction();
       }
     }
 
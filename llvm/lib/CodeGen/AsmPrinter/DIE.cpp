@@ -167,6 +167,34 @@ DIEAbbrev &DIEAbbrevSet::uniqueAbbreviation(DIE &Die) {
   return *New;
 }
 
+unsigned DIEAbbrevSet::uniqueAbbreviation(const DIEAbbrev &Abbrev) {
+  FoldingSetNodeID ID;
+  Abbrev.Profile(ID);
+
+  void *InsertPos;
+  if (DIEAbbrev *Existing =
+          AbbreviationsSet.FindNodeOrInsertPos(ID, InsertPos))
+    return Existing->getNumber();
+
+  // Copy the abbreviation to the heap and assign a number. The copy is built
+  // attribute by attribute rather than with the copy constructor so that the
+  // new node does not inherit the folding-set bucket link of the original.
+  DIEAbbrev *New = new (Alloc) DIEAbbrev(Abbrev.getTag(), Abbrev.hasChildren());
+  for (const DIEAbbrevData &AttrData : Abbrev.getData()) {
+    if (AttrData.getForm() == dwarf::DW_FORM_implicit_const)
+      New->AddImplicitConstAttribute(AttrData.getAttribute(),
+                                     AttrData.getValue());
+    else
+      New->AddAttribute(AttrData.getAttribute(), AttrData.getForm());
+  }
+  Abbreviations.push_back(New);
+  New->setNumber(Abbreviations.size());
+
+  // Store it for lookup.
+  AbbreviationsSet.InsertNode(New, InsertPos);
+  return New->getNumber();
+}
+
 void DIEAbbrevSet::Emit(const AsmPrinter *AP, MCSection *Section) const {
   if (!Abbreviations.empty()) {
     // Start the debug abbrev section.
@@ -310,6 +338,48 @@ unsigned DIE::computeOffsetsAndAbbrevs(const AsmPrinter *AP,
   return CUOffset;
 }
 
+void DIE::assignAbbrevs(DIEAbbrevSet &AbbrevSet) {
+  AbbrevSet.uniqueAbbreviation(*this);
+  for (auto &Child : children())
+    Child.assignAbbrevs(AbbrevSet);
+}
+
+unsigned
+DIE::remapAbbrevsAndComputeOffsets(const AsmPrinter *AP,
+                                   const std::vector<unsigned> &AbbrevRemap,
+                                   unsigned CUOffset) {
+  // Rewrite the per-unit abbreviation number assigned by assignAbbrevs() to
+  // the final number in the shared abbreviation set.
+  assert(getAbbrevNumber() != 0 && getAbbrevNumber() <= AbbrevRemap.size() &&
+         "DIE has no per-unit abbreviation number");
+  setAbbrevNumber(AbbrevRemap[getAbbrevNumber() - 1]);
+
+  // Set compile/type unit relative offset of this DIE.
+  setOffset(CUOffset);
+
+  // Add the byte size of the abbreviation code.
+  CUOffset += getULEB128Size(getAbbrevNumber());
+
+  // Add the byte size of all the DIE attribute values.
+  for (const auto &V : values())
+    CUOffset += V.SizeOf(AP);
+
+  // Let the children remap their abbreviations and compute their offsets.
+  if (hasChildren()) {
+    for (auto &Child : children())
+      CUOffset = Child.remapAbbrevsAndComputeOffsets(AP, AbbrevRemap, CUOffset);
+
+    // Each child chain is terminated with a zero byte, adjust the offset.
+    CUOffset += sizeof(int8_t);
+  }
+
+  // Compute the byte size of this DIE and all of its children correctly. This
+  // is needed so that top level DIE can help the compile unit set its length
+  // correctly.
+  setSize(CUOffset - getOffset());
+  return CUOffset;
+}
+
 //===----------------------------------------------------------------------===//
 // DIEUnit Implementation
 //===----------------------------------------------------------------------===//
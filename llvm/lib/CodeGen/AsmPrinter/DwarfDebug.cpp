@@ -3218,6 +3218,15 @@ void DwarfDebug::addDwarfTypeUnitType(DwarfCompileUnit &CU,
   if (!TypeUnitsUnderConstruction.empty() && AddrPool.hasBeenUsed())
     return;
 
+  // If this type already failed type unit construction because it references
+  // an address pool entry, trying again would rebuild the whole dependent
+  // type unit batch only to throw it away once more. Construct it in the CU
+  // directly.
+  if (AddrPoolDependentTypes.count(CTy)) {
+    CU.constructTypeDIE(RefDie, cast<DICompositeType>(CTy));
+    return;
+  }
+
   auto Ins = TypeSignatures.insert(std::make_pair(CTy, 0));
   if (!Ins.second) {
     CU.addDIETypeSignature(RefDie, Ins.first->second);
@@ -3277,6 +3286,12 @@ void DwarfDebug::addDwarfTypeUnitType(DwarfCompileUnit &CU,
       for (const auto &TU : TypeUnitsToAdd)
         TypeSignatures.erase(TU.second);
 
+      // Remember the top-level type so later references skip straight to CU
+      // construction. The other types in the batch are not recorded: they
+      // may not themselves depend on an address and can still end up in type
+      // units when requested on their own.
+      AddrPoolDependentTypes.insert(CTy);
+
       // Construct this type in the CU directly.
       // This is inefficient because all the dependent types will be rebuilt
       // from scratch, including building them in type units, discovering that
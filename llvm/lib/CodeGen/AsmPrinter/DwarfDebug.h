@@ -341,6 +341,12 @@ class DwarfDebug : public DebugHandlerBase {
   /// used to keep track of which types we have emitted type units for.
   DenseMap<const MDNode *, uint64_t> TypeSignatures;
 
+  /// Types that were found to reference the address pool while being built as
+  /// type units. Building such a type as a type unit fails in the same way
+  /// every time, so once that happens the type is constructed directly in the
+  /// referencing CU without redoing the speculative type unit work.
+  DenseSet<const MDNode *> AddrPoolDependentTypes;
+
   DenseMap<const MCSection *, const MCSymbol *> SectionLabels;
 
   SmallVector<
@@ -14,6 +14,7 @@
 #include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/Metadata.h"
 #include "llvm/MC/MCStreamer.h"
+#include "llvm/Support/Parallel.h"
 #include <algorithm>
 #include <cstdint>
 
@@ -57,24 +58,83 @@ void DwarfFile::emitUnit(DwarfUnit *TheU, bool UseOffsets) {
 
 // Compute the size and offset for each DIE.
 void DwarfFile::computeSizeAndOffsets() {
-  // Offset from the first CU in the debug info section is 0 initially.
-  uint64_t SecOffset = 0;
-
-  // Iterate over each compile unit and set the size and offsets for each
-  // DIE within each compile unit. All offsets are CU relative.
+  // Gather the units that will be emitted, stopping at the first CU that
+  // ended up not being needed (split CUs that were abandoned because they
+  // added no information beyond the non-split CU; they are always trailing).
+  SmallVector<DwarfUnit *, 4> Units;
+  bool StoppedEarly = false;
   for (const auto &TheU : CUs) {
     if (TheU->getCUNode()->isDebugDirectivesOnly())
       continue;
+    if (llvm::empty(TheU->getUnitDie().values())) {
+      StoppedEarly = true;
+      break;
+    }
+    Units.push_back(TheU.get());
+  }
 
-    // Skip CUs that ended up not being needed (split CUs that were abandoned
-    // because they added no information beyond the non-split CU)
-    if (llvm::empty(TheU->getUnitDie().values()))
-      return;
+  // With several units, lay them out with a deterministic three-phase scheme:
+  // assign per-unit abbreviation numbers in parallel, merge the per-unit
+  // abbreviation sets serially, then renumber and compute sizes and offsets
+  // in parallel. Keep the plain serial walk for the common single-unit case.
+  if (Units.size() > 1) {
+    // Phase 1: unique each unit's abbreviations into a set of its own. Only
+    // the unit's DIE tree and the local set are touched, so units are
+    // independent of each other.
+    struct UnitAbbrevs {
+      BumpPtrAllocator Alloc;
+      DIEAbbrevSet Set;
+      UnitAbbrevs() : Set(Alloc) {}
+    };
+    std::vector<std::unique_ptr<UnitAbbrevs>> LocalAbbrevs(Units.size());
+    parallelForEachN(0, Units.size(), [&](size_t I) {
+      LocalAbbrevs[I] = std::make_unique<UnitAbbrevs>();
+      Units[I]->getUnitDie().assignAbbrevs(LocalAbbrevs[I]->Set);
+    });
+
+    // Phase 2: merge the per-unit sets into the shared set in unit order.
+    // Within a unit the local numbers follow first use, so visiting them in
+    // order reproduces exactly the global first-use numbering the serial
+    // walk would have produced, and the output is byte-identical to it.
+    std::vector<std::vector<unsigned>> AbbrevRemaps(Units.size());
+    for (size_t I = 0, E = Units.size(); I != E; ++I)
+      for (const DIEAbbrev *A : LocalAbbrevs[I]->Set.getAbbreviations())
+        AbbrevRemaps[I].push_back(Abbrevs.uniqueAbbreviation(*A));
+
+    // Phase 3: rewrite each unit's abbreviation numbers to their final
+    // values and compute sizes and offsets. All offsets are CU relative;
+    // sizes depend on the final (ULEB128-encoded) abbreviation numbers,
+    // which is why they cannot be computed in phase 1.
+    std::vector<unsigned> UnitSizes(Units.size());
+    parallelForEachN(0, Units.size(), [&](size_t I) {
+      unsigned Offset = Asm->getUnitLengthFieldByteSize() +
+                        Units[I]->getHeaderSize();
+      UnitSizes[I] = Units[I]->getUnitDie().remapAbbrevsAndComputeOffsets(
+          Asm, AbbrevRemaps[I], Offset);
+    });
+
+    // Offset from the first CU in the debug info section is 0 initially.
+    uint64_t SecOffset = 0;
+    for (size_t I = 0, E = Units.size(); I != E; ++I) {
+      Units[I]->setDebugSectionOffset(SecOffset);
+      SecOffset += UnitSizes[I];
+    }
+    if (!StoppedEarly && SecOffset > UINT32_MAX && !Asm->isDwarf64())
+      report_fatal_error("The generated debug information is too large "
+                         "for the 32-bit DWARF format.");
+    return;
+  }
 
+  // Offset from the first CU in the debug info section is 0 initially.
+  uint64_t SecOffset = 0;
+
+  // Iterate over each compile unit and set the size and offsets for each
+  // DIE within each compile unit. All offsets are CU relative.
+  for (DwarfUnit *TheU : Units) {
     TheU->setDebugSectionOffset(SecOffset);
-    SecOffset += computeSizeAndOffsetsForUnit(TheU.get());
+    SecOffset += computeSizeAndOffsetsForUnit(TheU);
   }
-  if (SecOffset > UINT32_MAX && !Asm->isDwarf64())
+  if (!StoppedEarly && SecOffset > UINT32_MAX && !Asm->isDwarf64())
     report_fatal_error("The generated debug information is too large "
                        "for the 32-bit DWARF format.");
 }
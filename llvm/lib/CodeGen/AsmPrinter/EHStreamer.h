@@ -152,6 +152,7 @@ public:
 
   // Unused.
   void setSymbolSize(const MCSymbol *Sym, uint64_t Size) override {}
+  bool needsInstructionCallbacks() const override { return false; }
   void beginInstruction(const MachineInstr *MI) override {}
   void endInstruction() override {}
 
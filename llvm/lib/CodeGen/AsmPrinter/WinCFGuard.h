@@ -45,6 +45,8 @@ public:
   /// beginFunction at all.
   void endFunction(const MachineFunction *MF) override;
 
+  bool needsInstructionCallbacks() const override { return false; }
+
   /// Process beginning of an instruction.
   void beginInstruction(const MachineInstr *MI) override {}
 
@@ -174,17 +174,18 @@ uint64_t BranchRelaxation::computeBlockSize(const MachineBasicBlock &MBB) const
 /// moved around inside the function.
 unsigned BranchRelaxation::getInstrOffset(const MachineInstr &MI) const {
   const MachineBasicBlock *MBB = MI.getParent();
-
-  // The offset is composed of two things: the sum of the sizes of all MBB's
-  // before this instruction's block, and the offset from the start of the block
-  // it is in.
-  unsigned Offset = BlockInfo[MBB->getNumber()].Offset;
-
-  // Sum instructions before MI in MBB.
-  for (MachineBasicBlock::const_iterator I = MBB->begin(); &*I != &MI; ++I) {
-    assert(I != MBB->end() && "Didn't find MI in its own basic block?");
-    Offset += TII->getInstSizeInBytes(*I);
-  }
+  const BasicBlockInfo &BBI = BlockInfo[MBB->getNumber()];
+
+  // The queried instruction is a branch, so it sits at or near the end of its
+  // block. Since BBI.Size is the sum of all instruction sizes in the block,
+  // walking backwards over the few instructions from MI to the block end is
+  // much cheaper than summing every instruction that precedes it.
+  unsigned Offset = BBI.Offset + BBI.Size;
+
+  // Subtract the sizes of MI and the instructions following it in MBB.
+  for (MachineBasicBlock::const_iterator I = MI.getIterator(), E = MBB->end();
+       I != E; ++I)
+    Offset -= TII->getInstSizeInBytes(*I);
 
   return Offset;
 }
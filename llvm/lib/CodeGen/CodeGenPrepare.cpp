@@ -4930,6 +4930,33 @@ bool CodeGenPrepare::optimizeMemoryInst(Instruction *MemoryInst, Value *Addr,
                                         Type *AccessTy, unsigned AddrSpace) {
   Value *Repl = Addr;
 
+  // If we already sank a computation of this address for another memory
+  // instruction in this block, reuse it directly instead of re-deriving the
+  // addressing mode. The match depends on the web of values feeding the
+  // address, not on the particular user, and large GEP webs with many memory
+  // uses otherwise pay for a full match per use.
+  WeakTrackingVH CachedAddrVH = SunkAddrs[Addr];
+  if (CachedAddrVH.pointsToAliveValue()) {
+    Value *SunkAddr = CachedAddrVH;
+    LLVM_DEBUG(dbgs() << "CGP: Reusing sunk addr for " << *MemoryInst << "\n");
+    if (SunkAddr->getType() != Addr->getType()) {
+      IRBuilder<> Builder(MemoryInst);
+      SunkAddr = Builder.CreatePointerCast(SunkAddr, Addr->getType());
+    }
+    MemoryInst->replaceUsesOfWith(Repl, SunkAddr);
+    // If we have no uses, recursively delete the value and all dead
+    // instructions using it.
+    if (Repl->use_empty()) {
+      resetIteratorIfInvalidatedWhileCalling(CurInstIterator->getParent(), [&]() {
+        RecursivelyDeleteTriviallyDeadInstructions(
+            Repl, TLInfo, nullptr,
+            [&](Value *V) { removeAllAssertingVHReferences(V); });
+      });
+    }
+    ++NumMemoryInsts;
+    return true;
+  }
+
   // Try to collapse single-value PHI nodes.  This is necessary to undo
   // unprofitable PRE transformations.
   SmallVector<Value*, 8> worklist;
@@ -5033,21 +5060,12 @@ bool CodeGenPrepare::optimizeMemoryInst(Instruction *MemoryInst, Value *Addr,
   IRBuilder<> Builder(MemoryInst);
 
   // Now that we determined the addressing expression we want to use and know
-  // that we have to sink it into this block.  Check to see if we have already
-  // done this for some other load/store instr in this block.  If so, reuse
-  // the computation.  Before attempting reuse, check if the address is valid
-  // as it may have been erased.
-
-  WeakTrackingVH SunkAddrVH = SunkAddrs[Addr];
-
-  Value * SunkAddr = SunkAddrVH.pointsToAliveValue() ? SunkAddrVH : nullptr;
-  if (SunkAddr) {
-    LLVM_DEBUG(dbgs() << "CGP: Reusing nonlocal addrmode: " << AddrMode
-                      << " for " << *MemoryInst << "\n");
-    if (SunkAddr->getType() != Addr->getType())
-      SunkAddr = Builder.CreatePointerCast(SunkAddr, Addr->getType());
-  } else if (AddrSinkUsingGEPs || (!AddrSinkUsingGEPs.getNumOccurrences() &&
-                                   SubtargetInfo->addrSinkUsingGEPs())) {
+  // that we have to sink it into this block, materialize it. Any reusable
+  // computation sunk for an earlier memory instruction was already found (and
+  // taken) before matching.
+  Value *SunkAddr = nullptr;
+  if (AddrSinkUsingGEPs || (!AddrSinkUsingGEPs.getNumOccurrences() &&
+                            SubtargetInfo->addrSinkUsingGEPs())) {
     // By default, we use the GEP-based method when AA is used later. This
     // prevents new inttoptr/ptrtoint pairs from degrading AA capabilities.
     LLVM_DEBUG(dbgs() << "CGP: SINKING nonlocal addrmode: " << AddrMode
@@ -524,6 +524,13 @@ void MachineOutliner::findCandidates(
     CandidatesForRepeatedSeq.clear();
     SuffixTree::RepeatedSubstring RS = *It;
     unsigned StringLen = RS.Length;
+
+    // Process the occurrences in increasing start order. Since every
+    // occurrence of the sequence has the same length, a new occurrence can
+    // then only overlap the most recently accepted one, so a single
+    // comparison below replaces a scan over all accepted candidates, which
+    // becomes quadratic for sequences with very many occurrences.
+    llvm::sort(RS.StartIndices);
     for (const unsigned &StartIdx : RS.StartIndices) {
       unsigned EndIdx = StartIdx + StringLen - 1;
       // Trick: Discard some candidates that would be incompatible with the
@@ -547,11 +554,8 @@ void MachineOutliner::findCandidates(
       // That is, one must either
       // * End before the other starts
       // * Start after the other ends
-      if (std::all_of(
-              CandidatesForRepeatedSeq.begin(), CandidatesForRepeatedSeq.end(),
-              [&StartIdx, &EndIdx](const Candidate &C) {
-                return (EndIdx < C.getStartIdx() || StartIdx > C.getEndIdx());
-              })) {
+      if (CandidatesForRepeatedSeq.empty() ||
+          StartIdx > CandidatesForRepeatedSeq.back().getEndIdx()) {
         // It doesn't overlap with anything, so we can outline it.
         // Each sequence is over [StartIt, EndIt].
         // Save the candidate and its location.
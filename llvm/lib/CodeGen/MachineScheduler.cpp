@@ -58,6 +58,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/GraphWriter.h"
 #include "llvm/Support/MachineValueType.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -76,6 +77,11 @@ using namespace llvm;
 
 STATISTIC(NumClustered, "Number of load/store pairs clustered");
 
+/// Timer group used to account for the major phases of the scheduler under
+/// -time-passes.
+static const char TimerGroupName[] = "misched";
+static const char TimerGroupDescription[] = "Machine Instruction Scheduling";
+
 namespace llvm {
 
 cl::opt<bool> ForceTopDown("misched-topdown", cl::Hidden,
@@ -768,7 +774,11 @@ void ScheduleDAGMI::schedule() {
   LLVM_DEBUG(SchedImpl->dumpPolicy());
 
   // Build the DAG.
-  buildSchedGraph(AA);
+  {
+    NamedRegionTimer T("dag_build", "DAG Building", TimerGroupName,
+                       TimerGroupDescription, TimePassesIsEnabled);
+    buildSchedGraph(AA);
+  }
 
   postprocessDAG();
 
@@ -1216,7 +1226,11 @@ void ScheduleDAGMILive::dump() const {
 void ScheduleDAGMILive::schedule() {
   LLVM_DEBUG(dbgs() << "ScheduleDAGMILive::schedule starting\n");
   LLVM_DEBUG(SchedImpl->dumpPolicy());
-  buildDAGWithRegPressure();
+  {
+    NamedRegionTimer T("dag_build", "DAG Building", TimerGroupName,
+                       TimerGroupDescription, TimePassesIsEnabled);
+    buildDAGWithRegPressure();
+  }
 
   postprocessDAG();
 
@@ -62,6 +62,17 @@ EnableAntiDepBreaking("break-anti-dependencies",
                                "\"critical\", \"all\", or \"none\""),
                       cl::init("none"), cl::Hidden);
 
+// Bounding the region size keeps dependence graph construction from going
+// quadratic on pathologically large blocks, e.g. from heavily instrumented
+// code. Scheduling quality across a window boundary is lost, but blocks this
+// large are dominated by compile time, not schedule quality.
+static cl::opt<unsigned>
+MaxRegionInstrs("postra-sched-max-region",
+                cl::desc("Maximum number of instructions scheduled as a "
+                         "single post-RA region; larger runs are split into "
+                         "windows of this size (0 = no limit)"),
+                cl::init(1000), cl::Hidden);
+
 // If DebugDiv > 0 then only schedule MBB with (ID % DebugDiv) == DebugMod
 static cl::opt<int>
 DebugDiv("postra-sched-debugdiv",
@@ -158,6 +169,11 @@ namespace {
     // Set the index of RegionEnd within the current BB.
     void setEndIndex(unsigned EndIdx) { EndIndex = EndIdx; }
 
+    // Get the first instruction of the last emitted region. EmitSchedule may
+    // reorder instructions, so this is the only way for the driver loop to
+    // learn where the scheduled region now starts.
+    MachineBasicBlock::iterator getRegionBegin() const { return RegionBegin; }
+
     /// Initialize the scheduler state for the next scheduling region.
     void enterRegion(MachineBasicBlock *bb,
                      MachineBasicBlock::iterator begin,
@@ -333,6 +349,21 @@ bool PostRAScheduler::runOnMachineFunction(MachineFunction &Fn) {
     MachineBasicBlock::iterator Current = MBB.end();
     unsigned Count = MBB.size(), CurrentCount = Count;
     for (MachineBasicBlock::iterator I = Current; I != MBB.begin();) {
+      // If the open region has reached the size limit, schedule it as-is and
+      // open a fresh window directly above it. This bounds the quadratic cost
+      // of dependence graph construction on huge blocks.
+      if (MaxRegionInstrs && CurrentCount - Count >= MaxRegionInstrs) {
+        Scheduler.enterRegion(&MBB, I, Current, CurrentCount - Count);
+        Scheduler.setEndIndex(CurrentCount);
+        Scheduler.schedule();
+        Scheduler.exitRegion();
+        Scheduler.EmitSchedule();
+        // The first instruction of the region may have changed; the next
+        // window ends at whatever instruction leads the scheduled one now.
+        Current = Scheduler.getRegionBegin();
+        CurrentCount = Count;
+        I = Current;
+      }
       MachineInstr &MI = *std::prev(I);
       --Count;
       // Calls are not scheduling boundaries before register allocation, but
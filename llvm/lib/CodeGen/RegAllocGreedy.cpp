@@ -242,6 +242,12 @@ class RAGreedy : public MachineFunctionPass,
     // Cascade - Eviction loop prevention. See canEvictInterference().
     unsigned Cascade = 0;
 
+    // Cached result of LiveInterval::getSize(), or 0 when unknown. Eviction
+    // chains requeue the same unchanged intervals many times, and getSize()
+    // walks every segment; the cache is dropped whenever the interval is
+    // about to shrink.
+    unsigned Size = 0;
+
     RegInfo() = default;
   };
 
@@ -650,13 +656,19 @@ bool RAGreedy::LRE_CanEraseVirtReg(Register VirtReg) {
 }
 
 void RAGreedy::LRE_WillShrinkVirtReg(Register VirtReg) {
-  if (!VRM->hasPhys(VirtReg))
-    return;
+  if (VRM->hasPhys(VirtReg)) {
+    // Register is assigned, put it back on the queue for reassignment. The
+    // requeue happens before the shrink, so like before sizes were cached it
+    // is prioritized by the pre-shrink size.
+    LiveInterval &LI = LIS->getInterval(VirtReg);
+    Matrix->unassign(LI);
+    enqueue(&LI);
+  }
 
-  // Register is assigned, put it back on the queue for reassignment.
-  LiveInterval &LI = LIS->getInterval(VirtReg);
-  Matrix->unassign(LI);
-  enqueue(&LI);
+  // The interval is about to lose segments; drop its cached size so the next
+  // enqueue recomputes it.
+  if (ExtraRegInfo.inBounds(VirtReg))
+    ExtraRegInfo[VirtReg].Size = 0;
 }
 
 void RAGreedy::LRE_DidCloneVirtReg(Register New, Register Old) {
@@ -671,6 +683,10 @@ void RAGreedy::LRE_DidCloneVirtReg(Register New, Register Old) {
   ExtraRegInfo[Old].Stage = RS_Assign;
   ExtraRegInfo.grow(New);
   ExtraRegInfo[New] = ExtraRegInfo[Old];
+  // Both registers now cover different (smaller) sets of segments than the
+  // original, so neither cached size is meaningful anymore.
+  ExtraRegInfo[Old].Size = 0;
+  ExtraRegInfo[New].Size = 0;
 }
 
 void RAGreedy::releaseMemory() {
@@ -684,7 +700,6 @@ void RAGreedy::enqueue(LiveInterval *LI) { enqueue(Queue, LI); }
 void RAGreedy::enqueue(PQueue &CurQueue, LiveInterval *LI) {
   // Prioritize live ranges by size, assigning larger ranges first.
   // The queue holds (size, reg) pairs.
-  const unsigned Size = LI->getSize();
   const Register Reg = LI->reg();
   assert(Reg.isVirtual() && "Can only enqueue virtual registers");
   unsigned Prio;
@@ -693,6 +708,10 @@ void RAGreedy::enqueue(PQueue &CurQueue, LiveInterval *LI) {
   if (ExtraRegInfo[Reg].Stage == RS_New)
     ExtraRegInfo[Reg].Stage = RS_Assign;
 
+  if (!ExtraRegInfo[Reg].Size)
+    ExtraRegInfo[Reg].Size = LI->getSize();
+  const unsigned Size = ExtraRegInfo[Reg].Size;
+
   if (ExtraRegInfo[Reg].Stage == RS_Split) {
     // Unsplit ranges that couldn't be allocated immediately are deferred until
     // everything else has been allocated.
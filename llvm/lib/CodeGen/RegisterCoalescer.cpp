@@ -71,6 +71,8 @@ STATISTIC(NumInflated , "Number of register classes inflated");
 STATISTIC(NumLaneConflicts, "Number of dead lane conflicts tested");
 STATISTIC(NumLaneResolves,  "Number of dead lane conflicts resolved");
 STATISTIC(NumShrinkToUses,  "Number of shrinkToUses called");
+STATISTIC(NumUpdatesDeferred, "Number of interval updates deferred");
+STATISTIC(NumLateRepairs, "Number of deferred interval repair rounds");
 
 static cl::opt<bool> EnableJoining("join-liveintervals",
                                    cl::desc("Coalesce copies (default=true)"),
@@ -1560,7 +1562,8 @@ bool RegisterCoalescer::reMaterializeTrivialDef(const CoalescerPair &CP,
     if (!DeadDefs.empty())
       eliminateDeadDefs();
   } else {
-    ToBeUpdated.insert(SrcReg);
+    if (ToBeUpdated.insert(SrcReg).second)
+      ++NumUpdatesDeferred;
   }
   return true;
 }
@@ -3675,6 +3678,8 @@ static bool isLocalCopy(MachineInstr *Copy, const LiveIntervals *LIS) {
 }
 
 void RegisterCoalescer::lateLiveIntervalUpdate() {
+  if (!ToBeUpdated.empty())
+    ++NumLateRepairs;
   for (Register reg : ToBeUpdated) {
     if (!LIS->hasInterval(reg))
       continue;
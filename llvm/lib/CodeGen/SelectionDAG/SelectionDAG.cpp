@@ -1077,6 +1077,11 @@ void SelectionDAG::init(MachineFunction &NewMF,
   MF = &NewMF;
   SDAGISelPass = PassPtr;
   ORE = &NewORE;
+  // Release operand memory from the previous function. Within a function the
+  // operand arena stays warm across basic blocks (see clear()), so this is
+  // the only point where its slabs are returned to the system.
+  OperandRecycler.clear(OperandAllocator);
+  OperandAllocator.Reset();
   TLI = getSubtarget().getTargetLowering();
   TSI = getSubtarget().getSelectionDAGInfo();
   LibInfo = LibraryInfo;
@@ -1150,8 +1155,9 @@ SDNode *SelectionDAG::FindNodeOrInsertPos(const FoldingSetNodeID &ID,
 
 void SelectionDAG::clear() {
   allnodes_clear();
-  OperandRecycler.clear(OperandAllocator);
-  OperandAllocator.Reset();
+  // Keep the operand arena warm: allnodes_clear has returned all operand
+  // arrays to OperandRecycler's free lists, where the next block's nodes can
+  // reuse them. The slabs themselves are released per-function in init().
   CSEMap.clear();
 
   ExtendedValueTypeNodes.clear();
@@ -2896,6 +2896,34 @@ void SelectionDAGISel::SelectCodeCommon(SDNode *NodeToMatch,
       if (Opc >= OpcodeOffset.size())
         OpcodeOffset.resize((Opc+1)*2);
       OpcodeOffset[Opc] = Idx;
+
+      // If this opcode's case immediately switches on the node's result type,
+      // record a direct index for each type case as well.
+      if (MatcherTable[Idx] == OPC_SwitchType) {
+        SmallVector<std::pair<unsigned, unsigned>, 8> VTCases;
+        unsigned TIdx = Idx + 1;
+        bool HasIPtrCase = false;
+        while (true) {
+          unsigned TCaseSize = MatcherTable[TIdx++];
+          if (TCaseSize & 128)
+            TCaseSize = GetVBR(TCaseSize, MatcherTable, TIdx);
+          if (TCaseSize == 0) break;
+
+          unsigned CaseVT = MatcherTable[TIdx++];
+          if (CaseVT == MVT::iPTR) {
+            // iPTR resolves to the target pointer type at selection time and
+            // may shadow later concrete cases; fall back to the linear scan.
+            HasIPtrCase = true;
+            break;
+          }
+          VTCases.push_back({(unsigned(Opc) << 8) | CaseVT, TIdx});
+          TIdx += TCaseSize;
+        }
+        if (!HasIPtrCase)
+          for (const auto &VTCase : VTCases)
+            OpcodeVTOffset.insert(VTCase);
+      }
+
       Idx += CaseSize;
     }
 
@@ -2904,6 +2932,18 @@ void SelectionDAGISel::SelectCodeCommon(SDNode *NodeToMatch,
       MatcherIndex = OpcodeOffset[N.getOpcode()];
   }
 
+  // If the opcode dispatch landed on a type switch, dispatch on the node's
+  // result type too. A missing entry means either the type has no case (the
+  // interpreter will fail the match as usual) or the switch was not cached.
+  if (MatcherIndex != 0 && MatcherTable[MatcherIndex] == OPC_SwitchType) {
+    auto It = OpcodeVTOffset.find((N.getOpcode() << 8) |
+                                  N.getSimpleValueType().SimpleTy);
+    if (It != OpcodeVTOffset.end()) {
+      MatcherIndex = It->second;
+      LLVM_DEBUG(dbgs() << "  Initial Type index to " << MatcherIndex << "\n");
+    }
+  }
+
   while (true) {
     assert(MatcherIndex < TableSize && "Invalid index");
 #ifndef NDEBUG
@@ -1306,56 +1306,65 @@ bool StackColoring::runOnMachineFunction(MachineFunction &Func) {
   for (auto &s : LiveStarts)
     llvm::sort(s);
 
-  bool Changed = true;
-  while (Changed) {
-    Changed = false;
-    for (unsigned I = 0; I < NumSlots; ++I) {
-      if (SortedSlots[I] == -1)
-        continue;
+  // A single pass over the pairs is sufficient: merging only ever grows the
+  // surviving interval, so a pair that interferes at the point it is visited
+  // can never become disjoint later, and rescanning cannot find new merges.
+  for (unsigned I = 0; I < NumSlots; ++I) {
+    if (SortedSlots[I] == -1)
+      continue;
 
-      for (unsigned J=I+1; J < NumSlots; ++J) {
-        if (SortedSlots[J] == -1)
-          continue;
+    for (unsigned J=I+1; J < NumSlots; ++J) {
+      if (SortedSlots[J] == -1)
+        continue;
 
-        int FirstSlot = SortedSlots[I];
-        int SecondSlot = SortedSlots[J];
-        LiveInterval *First = &*Intervals[FirstSlot];
-        LiveInterval *Second = &*Intervals[SecondSlot];
-        auto &FirstS = LiveStarts[FirstSlot];
-        auto &SecondS = LiveStarts[SecondSlot];
-        assert(!First->empty() && !Second->empty() && "Found an empty range");
-
-        // Merge disjoint slots. This is a little bit tricky - see the
-        // Implementation Notes section for an explanation.
-        if (!First->isLiveAtIndexes(SecondS) &&
-            !Second->isLiveAtIndexes(FirstS)) {
-          Changed = true;
-          First->MergeSegmentsInAsValue(*Second, First->getValNumInfo(0));
-
-          int OldSize = FirstS.size();
-          FirstS.append(SecondS.begin(), SecondS.end());
-          auto Mid = FirstS.begin() + OldSize;
-          std::inplace_merge(FirstS.begin(), Mid, FirstS.end());
-
-          SlotRemap[SecondSlot] = FirstSlot;
-          SortedSlots[J] = -1;
-          LLVM_DEBUG(dbgs() << "Merging #" << FirstSlot << " and slots #"
-                            << SecondSlot << " together.\n");
-          Align MaxAlignment = std::max(MFI->getObjectAlign(FirstSlot),
-                                        MFI->getObjectAlign(SecondSlot));
-
-          assert(MFI->getObjectSize(FirstSlot) >=
-                 MFI->getObjectSize(SecondSlot) &&
-                 "Merging a small object into a larger one");
-
-          RemovedSlots+=1;
-          ReducedSize += MFI->getObjectSize(SecondSlot);
-          MFI->setObjectAlignment(FirstSlot, MaxAlignment);
-          MFI->RemoveStackObject(SecondSlot);
-        }
+      int FirstSlot = SortedSlots[I];
+      int SecondSlot = SortedSlots[J];
+      LiveInterval *First = &*Intervals[FirstSlot];
+      LiveInterval *Second = &*Intervals[SecondSlot];
+      auto &FirstS = LiveStarts[FirstSlot];
+      auto &SecondS = LiveStarts[SecondSlot];
+      assert(!First->empty() && !Second->empty() && "Found an empty range");
+
+      // Fast path: if the two live ranges do not overlap at all, neither
+      // slot can be in-use at any of the other's live points, so the
+      // segment-by-segment test below cannot fail. Coroutine frames often
+      // have thousands of slots with short, strictly sequential lifetimes,
+      // and this keeps the quadratic scan cheap for them.
+      bool Disjoint = First->endIndex() <= Second->beginIndex() ||
+                      Second->endIndex() <= First->beginIndex();
+
+      // Merge disjoint slots. This is a little bit tricky - see the
+      // Implementation Notes section for an explanation.
+      if (!Disjoint)
+        Disjoint = !First->isLiveAtIndexes(SecondS) &&
+                   !Second->isLiveAtIndexes(FirstS);
+
+      if (Disjoint) {
+        First->MergeSegmentsInAsValue(*Second, First->getValNumInfo(0));
+
+        int OldSize = FirstS.size();
+        FirstS.append(SecondS.begin(), SecondS.end());
+        auto Mid = FirstS.begin() + OldSize;
+        std::inplace_merge(FirstS.begin(), Mid, FirstS.end());
+
+        SlotRemap[SecondSlot] = FirstSlot;
+        SortedSlots[J] = -1;
+        LLVM_DEBUG(dbgs() << "Merging #" << FirstSlot << " and slots #"
+                          << SecondSlot << " together.\n");
+        Align MaxAlignment = std::max(MFI->getObjectAlign(FirstSlot),
+                                      MFI->getObjectAlign(SecondSlot));
+
+        assert(MFI->getObjectSize(FirstSlot) >=
+               MFI->getObjectSize(SecondSlot) &&
+               "Merging a small object into a larger one");
+
+        RemovedSlots+=1;
+        ReducedSize += MFI->getObjectSize(SecondSlot);
+        MFI->setObjectAlignment(FirstSlot, MaxAlignment);
+        MFI->RemoveStackObject(SecondSlot);
       }
     }
-  }// While changed.
+  }
 
   // Record statistics.
   StackSpaceSaved += ReducedSize;
@@ -22,12 +22,18 @@
 #include "llvm/IR/Function.h"
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
 
 using namespace llvm;
 
+// Defined in TargetPassConfig.cpp.
+namespace llvm {
+extern cl::opt<bool> RelaxIPRACodeGenOrder;
+} // namespace llvm
+
 TargetFrameLowering::~TargetFrameLowering() = default;
 
 bool TargetFrameLowering::enableCalleeSaveSkip(const MachineFunction &MF) const {
@@ -86,8 +92,11 @@ void TargetFrameLowering::determineCalleeSaves(MachineFunction &MF,
   SavedRegs.resize(TRI.getNumRegs());
 
   // When interprocedural register allocation is enabled caller saved registers
-  // are preferred over callee saved registers.
-  if (MF.getTarget().Options.EnableIPRA &&
+  // are preferred over callee saved registers. Skipping the saves is only
+  // sound when every caller is compiled after this function and picks up its
+  // collected register usage, i.e. under the bottom-up call graph codegen
+  // order.
+  if (MF.getTarget().Options.EnableIPRA && !RelaxIPRACodeGenOrder &&
       isSafeForNoCSROpt(MF.getFunction()) &&
       isProfitableForNoCSROpt(MF.getFunction()))
     return;
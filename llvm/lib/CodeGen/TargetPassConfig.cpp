@@ -54,6 +54,17 @@ static cl::opt<bool>
     EnableIPRA("enable-ipra", cl::init(false), cl::Hidden,
                cl::desc("Enable interprocedural register allocation "
                         "to reduce load/store at procedure calls."));
+// Referenced from TargetFrameLoweringImpl.cpp: relaxing the codegen order
+// also requires disabling the no-CSR optimization there.
+namespace llvm {
+cl::opt<bool> RelaxIPRACodeGenOrder(
+    "ipra-relax-cgscc-order", cl::init(false), cl::Hidden,
+    cl::desc("Do not force bottom-up call graph codegen order for "
+             "interprocedural register allocation. Call sites whose callee "
+             "has not been compiled yet keep the conservative calling "
+             "convention regmask, and callees may not skip callee-saved "
+             "spills."));
+} // namespace llvm
 static cl::opt<bool> DisablePostRASched("disable-post-ra", cl::Hidden,
     cl::desc("Disable Post Regalloc Scheduler"));
 static cl::opt<bool> DisableBranchFold("disable-branch-fold", cl::Hidden,
@@ -430,7 +441,7 @@ TargetPassConfig::TargetPassConfig(LLVMTargetMachine &TM, PassManagerBase &pm)
     TM.Options.EnableIPRA |= TM.useIPRA();
   }
 
-  if (TM.Options.EnableIPRA)
+  if (TM.Options.EnableIPRA && !RelaxIPRACodeGenOrder)
     setRequiresCodeGenSCCOrder();
 
   if (EnableGlobalISelAbort.getNumOccurrences())
@@ -28,6 +28,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/LEB128.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ThreadPool.h"
 #include <vector>
@@ -2216,13 +2217,25 @@ uint64_t DWARFLinker::DIECloner::cloneAllCompileUnits(
 
   if (!Linker.Options.NoOutput) {
     assert(Emitter);
+
+    // At this point every unit's start offset is known, and the fixups
+    // recorded for a unit only patch that unit's own output DIEs, so the
+    // cross-unit reference patching can be done on all units independently.
+    // The emission loop below stays sequential to keep the output offsets
+    // deterministic.
+    auto FixupForwardReferences = [](std::unique_ptr<CompileUnit> &Unit) {
+      Unit->fixupForwardReferences();
+    };
+    if (Linker.Options.Threads == 1)
+      for_each(CompileUnits, FixupForwardReferences);
+    else
+      parallelForEach(CompileUnits, FixupForwardReferences);
+
     // Emit all the compile unit's debug information.
     for (auto &CurrentUnit : CompileUnits) {
       if (LLVM_LIKELY(!Linker.Options.Update))
         Linker.generateUnitRanges(*CurrentUnit);
 
-      CurrentUnit->fixupForwardReferences();
-
       if (!CurrentUnit->getOutputUnitDIE())
         continue;
 
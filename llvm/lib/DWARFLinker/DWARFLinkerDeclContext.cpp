@@ -53,17 +53,10 @@ PointerIntPair<DeclContext *, 1> DeclContextTree::getChildDeclContext(
   default:
     // By default stop gathering child contexts.
     return PointerIntPair<DeclContext *, 1>(nullptr);
-  case dwarf::DW_TAG_module:
-    break;
   case dwarf::DW_TAG_compile_unit:
     return PointerIntPair<DeclContext *, 1>(&Context);
+  case dwarf::DW_TAG_module:
   case dwarf::DW_TAG_subprogram:
-    // Do not unique anything inside CU local functions.
-    if ((Context.getTag() == dwarf::DW_TAG_namespace ||
-         Context.getTag() == dwarf::DW_TAG_compile_unit) &&
-        !dwarf::toUnsigned(DIE.find(dwarf::DW_AT_external), 0))
-      return PointerIntPair<DeclContext *, 1>(nullptr);
-    LLVM_FALLTHROUGH;
   case dwarf::DW_TAG_member:
   case dwarf::DW_TAG_namespace:
   case dwarf::DW_TAG_structure_type:
@@ -71,15 +64,54 @@ PointerIntPair<DeclContext *, 1> DeclContextTree::getChildDeclContext(
   case dwarf::DW_TAG_union_type:
   case dwarf::DW_TAG_enumeration_type:
   case dwarf::DW_TAG_typedef:
-    // Artificial things might be ambiguous, because they might be created on
-    // demand. For example implicitly defined constructors are ambiguous
-    // because of the way we identify contexts, and they won't be generated
-    // every time everywhere.
-    if (dwarf::toUnsigned(DIE.find(dwarf::DW_AT_artificial), 0))
-      return PointerIntPair<DeclContext *, 1>(nullptr);
     break;
   }
 
+  // This runs for every DIE of every CU, and each DWARFDie::find() walks the
+  // DIE's attribute list from the start. Gather all the attributes that the
+  // uniquing decisions below depend on in a single walk instead.
+  uint64_t External = 0;
+  uint64_t Artificial = 0;
+  uint64_t ByteSizeValue = std::numeric_limits<uint64_t>::max();
+  uint64_t DeclFile = 0;
+  uint64_t DeclLine = 0;
+  for (const DWARFAttribute &AttrValue : DIE.attributes()) {
+    switch (AttrValue.Attr) {
+    case dwarf::DW_AT_external:
+      External = AttrValue.Value.getAsUnsignedConstant().getValueOr(0);
+      break;
+    case dwarf::DW_AT_artificial:
+      Artificial = AttrValue.Value.getAsUnsignedConstant().getValueOr(0);
+      break;
+    case dwarf::DW_AT_byte_size:
+      ByteSizeValue = AttrValue.Value.getAsUnsignedConstant().getValueOr(
+          std::numeric_limits<uint64_t>::max());
+      break;
+    case dwarf::DW_AT_decl_file:
+      DeclFile = AttrValue.Value.getAsUnsignedConstant().getValueOr(0);
+      break;
+    case dwarf::DW_AT_decl_line:
+      DeclLine = AttrValue.Value.getAsUnsignedConstant().getValueOr(0);
+      break;
+    default:
+      break;
+    }
+  }
+
+  // Do not unique anything inside CU local functions.
+  if (Tag == dwarf::DW_TAG_subprogram &&
+      (Context.getTag() == dwarf::DW_TAG_namespace ||
+       Context.getTag() == dwarf::DW_TAG_compile_unit) &&
+      !External)
+    return PointerIntPair<DeclContext *, 1>(nullptr);
+
+  // Artificial things might be ambiguous, because they might be created on
+  // demand. For example implicitly defined constructors are ambiguous
+  // because of the way we identify contexts, and they won't be generated
+  // every time everywhere.
+  if (Tag != dwarf::DW_TAG_module && Artificial)
+    return PointerIntPair<DeclContext *, 1>(nullptr);
+
   const char *Name = DIE.getLinkageName();
   const char *ShortName = DIE.getShortName();
 
@@ -119,11 +151,9 @@ PointerIntPair<DeclContext *, 1> DeclContextTree::getChildDeclContext(
     //
     // This is disabled for clang modules, because forward declarations of
     // module-defined types do not have a file and line.
-    ByteSize = dwarf::toUnsigned(DIE.find(dwarf::DW_AT_byte_size),
-                                 std::numeric_limits<uint64_t>::max());
+    ByteSize = ByteSizeValue;
     if (Tag != dwarf::DW_TAG_namespace || !Name) {
-      if (unsigned FileNum =
-              dwarf::toUnsigned(DIE.find(dwarf::DW_AT_decl_file), 0)) {
+      if (unsigned FileNum = DeclFile) {
         if (const auto *LT = U.getOrigUnit().getContext().getLineTableForUnit(
                 &U.getOrigUnit())) {
           // FIXME: dsymutil-classic compatibility. I'd rather not
@@ -133,7 +163,7 @@ PointerIntPair<DeclContext *, 1> DeclContextTree::getChildDeclContext(
             FileNum = 1;
 
           if (LT->hasFileAtIndex(FileNum)) {
-            Line = dwarf::toUnsigned(DIE.find(dwarf::DW_AT_decl_line), 0);
+            Line = DeclLine;
             // Cache the resolved paths based on the index in the line table,
             // because calling realpath is expansive.
             StringRef ResolvedPath = U.getResolvedPath(FileNum);
@@ -10,6 +10,7 @@
 #include "llvm/DebugInfo/GSYM/Header.h"
 #include "llvm/DebugInfo/GSYM/LineTable.h"
 #include "llvm/MC/StringTableBuilder.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <algorithm>
@@ -168,8 +169,10 @@ llvm::Error GsymCreator::finalize(llvm::raw_ostream &OS) {
                              "already finalized");
   Finalized = true;
 
-  // Sort function infos so we can emit sorted functions.
-  llvm::sort(Funcs.begin(), Funcs.end());
+  // Sort function infos so we can emit sorted functions. This is the single
+  // largest part of finalization for inputs with many functions, and the
+  // entries are independent, so sort them in parallel.
+  llvm::parallelSort(Funcs.begin(), Funcs.end());
 
   // Don't let the string table indexes change by finalizing in order.
   StrTab.finalizeInOrder();
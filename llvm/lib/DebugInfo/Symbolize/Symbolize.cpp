@@ -14,10 +14,13 @@
 
 #include "SymbolizableObjectFile.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/BinaryFormat/COFF.h"
 #include "llvm/Config/config.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/DebugInfo/GSYM/GsymDIContext.h"
+#include "llvm/DebugInfo/GSYM/GsymReader.h"
 #include "llvm/DebugInfo/PDB/PDB.h"
 #include "llvm/DebugInfo/PDB/PDBContext.h"
 #include "llvm/Demangle/Demangle.h"
@@ -31,6 +34,7 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include <algorithm>
 #include <cassert>
@@ -86,14 +90,8 @@ LLVMSymbolizer::symbolizeCode(const std::string &ModuleName,
 }
 
 Expected<DIInliningInfo>
-LLVMSymbolizer::symbolizeInlinedCode(const std::string &ModuleName,
-                                     object::SectionedAddress ModuleOffset) {
-  SymbolizableModule *Info;
-  if (auto InfoOrErr = getOrCreateModuleInfo(ModuleName))
-    Info = InfoOrErr.get();
-  else
-    return InfoOrErr.takeError();
-
+LLVMSymbolizer::symbolizeInlinedCodeCommon(
+    SymbolizableModule *Info, object::SectionedAddress ModuleOffset) {
   // A null module means an error has already been reported. Return an empty
   // result.
   if (!Info)
@@ -116,6 +114,64 @@ LLVMSymbolizer::symbolizeInlinedCode(const std::string &ModuleName,
   return InlinedContext;
 }
 
+Expected<DIInliningInfo>
+LLVMSymbolizer::symbolizeInlinedCode(const std::string &ModuleName,
+                                     object::SectionedAddress ModuleOffset) {
+  Expected<SymbolizableModule *> InfoOrErr = getOrCreateModuleInfo(ModuleName);
+  if (!InfoOrErr)
+    return InfoOrErr.takeError();
+  return symbolizeInlinedCodeCommon(*InfoOrErr, ModuleOffset);
+}
+
+std::vector<Expected<DIInliningInfo>>
+LLVMSymbolizer::symbolizeInlinedCodeBatch(ArrayRef<Request> Requests) {
+  std::vector<Expected<DIInliningInfo>> Results;
+  Results.reserve(Requests.size());
+
+  // Load every module while we are still on one thread: module creation
+  // mutates the symbolizer's caches, and a load failure must surface on the
+  // first request for that module only, exactly as repeated
+  // symbolizeInlinedCode() calls would report it.
+  DenseMap<SymbolizableModule *, size_t> GroupForInfo;
+  std::vector<std::pair<SymbolizableModule *, std::vector<size_t>>> Groups;
+  for (const Request &R : Requests) {
+    size_t ResultIndex = Results.size();
+    Expected<SymbolizableModule *> InfoOrErr =
+        getOrCreateModuleInfo(R.ModuleName);
+    if (!InfoOrErr) {
+      Results.push_back(InfoOrErr.takeError());
+      continue;
+    }
+    Results.push_back(DIInliningInfo());
+    SymbolizableModule *Info = *InfoOrErr;
+    // A null module keeps the empty result; the error was already reported.
+    if (!Info)
+      continue;
+    auto Inserted = GroupForInfo.try_emplace(Info, Groups.size());
+    if (Inserted.second)
+      Groups.emplace_back(Info, std::vector<size_t>());
+    Groups[Inserted.first->second].second.push_back(ResultIndex);
+  }
+
+  // Modules do not share mutable state once loaded, so they can be resolved
+  // concurrently. Within a module, visit the addresses in ascending order:
+  // nearby PCs then hit the same lazily-parsed compile units and line-table
+  // sequences back to back. Every request writes only its own result slot.
+  parallelForEach(Groups, [&](decltype(Groups)::value_type &Group) {
+    std::vector<size_t> &Indices = Group.second;
+    llvm::sort(Indices, [&](size_t A, size_t B) {
+      const object::SectionedAddress &AddrA = Requests[A].ModuleOffset;
+      const object::SectionedAddress &AddrB = Requests[B].ModuleOffset;
+      return std::tie(AddrA.SectionIndex, AddrA.Address) <
+             std::tie(AddrB.SectionIndex, AddrB.Address);
+    });
+    for (size_t I : Indices)
+      Results[I] =
+          symbolizeInlinedCodeCommon(Group.first, Requests[I].ModuleOffset);
+  });
+  return Results;
+}
+
 Expected<DIGlobal>
 LLVMSymbolizer::symbolizeData(const std::string &ModuleName,
                               object::SectionedAddress ModuleOffset) {
@@ -411,6 +467,30 @@ ObjectFile *LLVMSymbolizer::lookUpDebuglinkObject(const std::string &Path,
   return DbgObjOrErr.get();
 }
 
+std::string LLVMSymbolizer::lookUpGsymFile(const std::string &Path) {
+  auto CheckGsymFile = [](const llvm::StringRef &GsymPath) {
+    sys::fs::file_status Status;
+    std::error_code EC = llvm::sys::fs::status(GsymPath, Status);
+    return !EC && !llvm::sys::fs::is_directory(Status);
+  };
+
+  // First, look beside the binary file.
+  std::string GsymPath = Path + ".gsym";
+  if (CheckGsymFile(GsymPath))
+    return GsymPath;
+
+  // Then, look in the directories specified by GsymFileDirectory.
+  for (const auto &Directory : Opts.GsymFileDirectory) {
+    SmallString<16> DirPath = llvm::StringRef(Directory);
+    llvm::sys::path::append(DirPath,
+                            llvm::sys::path::filename(Path) + ".gsym");
+    if (CheckGsymFile(DirPath))
+      return static_cast<std::string>(DirPath.str());
+  }
+
+  return {};
+}
+
 ObjectFile *LLVMSymbolizer::lookUpBuildIDObject(const std::string &Path,
                                                 const ELFObjectFileBase *Obj,
                                                 const std::string &ArchName) {
@@ -566,6 +646,20 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
       Context.reset(new PDBContext(*CoffObject, std::move(Session)));
     }
   }
+  // Use a GSYM file if one is present; its lookups are faster than parsing
+  // DWARF and it is the preferred index when binaries ship with one.
+  if (!Context) {
+    std::string GsymFile = lookUpGsymFile(BinaryName);
+    if (!GsymFile.empty()) {
+      auto ReaderOrErr = gsym::GsymReader::openFile(GsymFile);
+      if (ReaderOrErr)
+        Context.reset(new gsym::GsymDIContext(
+            std::make_unique<gsym::GsymReader>(std::move(*ReaderOrErr))));
+      else
+        // Fall back to DWARF below if the GSYM file cannot be parsed.
+        consumeError(ReaderOrErr.takeError());
+    }
+  }
   if (!Context)
     Context = DWARFContext::create(*Objects.second, nullptr, Opts.DWPName);
   return createModuleInfo(Objects.first, std::move(Context), ModuleName);
@@ -128,5 +128,179 @@ InProcessMemoryManager::allocate(const SegmentsRequestMap &Request) {
       new IPMMAlloc(std::move(Blocks)));
 }
 
+// Allocation handed out by PooledMemoryManager. Deallocation returns the
+// underlying blocks to the parent's pool rather than unmapping them, so the
+// allocation must not outlive the manager.
+class PooledMemoryManager::PooledAlloc : public Allocation {
+public:
+  using AllocationMap = DenseMap<unsigned, sys::MemoryBlock>;
+
+  PooledAlloc(PooledMemoryManager &Parent, AllocationMap SegBlocks)
+      : Parent(Parent), SegBlocks(std::move(SegBlocks)) {}
+  MutableArrayRef<char> getWorkingMemory(ProtectionFlags Seg) override {
+    assert(SegBlocks.count(Seg) && "No allocation for segment");
+    return {static_cast<char *>(SegBlocks[Seg].base()),
+            SegBlocks[Seg].allocatedSize()};
+  }
+  JITTargetAddress getTargetMemory(ProtectionFlags Seg) override {
+    assert(SegBlocks.count(Seg) && "No allocation for segment");
+    return pointerToJITTargetAddress(SegBlocks[Seg].base());
+  }
+  void finalizeAsync(FinalizeContinuation OnFinalize) override {
+    OnFinalize(applyProtections());
+  }
+  Error deallocate() override {
+    std::lock_guard<std::mutex> Lock(Parent.PoolMutex);
+    for (auto &KV : SegBlocks)
+      if (auto Err = Parent.release(KV.first, KV.second))
+        return Err;
+    SegBlocks.clear();
+    return Error::success();
+  }
+
+private:
+  Error applyProtections() {
+    for (auto &KV : SegBlocks) {
+      auto &Prot = KV.first;
+      auto &Block = KV.second;
+      if (auto EC = sys::Memory::protectMappedMemory(Block, Prot))
+        return errorCodeToError(EC);
+      if (Prot & sys::Memory::MF_EXEC)
+        sys::Memory::InvalidateInstructionCache(Block.base(),
+                                                Block.allocatedSize());
+    }
+    return Error::success();
+  }
+
+  PooledMemoryManager &Parent;
+  AllocationMap SegBlocks;
+};
+
+Expected<std::unique_ptr<PooledMemoryManager>>
+PooledMemoryManager::Create(uint64_t SlabSize) {
+  uint64_t PageSize = sys::Process::getPageSizeEstimate();
+  if (!isPowerOf2_64(PageSize))
+    return make_error<StringError>("Page size is not a power of 2",
+                                   inconvertibleErrorCode());
+  SlabSize = alignTo(SlabSize, PageSize);
+  return std::unique_ptr<PooledMemoryManager>(
+      new PooledMemoryManager(SlabSize, PageSize));
+}
+
+PooledMemoryManager::~PooledMemoryManager() {
+  for (auto &Slab : Slabs)
+    sys::Memory::releaseMappedMemory(Slab);
+}
+
+Expected<sys::MemoryBlock> PooledMemoryManager::carve(unsigned Prot,
+                                                      uint64_t Size) {
+  auto &P = Pools[Prot];
+
+  // Reuse a deallocated block if one is big enough, returning any unused
+  // tail to the free list. All free-list blocks are read-write and start
+  // and end on page boundaries, so splitting preserves both properties.
+  for (auto I = P.FreeBlocks.begin(), E = P.FreeBlocks.end(); I != E; ++I) {
+    if (I->allocatedSize() < Size)
+      continue;
+    sys::MemoryBlock Result(I->base(), Size);
+    if (I->allocatedSize() > Size)
+      *I = sys::MemoryBlock(static_cast<char *>(I->base()) + Size,
+                            I->allocatedSize() - Size);
+    else
+      P.FreeBlocks.erase(I);
+    return Result;
+  }
+
+  const sys::Memory::ProtectionFlags SlabProt =
+      static_cast<sys::Memory::ProtectionFlags>(sys::Memory::MF_READ |
+                                                sys::Memory::MF_WRITE |
+                                                sys::Memory::MF_HUGE_HINT);
+
+  // Requests larger than a slab get a dedicated mapping. It is still
+  // tracked as a slab so that it is unmapped on destruction once released.
+  if (Size >= SlabSize) {
+    std::error_code EC;
+    auto Block = sys::Memory::allocateMappedMemory(Size, nullptr, SlabProt, EC);
+    if (EC)
+      return errorCodeToError(EC);
+    Slabs.push_back(Block);
+    return sys::MemoryBlock(Block.base(), Size);
+  }
+
+  // Reserve a fresh slab if the current one cannot hold the request. The
+  // unused tail of the old slab stays available through the free list.
+  if (P.Remaining.allocatedSize() < Size) {
+    std::error_code EC;
+    auto Slab =
+        sys::Memory::allocateMappedMemory(SlabSize, nullptr, SlabProt, EC);
+    if (EC)
+      return errorCodeToError(EC);
+    Slabs.push_back(Slab);
+    if (P.Remaining.allocatedSize() > 0)
+      P.FreeBlocks.push_back(P.Remaining);
+    P.Remaining = Slab;
+  }
+
+  sys::MemoryBlock Result(P.Remaining.base(), Size);
+  P.Remaining =
+      sys::MemoryBlock(static_cast<char *>(P.Remaining.base()) + Size,
+                       P.Remaining.allocatedSize() - Size);
+  return Result;
+}
+
+Error PooledMemoryManager::release(unsigned Prot, sys::MemoryBlock Block) {
+  const unsigned ReadWrite = sys::Memory::MF_READ | sys::Memory::MF_WRITE;
+
+  // Finalized code and read-only data must be writable again before the
+  // block can be handed out for a new allocation.
+  if (Prot != ReadWrite)
+    if (auto EC = sys::Memory::protectMappedMemory(
+            Block, static_cast<sys::Memory::ProtectionFlags>(ReadWrite)))
+      return errorCodeToError(EC);
+
+  Pools[Prot].FreeBlocks.push_back(Block);
+  return Error::success();
+}
+
+Expected<std::unique_ptr<JITLinkMemoryManager::Allocation>>
+PooledMemoryManager::allocate(const SegmentsRequestMap &Request) {
+
+  PooledAlloc::AllocationMap Blocks;
+
+  {
+    std::lock_guard<std::mutex> Lock(PoolMutex);
+
+    for (auto &KV : Request) {
+      const auto &Seg = KV.second;
+
+      if (Seg.getAlignment() > PageSize)
+        return make_error<StringError>("Cannot request higher than page "
+                                       "alignment",
+                                       inconvertibleErrorCode());
+
+      uint64_t SegmentSize =
+          alignTo(Seg.getContentSize() + Seg.getZeroFillSize(), PageSize);
+
+      auto SegMem = carve(KV.first, SegmentSize);
+      if (!SegMem) {
+        // Return any blocks already carved for this request to the pool.
+        // They have not been protected yet, so no re-protection is needed.
+        for (auto &BKV : Blocks)
+          Pools[BKV.first].FreeBlocks.push_back(BKV.second);
+        return SegMem.takeError();
+      }
+
+      // Zero out the zero-fill memory. Reused blocks may contain stale data.
+      memset(static_cast<char *>(SegMem->base()) + Seg.getContentSize(), 0,
+             Seg.getZeroFillSize());
+
+      // Record the block for this segment.
+      Blocks[KV.first] = std::move(*SegMem);
+    }
+  }
+
+  return std::unique_ptr<Allocation>(new PooledAlloc(*this, std::move(Blocks)));
+}
+
 } // end namespace jitlink
 } // end namespace llvm
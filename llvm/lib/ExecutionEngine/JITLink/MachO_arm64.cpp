@@ -449,6 +449,11 @@ public:
   void fixExternalBranchEdge(Edge &E, Symbol &Stub) {
     assert(E.getKind() == Branch26 && "Not a Branch32 edge?");
     assert(E.getAddend() == 0 && "Branch32 edge has non-zero addend?");
+
+    // Set the edge kind to Branch26ToStub. We will use this to check for stub
+    // optimization opportunities in the optimizeMachO_arm64_GOTAndStubs pass
+    // below.
+    E.setKind(Branch26ToStub);
     E.setTarget(Stub);
   }
 
@@ -478,10 +483,12 @@ private:
                      sizeof(StubContent));
   }
 
-  static const uint8_t NullGOTEntryContent[8];
-  static const uint8_t StubContent[8];
   Section *GOTSection = nullptr;
   Section *StubsSection = nullptr;
+
+public:
+  static const uint8_t NullGOTEntryContent[8];
+  static const uint8_t StubContent[8];
 };
 
 const uint8_t MachO_arm64_GOTAndStubsBuilder::NullGOTEntryContent[8] = {
@@ -493,6 +500,93 @@ const uint8_t MachO_arm64_GOTAndStubsBuilder::StubContent[8] = {
 
 } // namespace
 
+static Error optimizeMachO_arm64_GOTAndStubs(LinkGraph &G) {
+  LLVM_DEBUG(dbgs() << "Optimizing GOT entries and stubs:\n");
+
+  for (auto *B : G.blocks())
+    for (auto &E : B->edges())
+      if (E.getKind() == GOTPage21 || E.getKind() == GOTPageOffset12) {
+        auto &GOTBlock = E.getTarget().getBlock();
+        assert(GOTBlock.getSize() == G.getPointerSize() &&
+               "GOT entry block should be pointer sized");
+        assert(GOTBlock.edges_size() == 1 &&
+               "GOT entry should only have one outgoing edge");
+
+        auto &GOTTarget = GOTBlock.edges().begin()->getTarget();
+        JITTargetAddress TargetAddr = GOTTarget.getAddress();
+        JITTargetAddress EdgeAddr = B->getAddress() + E.getOffset();
+
+        // Replace the GOT load with a direct ADRP/ADD pair to the target if
+        // the target page is within ADRP range of the fixup.
+        int64_t PageDelta = (TargetAddr & ~static_cast<uint64_t>(4096 - 1)) -
+                            (EdgeAddr & ~static_cast<uint64_t>(4096 - 1));
+        if (PageDelta < -(1 << 30) || PageDelta > ((1 << 30) - 1))
+          continue;
+
+        if (E.getKind() == GOTPage21) {
+          E.setKind(Page21);
+          E.setTarget(GOTTarget);
+          LLVM_DEBUG({
+            dbgs() << "  Replaced GOT page load with direct page address:\n    ";
+            printEdge(dbgs(), *B, E,
+                      getMachOARM64RelocationKindName(E.getKind()));
+            dbgs() << "\n";
+          });
+        } else {
+          // Rewrite the 64-bit LDR to an ADD with the same operand
+          // registers. The PageOffset12 fixup will fill in the immediate.
+          auto *FixupPtr = reinterpret_cast<support::ulittle32_t *>(
+              const_cast<char *>(B->getContent().data()) + E.getOffset());
+          uint32_t RawInstr = *FixupPtr;
+          assert((RawInstr & 0xfffffc00) == 0xf9400000 &&
+                 "RawInstr isn't a 64-bit LDR immediate");
+          *FixupPtr = 0x91000000 | (RawInstr & 0x3ff);
+          E.setKind(PageOffset12);
+          E.setTarget(GOTTarget);
+          LLVM_DEBUG({
+            dbgs() << "  Replaced GOT load with ADD:\n    ";
+            printEdge(dbgs(), *B, E,
+                      getMachOARM64RelocationKindName(E.getKind()));
+            dbgs() << "\n";
+          });
+        }
+      } else if (E.getKind() == Branch26ToStub) {
+        // Switch the edge kind to Branch26: Whether we change the edge target
+        // or not this will be the desired kind.
+        E.setKind(Branch26);
+
+        auto &StubBlock = E.getTarget().getBlock();
+        assert(StubBlock.getSize() ==
+                   sizeof(MachO_arm64_GOTAndStubsBuilder::StubContent) &&
+               "Stub block should be stub sized");
+        assert(StubBlock.edges_size() == 1 &&
+               "Stub block should only have one outgoing edge");
+
+        auto &GOTBlock = StubBlock.edges().begin()->getTarget().getBlock();
+        assert(GOTBlock.getSize() == G.getPointerSize() &&
+               "GOT block should be pointer sized");
+        assert(GOTBlock.edges_size() == 1 &&
+               "GOT block should only have one outgoing edge");
+
+        auto &GOTTarget = GOTBlock.edges().begin()->getTarget();
+        JITTargetAddress TargetAddr = GOTTarget.getAddress();
+        JITTargetAddress EdgeAddr = B->getAddress() + E.getOffset();
+
+        int64_t Displacement = TargetAddr - EdgeAddr;
+        if (Displacement >= -(1 << 27) && Displacement <= ((1 << 27) - 1)) {
+          E.setTarget(GOTTarget);
+          LLVM_DEBUG({
+            dbgs() << "  Replaced stub branch with direct branch:\n    ";
+            printEdge(dbgs(), *B, E,
+                      getMachOARM64RelocationKindName(E.getKind()));
+            dbgs() << "\n";
+          });
+        }
+      }
+
+  return Error::success();
+}
+
 namespace llvm {
 namespace jitlink {
 
@@ -551,7 +645,8 @@ private:
     JITTargetAddress FixupAddress = B.getAddress() + E.getOffset();
 
     switch (E.getKind()) {
-    case Branch26: {
+    case Branch26:
+    case Branch26ToStub: {
       assert((FixupAddress & 0x3) == 0 && "Branch-inst is not 32-bit aligned");
 
       int64_t Value = E.getTarget().getAddress() - FixupAddress + E.getAddend();
@@ -697,6 +792,9 @@ void jitLink_MachO_arm64(std::unique_ptr<JITLinkContext> Ctx) {
       MachO_arm64_GOTAndStubsBuilder(G).run();
       return Error::success();
     });
+
+    // Add GOT/Stubs optimizer pass.
+    Config.PostAllocationPasses.push_back(optimizeMachO_arm64_GOTAndStubs);
   }
 
   if (auto Err = Ctx->modifyPassConfig(TT, Config))
@@ -710,6 +808,8 @@ StringRef getMachOARM64RelocationKindName(Edge::Kind R) {
   switch (R) {
   case Branch26:
     return "Branch26";
+  case Branch26ToStub:
+    return "Branch26ToStub";
   case Pointer64:
     return "Pointer64";
   case Pointer64Anon:
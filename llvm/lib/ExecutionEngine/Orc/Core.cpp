@@ -1939,6 +1939,50 @@ ExecutionSession::lookup(const JITDylibSearchOrder &SearchOrder,
 #endif
 }
 
+std::vector<Expected<SymbolMap>> ExecutionSession::lookupBatch(
+    std::vector<BatchLookupQuery> Queries, LookupKind K,
+    SymbolState RequiredState,
+    RegisterDependenciesFunction RegisterDependencies) {
+  std::vector<Expected<SymbolMap>> Results;
+  if (Queries.empty())
+    return Results;
+  Results.reserve(Queries.size());
+  for (size_t I = 0; I != Queries.size(); ++I)
+    Results.push_back(SymbolMap());
+
+#if LLVM_ENABLE_THREADS
+  std::atomic<size_t> Outstanding(Queries.size());
+  std::promise<void> AllDonePromise;
+  auto AllDoneFuture = AllDonePromise.get_future();
+#endif
+
+  // Run any outstanding MUs before taking the session lock, for the same
+  // reason as in the single-query lookup above.
+  dispatchOutstandingMUs();
+
+  // The session mutex is recursive, so holding it across the loop folds the
+  // per-query acquisitions inside the lookup path into this one lock epoch
+  // instead of handing the lock off once per query.
+  runSessionLocked([&]() {
+    for (size_t I = 0; I != Queries.size(); ++I) {
+      auto NotifyComplete = [&, I](Expected<SymbolMap> R) {
+        Results[I] = std::move(R);
+#if LLVM_ENABLE_THREADS
+        if (--Outstanding == 0)
+          AllDonePromise.set_value();
+#endif
+      };
+      lookup(K, Queries[I].SearchOrder, std::move(Queries[I].Symbols),
+             RequiredState, std::move(NotifyComplete), RegisterDependencies);
+    }
+  });
+
+#if LLVM_ENABLE_THREADS
+  AllDoneFuture.get();
+#endif
+  return Results;
+}
+
 Expected<JITEvaluatedSymbol>
 ExecutionSession::lookup(const JITDylibSearchOrder &SearchOrder,
                          SymbolStringPtr Name, SymbolState RequiredState) {
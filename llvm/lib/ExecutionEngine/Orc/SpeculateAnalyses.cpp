@@ -15,6 +15,7 @@
 #include "llvm/Analysis/BlockFrequencyInfo.h"
 #include "llvm/Analysis/BranchProbabilityInfo.h"
 #include "llvm/Analysis/CFG.h"
+#include "llvm/IR/Module.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/Passes/PassBuilder.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -125,6 +126,47 @@ BlockFreqQuery::ResultTy BlockFreqQuery::operator()(Function &F) {
   return CallerAndCalles;
 }
 
+// CallGraphReachabilityQuery Implementation
+
+SpeculateQuery::ResultTy CallGraphReachabilityQuery::operator()(Function &F) {
+  DenseMap<StringRef, DenseSet<StringRef>> CallerAndCalles;
+  DenseSet<StringRef> Calles;
+  const Module *M = F.getParent();
+
+  SmallVector<const Function *, 8> CurrentLevel{&F};
+  SmallPtrSet<const Function *, 16> Visited;
+  Visited.insert(&F);
+
+  for (unsigned Depth = 0; Depth < MaxDepth && !CurrentLevel.empty() &&
+                           Calles.size() < MaxCandidates;
+       ++Depth) {
+    SmallVector<const Function *, 8> NextLevel;
+    for (const Function *Caller : CurrentLevel) {
+      DenseSet<StringRef> DirectCalles;
+      for (auto &BB : *Caller)
+        findCalles(&BB, DirectCalles);
+      for (StringRef Name : DirectCalles) {
+        if (Calles.size() >= MaxCandidates)
+          break;
+        Calles.insert(Name);
+        // Only callees defined in this module can be traversed further;
+        // external candidates are filtered against the impl table at
+        // speculation time, like the CFG-based queries' results.
+        if (const Function *Callee = M->getFunction(Name))
+          if (!Callee->isDeclaration() && Visited.insert(Callee).second)
+            NextLevel.push_back(Callee);
+      }
+    }
+    CurrentLevel = std::move(NextLevel);
+  }
+
+  if (Calles.empty())
+    return None;
+
+  CallerAndCalles.insert({F.getName(), std::move(Calles)});
+  return CallerAndCalles;
+}
+
 // SequenceBBQuery Implementation
 std::size_t SequenceBBQuery::getHottestBlocks(std::size_t TotalBlocks) {
   if (TotalBlocks == 1)
@@ -24,12 +24,12 @@ namespace orc {
 // ImplSymbolMap methods
 void ImplSymbolMap::trackImpls(SymbolAliasMap ImplMaps, JITDylib *SrcJD) {
   assert(SrcJD && "Tracking on Null Source .impl dylib");
-  std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
   for (auto &I : ImplMaps) {
-    auto It = Maps.insert({I.first, {I.second.Aliasee, SrcJD}});
+    bool Inserted =
+        Maps.try_emplace(I.first, AliaseeDetails(I.second.Aliasee, SrcJD));
     // check rationale when independent dylibs have same symbol name?
-    assert(It.second && "ImplSymbols are already tracked for this Symbol?");
-    (void)(It);
+    assert(Inserted && "ImplSymbols are already tracked for this Symbol?");
+    (void)(Inserted);
   }
 }
 
@@ -1241,8 +1241,18 @@ Expected<size_t> Pattern::match(StringRef Buffer, size_t &MatchLen,
   unsigned int Flags = Regex::Newline;
   if (IgnoreCase)
     Flags |= Regex::IgnoreCase;
-  if (!Regex(RegExToMatch, Flags).match(Buffer, &MatchInfo))
+  if (Substitutions.empty()) {
+    // The regex is the same for every match attempt, so compile it once and
+    // keep it. CHECK-DAG and CHECK-NOT can try the same pattern against many
+    // buffer positions over a run, and recompiling dominated matching time
+    // for large inputs.
+    if (!CompiledRegex)
+      CompiledRegex.emplace(RegExStr, Flags);
+    if (!CompiledRegex->match(Buffer, &MatchInfo))
+      return make_error<NotFoundError>();
+  } else if (!Regex(RegExToMatch, Flags).match(Buffer, &MatchInfo)) {
     return make_error<NotFoundError>();
+  }
 
   // Successful regex match.
   assert(!MatchInfo.empty() && "Didn't get any match");
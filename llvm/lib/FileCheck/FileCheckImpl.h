@@ -20,6 +20,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/FileCheck/FileCheck.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Regex.h"
 #include "llvm/Support/SourceMgr.h"
 #include <map>
 #include <string>
@@ -581,6 +582,11 @@ class Pattern {
   /// a fixed string to match.
   std::string RegExStr;
 
+  /// Compiled form of RegExStr, built lazily on first use. Only used for
+  /// patterns without substitutions, whose regex is the same for every match
+  /// attempt.
+  mutable Optional<Regex> CompiledRegex;
+
   /// Entries in this vector represent a substitution of a string variable or
   /// an expression in the RegExStr regex at match time. For example, in the
   /// case of a CHECK directive with the pattern "foo[[bar]]baz[[#N+1]]",
@@ -0,0 +1,94 @@
+//===- AnalysisCacheSnapshot.cpp - Keep analysis caches across runs -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/IR/AnalysisCacheSnapshot.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+
+using namespace llvm;
+
+uint64_t llvm::computeFunctionContentHash(const Function &F) {
+  // Number every local value up front so operand references hash the same
+  // way regardless of forward references (e.g. from phis). Unlike the
+  // structural hash used by the expensive-checks pass verifier, operands and
+  // immediate values are included: analyses such as alias analysis are
+  // sensitive to them.
+  DenseMap<const Value *, unsigned> ValueNumbers;
+  unsigned NextNumber = 0;
+  for (const Argument &A : F.args())
+    ValueNumbers[&A] = NextNumber++;
+  for (const BasicBlock &BB : F) {
+    ValueNumbers[&BB] = NextNumber++;
+    for (const Instruction &I : BB)
+      ValueNumbers[&I] = NextNumber++;
+  }
+
+  uint64_t Hash = hash_combine(F.isVarArg(), F.arg_size());
+  auto Update = [&Hash](uint64_t V) {
+    Hash = hashing::detail::hash_16_bytes(Hash, V);
+  };
+
+  for (const Argument &A : F.args())
+    Update(reinterpret_cast<uintptr_t>(A.getType()));
+
+  for (const BasicBlock &BB : F) {
+    Update(ValueNumbers.lookup(&BB));
+    for (const Instruction &I : BB) {
+      Update(I.getOpcode());
+      // Type pointers are uniqued within the context and live as long as it
+      // does, so their addresses are stable keys for in-process comparison.
+      Update(reinterpret_cast<uintptr_t>(I.getType()));
+      Update(I.getNumOperands());
+      for (const Use &Op : I.operands()) {
+        const Value *V = Op.get();
+        auto It = ValueNumbers.find(V);
+        if (It != ValueNumbers.end()) {
+          Update(It->second);
+        } else if (auto *CI = dyn_cast<ConstantInt>(V)) {
+          Update(hash_value(CI->getValue()));
+        } else {
+          // Globals, constant expressions, and other context-uniqued values.
+          Update(reinterpret_cast<uintptr_t>(V));
+        }
+      }
+    }
+  }
+  return Hash;
+}
+
+void FunctionAnalysisCacheSnapshot::take(const Module &M) {
+  Hashes.clear();
+  for (const Function &F : M)
+    if (!F.isDeclaration())
+      Hashes[&F] = computeFunctionContentHash(F);
+}
+
+unsigned FunctionAnalysisCacheSnapshot::refresh(Module &M,
+                                                FunctionAnalysisManager &FAM) {
+  unsigned NumInvalidated = 0;
+  DenseMap<const Function *, uint64_t> NewHashes;
+  for (Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    uint64_t Hash = computeFunctionContentHash(F);
+    auto It = Hashes.find(&F);
+    if (It == Hashes.end() || It->second != Hash) {
+      FAM.invalidate(F, PreservedAnalyses::none());
+      ++NumInvalidated;
+    }
+    NewHashes[&F] = Hash;
+  }
+  // Rebuilding the map also drops entries for functions that were deleted;
+  // the analysis manager must be told about those separately (via clear())
+  // before their memory is reused.
+  Hashes = std::move(NewHashes);
+  return NumInvalidated;
+}
@@ -1012,6 +1012,23 @@ ConstantRange::multiply(const ConstantRange &Other) const {
   // other. We calculate two ranges; one treating the inputs as unsigned
   // and the other signed, then return the smallest of these ranges.
 
+  // If the products of the unsigned bounds do not overflow and stay within
+  // the non-negative signed half, the result is exactly the unsigned range
+  // [umin1 * umin2, umax1 * umax2], and the general path below would return
+  // it unchanged through its positive-unsigned-range early exit. Checking the
+  // products directly keeps this common case free of the heap-allocated
+  // double-width temporaries the excursion below needs for bit widths above
+  // 32.
+  if (getBitWidth() <= APInt::APINT_BITS_PER_WORD) {
+    bool MinOverflow, MaxOverflow;
+    APInt NewMin =
+        getUnsignedMin().umul_ov(Other.getUnsignedMin(), MinOverflow);
+    APInt NewMax =
+        getUnsignedMax().umul_ov(Other.getUnsignedMax(), MaxOverflow);
+    if (!MinOverflow && !MaxOverflow && NewMax.isNonNegative())
+      return getNonEmpty(std::move(NewMin), NewMax + 1);
+  }
+
   // Unsigned range first.
   APInt this_min = getUnsignedMin().zext(getBitWidth() * 2);
   APInt this_max = getUnsignedMax().zext(getBitWidth() * 2);
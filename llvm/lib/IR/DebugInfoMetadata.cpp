@@ -56,9 +56,29 @@ DILocation *DILocation::getImpl(LLVMContext &Context, unsigned Line,
   adjustColumn(Column);
 
   if (Storage == Uniqued) {
-    if (auto *N = getUniqued(Context.pImpl->DILocations,
-                             DILocationInfo::KeyTy(Line, Column, Scope,
-                                                   InlinedAt, ImplicitCode)))
+    DILocationInfo::KeyTy Key(Line, Column, Scope, InlinedAt, ImplicitCode);
+
+    // In concurrent uniquing mode, hold the key's shard lock across the
+    // lookup and (on miss) the insertion so racing threads agree on a single
+    // node for the key.
+    if (Context.pImpl->DILocationUniquingShards) {
+      auto &Shard = Context.pImpl->getDILocationUniquingShard(
+          DILocationInfo::getHashValue(Key));
+      std::lock_guard<std::mutex> Guard(Shard.Lock);
+      if (auto *N = getUniqued(Shard.Set, Key))
+        return N;
+      if (!ShouldCreate)
+        return nullptr;
+      SmallVector<Metadata *, 2> Ops;
+      Ops.push_back(Scope);
+      if (InlinedAt)
+        Ops.push_back(InlinedAt);
+      return storeImpl(new (Ops.size()) DILocation(Context, Storage, Line,
+                                                   Column, Ops, ImplicitCode),
+                       Storage, Shard.Set);
+    }
+
+    if (auto *N = getUniqued(Context.pImpl->DILocations, Key))
       return N;
     if (!ShouldCreate)
       return nullptr;
@@ -22,6 +22,7 @@
 #include "llvm/IR/LLVMRemarkStreamer.h"
 #include "llvm/IR/Metadata.h"
 #include "llvm/IR/Module.h"
+#include "llvm/IR/User.h"
 #include "llvm/Remarks/RemarkStreamer.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -91,7 +92,17 @@ LLVMContext::LLVMContext() : pImpl(new LLVMContextImpl(*this)) {
   (void)SystemSSID;
 }
 
-LLVMContext::~LLVMContext() { delete pImpl; }
+LLVMContext::~LLVMContext() {
+  // Modules still owned by the context are deleted inside ~LLVMContextImpl,
+  // and User deallocation consults the thread-local arena pointer to
+  // recognize (and skip freeing) arena-backed storage. The pointer must
+  // therefore stay installed until the impl is gone; only then clear it, if
+  // it still refers to this context's arena.
+  BumpPtrAllocator *Arena = &pImpl->ValueArenaAlloc;
+  delete pImpl;
+  if (User::getThreadLocalValueArena() == Arena)
+    User::setThreadLocalValueArena(nullptr);
+}
 
 void LLVMContext::addModule(Module *M) {
   pImpl->OwnedModules.insert(M);
@@ -342,6 +353,34 @@ void LLVMContext::enableDebugTypeODRUniquing() {
 
 void LLVMContext::disableDebugTypeODRUniquing() { pImpl->DITypeMap.reset(); }
 
+bool LLVMContext::hasConcurrentDILocationUniquing() const {
+  return pImpl->DILocationUniquingShards != nullptr;
+}
+
+void LLVMContext::enableConcurrentDILocationUniquing() {
+  if (pImpl->DILocationUniquingShards)
+    return;
+
+  pImpl->DILocationUniquingShards =
+      std::make_unique<LLVMContextImpl::DILocationUniquingShard[]>(
+          LLVMContextImpl::NumDILocationUniquingShards);
+
+  // Migrate nodes uniqued before the switch so the unsharded table can stay
+  // untouched (and thus race-free) while the shards are live.
+  for (DILocation *L : pImpl->DILocations)
+    pImpl->getDILocationUniquingShard(DILocationInfo::getHashValue(L))
+        .Set.insert(L);
+  pImpl->DILocations.clear();
+}
+
+void LLVMContext::enableValueArena() {
+  User::setThreadLocalValueArena(&pImpl->ValueArenaAlloc);
+}
+
+void LLVMContext::disableValueArena() {
+  User::setThreadLocalValueArena(nullptr);
+}
+
 void LLVMContext::setDiscardValueNames(bool Discard) {
   pImpl->DiscardValueNames = Discard;
 }
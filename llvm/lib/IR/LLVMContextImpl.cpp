@@ -64,6 +64,10 @@ LLVMContextImpl::~LLVMContextImpl() {
   for (auto *I : CLASS##s)                                                     \
     I->dropAllReferences();
 #include "llvm/IR/Metadata.def"
+  if (DILocationUniquingShards)
+    for (unsigned S = 0; S != NumDILocationUniquingShards; ++S)
+      for (auto *I : DILocationUniquingShards[S].Set)
+        I->dropAllReferences();
 
   // Also drop references that come from the Value bridges.
   for (auto &Pair : ValuesAsMetadata)
@@ -78,6 +82,10 @@ LLVMContextImpl::~LLVMContextImpl() {
   for (CLASS * I : CLASS##s)                                                   \
     delete I;
 #include "llvm/IR/Metadata.def"
+  if (DILocationUniquingShards)
+    for (unsigned S = 0; S != NumDILocationUniquingShards; ++S)
+      for (DILocation *I : DILocationUniquingShards[S].Set)
+        delete I;
 
   // Free the constants.
   for (auto *I : ExprConstants)
@@ -46,6 +46,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -1371,6 +1372,22 @@ public:
   DenseSet<CLASS *, CLASS##Info> CLASS##s;
 #include "llvm/IR/Metadata.def"
 
+  /// Sharded DILocation uniquing tables, used instead of \c DILocations once
+  /// concurrent DILocation uniquing is enabled (see
+  /// LLVMContext::enableConcurrentDILocationUniquing()). Each shard is an
+  /// independently locked set selected by the key hash, so parallel import
+  /// threads sharing one context mostly contend on distinct shards.
+  struct DILocationUniquingShard {
+    std::mutex Lock;
+    DenseSet<DILocation *, DILocationInfo> Set;
+  };
+  static constexpr unsigned NumDILocationUniquingShards = 64;
+  std::unique_ptr<DILocationUniquingShard[]> DILocationUniquingShards;
+
+  DILocationUniquingShard &getDILocationUniquingShard(unsigned Hash) {
+    return DILocationUniquingShards[Hash % NumDILocationUniquingShards];
+  }
+
   // Optional map for looking up composite types by identifier.
   Optional<DenseMap<const MDString *, DICompositeType *>> DITypeMap;
 
@@ -1422,6 +1439,10 @@ public:
   BumpPtrAllocator Alloc;
   UniqueStringSaver Saver{Alloc};
 
+  /// Opt-in arena backing User allocations (see
+  /// LLVMContext::enableValueArena()); torn down wholesale with the context.
+  BumpPtrAllocator ValueArenaAlloc;
+
   DenseMap<unsigned, IntegerType*> IntegerTypes;
 
   using FunctionTypeSet = DenseSet<FunctionType *, FunctionTypeKeyInfo>;
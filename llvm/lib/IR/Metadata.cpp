@@ -781,6 +781,16 @@ template <class NodeTy> struct MDNode::HasCachedHash {
 MDNode *MDNode::uniquify() {
   assert(!hasSelfReference(this) && "Cannot uniquify a self-referencing node");
 
+  // DILocations live in sharded, locked tables when concurrent uniquing is
+  // enabled; route re-uniquing through the owning shard.
+  if (getContext().pImpl->DILocationUniquingShards)
+    if (auto *Loc = dyn_cast<DILocation>(this)) {
+      auto &Shard = getContext().pImpl->getDILocationUniquingShard(
+          DILocationInfo::getHashValue(Loc));
+      std::lock_guard<std::mutex> Guard(Shard.Lock);
+      return uniquifyImpl(Loc, Shard.Set);
+    }
+
   // Try to insert into uniquing store.
   switch (getMetadataID()) {
   default:
@@ -798,6 +808,15 @@ MDNode *MDNode::uniquify() {
 }
 
 void MDNode::eraseFromStore() {
+  if (getContext().pImpl->DILocationUniquingShards)
+    if (auto *Loc = dyn_cast<DILocation>(this)) {
+      auto &Shard = getContext().pImpl->getDILocationUniquingShard(
+          DILocationInfo::getHashValue(Loc));
+      std::lock_guard<std::mutex> Guard(Shard.Lock);
+      Shard.Set.erase(Loc);
+      return;
+    }
+
   switch (getMetadataID()) {
   default:
     llvm_unreachable("Invalid or non-uniquable subclass of MDNode");
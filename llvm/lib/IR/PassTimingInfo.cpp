@@ -24,6 +24,7 @@
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Mutex.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/TypeName.h"
 #include "llvm/Support/raw_ostream.h"
 #include <string>
@@ -271,23 +272,57 @@ void TimePassesHandler::runAfterPass(StringRef PassID) {
 }
 
 void TimePassesHandler::registerCallbacks(PassInstrumentationCallbacks &PIC) {
-  if (!Enabled)
-    return;
+  if (Enabled) {
+    PIC.registerBeforeNonSkippedPassCallback(
+        [this](StringRef P, Any) { this->runBeforePass(P); });
+    PIC.registerAfterPassCallback(
+        [this](StringRef P, Any, const PreservedAnalyses &) {
+          this->runAfterPass(P);
+        });
+    PIC.registerAfterPassInvalidatedCallback(
+        [this](StringRef P, const PreservedAnalyses &) {
+          this->runAfterPass(P);
+        });
+    PIC.registerBeforeAnalysisCallback(
+        [this](StringRef P, Any) { this->runBeforePass(P); });
+    PIC.registerAfterAnalysisCallback(
+        [this](StringRef P, Any) { this->runAfterPass(P); });
+  }
 
-  PIC.registerBeforeNonSkippedPassCallback(
-      [this](StringRef P, Any) { this->runBeforePass(P); });
-  PIC.registerAfterPassCallback(
-      [this](StringRef P, Any, const PreservedAnalyses &) {
-        this->runAfterPass(P);
-      });
-  PIC.registerAfterPassInvalidatedCallback(
-      [this](StringRef P, const PreservedAnalyses &) {
-        this->runAfterPass(P);
-      });
-  PIC.registerBeforeAnalysisCallback(
-      [this](StringRef P, Any) { this->runBeforePass(P); });
-  PIC.registerAfterAnalysisCallback(
-      [this](StringRef P, Any) { this->runAfterPass(P); });
+  // When -ftime-trace is active, emit pass and analysis runs as trace events
+  // so that per-pass costs show up in the hierarchical JSON profile. The
+  // legacy pass manager already does this in LegacyPassManager.cpp; this
+  // covers the new pass manager. The callbacks are balanced: every
+  // non-skipped pass sees either an after-pass or an after-pass-invalidated
+  // callback, so the events nest correctly.
+  if (timeTraceProfilerEnabled()) {
+    auto IsSpecial = [](StringRef P) {
+      return isSpecialPass(P,
+                           {"PassManager", "PassAdaptor", "AnalysisManagerProxy"});
+    };
+    PIC.registerBeforeNonSkippedPassCallback([IsSpecial](StringRef P, Any) {
+      if (!IsSpecial(P))
+        timeTraceProfilerBegin(P, StringRef(""));
+    });
+    PIC.registerAfterPassCallback(
+        [IsSpecial](StringRef P, Any, const PreservedAnalyses &) {
+          if (!IsSpecial(P))
+            timeTraceProfilerEnd();
+        });
+    PIC.registerAfterPassInvalidatedCallback(
+        [IsSpecial](StringRef P, const PreservedAnalyses &) {
+          if (!IsSpecial(P))
+            timeTraceProfilerEnd();
+        });
+    PIC.registerBeforeAnalysisCallback([IsSpecial](StringRef P, Any) {
+      if (!IsSpecial(P))
+        timeTraceProfilerBegin(P, StringRef(""));
+    });
+    PIC.registerAfterAnalysisCallback([IsSpecial](StringRef P, Any) {
+      if (!IsSpecial(P))
+        timeTraceProfilerEnd();
+    });
+  }
 }
 
 } // namespace llvm
@@ -14,6 +14,35 @@
 namespace llvm {
 class BasicBlock;
 
+//===----------------------------------------------------------------------===//
+//                         Arena-backed Value storage
+//===----------------------------------------------------------------------===//
+
+/// Arena from which User storage is drawn on this thread, or null for plain
+/// malloc. Installed via LLVMContext::enableValueArena().
+static LLVM_THREAD_LOCAL BumpPtrAllocator *ValueArena = nullptr;
+
+void User::setThreadLocalValueArena(BumpPtrAllocator *Arena) {
+  ValueArena = Arena;
+}
+
+BumpPtrAllocator *User::getThreadLocalValueArena() { return ValueArena; }
+
+static void *allocateValueStorage(size_t Size) {
+  if (BumpPtrAllocator *Arena = ValueArena)
+    return Arena->Allocate(Size, alignof(std::max_align_t));
+  return ::operator new(Size);
+}
+
+static void deallocateValueStorage(void *Storage) {
+  // Storage carved out of the arena is reclaimed in bulk when the arena is
+  // destroyed; individual frees are a no-op.
+  if (BumpPtrAllocator *Arena = ValueArena)
+    if (Arena->identifyObject(Storage))
+      return;
+  ::operator delete(Storage);
+}
+
 //===----------------------------------------------------------------------===//
 //                                 User Class
 //===----------------------------------------------------------------------===//
@@ -47,7 +76,7 @@ void User::allocHungoffUses(unsigned N, bool IsPhi) {
   size_t size = N * sizeof(Use);
   if (IsPhi)
     size += N * sizeof(BasicBlock *);
-  Use *Begin = static_cast<Use*>(::operator new(size));
+  Use *Begin = static_cast<Use *>(allocateValueStorage(size));
   Use *End = Begin + N;
   setOperandList(Begin);
   for (; Begin != End; Begin++)
@@ -76,7 +105,8 @@ void User::growHungoffUses(unsigned NewNumUses, bool IsPhi) {
     auto *NewPtr = reinterpret_cast<char *>(NewOps + NewNumUses);
     std::copy(OldPtr, OldPtr + (OldNumUses * sizeof(BasicBlock *)), NewPtr);
   }
-  Use::zap(OldOps, OldOps + OldNumUses, true);
+  Use::zap(OldOps, OldOps + OldNumUses, false);
+  deallocateValueStorage(OldOps);
 }
 
 
@@ -124,7 +154,7 @@ void *User::allocateFixedOperandUser(size_t Size, unsigned Us,
          "We need this to satisfy alignment constraints for Uses");
 
   uint8_t *Storage = static_cast<uint8_t *>(
-      ::operator new(Size + sizeof(Use) * Us + DescBytesToAllocate));
+      allocateValueStorage(Size + sizeof(Use) * Us + DescBytesToAllocate));
   Use *Start = reinterpret_cast<Use *>(Storage + DescBytesToAllocate);
   Use *End = Start + Us;
   User *Obj = reinterpret_cast<User*>(End);
@@ -152,7 +182,7 @@ void *User::operator new(size_t Size, unsigned Us, unsigned DescBytes) {
 
 void *User::operator new(size_t Size) {
   // Allocate space for a single Use*
-  void *Storage = ::operator new(Size + sizeof(Use *));
+  void *Storage = allocateValueStorage(Size + sizeof(Use *));
   Use **HungOffOperandList = static_cast<Use **>(Storage);
   User *Obj = reinterpret_cast<User *>(HungOffOperandList + 1);
   Obj->NumUserOperands = 0;
@@ -178,20 +208,21 @@ LLVM_NO_SANITIZE_MEMORY_ATTRIBUTE void User::operator delete(void *Usr) {
     Use **HungOffOperandList = static_cast<Use **>(Usr) - 1;
     // drop the hung off uses.
     Use::zap(*HungOffOperandList, *HungOffOperandList + Obj->NumUserOperands,
-             /* Delete */ true);
-    ::operator delete(HungOffOperandList);
+             /* Delete */ false);
+    deallocateValueStorage(*HungOffOperandList);
+    deallocateValueStorage(HungOffOperandList);
   } else if (Obj->HasDescriptor) {
     Use *UseBegin = static_cast<Use *>(Usr) - Obj->NumUserOperands;
     Use::zap(UseBegin, UseBegin + Obj->NumUserOperands, /* Delete */ false);
 
     auto *DI = reinterpret_cast<DescriptorInfo *>(UseBegin) - 1;
     uint8_t *Storage = reinterpret_cast<uint8_t *>(DI) - DI->SizeInBytes;
-    ::operator delete(Storage);
+    deallocateValueStorage(Storage);
   } else {
     Use *Storage = static_cast<Use *>(Usr) - Obj->NumUserOperands;
     Use::zap(Storage, Storage + Obj->NumUserOperands,
              /* Delete */ false);
-    ::operator delete(Storage);
+    deallocateValueStorage(Storage);
   }
 }
 
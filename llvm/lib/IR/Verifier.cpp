@@ -115,6 +115,16 @@
 
 using namespace llvm;
 
+// Restricts the verifier to checks that need neither a dominator tree nor a
+// walk of the metadata graph. JIT and (Thin)LTO pipelines verify every module
+// they touch, and for well-tested frontends the dominance and debug info
+// checks dominate the verifier's cost; this keeps the cheap structural
+// checks while skipping the expensive tiers.
+static cl::opt<bool> VerifyStructuralOnly(
+    "verify-structural-only", cl::Hidden, cl::init(false),
+    cl::desc("Restrict the IR verifier to cheap structural checks, skipping "
+             "dominance verification and deep metadata walks"));
+
 namespace llvm {
 
 struct VerifierSupport {
@@ -335,7 +345,7 @@ public:
     // out-of-date dominator tree and makes it significantly more complex to run
     // this code outside of a pass manager.
     // FIXME: It's really gross that we have to cast away constness here.
-    if (!F.empty())
+    if (!F.empty() && !VerifyStructuralOnly)
       DT.recalculate(const_cast<Function &>(F));
 
     for (const BasicBlock &BB : F) {
@@ -794,6 +804,11 @@ void Verifier::visitNamedMDNode(const NamedMDNode &NMD) {
 }
 
 void Verifier::visitMDNode(const MDNode &MD, AreDebugLocsAllowed AllowLocs) {
+  // The metadata graph reachable from a large module can be enormous, and
+  // recursing into it is the expensive tier of metadata verification.
+  if (VerifyStructuralOnly)
+    return;
+
   // Only visit each node once.  Metadata can be mutually recursive, so this
   // avoids infinite recursion here, as well as being an optimization.
   if (!MDNodes.insert(&MD).second)
@@ -4213,6 +4228,11 @@ void Verifier::verifyDominatesUse(Instruction &I, unsigned i) {
   if (!isa<PHINode>(I) && InstsInThisBlock.count(Op))
     return;
 
+  // In structural-only mode no dominator tree was computed, so the same-block
+  // fast path above is the only check we can do.
+  if (VerifyStructuralOnly)
+    return;
+
   const Use &U = I.getOperandUse(i);
   Assert(DT.dominates(Op, U),
          "Instruction does not dominate all uses!", Op, &I);
@@ -4289,7 +4309,10 @@ void Verifier::visitInstruction(Instruction &I) {
   BasicBlock *BB = I.getParent();
   Assert(BB, "Instruction not embedded in basic block!", &I);
 
-  if (!isa<PHINode>(I)) {   // Check that non-phi nodes are not self referential
+  // Check that non-phi nodes are not self referential. Self references are
+  // only tolerated in unreachable blocks, which we cannot tell apart without
+  // a dominator tree, so skip the check in structural-only mode.
+  if (!isa<PHINode>(I) && !VerifyStructuralOnly) {
     for (User *U : I.users()) {
       Assert(U != (User *)&I || !DT.isReachableFromEntry(BB),
              "Only PHI nodes may reference their own value!", &I);
@@ -4422,7 +4445,8 @@ void Verifier::visitInstruction(Instruction &I) {
     visitDereferenceableMetadata(I, MD);
 
   if (MDNode *TBAA = I.getMetadata(LLVMContext::MD_tbaa))
-    TBAAVerifyHelper.visitTBAAMetadata(I, TBAA);
+    if (!VerifyStructuralOnly)
+      TBAAVerifyHelper.visitTBAAMetadata(I, TBAA);
 
   if (MDNode *AlignMD = I.getMetadata(LLVMContext::MD_align)) {
     Assert(I.getType()->isPointerTy(), "align applies only to pointer types",
@@ -50,6 +50,8 @@
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
 #include "llvm/Transforms/IPO/WholeProgramDevirt.h"
 #include "llvm/Transforms/Utils/FunctionImportUtils.h"
+
+#include <limits>
 #include "llvm/Transforms/Utils/SplitModule.h"
 
 #include <set>
@@ -1087,30 +1089,6 @@ ArrayRef<const char*> LTO::getRuntimeLibcallSymbols() {
   return makeArrayRef(libcallRoutineNames);
 }
 
-/// This class defines the interface to the ThinLTO backend.
-class lto::ThinBackendProc {
-protected:
-  const Config &Conf;
-  ModuleSummaryIndex &CombinedIndex;
-  const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries;
-
-public:
-  ThinBackendProc(const Config &Conf, ModuleSummaryIndex &CombinedIndex,
-                  const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries)
-      : Conf(Conf), CombinedIndex(CombinedIndex),
-        ModuleToDefinedGVSummaries(ModuleToDefinedGVSummaries) {}
-
-  virtual ~ThinBackendProc() {}
-  virtual Error start(
-      unsigned Task, BitcodeModule BM,
-      const FunctionImporter::ImportMapTy &ImportList,
-      const FunctionImporter::ExportSetTy &ExportList,
-      const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
-      MapVector<StringRef, BitcodeModule> &ModuleMap) = 0;
-  virtual Error wait() = 0;
-  virtual unsigned getThreadCount() = 0;
-};
-
 namespace {
 class InProcessThinBackend : public ThinBackendProc {
   ThreadPool BackendThreadPool;
@@ -1240,6 +1218,87 @@ ThinBackend lto::createInProcessThinBackend(ThreadPoolStrategy Parallelism) {
   };
 }
 
+namespace {
+class OutOfProcessThinBackend : public ThinBackendProc {
+  AddStreamFn AddStream;
+  NativeObjectCache Cache;
+  ThinBackendDispatchFn Dispatch;
+  std::function<Error()> WaitFn;
+  std::set<GlobalValue::GUID> CfiFunctionDefs;
+  std::set<GlobalValue::GUID> CfiFunctionDecls;
+
+public:
+  OutOfProcessThinBackend(
+      const Config &Conf, ModuleSummaryIndex &CombinedIndex,
+      const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
+      AddStreamFn AddStream, NativeObjectCache Cache,
+      ThinBackendDispatchFn Dispatch, std::function<Error()> WaitFn)
+      : ThinBackendProc(Conf, CombinedIndex, ModuleToDefinedGVSummaries),
+        AddStream(std::move(AddStream)), Cache(std::move(Cache)),
+        Dispatch(std::move(Dispatch)), WaitFn(std::move(WaitFn)) {
+    for (auto &Name : CombinedIndex.cfiFunctionDefs())
+      CfiFunctionDefs.insert(
+          GlobalValue::getGUID(GlobalValue::dropLLVMManglingEscape(Name)));
+    for (auto &Name : CombinedIndex.cfiFunctionDecls())
+      CfiFunctionDecls.insert(
+          GlobalValue::getGUID(GlobalValue::dropLLVMManglingEscape(Name)));
+  }
+
+  Error start(
+      unsigned Task, BitcodeModule BM,
+      const FunctionImporter::ImportMapTy &ImportList,
+      const FunctionImporter::ExportSetTy &ExportList,
+      const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
+      MapVector<StringRef, BitcodeModule> &ModuleMap) override {
+    StringRef ModulePath = BM.getModuleIdentifier();
+    assert(ModuleToDefinedGVSummaries.count(ModulePath));
+
+    AddStreamFn TaskAddStream = AddStream;
+    if (Cache && CombinedIndex.modulePaths().count(ModulePath) &&
+        !all_of(CombinedIndex.getModuleHash(ModulePath),
+                [](uint32_t V) { return V == 0; })) {
+      const GVSummaryMapTy &DefinedGlobals =
+          ModuleToDefinedGVSummaries.find(ModulePath)->second;
+      SmallString<40> Key;
+      computeLTOCacheKey(Key, Conf, CombinedIndex, ModulePath, ImportList,
+                         ExportList, ResolvedODR, DefinedGlobals,
+                         CfiFunctionDefs, CfiFunctionDecls);
+      // A null stream callback means the result is already in the cache; the
+      // job can be elided entirely.
+      TaskAddStream = Cache(Task, Key);
+      if (!TaskAddStream)
+        return Error::success();
+    }
+    return Dispatch(Task, BM, ImportList, std::move(TaskAddStream));
+  }
+
+  Error wait() override {
+    if (WaitFn)
+      return WaitFn();
+    return Error::success();
+  }
+
+  // Jobs run with whatever parallelism the remote executor provides. Report
+  // more than one thread so that modules are dispatched largest-first rather
+  // than in command-line order.
+  unsigned getThreadCount() override {
+    return std::numeric_limits<unsigned>::max();
+  }
+};
+} // end anonymous namespace
+
+ThinBackend lto::createOutOfProcessThinBackend(ThinBackendDispatchFn Dispatch,
+                                               std::function<Error()> Wait) {
+  return [Dispatch = std::move(Dispatch), Wait = std::move(Wait)](
+             const Config &Conf, ModuleSummaryIndex &CombinedIndex,
+             const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
+             AddStreamFn AddStream, NativeObjectCache Cache) {
+    return std::make_unique<OutOfProcessThinBackend>(
+        Conf, CombinedIndex, ModuleToDefinedGVSummaries, std::move(AddStream),
+        std::move(Cache), Dispatch, Wait);
+  };
+}
+
 // Given the original \p Path to an output file, replace any path
 // prefix matching \p OldPrefix with \p NewPrefix. Also, create the
 // resulting directory if it does not yet exist.
@@ -1296,8 +1355,9 @@ public:
                                      ImportList, ModuleToSummariesForIndex);
 
     std::error_code EC;
-    raw_fd_ostream OS(NewModulePath + ".thinlto.bc", EC,
-                      sys::fs::OpenFlags::OF_None);
+    // Open the index file as a raw_fd_stream so the bitcode writer can flush
+    // completed blocks to disk instead of buffering the whole index.
+    raw_fd_stream OS(NewModulePath + ".thinlto.bc", EC);
     if (EC)
       return errorCodeToError(EC);
     WriteIndexToFile(CombinedIndex, OS, &ModuleToSummariesForIndex);
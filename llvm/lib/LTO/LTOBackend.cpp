@@ -112,7 +112,10 @@ Error Config::addSaveTemps(std::string OutputFileName,
         PathPrefix = M.getModuleIdentifier() + ".";
       std::string Path = PathPrefix + PathSuffix + ".bc";
       std::error_code EC;
-      raw_fd_ostream OS(Path, EC, sys::fs::OpenFlags::OF_None);
+      // Open as a raw_fd_stream so the bitcode writer streams the module to
+      // disk rather than buffering it all; -save-temps runs while the backend
+      // threads are at peak memory use.
+      raw_fd_stream OS(Path, EC);
       // Because -save-temps is a debugging feature, we report the error
       // directly and exit.
       if (EC)
@@ -134,7 +137,7 @@ Error Config::addSaveTemps(std::string OutputFileName,
           const DenseSet<GlobalValue::GUID> &GUIDPreservedSymbols) {
         std::string Path = OutputFileName + "index.bc";
         std::error_code EC;
-        raw_fd_ostream OS(Path, EC, sys::fs::OpenFlags::OF_None);
+        raw_fd_stream OS(Path, EC);
         // Because -save-temps is a debugging feature, we report the error
         // directly and exit.
         if (EC)
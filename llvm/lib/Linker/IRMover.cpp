@@ -8,6 +8,7 @@
 
 #include "llvm/Linker/IRMover.h"
 #include "LinkDiagnosticInfo.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Triple.h"
@@ -72,16 +73,123 @@ public:
   }
 
 private:
+  /// Per-link cache of structural hashes for source struct types. Unlike the
+  /// destination cache in DstStructTypesSet this also records failures (None),
+  /// since source types are never mutated during a link.
+  DenseMap<StructType *, Optional<uint64_t>> SrcStructuralHashes;
+
   Type *remapType(Type *SrcTy) override { return get(SrcTy); }
 
+  bool mayBeIsomorphic(Type *DstTy, Type *SrcTy);
   bool areTypesIsomorphic(Type *DstTy, Type *SrcTy);
 };
 }
 
+/// Maximum number of types visited by a structural hash walk. Pathological
+/// type DAGs can make an unmemoized walk exponential; beyond this budget we
+/// give up on hashing and let the full isomorphism check decide.
+static const unsigned MaxStructuralHashSteps = 64;
+
+/// Compute a hash over the structure of \p Ty such that any two isomorphic
+/// type graphs hash identically, regardless of the struct identities (and
+/// names) involved. Returns None if no such hash can be assigned: type graphs
+/// containing opaque structs unify with arbitrary definitions, and the walk
+/// gives up once \p Budget is exhausted.
+///
+/// Recursive types are handled by encoding a back-edge as the position of its
+/// target on the current visit path (\p OnPath), which is identical for
+/// corresponding back-edges of isomorphic graphs.
+static Optional<uint64_t>
+computeStructuralHash(Type *Ty, unsigned &Budget,
+                      SmallDenseMap<StructType *, unsigned, 8> &OnPath) {
+  if (Budget == 0)
+    return None;
+  --Budget;
+
+  if (auto *IT = dyn_cast<IntegerType>(Ty))
+    return hash_combine(Ty->getTypeID(), IT->getBitWidth());
+
+  hash_code Hash = hash_combine(Ty->getTypeID());
+  if (auto *PT = dyn_cast<PointerType>(Ty)) {
+    Hash = hash_combine(Hash, PT->getAddressSpace());
+  } else if (auto *FT = dyn_cast<FunctionType>(Ty)) {
+    Hash = hash_combine(Hash, FT->isVarArg());
+  } else if (auto *AT = dyn_cast<ArrayType>(Ty)) {
+    Hash = hash_combine(Hash, AT->getNumElements());
+  } else if (auto *VT = dyn_cast<VectorType>(Ty)) {
+    Hash = hash_combine(Hash, VT->getElementCount().getKnownMinValue(),
+                        VT->getElementCount().isScalable());
+  } else if (auto *ST = dyn_cast<StructType>(Ty)) {
+    if (ST->isOpaque())
+      return None;
+    auto Inserted = OnPath.insert({ST, OnPath.size()});
+    if (!Inserted.second)
+      return hash_combine(Hash, Inserted.first->second);
+    Hash = hash_combine(Hash, ST->isPacked(), ST->isLiteral());
+  }
+
+  Hash = hash_combine(Hash, Ty->getNumContainedTypes());
+  for (Type *ETy : Ty->subtypes()) {
+    Optional<uint64_t> EHash = computeStructuralHash(ETy, Budget, OnPath);
+    if (!EHash)
+      return None;
+    Hash = hash_combine(Hash, *EHash);
+  }
+  if (auto *ST = dyn_cast<StructType>(Ty))
+    OnPath.erase(ST);
+  return uint64_t(Hash);
+}
+
+static Optional<uint64_t> computeStructuralHash(Type *Ty) {
+  unsigned Budget = MaxStructuralHashSteps;
+  SmallDenseMap<StructType *, unsigned, 8> OnPath;
+  return computeStructuralHash(Ty, Budget, OnPath);
+}
+
+/// Cheaply decide whether \p DstTy and \p SrcTy could be isomorphic by
+/// comparing their structural hashes, without the speculative mappings and
+/// rollback of the full recursive check. Pairs whose hashes differ are
+/// definitely not isomorphic; when either hash is unavailable (opaque structs
+/// involved, which unify with arbitrary definitions, or a graph too large to
+/// hash) the full check decides.
+bool TypeMapTy::mayBeIsomorphic(Type *DstTy, Type *SrcTy) {
+  if (DstTy == SrcTy || DstTy->getTypeID() != SrcTy->getTypeID())
+    return true;
+
+  Optional<uint64_t> DstHash;
+  if (auto *DstST = dyn_cast<StructType>(DstTy))
+    DstHash = DstStructTypesSet.getStructuralHash(DstST);
+  else
+    DstHash = computeStructuralHash(DstTy);
+  if (!DstHash)
+    return true;
+
+  Optional<uint64_t> SrcHash;
+  if (auto *SrcST = dyn_cast<StructType>(SrcTy)) {
+    auto Inserted = SrcStructuralHashes.insert({SrcST, None});
+    if (Inserted.second)
+      Inserted.first->second = computeStructuralHash(SrcTy);
+    SrcHash = Inserted.first->second;
+  } else {
+    SrcHash = computeStructuralHash(SrcTy);
+  }
+  if (!SrcHash)
+    return true;
+
+  return *DstHash == *SrcHash;
+}
+
 void TypeMapTy::addTypeMapping(Type *DstTy, Type *SrcTy) {
   assert(SpeculativeTypes.empty());
   assert(SpeculativeDstOpaqueTypes.empty());
 
+  // Reject pairs whose structural hashes prove they cannot be isomorphic
+  // before doing the recursive walk below; for repeated near-miss candidates
+  // (common when many modules define same-named but different types) the
+  // walk and its rollback are quadratic in aggregate.
+  if (!mayBeIsomorphic(DstTy, SrcTy))
+    return;
+
   // Check to see if these types are recursively isomorphic and establish a
   // mapping between them if so.
   if (!areTypesIsomorphic(DstTy, SrcTy)) {
@@ -1569,6 +1677,19 @@ bool IRMover::IdentifiedStructTypeSet::hasType(StructType *Ty) {
   return I == NonOpaqueStructTypes.end() ? false : *I == Ty;
 }
 
+Optional<uint64_t>
+IRMover::IdentifiedStructTypeSet::getStructuralHash(StructType *Ty) {
+  auto I = StructuralHashes.find(Ty);
+  if (I != StructuralHashes.end())
+    return I->second;
+  // Only cache successful hashes: a failure caused by a reachable opaque
+  // struct may turn into a hash once that struct is resolved.
+  Optional<uint64_t> Hash = computeStructuralHash(Ty);
+  if (Hash)
+    StructuralHashes.insert({Ty, *Hash});
+  return Hash;
+}
+
 IRMover::IRMover(Module &M) : Composite(M) {
   TypeFinder StructTypes;
   StructTypes.run(M, /* OnlyNamed */ false);
@@ -809,6 +809,29 @@ MCAssembler::handleFixup(const MCAsmLayout &Layout, MCFragment &F,
   return std::make_tuple(Target, FixedValue, IsResolved);
 }
 
+/// Check whether the size of any fragment in \p Sec can change during layout,
+/// either because the fragment is subject to relaxation or because its size is
+/// computed from expressions or offsets that relaxation elsewhere may move.
+static bool hasLayoutDependentFragments(const MCSection &Sec) {
+  for (const MCFragment &F : Sec) {
+    switch (F.getKind()) {
+    default:
+      break;
+    case MCFragment::FT_Relaxable:
+    case MCFragment::FT_Dwarf:
+    case MCFragment::FT_DwarfFrame:
+    case MCFragment::FT_LEB:
+    case MCFragment::FT_BoundaryAlign:
+    case MCFragment::FT_CVInlineLines:
+    case MCFragment::FT_CVDefRange:
+    case MCFragment::FT_Fill:
+    case MCFragment::FT_Org:
+      return true;
+    }
+  }
+  return false;
+}
+
 void MCAssembler::layout(MCAsmLayout &Layout) {
   assert(getBackendPtr() && "Expected assembler backend");
   DEBUG_WITH_TYPE("mc-dump", {
@@ -836,15 +859,27 @@ void MCAssembler::layout(MCAsmLayout &Layout) {
       Frag.setLayoutOrder(FragmentIndex++);
   }
 
+  // Only sections containing layout-dependent fragments can change size
+  // during the iteration below; everything else (notably the large data and
+  // debug payload sections of instrumented builds) keeps its layout, so
+  // identify the interesting sections once up front rather than rescanning
+  // the whole object on every pass.
+  SmallVector<MCSection *, 16> LayoutDependentSections;
+  for (MCSection &Sec : *this)
+    if (hasLayoutDependentFragments(Sec))
+      LayoutDependentSections.push_back(&Sec);
+
   // Layout until everything fits.
-  while (layoutOnce(Layout)) {
+  while (layoutOnce(Layout, LayoutDependentSections)) {
     if (getContext().hadError())
       return;
     // Size of fragments in one section can depend on the size of fragments in
     // another. If any fragment has changed size, we have to re-layout (and
-    // as a result possibly further relax) all.
-    for (MCSection &Sec : *this)
-      Layout.invalidateFragmentsFrom(&*Sec.begin());
+    // as a result possibly further relax) all layout-dependent sections.
+    // Sections without layout-dependent fragments have constant fragment
+    // sizes, so their cached offsets remain correct.
+    for (MCSection *Sec : LayoutDependentSections)
+      Layout.invalidateFragmentsFrom(&*Sec->begin());
   }
 
   DEBUG_WITH_TYPE("mc-dump", {
@@ -1215,12 +1250,13 @@ bool MCAssembler::layoutSectionOnce(MCAsmLayout &Layout, MCSection &Sec) {
   return false;
 }
 
-bool MCAssembler::layoutOnce(MCAsmLayout &Layout) {
+bool MCAssembler::layoutOnce(MCAsmLayout &Layout,
+                             ArrayRef<MCSection *> LayoutDependentSections) {
   ++stats::RelaxationSteps;
 
   bool WasRelaxed = false;
-  for (MCSection &Sec : *this) {
-    while (layoutSectionOnce(Layout, Sec))
+  for (MCSection *Sec : LayoutDependentSections) {
+    while (layoutSectionOnce(Layout, *Sec))
       WasRelaxed = true;
   }
 
@@ -25,6 +25,7 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/ToolOutputFile.h"
@@ -415,6 +416,37 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
   std::vector<MemberData> Ret;
   bool HasObject = false;
 
+  // Extract the symbols from all members up front. The object readers are
+  // independent of each other, so this can be done in parallel; for large
+  // archives symbol extraction dominates writing time. Each member gets its
+  // own name buffer, and the local offsets are rebased when the buffers are
+  // concatenated into SymNames below.
+  struct MemberSymbolData {
+    std::vector<unsigned> Offsets;
+    SmallString<0> Names;
+    bool HasObject = false;
+  };
+  std::vector<MemberSymbolData> SymbolData;
+  if (NeedSymbols) {
+    SymbolData.resize(NewMembers.size());
+    std::vector<Error> Errors;
+    for (size_t I = 0, E = NewMembers.size(); I != E; ++I)
+      Errors.push_back(Error::success());
+    parallelForEachN(0, NewMembers.size(), [&](size_t I) {
+      raw_svector_ostream NamesOS(SymbolData[I].Names);
+      Expected<std::vector<unsigned>> SymbolsOrErr =
+          getSymbols(NewMembers[I].Buf->getMemBufferRef(), NamesOS,
+                     SymbolData[I].HasObject);
+      if (SymbolsOrErr)
+        SymbolData[I].Offsets = std::move(*SymbolsOrErr);
+      else
+        Errors[I] = SymbolsOrErr.takeError();
+    });
+    for (Error &E : Errors)
+      if (E)
+        return std::move(E);
+  }
+
   // Deduplicate long member names in the string table and reuse earlier name
   // offsets. This especially saves space for COFF Import libraries where all
   // members have the same name.
@@ -470,7 +502,8 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
-  for (const NewArchiveMember &M : NewMembers) {
+  for (size_t MI = 0, ME = NewMembers.size(); MI != ME; ++MI) {
+    const NewArchiveMember &M = NewMembers[MI];
     std::string Header;
     raw_string_ostream Out(Header);
 
@@ -508,11 +541,13 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
     std::vector<unsigned> Symbols;
     if (NeedSymbols) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(Buf, SymNames, HasObject);
-      if (auto E = SymbolsOrErr.takeError())
-        return std::move(E);
-      Symbols = std::move(*SymbolsOrErr);
+      MemberSymbolData &MS = SymbolData[MI];
+      unsigned Base = SymNames.tell();
+      Symbols = std::move(MS.Offsets);
+      for (unsigned &Offset : Symbols)
+        Offset += Base;
+      SymNames << MS.Names;
+      HasObject |= MS.HasObject;
     }
 
     Pos += Header.size() + Data.size() + Padding.size();
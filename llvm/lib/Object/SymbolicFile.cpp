@@ -94,6 +94,17 @@ SymbolicFile::createSymbolicFile(MemoryBufferRef Object, file_magic Type,
   }
 }
 
+Error SymbolicFile::getSymbolDescriptors(
+    std::vector<BasicSymbolDescriptor> &Descriptors) const {
+  for (const BasicSymbolRef &Sym : symbols()) {
+    Expected<uint32_t> FlagsOrErr = Sym.getFlags();
+    if (!FlagsOrErr)
+      return FlagsOrErr.takeError();
+    Descriptors.push_back({Sym, *FlagsOrErr});
+  }
+  return Error::success();
+}
+
 bool SymbolicFile::isSymbolicFile(file_magic Type, const LLVMContext *Context) {
   switch (Type) {
   case file_magic::bitcode:
@@ -19,6 +19,7 @@
 #include "llvm/Analysis/CallGraphSCCPass.h"
 #include "llvm/Analysis/LazyCallGraph.h"
 #include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassInstrumentation.h"
@@ -26,8 +27,12 @@
 #include "llvm/IR/Verifier.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+#include <chrono>
 #include <unordered_set>
 #include <vector>
 
@@ -856,6 +861,85 @@ void VerifyInstrumentation::registerCallbacks(
       });
 }
 
+// An option for use by external bisection tooling: after every pass that
+// changed the module, write a bitcode snapshot into the given directory, and
+// record every pass run in <dir>/index.txt together with its wall time and
+// the snapshot it produced. Snapshots are deduplicated by hashing the
+// bitcode, so a pass that makes no change costs one serialization but no
+// disk space.
+static cl::opt<std::string> IRSnapshotDir(
+    "ir-snapshot-dir", cl::Hidden, cl::value_desc("directory"),
+    cl::desc("Write a bitcode snapshot of the module after every pass that "
+             "changes the IR into the given directory, with an index "
+             "recording the pass sequence and per-pass wall time"));
+
+void IRSnapshotInstrumentation::registerCallbacks(
+    PassInstrumentationCallbacks &PIC) {
+  if (IRSnapshotDir.empty())
+    return;
+
+  std::error_code EC = sys::fs::create_directories(IRSnapshotDir);
+  if (!EC) {
+    SmallString<128> IndexPath(IRSnapshotDir);
+    sys::path::append(IndexPath, "index.txt");
+    IndexOS = std::make_unique<raw_fd_ostream>(IndexPath, EC, sys::fs::OF_Text);
+  }
+  if (EC)
+    report_fatal_error(Twine("unable to set up IR snapshot directory '") +
+                       IRSnapshotDir + "': " + EC.message());
+
+  PIC.registerBeforeNonSkippedPassCallback([this](StringRef, Any) {
+    StartTimes.push_back(std::chrono::steady_clock::now());
+  });
+  PIC.registerAfterPassCallback(
+      [this](StringRef P, Any IR, const PreservedAnalyses &) {
+        recordAfterPass(P, IR, /*Invalidated=*/false);
+      });
+  PIC.registerAfterPassInvalidatedCallback(
+      [this](StringRef P, const PreservedAnalyses &) {
+        recordAfterPass(P, Any(), /*Invalidated=*/true);
+      });
+}
+
+void IRSnapshotInstrumentation::recordAfterPass(StringRef PassID, Any IR,
+                                                bool Invalidated) {
+  assert(!StartTimes.empty() && "unbalanced pass instrumentation callbacks");
+  auto WallTime = std::chrono::steady_clock::now() - StartTimes.pop_back_val();
+  auto Micros =
+      std::chrono::duration_cast<std::chrono::microseconds>(WallTime).count();
+
+  // Pass managers and adaptors get an index line for their accumulated wall
+  // time, but never a snapshot of their own; a pass whose IR unit was
+  // invalidated cannot be snapshotted at all.
+  std::string SnapshotFile = "-";
+  if (!Invalidated && !isIgnored(PassID)) {
+    const Module *M = unwrapModule(IR, /*Force=*/true)->first;
+    SmallString<0> Bitcode;
+    raw_svector_ostream BitcodeOS(Bitcode);
+    WriteBitcodeToFile(*M, BitcodeOS);
+
+    uint64_t Hash = xxHash64(Bitcode);
+    if (Hash != LastSnapshotHash) {
+      LastSnapshotHash = Hash;
+      SnapshotFile = formatv("{0}.bc", EventIndex).str();
+
+      std::error_code EC;
+      SmallString<128> Path(IRSnapshotDir);
+      sys::path::append(Path, SnapshotFile);
+      raw_fd_ostream OS(Path, EC, sys::fs::OF_None);
+      if (EC)
+        report_fatal_error(Twine("unable to write IR snapshot '") + Path +
+                           "': " + EC.message());
+      OS << Bitcode;
+    }
+  }
+
+  // Line format: <event> <wall-time-us> <snapshot file or -> <pass>.
+  *IndexOS << EventIndex << ' ' << Micros << ' ' << SnapshotFile << ' '
+           << PassID << '\n';
+  ++EventIndex;
+}
+
 void StandardInstrumentations::registerCallbacks(
     PassInstrumentationCallbacks &PIC) {
   PrintIR.registerCallbacks(PIC);
@@ -865,6 +949,7 @@ void StandardInstrumentations::registerCallbacks(
   OptBisect.registerCallbacks(PIC);
   PreservedCFGChecker.registerCallbacks(PIC);
   PrintChangedIR.registerCallbacks(PIC);
+  IRSnapshots.registerCallbacks(PIC);
   if (VerifyEach)
     Verify.registerCallbacks(PIC);
 }
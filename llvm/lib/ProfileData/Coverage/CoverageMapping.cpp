@@ -242,6 +242,17 @@ Error CoverageMapping::loadFunctionRecord(
       Record.MappingRegions[0].Count.isZero() && Counts[0] > 0)
     return Error::success();
 
+  // Don't create records for (filenames, function) pairs we've already seen.
+  // Duplicates are common when an inline function is instrumented in many
+  // TUs, so check before evaluating the regions rather than after; records
+  // that fail to evaluate below don't claim provenance, hence the deferred
+  // insertion.
+  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
+                                          Record.Filenames.end());
+  auto FuncNameHash = hash_value(OrigFuncName);
+  if (RecordProvenance[FilenamesHash].count(FuncNameHash))
+    return Error::success();
+
   FunctionRecord Function(OrigFuncName, Record.Filenames);
   for (const auto &Region : Record.MappingRegions) {
     Expected<int64_t> ExecutionCount = Ctx.evaluate(Region.Count);
@@ -252,11 +263,7 @@ Error CoverageMapping::loadFunctionRecord(
     Function.pushRegion(Region, *ExecutionCount);
   }
 
-  // Don't create records for (filenames, function) pairs we've already seen.
-  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
-                                          Record.Filenames.end());
-  if (!RecordProvenance[FilenamesHash].insert(hash_value(OrigFuncName)).second)
-    return Error::success();
+  RecordProvenance[FilenamesHash].insert(FuncNameHash);
 
   Functions.push_back(std::move(Function));
 
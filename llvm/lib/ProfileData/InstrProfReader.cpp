@@ -39,9 +39,10 @@
 using namespace llvm;
 
 static Expected<std::unique_ptr<MemoryBuffer>>
-setupMemoryBuffer(const Twine &Path) {
+setupMemoryBuffer(const Twine &Path, bool RequiresNullTerminator = true) {
   ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
-      MemoryBuffer::getFileOrSTDIN(Path);
+      MemoryBuffer::getFileOrSTDIN(Path, /*FileSize=*/-1,
+                                   RequiresNullTerminator);
   if (std::error_code EC = BufferOrErr.getError())
     return errorCodeToError(EC);
   return std::move(BufferOrErr.get());
@@ -91,8 +92,12 @@ InstrProfReader::create(std::unique_ptr<MemoryBuffer> Buffer) {
 
 Expected<std::unique_ptr<IndexedInstrProfReader>>
 IndexedInstrProfReader::create(const Twine &Path, const Twine &RemappingPath) {
-  // Set up the buffer to read.
-  auto BufferOrError = setupMemoryBuffer(Path);
+  // Set up the buffer to read. The indexed format is read with explicit
+  // bounds and never relies on a terminating NUL, so don't request one:
+  // requiring it forces a private in-memory copy whenever the file size is a
+  // multiple of the page size, whereas a plain mmap lets concurrent readers
+  // of a large profile share a single page-cache copy.
+  auto BufferOrError = setupMemoryBuffer(Path, /*RequiresNullTerminator=*/false);
   if (Error E = BufferOrError.takeError())
     return std::move(E);
 
@@ -535,6 +540,20 @@ bool InstrProfLookupTrait::readValueProfilingData(
   return true;
 }
 
+/// Advance \p D past a serialized ValueProfData without deserializing it.
+bool InstrProfLookupTrait::skipValueProfilingData(
+    const unsigned char *&D, const unsigned char *const End) {
+  using namespace support;
+
+  if (D + sizeof(uint32_t) > End)
+    return false;
+  uint32_t TotalSize = endian::read<uint32_t>(D, ValueProfDataEndianness);
+  if (TotalSize % sizeof(uint64_t) || D + TotalSize > End)
+    return false;
+  D += TotalSize;
+  return true;
+}
+
 data_type InstrProfLookupTrait::ReadData(StringRef K, const unsigned char *D,
                                          offset_type N) {
   using namespace support;
@@ -574,7 +593,8 @@ data_type InstrProfLookupTrait::ReadData(StringRef K, const unsigned char *D,
 
     // Read value profiling data.
     if (GET_VERSION(FormatVersion) > IndexedInstrProf::ProfVersion::Version2 &&
-        !readValueProfilingData(D, End)) {
+        !(SkipValueProfData ? skipValueProfilingData(D, End)
+                            : readValueProfilingData(D, End))) {
       DataBuffer.clear();
       return data_type();
     }
@@ -895,11 +915,15 @@ IndexedInstrProfReader::getInstrProfRecord(StringRef FuncName,
 Error IndexedInstrProfReader::getFunctionCounts(StringRef FuncName,
                                                 uint64_t FuncHash,
                                                 std::vector<uint64_t> &Counts) {
+  // Only the counters are needed, so don't pay for deserializing the value
+  // profile data attached to the records.
+  Index->setSkipValueProfData(true);
   Expected<InstrProfRecord> Record = getInstrProfRecord(FuncName, FuncHash);
+  Index->setSkipValueProfData(false);
   if (Error E = Record.takeError())
     return error(std::move(E));
 
-  Counts = Record.get().Counts;
+  Counts = std::move(Record.get().Counts);
   return success();
 }
 
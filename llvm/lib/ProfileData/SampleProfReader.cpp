@@ -1075,25 +1075,27 @@ std::error_code SampleProfileReaderBinary::readSummary() {
   return sampleprof_error::success;
 }
 
-bool SampleProfileReaderRawBinary::hasFormat(const MemoryBuffer &Buffer) {
+/// Decode the magic number from the start of \p Buffer, without reading past
+/// its end. The buffer is not necessarily null terminated.
+static uint64_t decodeMagic(const MemoryBuffer &Buffer) {
   const uint8_t *Data =
       reinterpret_cast<const uint8_t *>(Buffer.getBufferStart());
-  uint64_t Magic = decodeULEB128(Data);
-  return Magic == SPMagic();
+  const char *Error = nullptr;
+  uint64_t Magic =
+      decodeULEB128(Data, nullptr, Data + Buffer.getBufferSize(), &Error);
+  return Error ? 0 : Magic;
+}
+
+bool SampleProfileReaderRawBinary::hasFormat(const MemoryBuffer &Buffer) {
+  return decodeMagic(Buffer) == SPMagic();
 }
 
 bool SampleProfileReaderExtBinary::hasFormat(const MemoryBuffer &Buffer) {
-  const uint8_t *Data =
-      reinterpret_cast<const uint8_t *>(Buffer.getBufferStart());
-  uint64_t Magic = decodeULEB128(Data);
-  return Magic == SPMagic(SPF_Ext_Binary);
+  return decodeMagic(Buffer) == SPMagic(SPF_Ext_Binary);
 }
 
 bool SampleProfileReaderCompactBinary::hasFormat(const MemoryBuffer &Buffer) {
-  const uint8_t *Data =
-      reinterpret_cast<const uint8_t *>(Buffer.getBufferStart());
-  uint64_t Magic = decodeULEB128(Data);
-  return Magic == SPMagic(SPF_Compact_Binary);
+  return decodeMagic(Buffer) == SPMagic(SPF_Compact_Binary);
 }
 
 std::error_code SampleProfileReaderGCC::skipNextWord() {
@@ -1376,8 +1378,9 @@ SampleProfileReaderItaniumRemapper::lookUpNameInProfile(StringRef Fname) {
 ///
 /// \returns an error code indicating the status of the buffer.
 static ErrorOr<std::unique_ptr<MemoryBuffer>>
-setupMemoryBuffer(const Twine &Filename) {
-  auto BufferOrErr = MemoryBuffer::getFileOrSTDIN(Filename);
+setupMemoryBuffer(const Twine &Filename, bool RequiresNullTerminator = true) {
+  auto BufferOrErr = MemoryBuffer::getFileOrSTDIN(Filename, /*FileSize=*/-1,
+                                                  RequiresNullTerminator);
   if (std::error_code EC = BufferOrErr.getError())
     return EC;
   auto Buffer = std::move(BufferOrErr.get());
@@ -1401,9 +1404,23 @@ setupMemoryBuffer(const Twine &Filename) {
 ErrorOr<std::unique_ptr<SampleProfileReader>>
 SampleProfileReader::create(const std::string Filename, LLVMContext &C,
                             const std::string RemapFilename) {
-  auto BufferOrError = setupMemoryBuffer(Filename);
+  // Map the profile without requiring a null terminator, so that large binary
+  // profiles are always mmapped and their pages shared between parallel
+  // compiles instead of being copied into private memory. The text and GCC
+  // readers scan the buffer as a string, so if the file is not one of the
+  // LLVM binary formats, reload it with a null terminator.
+  auto BufferOrError =
+      setupMemoryBuffer(Filename, /*RequiresNullTerminator=*/false);
   if (std::error_code EC = BufferOrError.getError())
     return EC;
+  auto &Buffer = BufferOrError.get();
+  if (!SampleProfileReaderRawBinary::hasFormat(*Buffer) &&
+      !SampleProfileReaderExtBinary::hasFormat(*Buffer) &&
+      !SampleProfileReaderCompactBinary::hasFormat(*Buffer)) {
+    BufferOrError = setupMemoryBuffer(Filename);
+    if (std::error_code EC = BufferOrError.getError())
+      return EC;
+  }
   return create(BufferOrError.get(), C, RemapFilename);
 }
 
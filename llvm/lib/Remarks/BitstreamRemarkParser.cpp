@@ -41,7 +41,7 @@ BitstreamMetaParserHelper::BitstreamMetaParserHelper(
 static Error parseRecord(BitstreamMetaParserHelper &Parser, unsigned Code) {
   BitstreamCursor &Stream = Parser.Stream;
   // Note: 2 is used here because it's the max number of fields we have per
-  // record.
+  // record, except for the variable-length remark index records.
   SmallVector<uint64_t, 2> Record;
   StringRef Blob;
   Expected<unsigned> RecordID = Stream.readRecord(Code, Record, &Blob);
@@ -74,6 +74,13 @@ static Error parseRecord(BitstreamMetaParserHelper &Parser, unsigned Code) {
     Parser.ExternalFilePath = Blob;
     break;
   }
+  case RECORD_META_REMARK_INDEX: {
+    // A function name index followed by at least one remark offset.
+    if (Record.size() < 2)
+      return malformedRecord("BLOCK_META", "RECORD_META_REMARK_INDEX");
+    Parser.RemarkIndexEntries.emplace_back(Record.begin(), Record.end());
+    break;
+  }
   default:
     return unknownRecord("BLOCK_META", *RecordID);
   }
@@ -355,13 +362,24 @@ Error BitstreamRemarkParser::parseMeta() {
 
   switch (ContainerType) {
   case BitstreamRemarkContainerType::Standalone:
-    return processStandaloneMeta(MetaHelper);
+    if (Error E = processStandaloneMeta(MetaHelper))
+      return E;
+    break;
   case BitstreamRemarkContainerType::SeparateRemarksFile:
-    return processSeparateRemarksFileMeta(MetaHelper);
+    if (Error E = processSeparateRemarksFileMeta(MetaHelper))
+      return E;
+    break;
   case BitstreamRemarkContainerType::SeparateRemarksMeta:
-    return processSeparateRemarksMetaMeta(MetaHelper);
+    if (Error E = processSeparateRemarksMetaMeta(MetaHelper))
+      return E;
+    break;
   }
-  llvm_unreachable("Unknown BitstreamRemarkContainerType enum");
+
+  // Whatever the container type, the cursor is now at the first remark block,
+  // if any. Remember its position so that the offsets provided by the remark
+  // index can be resolved when seeking.
+  RemarksStartBitPos = ParserHelper.Stream.GetCurrentBitNo();
+  return Error::success();
 }
 
 Error BitstreamRemarkParser::processCommonMeta(
@@ -484,9 +502,59 @@ Error BitstreamRemarkParser::processSeparateRemarksMetaMeta(
     BitstreamMetaParserHelper &Helper) {
   if (Error E = processStrTab(*this, Helper.StrTabBuf))
     return E;
+  // The remark index needs the string table to resolve the function names.
+  if (Error E = processRemarkIndex(Helper))
+    return E;
   return processExternalFilePath(Helper.ExternalFilePath);
 }
 
+Error BitstreamRemarkParser::processRemarkIndex(
+    BitstreamMetaParserHelper &Helper) {
+  // The index is optional.
+  for (const SmallVector<uint64_t, 4> &Entry : Helper.RemarkIndexEntries) {
+    assert(Entry.size() >= 2 && "Malformed index entries are rejected when "
+                                "parsing the META_BLOCK records.");
+    Expected<StringRef> FunctionName = (*StrTab)[Entry[0]];
+    if (!FunctionName)
+      return FunctionName.takeError();
+    SmallVector<uint64_t, 4> &Offsets = Index[*FunctionName];
+    Offsets.append(Entry.begin() + 1, Entry.end());
+  }
+  return Error::success();
+}
+
+Expected<Optional<ArrayRef<uint64_t>>>
+BitstreamRemarkParser::getRemarkOffsetsFor(StringRef FunctionName) {
+  // The remark index is parsed along with the rest of the metadata.
+  if (!ReadyToParseRemarks) {
+    if (Error E = parseMeta())
+      return std::move(E);
+    ReadyToParseRemarks = true;
+  }
+
+  // No index in the metadata: the caller has to scan through all the remarks.
+  if (Index.empty())
+    return Optional<ArrayRef<uint64_t>>(None);
+
+  auto It = Index.find(FunctionName);
+  if (It == Index.end())
+    return Optional<ArrayRef<uint64_t>>(ArrayRef<uint64_t>());
+  return Optional<ArrayRef<uint64_t>>(makeArrayRef(It->second));
+}
+
+Error BitstreamRemarkParser::seekToRemark(uint64_t Offset) {
+  if (!ReadyToParseRemarks) {
+    if (Error E = parseMeta())
+      return E;
+    ReadyToParseRemarks = true;
+  }
+
+  // The offsets are expressed in bytes relative to the first remark block.
+  // All the remark blocks are flushed 32-bit aligned, so this lands exactly on
+  // the ENTER_SUBBLOCK of the requested remark.
+  return ParserHelper.Stream.JumpToBit(RemarksStartBitPos + Offset * 8);
+}
+
 Expected<std::unique_ptr<Remark>> BitstreamRemarkParser::parseRemark() {
   BitstreamRemarkParserHelper RemarkHelper(ParserHelper.Stream);
   if (Error E = RemarkHelper.parse())
@@ -14,6 +14,7 @@
 #define LLVM_LIB_REMARKS_BITSTREAM_REMARK_PARSER_H
 
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Remarks/BitstreamRemarkContainer.h"
 #include "llvm/Remarks/BitstreamRemarkParser.h"
 #include "llvm/Remarks/Remark.h"
@@ -40,6 +41,13 @@ struct BitstreamRemarkParser : public RemarkParser {
       BitstreamRemarkContainerType::Standalone;
   /// Wether the parser is ready to parse remarks.
   bool ReadyToParseRemarks = false;
+  /// The offsets of the remark blocks for each function, parsed from the
+  /// remark index in the metadata, if present. The offsets are expressed in
+  /// bytes relative to the first remark block.
+  StringMap<SmallVector<uint64_t, 4>> Index;
+  /// The position of the first remark block in the stream. Used to resolve
+  /// the offsets provided by the remark index.
+  uint64_t RemarksStartBitPos = 0;
 
   /// Create a parser that expects to find a string table embedded in the
   /// stream.
@@ -53,6 +61,11 @@ struct BitstreamRemarkParser : public RemarkParser {
 
   Expected<std::unique_ptr<Remark>> next() override;
 
+  Expected<Optional<ArrayRef<uint64_t>>>
+  getRemarkOffsetsFor(StringRef FunctionName) override;
+
+  Error seekToRemark(uint64_t Offset) override;
+
   static bool classof(const RemarkParser *P) {
     return P->ParserFormat == Format::Bitstream;
   }
@@ -66,6 +79,7 @@ struct BitstreamRemarkParser : public RemarkParser {
 private:
   /// Helper functions.
   Error processCommonMeta(BitstreamMetaParserHelper &Helper);
+  Error processRemarkIndex(BitstreamMetaParserHelper &Helper);
   Error processStandaloneMeta(BitstreamMetaParserHelper &Helper);
   Error processSeparateRemarksFileMeta(BitstreamMetaParserHelper &Helper);
   Error processSeparateRemarksMetaMeta(BitstreamMetaParserHelper &Helper);
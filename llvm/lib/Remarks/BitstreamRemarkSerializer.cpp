@@ -121,6 +121,33 @@ void BitstreamRemarkSerializerHelper::emitMetaExternalFile(StringRef Filename) {
   Bitstream.EmitRecordWithBlob(RecordMetaExternalFileAbbrevID, R, Filename);
 }
 
+void BitstreamRemarkSerializerHelper::setupMetaRemarkIndex() {
+  setRecordName(RECORD_META_REMARK_INDEX, Bitstream, R, MetaRemarkIndexName);
+
+  auto Abbrev = std::make_shared<BitCodeAbbrev>();
+  Abbrev->Add(BitCodeAbbrevOp(RECORD_META_REMARK_INDEX));
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 8)); // Function name.
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Array)); // Offsets.
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 8)); // Offset.
+  RecordMetaRemarkIndexAbbrevID =
+      Bitstream.EmitBlockInfoAbbrev(META_BLOCK_ID, Abbrev);
+}
+
+void BitstreamRemarkSerializerHelper::emitMetaRemarkIndex(
+    const BitstreamRemarkIndex &Index) {
+  // The index is emitted only in the separate metadata. Emit one record per
+  // function, containing the index of the function name in the string table,
+  // followed by the offsets of all the remark blocks emitted for that function
+  // in the external remarks file.
+  for (const auto &Entry : Index) {
+    R.clear();
+    R.push_back(RECORD_META_REMARK_INDEX);
+    R.push_back(Entry.first);
+    R.append(Entry.second.begin(), Entry.second.end());
+    Bitstream.EmitRecordWithAbbrev(RecordMetaRemarkIndexAbbrevID, R);
+  }
+}
+
 void BitstreamRemarkSerializerHelper::setupRemarkBlockInfo() {
   // Setup the remark block.
   initBlock(REMARK_BLOCK_ID, Bitstream, R, RemarkBlockName);
@@ -210,6 +237,8 @@ void BitstreamRemarkSerializerHelper::setupBlockInfo() {
     setupMetaStrTab();
     // Needs to know where the external remarks file is.
     setupMetaExternalFile();
+    // May index the remarks in the external remarks file.
+    setupMetaRemarkIndex();
     break;
   case BitstreamRemarkContainerType::SeparateRemarksFile:
     // Contains remarks: emit the version.
@@ -232,7 +261,8 @@ void BitstreamRemarkSerializerHelper::setupBlockInfo() {
 
 void BitstreamRemarkSerializerHelper::emitMetaBlock(
     uint64_t ContainerVersion, Optional<uint64_t> RemarkVersion,
-    Optional<const StringTable *> StrTab, Optional<StringRef> Filename) {
+    Optional<const StringTable *> StrTab, Optional<StringRef> Filename,
+    Optional<const BitstreamRemarkIndex *> Index) {
   // Emit the meta block
   Bitstream.EnterSubblock(META_BLOCK_ID, 3);
 
@@ -249,6 +279,9 @@ void BitstreamRemarkSerializerHelper::emitMetaBlock(
     emitMetaStrTab(**StrTab);
     assert(Filename != None);
     emitMetaExternalFile(*Filename);
+    // The index is optional.
+    if (Index != None && *Index != nullptr)
+      emitMetaRemarkIndex(**Index);
     break;
   case BitstreamRemarkContainerType::SeparateRemarksFile:
     assert(RemarkVersion != None);
@@ -356,10 +389,22 @@ void BitstreamRemarkSerializer::emit(const Remark &Remark) {
         IsStandalone ? &*StrTab : Optional<const StringTable *>(None));
     MetaSerializer.emit();
     DidSetUp = true;
+    // The meta block has been flushed to OS: the remark blocks start here.
+    RemarksStartOffset = OS.tell();
   }
 
   assert(DidSetUp &&
          "The Block info block and the meta block were not emitted yet.");
+
+  // All the blocks emitted so far are flushed 32-bit aligned, so the current
+  // position in the stream is where the next remark block starts. Remember it,
+  // keyed by function name, so that the separate metadata can emit an index of
+  // the remarks.
+  if (Helper.ContainerType ==
+      BitstreamRemarkContainerType::SeparateRemarksFile)
+    FunctionIndex[StrTab->add(Remark.FunctionName).first].push_back(
+        OS.tell() - RemarksStartOffset);
+
   Helper.emitRemarkBlock(Remark, *StrTab);
 
   Helper.flushToStream(OS);
@@ -375,12 +420,14 @@ std::unique_ptr<MetaSerializer> BitstreamRemarkSerializer::metaSerializer(
       OS,
       IsStandalone ? BitstreamRemarkContainerType::Standalone
                    : BitstreamRemarkContainerType::SeparateRemarksMeta,
-      &*StrTab, ExternalFilename);
+      &*StrTab, ExternalFilename,
+      IsStandalone ? Optional<const BitstreamRemarkIndex *>(None)
+                   : Optional<const BitstreamRemarkIndex *>(&FunctionIndex));
 }
 
 void BitstreamMetaSerializer::emit() {
   Helper->setupBlockInfo();
   Helper->emitMetaBlock(CurrentContainerVersion, CurrentRemarkVersion, StrTab,
-                        ExternalFilename);
+                        ExternalFilename, Index);
   Helper->flushToStream(OS);
 }
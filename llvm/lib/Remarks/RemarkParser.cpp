@@ -23,6 +23,17 @@ using namespace llvm::remarks;
 
 char EndOfFileError::ID = 0;
 
+Expected<Optional<ArrayRef<uint64_t>>>
+RemarkParser::getRemarkOffsetsFor(StringRef /*FunctionName*/) {
+  // By default, formats do not provide an index of the remarks.
+  return Optional<ArrayRef<uint64_t>>(None);
+}
+
+Error RemarkParser::seekToRemark(uint64_t /*Offset*/) {
+  return createStringError(std::make_error_code(std::errc::invalid_argument),
+                           "The format does not support seeking to a remark.");
+}
+
 ParsedStringTable::ParsedStringTable(StringRef InBuffer) : Buffer(InBuffer) {
   while (!InBuffer.empty()) {
     // Strings are separated by '\0' bytes.
@@ -11,11 +11,13 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/CachePruning.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -208,7 +210,11 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy) {
   std::error_code EC;
   SmallString<128> CachePathNative;
   sys::path::native(Path, CachePathNative);
-  // Walk all of the files within this directory.
+  // Collect the paths of all of the files within this directory first and
+  // stat them in parallel afterwards. On network filesystems every stat is a
+  // round trip, and a well-used cache can hold tens of thousands of entries,
+  // so overlapping the requests dwarfs the cost of the second pass.
+  std::vector<std::string> FilePaths;
   for (sys::fs::directory_iterator File(CachePathNative, EC), FileEnd;
        File != FileEnd && !EC; File.increment(EC)) {
     // Ignore any files not beginning with the string "llvmcache-". This
@@ -217,29 +223,39 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy) {
     // wrong directory as their cache directory.
     if (!sys::path::filename(File->path()).startswith("llvmcache-"))
       continue;
+    FilePaths.push_back(File->path());
+  }
+
+  std::vector<Optional<sys::fs::file_status>> Statuses(FilePaths.size());
+  parallelForEachN(0, FilePaths.size(), [&](size_t Idx) {
+    sys::fs::file_status Status;
+    if (!sys::fs::status(FilePaths[Idx], Status))
+      Statuses[Idx] = Status;
+  });
+
+  for (size_t Idx = 0; Idx != FilePaths.size(); ++Idx) {
+    StringRef FilePath = FilePaths[Idx];
 
-    // Look at this file. If we can't stat it, there's nothing interesting
-    // there.
-    ErrorOr<sys::fs::basic_file_status> StatusOrErr = File->status();
-    if (!StatusOrErr) {
-      LLVM_DEBUG(dbgs() << "Ignore " << File->path() << " (can't stat)\n");
+    // If we couldn't stat the file, there's nothing interesting there.
+    if (!Statuses[Idx]) {
+      LLVM_DEBUG(dbgs() << "Ignore " << FilePath << " (can't stat)\n");
       continue;
     }
 
     // If the file hasn't been used recently enough, delete it
-    const auto FileAccessTime = StatusOrErr->getLastAccessedTime();
+    const auto FileAccessTime = Statuses[Idx]->getLastAccessedTime();
     auto FileAge = CurrentTime - FileAccessTime;
     if (Policy.Expiration != seconds(0) && FileAge > Policy.Expiration) {
-      LLVM_DEBUG(dbgs() << "Remove " << File->path() << " ("
+      LLVM_DEBUG(dbgs() << "Remove " << FilePath << " ("
                         << duration_cast<seconds>(FileAge).count()
                         << "s old)\n");
-      sys::fs::remove(File->path());
+      sys::fs::remove(FilePath);
       continue;
     }
 
     // Leave it here for now, but add it to the list of size-based pruning.
-    TotalSize += StatusOrErr->getSize();
-    FileInfos.insert({FileAccessTime, StatusOrErr->getSize(), File->path()});
+    TotalSize += Statuses[Idx]->getSize();
+    FileInfos.insert({FileAccessTime, Statuses[Idx]->getSize(), FilePath.str()});
   }
 
   auto FileInfo = FileInfos.begin();
@@ -158,6 +158,14 @@ public:
   // ParseCommandLineOptions actually runs.
   SmallVector<Option*, 4> DefaultOptions;
 
+  // Options whose registration has been deferred. Filling in the per-
+  // subcommand option maps for every option linked into a tool is pure
+  // startup overhead for the many invocations that never get around to
+  // parsing, so options are queued here by their global constructors and only
+  // materialized into the maps when the parser (or a client inspecting the
+  // registered options) first needs them.
+  SmallVector<Option *, 0> PendingOptions;
+
   // This collects the different option categories that have been registered.
   SmallPtrSet<OptionCategory *, 16> RegisteredOptionCategories;
 
@@ -257,6 +265,15 @@ public:
       return;
     }
 
+    if (!ProcessDefaultOption) {
+      PendingOptions.push_back(O);
+      return;
+    }
+
+    addOptionNow(O);
+  }
+
+  void addOptionNow(Option *O) {
     if (O->Subs.empty()) {
       addOption(O, &*TopLevelSubCommand);
     } else {
@@ -265,6 +282,14 @@ public:
     }
   }
 
+  /// Move any queued options into the per-subcommand maps. Must be called
+  /// before the maps are consulted.
+  void materializePendingOptions() {
+    for (Option *O : PendingOptions)
+      addOptionNow(O);
+    PendingOptions.clear();
+  }
+
   void removeOption(Option *O, SubCommand *SC) {
     SmallVector<StringRef, 16> OptionNames;
     O->getExtraOptionNames(OptionNames);
@@ -299,6 +324,14 @@ public:
   }
 
   void removeOption(Option *O) {
+    // If the option was never materialized, there is nothing to remove from
+    // the maps.
+    auto I = find(PendingOptions, O);
+    if (I != PendingOptions.end()) {
+      PendingOptions.erase(I);
+      return;
+    }
+
     if (O->Subs.empty())
       removeOption(O, &*TopLevelSubCommand);
     else {
@@ -338,6 +371,11 @@ public:
   }
 
   void updateArgStr(Option *O, StringRef NewName) {
+    // A pending option is not in any map yet; its new name is picked up when
+    // it is materialized.
+    if (is_contained(PendingOptions, O))
+      return;
+
     if (O->Subs.empty())
       updateArgStr(O, NewName, &*TopLevelSubCommand);
     else {
@@ -413,6 +451,7 @@ public:
     registerSubCommand(&*AllSubCommands);
 
     DefaultOptions.clear();
+    PendingOptions.clear();
   }
 
 private:
@@ -1320,6 +1359,8 @@ void CommandLineParser::ResetAllOptionOccurrences() {
     for (auto &O : SC->OptionsMap)
       O.second->reset();
   }
+  for (Option *O : PendingOptions)
+    O->reset();
 }
 
 bool CommandLineParser::ParseCommandLineOptions(int argc,
@@ -1327,6 +1368,7 @@ bool CommandLineParser::ParseCommandLineOptions(int argc,
                                                 StringRef Overview,
                                                 raw_ostream *Errs,
                                                 bool LongOptionsUseDoubleDash) {
+  materializePendingOptions();
   assert(hasOptions() && "No options specified!");
 
   // Expand response files.
@@ -2542,6 +2584,7 @@ static cl::opt<VersionPrinter, true, parser<bool>>
 
 // Utility function for printing the help message.
 void cl::PrintHelpMessage(bool Hidden, bool Categorized) {
+  GlobalParser->materializePendingOptions();
   if (!Hidden && !Categorized)
     UncategorizedNormalPrinter.printHelp();
   else if (!Hidden && Categorized)
@@ -2565,6 +2608,7 @@ void cl::AddExtraVersionPrinter(VersionPrinterTy func) {
 }
 
 StringMap<Option *> &cl::getRegisteredOptions(SubCommand &Sub) {
+  GlobalParser->materializePendingOptions();
   auto &Subs = GlobalParser->RegisteredSubCommands;
   (void)Subs;
   assert(is_contained(Subs, &Sub));
@@ -2577,6 +2621,7 @@ cl::getRegisteredSubcommands() {
 }
 
 void cl::HideUnrelatedOptions(cl::OptionCategory &Category, SubCommand &Sub) {
+  GlobalParser->materializePendingOptions();
   for (auto &I : Sub.OptionsMap) {
     for (auto &Cat : I.second->Categories) {
       if (Cat != &Category &&
@@ -2588,6 +2633,7 @@ void cl::HideUnrelatedOptions(cl::OptionCategory &Category, SubCommand &Sub) {
 
 void cl::HideUnrelatedOptions(ArrayRef<const cl::OptionCategory *> Categories,
                               SubCommand &Sub) {
+  GlobalParser->materializePendingOptions();
   for (auto &I : Sub.OptionsMap) {
     for (auto &Cat : I.second->Categories) {
       if (find(Categories, Cat) == Categories.end() && Cat != &GenericCategory)
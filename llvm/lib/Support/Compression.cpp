@@ -60,6 +60,48 @@ Error zlib::compress(StringRef InputBuffer,
   return Res ? createError(convertZlibCodeToString(Res)) : Error::success();
 }
 
+Error zlib::compressShard(StringRef InputBuffer,
+                          SmallVectorImpl<char> &CompressedBuffer, int Level,
+                          bool LastShard) {
+  // A negative windowBits (15 is the default) makes zlib emit a raw deflate
+  // stream with no header or trailer; 8 is the default memLevel.
+  z_stream Stream = {};
+  int Res =
+      ::deflateInit2(&Stream, Level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  if (Res != Z_OK)
+    return createError(convertZlibCodeToString(Res));
+
+  // deflateBound covers stored-block overhead; leave a little slack for the
+  // empty block a Z_SYNC_FLUSH appends.
+  unsigned long CompressedSize =
+      ::deflateBound(&Stream, InputBuffer.size()) + 16;
+  CompressedBuffer.reserve(CompressedSize);
+  Stream.next_in =
+      (Bytef *)const_cast<char *>(InputBuffer.data());
+  Stream.avail_in = InputBuffer.size();
+  Stream.next_out = (Bytef *)CompressedBuffer.data();
+  Stream.avail_out = CompressedSize;
+  Res = ::deflate(&Stream, LastShard ? Z_FINISH : Z_SYNC_FLUSH);
+  assert(Stream.avail_in == 0 && "output buffer covers the deflate bound");
+  // Tell MemorySanitizer that zlib output buffer is fully initialized.
+  // This avoids a false report when running LLVM with uninstrumented ZLib.
+  __msan_unpoison(CompressedBuffer.data(), Stream.total_out);
+  CompressedBuffer.set_size(Stream.total_out);
+  ::deflateEnd(&Stream);
+  return (Res == Z_OK || Res == Z_STREAM_END)
+             ? Error::success()
+             : createError(convertZlibCodeToString(Res));
+}
+
+uint32_t zlib::adler32(StringRef Buffer) {
+  return ::adler32(1, (const Bytef *)Buffer.data(), Buffer.size());
+}
+
+uint32_t zlib::adler32Combine(uint32_t Checksum1, uint32_t Checksum2,
+                              size_t Length2) {
+  return ::adler32_combine(Checksum1, Checksum2, Length2);
+}
+
 Error zlib::uncompress(StringRef InputBuffer, char *UncompressedBuffer,
                        size_t &UncompressedSize) {
   int Res =
@@ -91,6 +133,18 @@ Error zlib::compress(StringRef InputBuffer,
                      SmallVectorImpl<char> &CompressedBuffer, int Level) {
   llvm_unreachable("zlib::compress is unavailable");
 }
+Error zlib::compressShard(StringRef InputBuffer,
+                          SmallVectorImpl<char> &CompressedBuffer, int Level,
+                          bool LastShard) {
+  llvm_unreachable("zlib::compressShard is unavailable");
+}
+uint32_t zlib::adler32(StringRef Buffer) {
+  llvm_unreachable("zlib::adler32 is unavailable");
+}
+uint32_t zlib::adler32Combine(uint32_t Checksum1, uint32_t Checksum2,
+                              size_t Length2) {
+  llvm_unreachable("zlib::adler32Combine is unavailable");
+}
 Error zlib::uncompress(StringRef InputBuffer, char *UncompressedBuffer,
                        size_t &UncompressedSize) {
   llvm_unreachable("zlib::uncompress is unavailable");
@@ -519,15 +519,22 @@ bool Parser::parseNumber(char First, Value &Out) {
 
 bool Parser::parseString(std::string &Out) {
   // leading quote was already consumed.
-  for (char C = next(); C != '"'; C = next()) {
+  for (;;) {
+    // Fast path: most strings contain no escapes or control characters, so
+    // scan ahead for the next special character and copy the run in one
+    // append rather than a push_back per byte.
+    const char *ChunkStart = P;
+    while (P != End && *P != '"' && *P != '\\' &&
+           LLVM_LIKELY((*P & 0x1f) != *P))
+      ++P;
+    Out.append(ChunkStart, P);
     if (LLVM_UNLIKELY(P == End))
       return parseError("Unterminated string");
+    char C = next();
+    if (C == '"')
+      return true;
     if (LLVM_UNLIKELY((C & 0x1f) == C))
       return parseError("Control character in string");
-    if (LLVM_LIKELY(C != '\\')) {
-      Out.push_back(C);
-      continue;
-    }
     // Handle escape sequence.
     switch (C = next()) {
     case '"':
@@ -558,7 +565,6 @@ bool Parser::parseString(std::string &Out) {
       return parseError("Invalid escape sequence");
     }
   }
-  return true;
 }
 
 static void encodeUtf8(uint32_t Rune, std::string &Out) {
@@ -12,8 +12,9 @@
 #include "llvm/Support/Threading.h"
 
 #include <atomic>
+#include <deque>
 #include <future>
-#include <stack>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -36,18 +37,28 @@ public:
   static Executor *getDefaultExecutor();
 };
 
-/// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+/// The index of the owning worker thread inside its executor, or -1 on
+/// threads that are not executor workers.
+static thread_local int WorkerIndex = -1;
+
+/// An implementation of an Executor that runs closures on a thread pool.
+///
+/// Each worker owns a deque of tasks. A worker services its own deque newest
+/// first and, when it runs dry, steals the oldest task from another worker.
+/// Tasks spawned from a worker thread land on that worker's own deque, so
+/// work recursively spawned while processing a task stays on the thread whose
+/// cache is already warm unless an idle worker steals it.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(ThreadPoolStrategy S = hardware_concurrency()) {
-    unsigned ThreadCount = S.compute_thread_count();
+    ThreadCount = S.compute_thread_count();
+    WorkQueues = std::make_unique<WorkQueue[]>(ThreadCount);
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     Threads.reserve(ThreadCount);
     Threads.resize(1);
     std::lock_guard<std::mutex> Lock(Mutex);
-    Threads[0] = std::thread([this, ThreadCount, S] {
+    Threads[0] = std::thread([this, S] {
       for (unsigned I = 1; I < ThreadCount; ++I) {
         Threads.emplace_back([=] { work(S, I); });
         if (Stop)
@@ -87,30 +98,79 @@ public:
   };
 
   void add(std::function<void()> F) override {
+    // Keep recursively spawned tasks on the spawning worker; distribute tasks
+    // from other threads round-robin across the workers.
+    unsigned Index = WorkerIndex >= 0 ? unsigned(WorkerIndex)
+                                      : NextQueue++ % ThreadCount;
     {
-      std::lock_guard<std::mutex> Lock(Mutex);
-      WorkStack.push(F);
+      std::lock_guard<std::mutex> Lock(WorkQueues[Index].Mutex);
+      WorkQueues[Index].Tasks.push_back(std::move(F));
     }
+    ++NumTasks;
+    // Lock and unlock the sleep mutex so a worker that saw an empty pool but
+    // has not yet blocked in wait() cannot miss this notification.
+    { std::lock_guard<std::mutex> Lock(Mutex); }
     Cond.notify_one();
   }
 
 private:
+  struct WorkQueue {
+    std::mutex Mutex;
+    std::deque<std::function<void()>> Tasks;
+  };
+
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
+    WorkerIndex = ThreadID;
     S.apply_thread_strategy(ThreadID);
-    while (true) {
+    while (!Stop) {
+      std::function<void()> Task;
+      if (popTask(ThreadID, Task)) {
+        Task();
+        continue;
+      }
       std::unique_lock<std::mutex> Lock(Mutex);
-      Cond.wait(Lock, [&] { return Stop || !WorkStack.empty(); });
-      if (Stop)
-        break;
-      auto Task = WorkStack.top();
-      WorkStack.pop();
-      Lock.unlock();
-      Task();
+      Cond.wait(Lock, [&] { return Stop || NumTasks > 0; });
+    }
+  }
+
+  bool popTask(unsigned ThreadID, std::function<void()> &Task) {
+    // Prefer the local deque, newest task first: the most recently spawned
+    // task is the most likely to still be hot in this worker's cache.
+    if (popFrom(WorkQueues[ThreadID], /*StealOldest=*/false, Task))
+      return true;
+    // Otherwise steal the oldest task from another worker, which is the task
+    // the victim is least likely to get to soon.
+    for (unsigned I = 1; I < ThreadCount; ++I)
+      if (popFrom(WorkQueues[(ThreadID + I) % ThreadCount],
+                  /*StealOldest=*/true, Task))
+        return true;
+    return false;
+  }
+
+  bool popFrom(WorkQueue &Q, bool StealOldest, std::function<void()> &Task) {
+    std::lock_guard<std::mutex> Lock(Q.Mutex);
+    if (Q.Tasks.empty())
+      return false;
+    if (StealOldest) {
+      Task = std::move(Q.Tasks.front());
+      Q.Tasks.pop_front();
+    } else {
+      Task = std::move(Q.Tasks.back());
+      Q.Tasks.pop_back();
     }
+    --NumTasks;
+    return true;
   }
 
   std::atomic<bool> Stop{false};
-  std::stack<std::function<void()>> WorkStack;
+  // An over-approximation of the number of queued tasks: incremented after a
+  // push and decremented under the queue lock on a successful pop, so it may
+  // transiently run low but never stays stale once adds quiesce. Used only to
+  // decide whether idle workers should sleep.
+  std::atomic<int64_t> NumTasks{0};
+  std::atomic<unsigned> NextQueue{0};
+  unsigned ThreadCount;
+  std::unique_ptr<WorkQueue[]> WorkQueues;
   std::mutex Mutex;
   std::condition_variable Cond;
   std::promise<void> ThreadsCreated;
@@ -78,11 +78,14 @@ static std::vector<T> &GetOrCreateOffsetCache(void *&OffsetCache,
   auto *Offsets = new std::vector<T>();
   size_t Sz = Buffer->getBufferSize();
   assert(Sz <= std::numeric_limits<T>::max());
+  (void)Sz;
+  // Find the newlines with StringRef::find, i.e. memchr, rather than checking
+  // every byte ourselves: on multi-hundred-megabyte inputs the scan dominates
+  // the cost of the first location lookup, and memchr is typically vectorized
+  // by the C library.
   StringRef S = Buffer->getBuffer();
-  for (size_t N = 0; N < Sz; ++N) {
-    if (S[N] == '\n')
-      Offsets->push_back(static_cast<T>(N));
-  }
+  for (size_t N = S.find('\n'); N != StringRef::npos; N = S.find('\n', N + 1))
+    Offsets->push_back(static_cast<T>(N));
 
   OffsetCache = Offsets;
   return *Offsets;
@@ -47,6 +47,16 @@ StringMapImpl::StringMapImpl(unsigned InitSize, unsigned itemSize) {
   NumTombstones = 0;
 }
 
+void StringMapImpl::reserve(unsigned NumEntries) {
+  unsigned MinBuckets = getMinBucketToReserveForEntries(NumEntries);
+  if (MinBuckets <= NumBuckets)
+    return;
+  if (NumBuckets == 0)
+    init(MinBuckets);
+  else
+    rehashTableInto(MinBuckets, 0);
+}
+
 void StringMapImpl::init(unsigned InitSize) {
   assert((InitSize & (InitSize - 1)) == 0 &&
          "Init Size must be a power of 2 or zero!");
@@ -199,7 +209,6 @@ StringMapEntryBase *StringMapImpl::RemoveKey(StringRef Key) {
 /// the appropriate mod-of-hashtable-size.
 unsigned StringMapImpl::RehashTable(unsigned BucketNo) {
   unsigned NewSize;
-  unsigned *HashTable = (unsigned *)(TheTable + NumBuckets + 1);
 
   // If the hash table is now more than 3/4 full, or if fewer than 1/8 of
   // the buckets are empty (meaning that many are filled with tombstones),
@@ -213,6 +222,14 @@ unsigned StringMapImpl::RehashTable(unsigned BucketNo) {
     return BucketNo;
   }
 
+  return rehashTableInto(NewSize, BucketNo);
+}
+
+/// rehashTableInto - Redistribute the items into a freshly allocated table
+/// with NewSize buckets, which must be a power of two no smaller than what
+/// the current items require.
+unsigned StringMapImpl::rehashTableInto(unsigned NewSize, unsigned BucketNo) {
+  unsigned *HashTable = (unsigned *)(TheTable + NumBuckets + 1);
   unsigned NewBucketNo = BucketNo;
   // Allocate one extra bucket which will always be non-empty.  This allows the
   // iterators to stop at end.
@@ -0,0 +1,23 @@
+//===- ThreadBufferedOStream.cpp - Per-thread buffered stream -------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ThreadBufferedOStream.h"
+
+using namespace llvm;
+
+void thread_buffered_ostream::anchor() {}
+
+void thread_buffered_ostream::emitBuffer() {
+  if (Buffer.empty())
+    return;
+  {
+    std::lock_guard<std::mutex> Lock(StreamLock);
+    OS << str();
+  }
+  Buffer.clear();
+}
@@ -21,10 +21,18 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 using namespace std::chrono;
 using namespace llvm;
 
@@ -45,12 +53,85 @@ typedef std::pair<size_t, DurationType> CountAndDurationType;
 typedef std::pair<std::string, CountAndDurationType>
     NameAndCountAndDurationType;
 
+// Set by timeTraceProfilerEnableHardwareCounters() before the profiler
+// instances are created.
+static bool HardwareCountersRequested = false;
+
 namespace {
+
+/// Per-thread hardware performance counters, read at the start and end of
+/// every entry. Only implemented on Linux; elsewhere isAvailable() is false
+/// and no reader is ever constructed.
+class HardwareCounterReader {
+public:
+  struct Values {
+    uint64_t Instructions = 0;
+    uint64_t CacheMisses = 0;
+  };
+
+#ifdef __linux__
+  HardwareCounterReader() {
+    InstructionsFD = openCounter(PERF_COUNT_HW_INSTRUCTIONS);
+    CacheMissesFD = openCounter(PERF_COUNT_HW_CACHE_MISSES);
+  }
+
+  HardwareCounterReader(const HardwareCounterReader &) = delete;
+  HardwareCounterReader &operator=(const HardwareCounterReader &) = delete;
+
+  ~HardwareCounterReader() {
+    if (InstructionsFD != -1)
+      ::close(InstructionsFD);
+    if (CacheMissesFD != -1)
+      ::close(CacheMissesFD);
+  }
+
+  bool isAvailable() const {
+    return InstructionsFD != -1 && CacheMissesFD != -1;
+  }
+
+  Values read() const {
+    Values V;
+    uint64_t Count;
+    if (::read(InstructionsFD, &Count, sizeof(Count)) == sizeof(Count))
+      V.Instructions = Count;
+    if (::read(CacheMissesFD, &Count, sizeof(Count)) == sizeof(Count))
+      V.CacheMisses = Count;
+    return V;
+  }
+
+private:
+  // Opens a counter for the calling thread only, counting user space. The
+  // profiler instance is thread-local, so begin() and end() always run on
+  // the thread the counters were opened for.
+  static int openCounter(uint64_t Config) {
+    struct perf_event_attr Attr;
+    std::memset(&Attr, 0, sizeof(Attr));
+    Attr.type = PERF_TYPE_HARDWARE;
+    Attr.size = sizeof(Attr);
+    Attr.config = Config;
+    Attr.exclude_kernel = 1;
+    Attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &Attr, /*pid=*/0, /*cpu=*/-1,
+                   /*group_fd=*/-1, /*flags=*/0);
+  }
+
+  int InstructionsFD = -1;
+  int CacheMissesFD = -1;
+#else
+  bool isAvailable() const { return false; }
+  Values read() const { return Values(); }
+#endif
+};
+
 struct Entry {
   const TimePointType Start;
   TimePointType End;
   const std::string Name;
   const std::string Detail;
+  // Hardware counter values at Start, and the Start-to-End deltas. Only
+  // meaningful when the owning profiler has a counter reader.
+  HardwareCounterReader::Values StartCounters;
+  HardwareCounterReader::Values CounterDeltas;
 
   Entry(TimePointType &&S, TimePointType &&E, std::string &&N, std::string &&Dt)
       : Start(std::move(S)), End(std::move(E)), Name(std::move(N)),
@@ -79,17 +160,30 @@ struct llvm::TimeTraceProfiler {
         ProcName(ProcName), Pid(sys::Process::getProcessId()),
         Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity) {
     llvm::get_thread_name(ThreadName);
+    if (HardwareCountersRequested) {
+      auto Reader = std::make_unique<HardwareCounterReader>();
+      if (Reader->isAvailable())
+        HWCounters = std::move(Reader);
+    }
   }
 
   void begin(std::string Name, llvm::function_ref<std::string()> Detail) {
     Stack.emplace_back(steady_clock::now(), TimePointType(), std::move(Name),
                        Detail());
+    if (HWCounters)
+      Stack.back().StartCounters = HWCounters->read();
   }
 
   void end() {
     assert(!Stack.empty() && "Must call begin() first");
     Entry &E = Stack.back();
     E.End = steady_clock::now();
+    if (HWCounters) {
+      HardwareCounterReader::Values Now = HWCounters->read();
+      E.CounterDeltas.Instructions =
+          Now.Instructions - E.StartCounters.Instructions;
+      E.CounterDeltas.CacheMisses = Now.CacheMisses - E.StartCounters.CacheMisses;
+    }
 
     // Check that end times monotonically increase.
     assert((Entries.empty() ||
@@ -138,7 +232,7 @@ struct llvm::TimeTraceProfiler {
     J.arrayBegin();
 
     // Emit all events for the main flame graph.
-    auto writeEvent = [&](const auto &E, uint64_t Tid) {
+    auto writeEvent = [&](const auto &E, uint64_t Tid, bool HasCounters) {
       auto StartUs = E.getFlameGraphStartUs(StartTime);
       auto DurUs = E.getFlameGraphDurUs();
 
@@ -149,16 +243,24 @@ struct llvm::TimeTraceProfiler {
         J.attribute("ts", StartUs);
         J.attribute("dur", DurUs);
         J.attribute("name", E.Name);
-        if (!E.Detail.empty()) {
-          J.attributeObject("args", [&] { J.attribute("detail", E.Detail); });
+        if (!E.Detail.empty() || HasCounters) {
+          J.attributeObject("args", [&] {
+            if (!E.Detail.empty())
+              J.attribute("detail", E.Detail);
+            if (HasCounters) {
+              J.attribute("instructions",
+                          int64_t(E.CounterDeltas.Instructions));
+              J.attribute("cache-misses", int64_t(E.CounterDeltas.CacheMisses));
+            }
+          });
         }
       });
     };
     for (const Entry &E : Entries)
-      writeEvent(E, this->Tid);
+      writeEvent(E, this->Tid, HWCounters != nullptr);
     for (const TimeTraceProfiler *TTP : ThreadTimeTraceProfilerInstances)
       for (const Entry &E : TTP->Entries)
-        writeEvent(E, TTP->Tid);
+        writeEvent(E, TTP->Tid, TTP->HWCounters != nullptr);
 
     // Emit totals by section name as additional "thread" events, sorted from
     // longest one.
@@ -255,6 +357,9 @@ struct llvm::TimeTraceProfiler {
   const sys::Process::Pid Pid;
   SmallString<0> ThreadName;
   const uint64_t Tid;
+  // Non-null iff hardware counters were requested and could be opened for
+  // this thread.
+  std::unique_ptr<HardwareCounterReader> HWCounters;
 
   // Minimum time granularity (in microseconds)
   const unsigned TimeTraceGranularity;
@@ -268,6 +373,10 @@ void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
       TimeTraceGranularity, llvm::sys::path::filename(ProcName));
 }
 
+void llvm::timeTraceProfilerEnableHardwareCounters() {
+  HardwareCountersRequested = true;
+}
+
 // Removes all TimeTraceProfilerInstances.
 // Called from main thread.
 void llvm::timeTraceProfilerCleanup() {
@@ -520,6 +520,46 @@ directory_iterator OverlayFileSystem::dir_begin(const Twine &Dir,
 
 void ProxyFileSystem::anchor() {}
 
+//===-----------------------------------------------------------------------===/
+// StatCacheFileSystem implementation
+//===-----------------------------------------------------------------------===/
+
+ErrorOr<Status> StatCacheFileSystem::status(const Twine &Path) {
+  SmallString<256> AbsolutePath;
+  Path.toVector(AbsolutePath);
+  if (std::error_code EC = makeAbsolute(AbsolutePath))
+    return EC;
+
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto I = StatCache.find(AbsolutePath);
+    if (I != StatCache.end())
+      return I->second;
+  }
+
+  // Don't hold the lock during the stat itself: on slow (e.g. network-backed)
+  // file systems this is the expensive part, and concurrent misses on
+  // different paths shouldn't serialize each other.
+  ErrorOr<Status> S = getUnderlyingFS().status(AbsolutePath);
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return StatCache.try_emplace(AbsolutePath, std::move(S)).first->second;
+}
+
+void StatCacheFileSystem::invalidateEntry(const Twine &Path) {
+  SmallString<256> AbsolutePath;
+  Path.toVector(AbsolutePath);
+  if (makeAbsolute(AbsolutePath))
+    return;
+  std::lock_guard<std::mutex> Lock(Mutex);
+  StatCache.erase(AbsolutePath);
+}
+
+void StatCacheFileSystem::clearStatCache() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  StatCache.clear();
+}
+
 namespace llvm {
 namespace vfs {
 
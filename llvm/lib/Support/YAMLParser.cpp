@@ -907,6 +907,13 @@ static bool is_ns_word_char(const char C) {
          || (C >= 'A' && C <= 'Z');
 }
 
+/// A flow indicator or ':', any of which may end a plain scalar inside flow
+/// context.
+static bool is_flow_indicator_or_colon(const char C) {
+  return C == ',' || C == ':' || C == '?' || C == '[' || C == ']' ||
+         C == '{' || C == '}';
+}
+
 void Scanner::scan_ns_uri_char() {
   while (true) {
     if (Current == End)
@@ -1336,6 +1343,17 @@ bool Scanner::scanPlainScalar() {
       break;
 
     while (Current != End && !isBlankOrBreak(Current)) {
+      // Bulk-skip the common case: printable ASCII that can neither end the
+      // scalar nor require lookahead, to avoid the full per-character checks
+      // for the bulk of a typical plain scalar.
+      while (Current != End && *Current > 0x20 && *Current <= 0x7E &&
+             !is_flow_indicator_or_colon(*Current)) {
+        ++Current;
+        ++Column;
+      }
+      if (Current == End || isBlankOrBreak(Current))
+        break;
+
       if (FlowLevel && *Current == ':' &&
           (Current + 1 == End ||
            !(isBlankOrBreak(Current + 1) || *(Current + 1) == ','))) {
@@ -1345,9 +1363,7 @@ bool Scanner::scanPlainScalar() {
 
       // Check for the end of the plain scalar.
       if (  (*Current == ':' && isBlankOrBreak(Current + 1))
-          || (  FlowLevel
-          && (StringRef(Current, 1).find_first_of(",:?[]{}")
-              != StringRef::npos)))
+          || (FlowLevel && is_flow_indicator_or_colon(*Current)))
         break;
 
       StringRef::iterator i = skip_nb_char(Current);
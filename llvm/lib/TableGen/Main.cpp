@@ -16,9 +16,13 @@
 
 #include "llvm/TableGen/Main.h"
 #include "TGParser.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/TableGen/Error.h"
@@ -28,9 +32,9 @@
 #include <system_error>
 using namespace llvm;
 
-static cl::opt<std::string>
-OutputFilename("o", cl::desc("Output filename"), cl::value_desc("filename"),
-               cl::init("-"));
+static cl::list<std::string>
+OutputFilenames("o", cl::desc("Output filename (one per requested action)"),
+                cl::value_desc("filename"));
 
 static cl::opt<std::string>
 DependFilename("d",
@@ -55,18 +59,38 @@ WriteIfChanged("write-if-changed", cl::desc("Only write output if it changed"));
 static cl::opt<bool>
 TimePhases("time-phases", cl::desc("Time phases of parser and backend"));
 
+static cl::opt<std::string> ContentCacheFilename(
+    "content-cache",
+    cl::desc("Skip the whole run when the inputs recorded in this cache file "
+             "are unchanged. The cache keys on the content hashes of the "
+             "input file, every include it pulled in, and the output file, "
+             "so it must only be enabled under a build system that reruns "
+             "tablegen when the rest of the command line changes."),
+    cl::value_desc("filename"), cl::init(""));
+
 static int reportError(const char *ProgName, Twine Msg) {
   errs() << ProgName << ": " << Msg;
   errs().flush();
   return 1;
 }
 
+/// Return the output filenames, defaulting to stdout when none were given.
+static std::vector<std::string> getOutputFilenames() {
+  std::vector<std::string> Outputs(OutputFilenames.begin(),
+                                   OutputFilenames.end());
+  if (Outputs.empty())
+    Outputs.push_back("-");
+  return Outputs;
+}
+
 /// Create a dependency file for `-d` option.
 ///
 /// This functionality is really only for the benefit of the build system.
 /// It is similar to GCC's `-M*` family of options.
-static int createDependencyFile(const TGParser &Parser, const char *argv0) {
-  if (OutputFilename == "-")
+static int createDependencyFile(ArrayRef<std::string> Outputs,
+                                ArrayRef<std::string> Deps,
+                                const char *argv0) {
+  if (Outputs[0] == "-")
     return reportError(argv0, "the option -d must be used together with -o\n");
 
   std::error_code EC;
@@ -74,16 +98,139 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   if (EC)
     return reportError(argv0, "error opening " + DependFilename + ":" +
                                   EC.message() + "\n");
-  DepOut.os() << OutputFilename << ":";
-  for (const auto &Dep : Parser.getDependencies()) {
-    DepOut.os() << ' ' << Dep;
+  for (const auto &Output : Outputs) {
+    DepOut.os() << Output << ":";
+    for (const auto &Dep : Deps)
+      DepOut.os() << ' ' << Dep;
+    DepOut.os() << "\n";
   }
-  DepOut.os() << "\n";
   DepOut.keep();
   return 0;
 }
 
+/// Hash the contents of \p Path, or return None if it cannot be read.
+static Optional<SmallString<32>> hashFileContents(const Twine &Path) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr = MemoryBuffer::getFile(Path);
+  if (!BufOrErr)
+    return None;
+  MD5 Hash;
+  Hash.update((*BufOrErr)->getBuffer());
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  return Result.digest();
+}
+
+/// Hash the parts of the invocation the cache must key on: the tool, the
+/// input file name, and the include and macro options. Changes to any of
+/// these can alter which files are read or how they are parsed.
+static SmallString<32> hashInvocation(const char *argv0) {
+  MD5 Hash;
+  auto AddString = [&Hash](StringRef S) {
+    Hash.update(S);
+    Hash.update(StringRef("\0", 1));
+  };
+  AddString(argv0);
+  AddString(InputFilename);
+  for (const std::string &Dir : IncludeDirs)
+    AddString(Dir);
+  for (const std::string &Macro : MacroNames)
+    AddString(Macro);
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  return Result.digest();
+}
+
+/// Return true if the content cache proves that rerunning tablegen would
+/// reproduce the existing output files. On success, \p Deps is filled with
+/// the dependency paths recorded in the cache.
+static bool isCacheUpToDate(const char *argv0, ArrayRef<std::string> Outputs,
+                            std::vector<std::string> &Deps) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> CacheOrErr =
+      MemoryBuffer::getFile(ContentCacheFilename);
+  if (!CacheOrErr)
+    return false;
+
+  SmallVector<StringRef, 32> Lines;
+  (*CacheOrErr)->getBuffer().split(Lines, '\n', /*MaxSplit=*/-1,
+                                   /*KeepEmpty=*/false);
+  if (Lines.size() < 2 || Lines[0] != "tablegen content cache v1")
+    return false;
+
+  // Line 1 holds the invocation hash; the remaining lines hold
+  // "<hash> <path>" pairs, the leading ones describing the output files.
+  if (Lines[1] != hashInvocation(argv0).str())
+    return false;
+
+  unsigned NumOutputsSeen = 0;
+  for (StringRef Line : makeArrayRef(Lines).drop_front(2)) {
+    StringRef HashStr, Path;
+    std::tie(HashStr, Path) = Line.split(' ');
+    if (Path.empty())
+      return false;
+    Optional<SmallString<32>> FileHash = hashFileContents(Path);
+    if (!FileHash || FileHash->str() != HashStr)
+      return false;
+    if (is_contained(Outputs, Path))
+      ++NumOutputsSeen;
+    else
+      Deps.push_back(Path.str());
+  }
+  // Require every requested output to be covered by the cache; a changed -o
+  // list must invalidate it.
+  return NumOutputsSeen == Outputs.size();
+}
+
+/// Record the hashes of this run's inputs and outputs so the next run with
+/// identical content can be skipped.
+static void writeContentCache(const char *argv0, const TGParser &Parser,
+                              ArrayRef<std::string> Outputs,
+                              ArrayRef<std::string> OutputContents) {
+  std::error_code EC;
+  ToolOutputFile CacheOut(ContentCacheFilename, EC, sys::fs::OF_None);
+  if (EC)
+    return;
+
+  auto AddFile = [&CacheOut](StringRef Path) {
+    if (Optional<SmallString<32>> FileHash = hashFileContents(Path))
+      CacheOut.os() << *FileHash << ' ' << Path << '\n';
+  };
+
+  CacheOut.os() << "tablegen content cache v1\n"
+                << hashInvocation(argv0) << '\n';
+  // Hash the in-memory outputs rather than rereading them from disk; the two
+  // are identical whenever the run succeeded.
+  for (size_t I = 0, E = Outputs.size(); I != E; ++I) {
+    MD5 OutputHash;
+    OutputHash.update(OutputContents[I]);
+    MD5::MD5Result OutputResult;
+    OutputHash.final(OutputResult);
+    CacheOut.os() << OutputResult.digest() << ' ' << Outputs[I] << '\n';
+  }
+  AddFile(InputFilename);
+  for (const auto &Dep : Parser.getDependencies())
+    AddFile(Dep);
+  CacheOut.keep();
+}
+
 int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
+  std::vector<std::string> Outputs = getOutputFilenames();
+
+  // If the content cache proves every input is unchanged since the run that
+  // produced the current outputs, skip parsing and the backends entirely.
+  // The dependency file is still rewritten from the cached dependency list
+  // so that build systems do not consider the outputs dirty.
+  if (!ContentCacheFilename.empty() && InputFilename != "-" &&
+      !is_contained(Outputs, "-")) {
+    std::vector<std::string> CachedDeps;
+    if (isCacheUpToDate(argv0, Outputs, CachedDeps)) {
+      if (!DependFilename.empty()) {
+        if (int Ret = createDependencyFile(Outputs, CachedDeps, argv0))
+          return Ret;
+      }
+      return 0;
+    }
+  }
+
   RecordKeeper Records;
 
   if (TimePhases)
@@ -113,11 +260,18 @@ int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
     return 1;
   Records.stopTimer();
 
-  // Write output to memory.
+  // Write the outputs to memory. MainFn is invoked once per output file;
+  // drivers supporting several actions per run pick the next one off their
+  // action list on each invocation. The emitters share the RecordKeeper, so
+  // the whole .td tree is only parsed once per process.
   Records.startBackendTimer("Backend overall");
-  std::string OutString;
-  raw_string_ostream Out(OutString);
-  unsigned status = MainFn(Out, Records);
+  std::vector<std::string> OutStrings(Outputs.size());
+  unsigned status = 0;
+  for (size_t I = 0, E = Outputs.size(); I != E && !status; ++I) {
+    raw_string_ostream Out(OutStrings[I]);
+    status = MainFn(Out, Records);
+    Out.flush();
+  }
   Records.stopBackendTimer();
   if (status)
     return 1;
@@ -127,31 +281,39 @@ int llvm::TableGenMain(const char *argv0, TableGenMainFn *MainFn) {
   // the early exit below and someone deleted the .inc.d file but not the .inc
   // file, tablegen would never write the depfile.
   if (!DependFilename.empty()) {
-    if (int Ret = createDependencyFile(Parser, argv0))
+    std::vector<std::string> Deps(Parser.getDependencies().begin(),
+                                  Parser.getDependencies().end());
+    if (int Ret = createDependencyFile(Outputs, Deps, argv0))
       return Ret;
   }
 
   Records.startTimer("Write output");
-  bool WriteFile = true;
-  if (WriteIfChanged) {
-    // Only updates the real output file if there are any differences.
-    // This prevents recompilation of all the files depending on it if there
-    // aren't any.
-    if (auto ExistingOrErr = MemoryBuffer::getFile(OutputFilename))
-      if (std::move(ExistingOrErr.get())->getBuffer() == Out.str())
-        WriteFile = false;
+  for (size_t I = 0, E = Outputs.size(); I != E; ++I) {
+    bool WriteFile = true;
+    if (WriteIfChanged) {
+      // Only updates the real output file if there are any differences.
+      // This prevents recompilation of all the files depending on it if there
+      // aren't any.
+      if (auto ExistingOrErr = MemoryBuffer::getFile(Outputs[I]))
+        if (std::move(ExistingOrErr.get())->getBuffer() == OutStrings[I])
+          WriteFile = false;
+    }
+    if (WriteFile) {
+      std::error_code EC;
+      ToolOutputFile OutFile(Outputs[I], EC, sys::fs::OF_None);
+      if (EC)
+        return reportError(argv0, "error opening " + Outputs[I] + ": " +
+                                      EC.message() + "\n");
+      OutFile.os() << OutStrings[I];
+      if (ErrorsPrinted == 0)
+        OutFile.keep();
+    }
   }
-  if (WriteFile) {
-    std::error_code EC;
-    ToolOutputFile OutFile(OutputFilename, EC, sys::fs::OF_None);
-    if (EC)
-      return reportError(argv0, "error opening " + OutputFilename + ": " +
-                                    EC.message() + "\n");
-    OutFile.os() << Out.str();
-    if (ErrorsPrinted == 0)
-      OutFile.keep();
-  }
-  
+
+  if (!ContentCacheFilename.empty() && ErrorsPrinted == 0 &&
+      InputFilename != "-" && !is_contained(Outputs, "-"))
+    writeContentCache(argv0, Parser, Outputs, OutStrings);
+
   Records.stopTimer();
   Records.stopPhaseTiming();
 
@@ -767,6 +767,11 @@ AArch64TTIImpl::enableMemCmpExpansion(bool OptSize, bool IsZeroCmp) const {
   // they may wake up the FP unit, which raises the power consumption.  Perhaps
   // they could be used with no holds barred (-O3).
   Options.LoadSizes = {8, 4, 2, 1};
+  // For compares against zero only, allow a 16-byte block: it legalizes to a
+  // load pair feeding a single compare-and-branch, which beats a libc call
+  // for the short buffers that dominate memcmp size profiles.
+  if (IsZeroCmp)
+    Options.LoadSizes.insert(Options.LoadSizes.begin(), 16);
   return Options;
 }
 
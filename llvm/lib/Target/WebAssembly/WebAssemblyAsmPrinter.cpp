@@ -173,8 +173,11 @@ MCSymbolWasm *WebAssemblyAsmPrinter::getMCSymbolForFunction(
 
 void WebAssemblyAsmPrinter::emitEndOfAsmFile(Module &M) {
   for (auto &It : OutContext.getSymbols()) {
+    // Skip table entries that only reserve a name without a symbol.
+    if (!It.getValue().Symbol)
+      continue;
     // Emit a .globaltype and .eventtype declaration.
-    auto Sym = cast<MCSymbolWasm>(It.getValue());
+    auto Sym = cast<MCSymbolWasm>(It.getValue().Symbol);
     if (Sym->getType() == wasm::WASM_SYMBOL_TYPE_GLOBAL)
       getTargetStreamer()->emitGlobalType(Sym);
     else if (Sym->getType() == wasm::WASM_SYMBOL_TYPE_EVENT)
@@ -2115,6 +2115,10 @@ static void collectFrameAllocas(Function &F, coro::Shape &Shape,
     }
   }
 
+  // The dominator tree is only consulted by the use visitor below, but
+  // computing it per alloca is quadratic on coroutines with many allocas.
+  DominatorTree DT(F);
+
   for (Instruction &I : instructions(F)) {
     auto *AI = dyn_cast<AllocaInst>(&I);
     if (!AI)
@@ -2141,7 +2145,6 @@ static void collectFrameAllocas(Function &F, coro::Shape &Shape,
     // At this point, either ShouldLiveOnFrame is true or we didn't have
     // lifetime information. We will need to rely on more precise pointer
     // tracking.
-    DominatorTree DT(F);
     AllocaUseVisitor Visitor{F.getParent()->getDataLayout(), DT,
                              *Shape.CoroBegin, Checker};
     Visitor.visitPtr(*AI);
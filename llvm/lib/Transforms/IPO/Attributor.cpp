@@ -1936,7 +1936,14 @@ void Attributor::recordDependence(const AbstractAttribute &FromAA,
 void Attributor::rememberDependences() {
   assert(!DependenceStack.empty() && "No dependences to remember!");
 
+  // A single update commonly queries the same attribute many times, e.g.,
+  // once per use or instruction it visits. Record each dependence only once
+  // so the dependence vectors, and the work lists seeded from them during the
+  // fixpoint iteration, stay small.
+  SmallDenseSet<PointerIntPair<const AbstractAttribute *, 1>, 16> SeenDeps;
   for (DepInfo &DI : *DependenceStack.back()) {
+    if (!SeenDeps.insert({DI.FromAA, unsigned(DI.DepClass)}).second)
+      continue;
     auto &DepAAs = const_cast<AbstractAttribute &>(*DI.FromAA).Deps;
     DepAAs.push_back(AbstractAttribute::DepTy(
         const_cast<AbstractAttribute *>(DI.ToAA), unsigned(DI.DepClass)));
@@ -1171,7 +1171,10 @@ Expected<bool> FunctionImporter::importFunctions(
     // Find the globals to import
     SetVector<GlobalValue *> GlobalsToImport;
     for (Function &F : *SrcModule) {
-      if (!F.hasName())
+      // Only definitions in the source module can be imported from it, so
+      // skip declarations before computing the GUID; hashing the global
+      // identifier of every external declaration is wasted work.
+      if (!F.hasName() || F.isDeclaration())
         continue;
       auto GUID = F.getGUID();
       auto Import = ImportGUIDs.count(GUID);
@@ -1193,7 +1196,7 @@ Expected<bool> FunctionImporter::importFunctions(
       }
     }
     for (GlobalVariable &GV : SrcModule->globals()) {
-      if (!GV.hasName())
+      if (!GV.hasName() || GV.isDeclaration())
         continue;
       auto GUID = GV.getGUID();
       auto Import = ImportGUIDs.count(GUID);
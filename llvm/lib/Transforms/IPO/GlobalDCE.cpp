@@ -300,16 +300,19 @@ PreservedAnalyses GlobalDCEPass::run(Module &M, ModuleAnalysisManager &MAM) {
   // Remove empty functions from the global ctors list.
   Changed |= optimizeGlobalCtorsList(M, isEmptyFunction);
 
-  // Collect the set of members for each comdat.
-  for (Function &F : M)
-    if (Comdat *C = F.getComdat())
-      ComdatMembers.insert(std::make_pair(C, &F));
-  for (GlobalVariable &GV : M.globals())
-    if (Comdat *C = GV.getComdat())
-      ComdatMembers.insert(std::make_pair(C, &GV));
-  for (GlobalAlias &GA : M.aliases())
-    if (Comdat *C = GA.getComdat())
-      ComdatMembers.insert(std::make_pair(C, &GA));
+  // Collect the set of members for each comdat. Skip the walk entirely when
+  // the module defines no comdats, as is typical after LTO internalization.
+  if (!M.getComdatSymbolTable().empty()) {
+    for (Function &F : M)
+      if (Comdat *C = F.getComdat())
+        ComdatMembers.insert(std::make_pair(C, &F));
+    for (GlobalVariable &GV : M.globals())
+      if (Comdat *C = GV.getComdat())
+        ComdatMembers.insert(std::make_pair(C, &GV));
+    for (GlobalAlias &GA : M.aliases())
+      if (Comdat *C = GA.getComdat())
+        ComdatMembers.insert(std::make_pair(C, &GA));
+  }
 
   // Add dependencies between virtual call sites and the virtual functions they
   // might call, if we have that information.
@@ -3079,19 +3079,25 @@ static bool optimizeGlobalsInModule(
   while (LocalChange) {
     LocalChange = false;
 
+    // Rebuilding this set walks every global three times per round, which is
+    // wasted work when the module has no comdats at all -- the common case
+    // for fully internalized LTO modules, which are also the modules with
+    // the most globals.
     NotDiscardableComdats.clear();
-    for (const GlobalVariable &GV : M.globals())
-      if (const Comdat *C = GV.getComdat())
-        if (!GV.isDiscardableIfUnused() || !GV.use_empty())
-          NotDiscardableComdats.insert(C);
-    for (Function &F : M)
-      if (const Comdat *C = F.getComdat())
-        if (!F.isDefTriviallyDead())
-          NotDiscardableComdats.insert(C);
-    for (GlobalAlias &GA : M.aliases())
-      if (const Comdat *C = GA.getComdat())
-        if (!GA.isDiscardableIfUnused() || !GA.use_empty())
-          NotDiscardableComdats.insert(C);
+    if (!M.getComdatSymbolTable().empty()) {
+      for (const GlobalVariable &GV : M.globals())
+        if (const Comdat *C = GV.getComdat())
+          if (!GV.isDiscardableIfUnused() || !GV.use_empty())
+            NotDiscardableComdats.insert(C);
+      for (Function &F : M)
+        if (const Comdat *C = F.getComdat())
+          if (!F.isDefTriviallyDead())
+            NotDiscardableComdats.insert(C);
+      for (GlobalAlias &GA : M.aliases())
+        if (const Comdat *C = GA.getComdat())
+          if (!GA.isDiscardableIfUnused() || !GA.use_empty())
+            NotDiscardableComdats.insert(C);
+    }
 
     // Delete functions that are trivially dead, ccc -> fastcc
     LocalChange |= OptimizeFunctions(M, GetTLI, GetTTI, GetBFI, LookupDomTree,
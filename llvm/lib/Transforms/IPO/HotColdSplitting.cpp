@@ -576,8 +576,12 @@ bool HotColdSplitting::outlineColdRegions(Function &F, bool HasProfileSummary) {
   // Calculate BFI lazily (it's only used to query ProfileSummaryInfo). This
   // reduces compile-time significantly. TODO: When we *do* use BFI, we should
   // be able to salvage its domtrees instead of recomputing them.
+  //
+  // Skip BFI for functions without profile counts: without an entry count
+  // every block profile count query comes back empty, so PSI can never
+  // classify a block as cold and only the static analysis below applies.
   BlockFrequencyInfo *BFI = nullptr;
-  if (HasProfileSummary)
+  if (HasProfileSummary && F.hasProfileData())
     BFI = GetBFI(F);
 
   TargetTransformInfo &TTI = GetTTI(F);
@@ -733,8 +733,6 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
 
   // Populate the initial list of calls in this SCC.
   for (auto &N : InitialC) {
-    auto &ORE =
-        FAM.getResult<OptimizationRemarkEmitterAnalysis>(N.getFunction());
     // We want to generally process call sites top-down in order for
     // simplifications stemming from replacing the call with the returned value
     // after inlining to be visible to subsequent inlining decisions.
@@ -748,6 +746,11 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
           else if (!isa<IntrinsicInst>(I)) {
             using namespace ore;
             setInlineRemark(*CB, "unavailable definition");
+            // Request the remark emitter lazily: computing it (and any
+            // hotness information it needs) for functions that never emit a
+            // remark is wasted work.
+            auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(
+                N.getFunction());
             ORE.emit([&]() {
               return OptimizationRemarkMissed(DEBUG_TYPE, "NoDefinition", &I)
                      << NV("Callee", Callee) << " will not be inlined into "
@@ -782,6 +785,11 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
   // Loop forward over all of the calls. Note that we cannot cache the size as
   // inlining can introduce new calls that need to be processed.
   for (int I = 0; I < (int)Calls.size(); ++I) {
+    // Entries are set to nullptr rather than erased when their caller is
+    // deleted, to keep this loop linear in the number of call sites.
+    if (!Calls[I].first)
+      continue;
+
     // We expect the calls to typically be batched with sequences of calls that
     // have the same caller, so we first set up some shared infrastructure for
     // this caller. We also do any pruning we can at this layer on the caller
@@ -807,7 +815,9 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
     // We bail out as soon as the caller has to change so we can update the
     // call graph and prepare the context of that new caller.
     bool DidInline = false;
-    for (; I < (int)Calls.size() && Calls[I].first->getCaller() == &F; ++I) {
+    for (; I < (int)Calls.size() && Calls[I].first &&
+           Calls[I].first->getCaller() == &F;
+         ++I) {
       auto &P = Calls[I];
       CallBase *CB = P.first;
       const int InlineHistoryID = P.second;
@@ -895,12 +905,13 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
         // made dead by this operation on other functions).
         Callee.removeDeadConstantUsers();
         if (Callee.use_empty() && !CG.isLibFunction(Callee)) {
-          Calls.erase(
-              std::remove_if(Calls.begin() + I + 1, Calls.end(),
-                             [&](const std::pair<CallBase *, int> &Call) {
-                               return Call.first->getCaller() == &Callee;
-                             }),
-              Calls.end());
+          // Invalidate pending call sites within the dead callee instead of
+          // erasing them; erasing shifts the whole tail of the worklist and
+          // makes this pass quadratic in the number of call sites for SCCs
+          // with many trivially dead local functions.
+          for (auto &Call : make_range(Calls.begin() + I + 1, Calls.end()))
+            if (Call.first && Call.first->getCaller() == &Callee)
+              Call.first = nullptr;
           // Clear the body and queue the function itself for deletion when we
           // finish inlining and call graph updates.
           // Note that after this point, it is an error to do anything other
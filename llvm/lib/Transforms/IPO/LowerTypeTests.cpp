@@ -65,6 +65,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TrailingObjects.h"
 #include "llvm/Support/YAMLTraits.h"
 #include "llvm/Support/raw_ostream.h"
@@ -477,10 +478,8 @@ class LowerTypeTestsModule {
                                        ArrayRef<GlobalTypeMember *> Functions);
   void buildBitSetsFromFunctionsWASM(ArrayRef<Metadata *> TypeIds,
                                      ArrayRef<GlobalTypeMember *> Functions);
-  void
-  buildBitSetsFromDisjointSet(ArrayRef<Metadata *> TypeIds,
-                              ArrayRef<GlobalTypeMember *> Globals,
-                              ArrayRef<ICallBranchFunnel *> ICallBranchFunnels);
+  void buildBitSetsFromDisjointSet(ArrayRef<Metadata *> TypeIds,
+                                   ArrayRef<GlobalTypeMember *> OrderedGTMs);
 
   void replaceWeakDeclarationWithJumpTablePtr(Function *F, Constant *JT,
                                               bool IsJumpTableCanonical);
@@ -1618,9 +1617,14 @@ void LowerTypeTestsModule::buildBitSetsFromFunctionsWASM(
                      GlobalLayout);
 }
 
-void LowerTypeTestsModule::buildBitSetsFromDisjointSet(
-    ArrayRef<Metadata *> TypeIds, ArrayRef<GlobalTypeMember *> Globals,
-    ArrayRef<ICallBranchFunnel *> ICallBranchFunnels) {
+/// Compute the layout of the combined global for one disjoint set, i.e. the
+/// order in which its members will be concatenated. This only reads type
+/// metadata, so the layouts of distinct disjoint sets may be computed in
+/// parallel.
+static std::vector<GlobalTypeMember *>
+layoutDisjointSet(ArrayRef<Metadata *> TypeIds,
+                  ArrayRef<GlobalTypeMember *> Globals,
+                  ArrayRef<ICallBranchFunnel *> ICallBranchFunnels) {
   DenseMap<Metadata *, uint64_t> TypeIdIndices;
   for (unsigned I = 0; I != TypeIds.size(); ++I)
     TypeIdIndices[TypeIds[I]] = I;
@@ -1663,18 +1667,23 @@ void LowerTypeTestsModule::buildBitSetsFromDisjointSet(
     GLB.addFragment(MemSet);
 
   // Build a vector of globals with the computed layout.
-  bool IsGlobalSet =
-      Globals.empty() || isa<GlobalVariable>(Globals[0]->getGlobal());
   std::vector<GlobalTypeMember *> OrderedGTMs(Globals.size());
   auto OGTMI = OrderedGTMs.begin();
-  for (auto &&F : GLB.Fragments) {
-    for (auto &&Offset : F) {
-      if (IsGlobalSet != isa<GlobalVariable>(Globals[Offset]->getGlobal()))
-        report_fatal_error("Type identifier may not contain both global "
-                           "variables and functions");
+  for (auto &&F : GLB.Fragments)
+    for (auto &&Offset : F)
       *OGTMI++ = Globals[Offset];
-    }
-  }
+
+  return OrderedGTMs;
+}
+
+void LowerTypeTestsModule::buildBitSetsFromDisjointSet(
+    ArrayRef<Metadata *> TypeIds, ArrayRef<GlobalTypeMember *> OrderedGTMs) {
+  bool IsGlobalSet =
+      OrderedGTMs.empty() || isa<GlobalVariable>(OrderedGTMs[0]->getGlobal());
+  for (GlobalTypeMember *GTM : OrderedGTMs)
+    if (IsGlobalSet != isa<GlobalVariable>(GTM->getGlobal()))
+      report_fatal_error("Type identifier may not contain both global "
+                         "variables and functions");
 
   // Build the bitsets from this disjoint set.
   if (IsGlobalSet)
@@ -2154,39 +2163,55 @@ bool LowerTypeTestsModule::lower() {
                return S1.second < S2.second;
              });
 
-  // For each disjoint set we found...
-  for (const auto &S : Sets) {
-    // Build the list of type identifiers in this disjoint set.
+  // Materialize the members of each disjoint set.
+  struct DisjointSetInfo {
     std::vector<Metadata *> TypeIds;
     std::vector<GlobalTypeMember *> Globals;
     std::vector<ICallBranchFunnel *> ICallBranchFunnels;
+    std::vector<GlobalTypeMember *> OrderedGTMs;
+  };
+  std::vector<DisjointSetInfo> SetInfos(Sets.size());
+  for (unsigned I = 0; I != Sets.size(); ++I) {
+    DisjointSetInfo &SI = SetInfos[I];
+    // Build the list of type identifiers in this disjoint set.
     for (GlobalClassesTy::member_iterator MI =
-             GlobalClasses.member_begin(S.first);
+             GlobalClasses.member_begin(Sets[I].first);
          MI != GlobalClasses.member_end(); ++MI) {
       if (MI->is<Metadata *>())
-        TypeIds.push_back(MI->get<Metadata *>());
+        SI.TypeIds.push_back(MI->get<Metadata *>());
       else if (MI->is<GlobalTypeMember *>())
-        Globals.push_back(MI->get<GlobalTypeMember *>());
+        SI.Globals.push_back(MI->get<GlobalTypeMember *>());
       else
-        ICallBranchFunnels.push_back(MI->get<ICallBranchFunnel *>());
+        SI.ICallBranchFunnels.push_back(MI->get<ICallBranchFunnel *>());
     }
 
     // Order type identifiers by unique ID for determinism. This ordering is
     // stable as there is a one-to-one mapping between metadata and unique IDs.
-    llvm::sort(TypeIds, [&](Metadata *M1, Metadata *M2) {
+    llvm::sort(SI.TypeIds, [&](Metadata *M1, Metadata *M2) {
       return TypeIdInfo[M1].UniqueId < TypeIdInfo[M2].UniqueId;
     });
 
     // Same for the branch funnels.
-    llvm::sort(ICallBranchFunnels,
+    llvm::sort(SI.ICallBranchFunnels,
                [&](ICallBranchFunnel *F1, ICallBranchFunnel *F2) {
                  return F1->UniqueId < F2->UniqueId;
                });
-
-    // Build bitsets for this disjoint set.
-    buildBitSetsFromDisjointSet(TypeIds, Globals, ICallBranchFunnels);
   }
 
+  // Compute the combined global layouts. This only reads type metadata, so
+  // the layouts of distinct disjoint sets can be computed in parallel. The
+  // resulting IR is built serially below, in the same deterministic order as
+  // before.
+  parallelForEachN(0, SetInfos.size(), [&](size_t I) {
+    DisjointSetInfo &SI = SetInfos[I];
+    SI.OrderedGTMs =
+        layoutDisjointSet(SI.TypeIds, SI.Globals, SI.ICallBranchFunnels);
+  });
+
+  // Build bitsets for each disjoint set.
+  for (const DisjointSetInfo &SI : SetInfos)
+    buildBitSetsFromDisjointSet(SI.TypeIds, SI.OrderedGTMs);
+
   allocateByteArrays();
 
   // Parse alias data to replace stand-in function declarations for aliases
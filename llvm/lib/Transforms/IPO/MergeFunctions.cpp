@@ -119,6 +119,7 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/MergeFunctions.h"
@@ -416,10 +417,19 @@ bool MergeFunctions::runOnModule(Module &M) {
     HashedFuncs;
   for (Function &Func : M) {
     if (isEligibleForMerging(Func)) {
-      HashedFuncs.push_back({FunctionComparator::functionHash(Func), &Func});
+      HashedFuncs.push_back({0, &Func});
     }
   }
 
+  // Hashing only reads the candidate function, so compute all hashes in
+  // parallel before the serial comparison and merging below; on modules with
+  // very many small functions the hash prepass is a large fraction of the
+  // pass time.
+  parallelForEachN(0, HashedFuncs.size(), [&](size_t I) {
+    HashedFuncs[I].first =
+        FunctionComparator::functionHash(*HashedFuncs[I].second);
+  });
+
   llvm::stable_sort(HashedFuncs, less_first());
 
   auto S = HashedFuncs.begin();
@@ -93,6 +93,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/GlobPattern.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/FunctionAttrs.h"
 #include "llvm/Transforms/Utils/Evaluator.h"
@@ -2186,25 +2187,38 @@ void DevirtIndex::run() {
     }
   }
 
+  // Search the members of each type identifier for the virtual function
+  // implementation at the slot's offset, in parallel. This walk over the
+  // compatible-vtable summaries dominates the thin link when whole program
+  // vtables are enabled, and it only reads the index; an empty target list
+  // records a slot we could not analyze. The decisions are applied serially
+  // below, because slots can share both type id summaries and calling
+  // function summaries, which get mutated there.
+  std::vector<std::vector<ValueInfo>> TargetsForSlots(CallSlots.size());
+  parallelForEachN(0, CallSlots.size(), [&](size_t I) {
+    const VTableSlotSummary &Slot = CallSlots.begin()[I].first;
+    auto TidSummary =
+        ExportSummary.getTypeIdCompatibleVtableSummary(Slot.TypeID);
+    assert(TidSummary);
+    // The helper can fail after having found some targets; drop those so
+    // that an empty list is the only failure signal.
+    if (!tryFindVirtualCallTargets(TargetsForSlots[I], *TidSummary,
+                                   Slot.ByteOffset))
+      TargetsForSlots[I].clear();
+  });
+
   std::set<ValueInfo> DevirtTargets;
   // For each (type, offset) pair:
-  for (auto &S : CallSlots) {
-    // Search each of the members of the type identifier for the virtual
-    // function implementation at offset S.first.ByteOffset, and add to
-    // TargetsForSlot.
-    std::vector<ValueInfo> TargetsForSlot;
-    auto TidSummary = ExportSummary.getTypeIdCompatibleVtableSummary(S.first.TypeID);
-    assert(TidSummary);
+  for (size_t I = 0, E = CallSlots.size(); I != E; ++I) {
+    auto &S = CallSlots.begin()[I];
     // Create the type id summary resolution regardlness of whether we can
     // devirtualize, so that lower type tests knows the type id is used on
     // a global and not Unsat.
     WholeProgramDevirtResolution *Res =
         &ExportSummary.getOrInsertTypeIdSummary(S.first.TypeID)
              .WPDRes[S.first.ByteOffset];
-    if (tryFindVirtualCallTargets(TargetsForSlot, *TidSummary,
-                                  S.first.ByteOffset)) {
-
-      if (!trySingleImplDevirt(TargetsForSlot, S.first, S.second, Res,
+    if (!TargetsForSlots[I].empty()) {
+      if (!trySingleImplDevirt(TargetsForSlots[I], S.first, S.second, Res,
                                DevirtTargets))
         continue;
     }
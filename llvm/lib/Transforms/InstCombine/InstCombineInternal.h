@@ -442,12 +442,16 @@ public:
     salvageDebugInfo(I);
 
     // Make sure that we reprocess all operands now that we reduced their
-    // use counts.
+    // use counts. The shorter use lists may enable folds that were guarded
+    // by hasOneUse(), so note the operands as modified too.
     for (Use &Operand : I.operands())
-      if (auto *Inst = dyn_cast<Instruction>(Operand))
+      if (auto *Inst = dyn_cast<Instruction>(Operand)) {
         Worklist.add(Inst);
+        Worklist.noteModified(Inst);
+      }
 
     Worklist.remove(&I);
+    Worklist.forget(&I);
     I.eraseFromParent();
     MadeIRChange = true;
     return nullptr; // Don't do anything with FI
@@ -120,6 +120,7 @@ STATISTIC(NumWorklistIterations,
 STATISTIC(NumCombined , "Number of insts combined");
 STATISTIC(NumConstProp, "Number of constant folds");
 STATISTIC(NumDeadInst , "Number of dead inst eliminated");
+STATISTIC(NumRevisitsSkipped, "Number of unchanged revisits skipped");
 STATISTIC(NumSunkInst , "Number of instructions sunk");
 STATISTIC(NumExpand,    "Number of expansions");
 STATISTIC(NumFactor   , "Number of factorizations");
@@ -139,6 +140,11 @@ static cl::opt<bool>
 EnableCodeSinking("instcombine-code-sinking", cl::desc("Enable code sinking"),
                                               cl::init(true));
 
+static cl::opt<bool> SkipUnchangedRevisits(
+    "instcombine-skip-unchanged-revisits", cl::Hidden, cl::init(true),
+    cl::desc("Skip re-visiting instructions when neither they nor their "
+             "operands have changed since the last unsuccessful visit"));
+
 static cl::opt<unsigned> LimitMaxIterations(
     "instcombine-max-iterations",
     cl::desc("Limit the maximum number of instruction combining iterations"),
@@ -3606,6 +3612,16 @@ bool InstCombinerImpl::run() {
       continue;
     }
 
+    // If a previous visit of this instruction applied no fold and nothing it
+    // can observe through its operands has changed since, visiting it again
+    // would reach the same conclusion. This cuts the repeated revisits that
+    // pushUsersToWorkList() generates on long use chains.
+    if (SkipUnchangedRevisits && Worklist.shouldSkipRevisit(I)) {
+      LLVM_DEBUG(dbgs() << "IC: Skipping unchanged: " << *I << '\n');
+      ++NumRevisitsSkipped;
+      continue;
+    }
+
     if (!DebugCounter::shouldExecute(VisitCounter))
       continue;
 
@@ -3682,6 +3698,7 @@ bool InstCombinerImpl::run() {
     LLVM_DEBUG(raw_string_ostream SS(OrigI); I->print(SS); OrigI = SS.str(););
     LLVM_DEBUG(dbgs() << "IC: Visiting: " << OrigI << '\n');
 
+    uint64_t GenBeforeVisit = Worklist.getGeneration();
     if (Instruction *Result = visit(*I)) {
       ++NumCombined;
       // Should we replace the old instruction with a new one?
@@ -3713,6 +3730,7 @@ bool InstCombinerImpl::run() {
         InstParent->getInstList().insert(InsertPos, Result);
 
         // Push the new instruction and any users onto the worklist.
+        Worklist.noteModified(Result);
         Worklist.pushUsersToWorkList(*Result);
         Worklist.push(Result);
 
@@ -3721,6 +3739,12 @@ bool InstCombinerImpl::run() {
         LLVM_DEBUG(dbgs() << "IC: Mod = " << OrigI << '\n'
                           << "    New = " << *I << '\n');
 
+        // The instruction changed in place; its operands may have been
+        // swapped or rewritten without going through replaceOperand().
+        Worklist.noteModified(I);
+        for (Use &U : I->operands())
+          Worklist.noteModifiedValue(U.get());
+
         // If the instruction was modified, it's possible that it is now dead.
         // if so, remove it.
         if (isInstructionTriviallyDead(I, &TLI)) {
@@ -3731,6 +3755,10 @@ bool InstCombinerImpl::run() {
         }
       }
       MadeIRChange = true;
+    } else if (Worklist.getGeneration() == GenBeforeVisit) {
+      // No fold applied and nothing was modified along the way: remember
+      // this so the next pop of I can be skipped unless its operands change.
+      Worklist.noteFailedVisit(I, GenBeforeVisit);
     }
   }
 
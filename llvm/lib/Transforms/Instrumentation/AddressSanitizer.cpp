@@ -170,6 +170,8 @@ const char kAsanOptionDetectUseAfterReturn[] =
 const char kAsanShadowMemoryDynamicAddress[] =
     "__asan_shadow_memory_dynamic_address";
 
+const char kAsanSampleCounterName[] = "asan.sample_counter";
+
 const char kAsanAllocaPoison[] = "__asan_alloca_poison";
 const char kAsanAllocasUnpoison[] = "__asan_allocas_unpoison";
 
@@ -360,6 +362,14 @@ static cl::opt<uint32_t> ClForceExperiment(
     cl::desc("Force optimization experiment (for testing)"), cl::Hidden,
     cl::init(0));
 
+static cl::opt<unsigned> ClSampleRate(
+    "asan-sample-rate",
+    cl::desc("Execute the inline shadow checks on only one out of every N "
+             "executions of a function, chosen via a per-thread counter "
+             "updated at function entry. Trades detection coverage for "
+             "runtime overhead. 0 or 1 checks every execution (default)"),
+    cl::Hidden, cl::init(0));
+
 static cl::opt<bool>
     ClUsePrivateAlias("asan-use-private-alias",
                       cl::desc("Use private aliases for global variables"),
@@ -646,6 +656,7 @@ struct AddressSanitizer {
   bool instrumentFunction(Function &F, const TargetLibraryInfo *TLI);
   bool maybeInsertAsanInitAtFunctionEntry(Function &F);
   bool maybeInsertDynamicShadowAtFunctionEntry(Function &F);
+  void insertSampleGuardAtFunctionEntry(Function &F);
   void markEscapedLocalAllocas(Function &F);
 
 private:
@@ -666,10 +677,12 @@ private:
       assert(Pass->ProcessedAllocas.empty() &&
              "last pass forgot to clear cache");
       assert(!Pass->LocalDynamicShadow);
+      assert(!Pass->SampleGuard);
     }
 
     ~FunctionStateRAII() {
       Pass->LocalDynamicShadow = nullptr;
+      Pass->SampleGuard = nullptr;
       Pass->ProcessedAllocas.clear();
     }
   };
@@ -696,6 +709,9 @@ private:
 
   FunctionCallee AsanMemmove, AsanMemcpy, AsanMemset;
   Value *LocalDynamicShadow = nullptr;
+  // When sampling is enabled, holds the per-invocation "this execution is
+  // sampled" flag computed at function entry.
+  Value *SampleGuard = nullptr;
   const GlobalsMetadata &GlobalsMD;
   DenseMap<const AllocaInst *, bool> ProcessedAllocas;
 };
@@ -1585,11 +1601,22 @@ void AddressSanitizer::instrumentMop(ObjectSizeOffsetVisitor &ObjSizeVis,
 
   unsigned Granularity = 1 << Mapping.Scale;
   if (O.MaybeMask) {
+    // Masked accesses already branch on the mask elements and are rare enough
+    // that they are not worth sampling: always check them.
     instrumentMaskedLoadOrStore(this, DL, IntptrTy, O.MaybeMask, O.getInsn(),
                                 Addr, O.Alignment, Granularity, O.TypeSize,
                                 O.IsWrite, nullptr, UseCalls, Exp);
   } else {
-    doInstrumentAddress(this, O.getInsn(), O.getInsn(), Addr, O.Alignment,
+    Instruction *InsertBefore = O.getInsn();
+    if (SampleGuard) {
+      // Only run the check on the sampled executions of this function: branch
+      // over it otherwise.
+      Instruction *GuardTerm = SplitBlockAndInsertIfThen(
+          SampleGuard, InsertBefore, false,
+          MDBuilder(*C).createBranchWeights(1, ClSampleRate - 1));
+      InsertBefore = GuardTerm;
+    }
+    doInstrumentAddress(this, O.getInsn(), InsertBefore, Addr, O.Alignment,
                         Granularity, O.TypeSize, O.IsWrite, nullptr, UseCalls,
                         Exp);
   }
@@ -2634,6 +2661,29 @@ bool AddressSanitizer::maybeInsertDynamicShadowAtFunctionEntry(Function &F) {
   return true;
 }
 
+// Increment a per-thread counter at function entry and compute whether this
+// execution of the function is sampled, i.e. whether its shadow checks should
+// run. instrumentMop branches over the checks when the guard is false.
+void AddressSanitizer::insertSampleGuardAtFunctionEntry(Function &F) {
+  Module &M = *F.getParent();
+  Type *Int32Ty = Type::getInt32Ty(*C);
+  GlobalVariable *Counter = M.getGlobalVariable(kAsanSampleCounterName);
+  if (!Counter) {
+    Counter = new GlobalVariable(M, Int32Ty, false,
+                                 GlobalValue::InternalLinkage,
+                                 Constant::getNullValue(Int32Ty),
+                                 kAsanSampleCounterName);
+    Counter->setThreadLocal(true);
+  }
+  IRBuilder<> IRB(&F.front().front());
+  Value *Count = IRB.CreateLoad(Int32Ty, Counter);
+  Value *Incremented = IRB.CreateAdd(Count, IRB.getInt32(1));
+  Value *Wrapped =
+      IRB.CreateURem(Incremented, IRB.getInt32(ClSampleRate));
+  IRB.CreateStore(Wrapped, Counter);
+  SampleGuard = IRB.CreateICmpEQ(Wrapped, IRB.getInt32(0), "asan.sampled");
+}
+
 void AddressSanitizer::markEscapedLocalAllocas(Function &F) {
   // Find the one possible call to llvm.localescape and pre-mark allocas passed
   // to it as uninteresting. This assumes we haven't started processing allocas
@@ -2764,6 +2814,9 @@ bool AddressSanitizer::instrumentFunction(Function &F,
   bool UseCalls = (ClInstrumentationWithCallsThreshold >= 0 &&
                    OperandsToInstrument.size() + IntrinToInstrument.size() >
                        (unsigned)ClInstrumentationWithCallsThreshold);
+
+  if (ClSampleRate > 1 && !OperandsToInstrument.empty())
+    insertSampleGuardAtFunctionEntry(F);
   const DataLayout &DL = F.getParent()->getDataLayout();
   ObjectSizeOpts ObjSizeOpts;
   ObjSizeOpts.RoundToAlign = true;
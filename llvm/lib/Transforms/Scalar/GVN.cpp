@@ -132,6 +132,12 @@ struct llvm::GVN::Expression {
   Type *type = nullptr;
   SmallVector<uint32_t, 4> varargs;
 
+  // The cached hash of this expression, or zero if it has not been computed
+  // yet. Filled in by DenseMapInfo<Expression>::getHashValue, so growing the
+  // expression table does not hash every resident entry from scratch. Must be
+  // reset to zero whenever opcode or varargs are modified.
+  mutable unsigned HashValue = 0;
+
   Expression(uint32_t o = ~2U) : opcode(o) {}
 
   bool operator==(const Expression &other) const {
@@ -162,7 +168,9 @@ template <> struct DenseMapInfo<GVN::Expression> {
   static unsigned getHashValue(const GVN::Expression &e) {
     using llvm::hash_value;
 
-    return static_cast<unsigned>(hash_value(e));
+    if (!e.HashValue)
+      e.HashValue = static_cast<unsigned>(hash_value(e));
+    return e.HashValue;
   }
 
   static bool isEqual(const GVN::Expression &LHS, const GVN::Expression &RHS) {
@@ -596,6 +604,15 @@ uint32_t GVN::ValueTable::lookupOrAddCmp(unsigned Opcode,
   return assignExpNewValueNum(exp).first;
 }
 
+/// Pre-allocate space for roughly \p NumValues values, so that numbering a
+/// large function does not repeatedly grow and rehash the tables.
+void GVN::ValueTable::reserve(uint32_t NumValues) {
+  valueNumbering.reserve(NumValues);
+  expressionNumbering.reserve(NumValues);
+  Expressions.reserve(NumValues);
+  ExprIdx.reserve(NumValues);
+}
+
 /// Remove all entries from the ValueTable.
 void GVN::ValueTable::clear() {
   valueNumbering.clear();
@@ -1883,6 +1900,9 @@ uint32_t GVN::ValueTable::phiTranslateImpl(const BasicBlock *Pred,
   if (Num >= ExprIdx.size() || ExprIdx[Num] == 0)
     return Num;
   Expression Exp = Expressions[ExprIdx[Num]];
+  // The translation below modifies the expression; drop the cached hash that
+  // was copied along with it.
+  Exp.HashValue = 0;
 
   for (unsigned i = 0; i < Exp.varargs.size(); i++) {
     // For InsertValue and ExtractValue, some varargs are index numbers
@@ -2306,6 +2326,11 @@ bool GVN::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
   MemorySSAUpdater Updater(MSSA);
   MSSAU = MSSA ? &Updater : nullptr;
 
+  // Pre-size the numbering tables; nearly every instruction receives a value
+  // number, and growing the tables on demand rehashes all resident entries at
+  // every doubling.
+  VN.reserve(F.getInstructionCount());
+
   bool Changed = false;
   bool ShouldContinue = true;
 
@@ -124,6 +124,21 @@ static cl::opt<int>
 LICMN2Theshold("licm-n2-threshold", cl::Hidden, cl::init(0),
                cl::desc("How many instruction to cross product using AA"));
 
+// Default value of zero means LICM uses the global
+// -alias-set-saturation-threshold limit. A non-zero value overrides it for
+// the alias set trackers LICM builds, letting large memory-heavy loops keep
+// precise alias sets instead of degrading to a single "alias anything" set.
+static cl::opt<unsigned> LICMAliasSetSaturationThreshold(
+    "licm-alias-set-saturation-threshold", cl::Hidden, cl::init(0),
+    cl::desc("Override the alias set saturation threshold for the trackers "
+             "built by LICM (0 = use the global default)"));
+
+static Optional<unsigned> getLICMSaturationThreshold() {
+  if (LICMAliasSetSaturationThreshold == 0)
+    return None;
+  return LICMAliasSetSaturationThreshold.getValue();
+}
+
 // Experimental option to allow imprecision in LICM in pathological cases, in
 // exchange for faster compile. This is to be removed if MemorySSA starts to
 // address the same issue. This flag applies only when LICM uses MemorySSA
@@ -2220,7 +2235,8 @@ bool llvm::promoteLoopAccessesToScalars(
 std::unique_ptr<AliasSetTracker>
 LoopInvariantCodeMotion::collectAliasInfoForLoop(Loop *L, LoopInfo *LI,
                                                  AAResults *AA) {
-  auto CurAST = std::make_unique<AliasSetTracker>(*AA);
+  auto CurAST =
+      std::make_unique<AliasSetTracker>(*AA, getLICMSaturationThreshold());
 
   // Add everything from all the sub loops.
   for (Loop *InnerL : L->getSubLoops())
@@ -2239,7 +2255,8 @@ std::unique_ptr<AliasSetTracker>
 LoopInvariantCodeMotion::collectAliasInfoForLoopWithMSSA(
     Loop *L, AAResults *AA, MemorySSAUpdater *MSSAU) {
   auto *MSSA = MSSAU->getMemorySSA();
-  auto CurAST = std::make_unique<AliasSetTracker>(*AA, MSSA, L);
+  auto CurAST = std::make_unique<AliasSetTracker>(
+      *AA, MSSA, L, getLICMSaturationThreshold());
   CurAST->addAllInstructionsInLoopUsingMSSA();
   return CurAST;
 }
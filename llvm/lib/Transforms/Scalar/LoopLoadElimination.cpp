@@ -731,6 +731,11 @@ PreservedAnalyses LoopLoadEliminationPass::run(Function &F,
   if (!Changed)
     return PreservedAnalyses::all();
 
+  // LoopVersioning keeps the dominator tree and loop info up to date, so
+  // preserve them as the legacy pass does; dropping them here would also
+  // needlessly flush every cached loop analysis for the function.
   PreservedAnalyses PA;
+  PA.preserve<DominatorTreeAnalysis>();
+  PA.preserve<LoopAnalysis>();
   return PA;
 }
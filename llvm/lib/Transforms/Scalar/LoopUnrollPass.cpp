@@ -1096,8 +1096,20 @@ static LoopUnrollResult tryToUnrollLoop(
   if (!ExitingBlock || !L->isLoopExiting(ExitingBlock))
     ExitingBlock = L->getExitingBlock();
   if (ExitingBlock) {
-    TripCount = SE.getSmallConstantTripCount(L, ExitingBlock);
-    TripMultiple = SE.getSmallConstantTripMultiple(L, ExitingBlock);
+    // Try the cheap pattern-matching fast path first; loops with a small
+    // constant trip count are common and answering them here avoids
+    // computing a backedge-taken count through SCEV. The fast path only
+    // handles latch-exiting loops, for which it agrees with the latch-based
+    // trip count below.
+    if (Optional<unsigned> KnownTripCount =
+            getSmallConstantTripCountWithoutSCEV(L)) {
+      TripCount = *KnownTripCount;
+      // An exact trip count is trivially its own largest divisor.
+      TripMultiple = *KnownTripCount;
+    } else {
+      TripCount = SE.getSmallConstantTripCount(L, ExitingBlock);
+      TripMultiple = SE.getSmallConstantTripMultiple(L, ExitingBlock);
+    }
   }
 
   // If the loop contains a convergent operation, the prelude we'd add
@@ -68,7 +68,7 @@ using namespace llvm;
 #define DEBUG_TYPE "memcpyopt"
 
 static cl::opt<bool>
-    EnableMemorySSA("enable-memcpyopt-memoryssa", cl::init(false), cl::Hidden,
+    EnableMemorySSA("enable-memcpyopt-memoryssa", cl::init(true), cl::Hidden,
                     cl::desc("Use MemorySSA-backed MemCpyOpt."));
 
 STATISTIC(NumMemCpyInstr, "Number of memcpy instructions deleted");
@@ -308,6 +308,7 @@ INITIALIZE_PASS_DEPENDENCY(MemoryDependenceWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(TargetLibraryInfoWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(AAResultsWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(GlobalsAAWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(MemorySSAWrapperPass)
 INITIALIZE_PASS_END(MemCpyOptLegacyPass, "memcpyopt", "MemCpy Optimization",
                     false, false)
 
@@ -515,9 +516,13 @@ Instruction *MemCpyOptPass::tryMergingIntoMemset(Instruction *StartInst,
 // may alias with these.
 // The method returns true if it was successful.
 bool MemCpyOptPass::moveUp(StoreInst *SI, Instruction *P, const LoadInst *LI) {
+  // The IR is only modified once all queries have been made, so we can batch
+  // the alias queries and reuse BasicAA's decomposition caches across them.
+  BatchAAResults BAA(*AA);
+
   // If the store alias this position, early bail out.
   MemoryLocation StoreLoc = MemoryLocation::get(SI);
-  if (isModOrRefSet(AA->getModRefInfo(P, StoreLoc)))
+  if (isModOrRefSet(BAA.getModRefInfo(P, StoreLoc)))
     return false;
 
   // Keep track of the arguments of all instruction we plan to lift
@@ -546,19 +551,19 @@ bool MemCpyOptPass::moveUp(StoreInst *SI, Instruction *P, const LoadInst *LI) {
     if (!isGuaranteedToTransferExecutionToSuccessor(C))
       return false;
 
-    bool MayAlias = isModOrRefSet(AA->getModRefInfo(C, None));
+    bool MayAlias = isModOrRefSet(BAA.getModRefInfo(C, None));
 
     bool NeedLift = false;
     if (Args.erase(C))
       NeedLift = true;
     else if (MayAlias) {
-      NeedLift = llvm::any_of(MemLocs, [C, this](const MemoryLocation &ML) {
-        return isModOrRefSet(AA->getModRefInfo(C, ML));
+      NeedLift = llvm::any_of(MemLocs, [C, &BAA](const MemoryLocation &ML) {
+        return isModOrRefSet(BAA.getModRefInfo(C, ML));
       });
 
       if (!NeedLift)
-        NeedLift = llvm::any_of(Calls, [C, this](const CallBase *Call) {
-          return isModOrRefSet(AA->getModRefInfo(C, Call));
+        NeedLift = llvm::any_of(Calls, [C, &BAA](const CallBase *Call) {
+          return isModOrRefSet(BAA.getModRefInfo(C, Call));
         });
     }
 
@@ -568,18 +573,18 @@ bool MemCpyOptPass::moveUp(StoreInst *SI, Instruction *P, const LoadInst *LI) {
     if (MayAlias) {
       // Since LI is implicitly moved downwards past the lifted instructions,
       // none of them may modify its source.
-      if (isModSet(AA->getModRefInfo(C, LoadLoc)))
+      if (isModSet(BAA.getModRefInfo(C, LoadLoc)))
         return false;
       else if (const auto *Call = dyn_cast<CallBase>(C)) {
         // If we can't lift this before P, it's game over.
-        if (isModOrRefSet(AA->getModRefInfo(P, Call)))
+        if (isModOrRefSet(BAA.getModRefInfo(P, Call)))
           return false;
 
         Calls.push_back(Call);
       } else if (isa<LoadInst>(C) || isa<StoreInst>(C) || isa<VAArgInst>(C)) {
         // If we can't lift this before P, it's game over.
         auto ML = MemoryLocation::get(C);
-        if (isModOrRefSet(AA->getModRefInfo(P, ML)))
+        if (isModOrRefSet(BAA.getModRefInfo(P, ML)))
           return false;
 
         MemLocs.push_back(ML);
@@ -673,9 +678,10 @@ bool MemCpyOptPass::processStore(StoreInst *SI, BasicBlock::iterator &BBI) {
         // such an instruction is found, we try to promote there instead
         // of at the store position.
         // TODO: Can use MSSA for this.
+        BatchAAResults BAA(*AA);
         Instruction *P = SI;
         for (auto &I : make_range(++LI->getIterator(), SI->getIterator())) {
-          if (isModSet(AA->getModRefInfo(&I, LoadLoc))) {
+          if (isModSet(BAA.getModRefInfo(&I, LoadLoc))) {
             P = &I;
             break;
           }
@@ -761,10 +767,11 @@ bool MemCpyOptPass::processStore(StoreInst *SI, BasicBlock::iterator &BBI) {
                               MSSA->getMemoryAccess(SI)))
             C = nullptr;
         } else {
+          BatchAAResults BAA(*AA);
           for (BasicBlock::iterator I = --SI->getIterator(),
                                     E = C->getIterator();
                I != E; --I) {
-            if (isModOrRefSet(AA->getModRefInfo(&*I, StoreLoc))) {
+            if (isModOrRefSet(BAA.getModRefInfo(&*I, StoreLoc))) {
               C = nullptr;
               break;
             }
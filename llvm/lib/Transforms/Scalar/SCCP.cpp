@@ -188,6 +188,11 @@ public:
     return A->second.PredInfo->getPredicateInfoFor(I);
   }
 
+  /// Pre-size the value state table for roughly \p NumValues lattice cells.
+  /// On large modules the solver otherwise grows the table many times while
+  /// solving, and every rehash moves all previously inserted cells.
+  void reserveValueStates(unsigned NumValues) { ValueState.reserve(NumValues); }
+
   DomTreeUpdater getDTU(Function &F) {
     auto A = AnalysisResults.find(&F);
     assert(A != AnalysisResults.end() && "Need analysis results for function.");
@@ -1716,6 +1721,8 @@ static bool runSCCP(Function &F, const DataLayout &DL,
       DL, [TLI](Function &F) -> const TargetLibraryInfo & { return *TLI; },
       F.getContext());
 
+  Solver.reserveValueStates(F.arg_size() + F.getInstructionCount());
+
   // Mark the first block of the function as being executable.
   Solver.MarkBlockExecutable(&F.front());
 
@@ -1936,6 +1943,14 @@ bool llvm::runIPSCCP(
     function_ref<AnalysisResultsForFn(Function &)> getAnalysis) {
   SCCPSolver Solver(DL, GetTLI, M.getContext());
 
+  // Size the lattice for the whole module up front. This overcounts (dead
+  // functions, values that never get a cell), but a hashtable reservation is
+  // only a hint and it keeps the solver from rehashing while it runs.
+  unsigned NumValues = 0;
+  for (Function &F : M)
+    NumValues += F.arg_size() + F.getInstructionCount();
+  Solver.reserveValueStates(NumValues);
+
   // Loop over all functions, marking arguments to those with their addresses
   // taken or that are external as overdefined.
   for (Function &F : M) {
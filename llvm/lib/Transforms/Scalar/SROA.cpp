@@ -4442,12 +4442,28 @@ bool SROA::splitAlloca(AllocaInst &AI, AllocaSlices &AS) {
   const uint64_t MaxBitVectorSize = 1024;
   if (AllocaSize <= MaxBitVectorSize) {
     // If a byte boundary is included in any load or store, a slice starting or
-    // ending at the boundary is not splittable.
+    // ending at the boundary is not splittable. Compute the interior offsets
+    // with a sweep over the slice boundaries rather than walking every byte
+    // covered by every slice, which becomes quadratic when many slices span
+    // large parts of the alloca.
     SmallBitVector SplittableOffset(AllocaSize + 1, true);
-    for (Slice &S : AS)
-      for (unsigned O = S.beginOffset() + 1;
-           O < S.endOffset() && O < AllocaSize; O++)
-        SplittableOffset.reset(O);
+    {
+      SmallVector<int64_t, 0> Coverage(AllocaSize + 1, 0);
+      for (Slice &S : AS) {
+        uint64_t Begin = std::min(S.beginOffset() + 1, AllocaSize);
+        uint64_t End = std::min(S.endOffset(), AllocaSize);
+        if (Begin >= End)
+          continue;
+        ++Coverage[Begin];
+        --Coverage[End];
+      }
+      int64_t Depth = 0;
+      for (uint64_t O = 0; O <= AllocaSize; ++O) {
+        Depth += Coverage[O];
+        if (Depth > 0)
+          SplittableOffset.reset(O);
+      }
+    }
 
     for (Slice &S : AS) {
       if (!S.isSplittable())
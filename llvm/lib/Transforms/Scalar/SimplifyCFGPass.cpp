@@ -31,6 +31,7 @@
 #include "llvm/IR/CFG.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DataLayout.h"
+#include "llvm/IR/Dominators.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Module.h"
@@ -70,6 +71,12 @@ static cl::opt<bool> UserSinkCommonInsts(
     "sink-common-insts", cl::Hidden, cl::init(false),
     cl::desc("Sink common instructions (default = false)"));
 
+static cl::opt<bool> UserPreserveDomTree(
+    "simplifycfg-preserve-domtree", cl::Hidden, cl::init(false),
+    cl::desc("Preserve the dominator tree across the pass by recomputing it "
+             "once after all simplifications instead of letting every "
+             "downstream user rebuild it (default = false)"));
+
 
 STATISTIC(NumSimpl, "Number of blocks simplified");
 
@@ -253,6 +260,14 @@ PreservedAnalyses SimplifyCFGPass::run(Function &F,
   if (!simplifyFunctionCFG(F, TTI, Options))
     return PreservedAnalyses::all();
   PreservedAnalyses PA;
+  if (UserPreserveDomTree) {
+    // The individual simplifications do not maintain the tree incrementally
+    // (yet), but one batched recomputation here is much cheaper than having
+    // every downstream DominatorTree user rebuild it from scratch.
+    if (auto *DT = AM.getCachedResult<DominatorTreeAnalysis>(F))
+      DT->recalculate(F);
+    PA.preserve<DominatorTreeAnalysis>();
+  }
   PA.preserve<GlobalsAA>();
   return PA;
 }
@@ -287,11 +302,17 @@ struct CFGSimplifyPass : public FunctionPass {
     }
 
     auto &TTI = getAnalysis<TargetTransformInfoWrapperPass>().getTTI(F);
-    return simplifyFunctionCFG(F, TTI, Options);
+    bool Changed = simplifyFunctionCFG(F, TTI, Options);
+    if (Changed && UserPreserveDomTree)
+      if (auto *DTWP = getAnalysisIfAvailable<DominatorTreeWrapperPass>())
+        DTWP->getDomTree().recalculate(F);
+    return Changed;
   }
   void getAnalysisUsage(AnalysisUsage &AU) const override {
     AU.addRequired<AssumptionCacheTracker>();
     AU.addRequired<TargetTransformInfoWrapperPass>();
+    if (UserPreserveDomTree)
+      AU.addPreserved<DominatorTreeWrapperPass>();
     AU.addPreserved<GlobalsAAWrapperPass>();
   }
 };
@@ -964,6 +964,12 @@ FunctionComparator::FunctionHash FunctionComparator::functionHash(Function &F) {
     H.add(45798);
     for (auto &Inst : *BB) {
       H.add(Inst.getOpcode());
+      // Also mix in cheap invariants that any pair of instructions compared
+      // equal by cmpOperations must share. This keeps the hash insensitive to
+      // the operand values themselves while filtering out provably distinct
+      // bodies before the expensive ordered comparison.
+      H.add(Inst.getNumOperands());
+      H.add(Inst.getType()->getTypeID());
     }
     const Instruction *Term = BB->getTerminator();
     for (unsigned i = 0, e = Term->getNumSuccessors(); i != e; ++i) {
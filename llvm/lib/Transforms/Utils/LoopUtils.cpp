@@ -846,6 +846,113 @@ bool llvm::setLoopEstimatedTripCount(Loop *L, unsigned EstimatedTripCount,
   return true;
 }
 
+/// Evaluate an integer compare of two constant values.
+static bool evaluateICmp(ICmpInst::Predicate Pred, const APInt &LHS,
+                         const APInt &RHS) {
+  switch (Pred) {
+  case ICmpInst::ICMP_EQ:
+    return LHS == RHS;
+  case ICmpInst::ICMP_NE:
+    return LHS != RHS;
+  case ICmpInst::ICMP_UGT:
+    return LHS.ugt(RHS);
+  case ICmpInst::ICMP_UGE:
+    return LHS.uge(RHS);
+  case ICmpInst::ICMP_ULT:
+    return LHS.ult(RHS);
+  case ICmpInst::ICMP_ULE:
+    return LHS.ule(RHS);
+  case ICmpInst::ICMP_SGT:
+    return LHS.sgt(RHS);
+  case ICmpInst::ICMP_SGE:
+    return LHS.sge(RHS);
+  case ICmpInst::ICMP_SLT:
+    return LHS.slt(RHS);
+  case ICmpInst::ICMP_SLE:
+    return LHS.sle(RHS);
+  default:
+    llvm_unreachable("Invalid integer predicate");
+  }
+}
+
+Optional<unsigned> llvm::getSmallConstantTripCountWithoutSCEV(Loop *L) {
+  // Give up after simulating this many iterations; clients of this fast path
+  // only care about trip counts small enough to consider unrolling anyway.
+  const unsigned MaxSimulatedIterations = 1024;
+
+  // Only handle rotated loops where the latch is the sole exiting block, so
+  // the latch condition alone determines the trip count.
+  BasicBlock *Header = L->getHeader();
+  BasicBlock *Latch = L->getLoopLatch();
+  BasicBlock *Preheader = L->getLoopPreheader();
+  if (!Latch || !Preheader || L->getExitingBlock() != Latch)
+    return None;
+
+  auto *LatchBranch = dyn_cast<BranchInst>(Latch->getTerminator());
+  if (!LatchBranch || !LatchBranch->isConditional())
+    return None;
+  bool ExitOnTrue = !L->contains(LatchBranch->getSuccessor(0));
+
+  auto *Cmp = dyn_cast<ICmpInst>(LatchBranch->getCondition());
+  if (!Cmp)
+    return None;
+  auto *Bound = dyn_cast<ConstantInt>(Cmp->getOperand(1));
+  if (!Bound)
+    return None;
+
+  // The compared value must be a canonical induction recurrence: either the
+  // header phi or its increment in the latch-incoming value.
+  PHINode *IV;
+  BinaryOperator *Inc;
+  if ((IV = dyn_cast<PHINode>(Cmp->getOperand(0)))) {
+    if (IV->getParent() != Header)
+      return None;
+    Inc = dyn_cast<BinaryOperator>(IV->getIncomingValueForBlock(Latch));
+    if (!Inc)
+      return None;
+  } else if ((Inc = dyn_cast<BinaryOperator>(Cmp->getOperand(0)))) {
+    IV = dyn_cast<PHINode>(Inc->getOperand(0));
+    if (!IV || IV->getParent() != Header ||
+        IV->getIncomingValueForBlock(Latch) != Inc)
+      return None;
+  } else {
+    return None;
+  }
+  if (IV->getNumIncomingValues() != 2 || Inc->getOpcode() != Instruction::Add ||
+      Inc->getOperand(0) != IV)
+    return None;
+  auto *Step = dyn_cast<ConstantInt>(Inc->getOperand(1));
+  auto *Start = dyn_cast<ConstantInt>(IV->getIncomingValueForBlock(Preheader));
+  if (!Step || !Start)
+    return None;
+
+  // Simulate the recurrence. On iteration TC the latch compares either the
+  // phi value or its increment against the bound and exits or loops back;
+  // the trip count is the number of times the loop body runs.
+  bool ComparesIncrement = Cmp->getOperand(0) == Inc;
+  bool HasNSW = Inc->hasNoSignedWrap();
+  bool HasNUW = Inc->hasNoUnsignedWrap();
+  const APInt &StepVal = Step->getValue();
+  const APInt &BoundVal = Bound->getValue();
+  APInt IVVal = Start->getValue();
+  for (unsigned TC = 1; TC <= MaxSimulatedIterations; ++TC) {
+    // If the increment would violate its wrap flags the value is poison and
+    // the latch branch has no meaningful trip count.
+    bool SignedOverflow, UnsignedOverflow;
+    APInt IncVal = IVVal.sadd_ov(StepVal, SignedOverflow);
+    (void)IVVal.uadd_ov(StepVal, UnsignedOverflow);
+    if ((HasNSW && SignedOverflow) || (HasNUW && UnsignedOverflow))
+      return None;
+
+    if (evaluateICmp(Cmp->getPredicate(),
+                     ComparesIncrement ? IncVal : IVVal,
+                     BoundVal) == ExitOnTrue)
+      return TC;
+    IVVal = IncVal;
+  }
+  return None;
+}
+
 bool llvm::hasIterationCountInvariantInParent(Loop *InnerLoop,
                                               ScalarEvolution &SE) {
   Loop *OuterL = InnerLoop->getParentLoop();
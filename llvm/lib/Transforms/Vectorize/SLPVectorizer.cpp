@@ -6038,19 +6038,61 @@ bool SLPVectorizerPass::vectorizeStores(ArrayRef<StoreInst *> Stores,
     ConsecutiveChain[K] = Idx;
     return true;
   };
-  // Do a quadratic search on all of the given stores in reverse order and find
-  // all of the pairs of stores that follow each other.
-  for (int Idx = E - 1; Idx >= 0; --Idx) {
-    // If a store has multiple consecutive store candidates, search according
-    // to the sequence: Idx-1, Idx+1, Idx-2, Idx+2, ...
-    // This is because usually pairing with immediate succeeding or preceding
-    // candidate create the best chance to find slp vectorization opportunity.
-    const int MaxLookDepth = std::max(E - Idx, Idx + 1);
-    IterCnt = 0;
-    for (int Offset = 1, F = MaxLookDepth; Offset < F; ++Offset)
-      if ((Idx >= Offset && FindConsecutiveAccess(Idx - Offset, Idx)) ||
-          (Idx + Offset < E && FindConsecutiveAccess(Idx + Offset, Idx)))
-        break;
+  // If the distance of every store from the first one is a compile-time
+  // constant, sorting by that distance exposes the consecutive pairs directly
+  // and chain formation is O(E log E). This is the common case, since the
+  // stores in a bucket share their underlying object. Otherwise fall back to
+  // the capped quadratic probe below.
+  bool AllConstantOffsets = true;
+  SmallVector<std::pair<int64_t, int>, 16> OffsetAndIdx;
+  OffsetAndIdx.reserve(E);
+  const SCEV *BaseSCEV = SE->getSCEV(Stores[0]->getPointerOperand());
+  for (int Idx = 0; Idx != E; ++Idx) {
+    const auto *Diff = dyn_cast<SCEVConstant>(SE->getMinusSCEV(
+        SE->getSCEV(Stores[Idx]->getPointerOperand()), BaseSCEV));
+    if (!Diff) {
+      AllConstantOffsets = false;
+      break;
+    }
+    OffsetAndIdx.emplace_back(Diff->getAPInt().getSExtValue(), Idx);
+  }
+
+  if (AllConstantOffsets) {
+    stable_sort(OffsetAndIdx, [](const std::pair<int64_t, int> &LHS,
+                                 const std::pair<int64_t, int> &RHS) {
+      return LHS.first < RHS.first;
+    });
+    int PrevIdx = OffsetAndIdx.front().second;
+    int64_t PrevOffset = OffsetAndIdx.front().first;
+    for (int I = 1; I != E; ++I) {
+      int64_t Offset = OffsetAndIdx[I].first;
+      int Idx = OffsetAndIdx[I].second;
+      // Stores at the same address can't extend the chain; keep the earlier
+      // one as the candidate predecessor, as the quadratic search would.
+      if (Offset == PrevOffset)
+        continue;
+      if (isConsecutiveAccess(Stores[PrevIdx], Stores[Idx], *DL, *SE)) {
+        Tails.set(Idx);
+        ConsecutiveChain[PrevIdx] = Idx;
+      }
+      PrevIdx = Idx;
+      PrevOffset = Offset;
+    }
+  } else {
+    // Do a quadratic search on all of the given stores in reverse order and
+    // find all of the pairs of stores that follow each other.
+    for (int Idx = E - 1; Idx >= 0; --Idx) {
+      // If a store has multiple consecutive store candidates, search according
+      // to the sequence: Idx-1, Idx+1, Idx-2, Idx+2, ...
+      // This is because usually pairing with immediate succeeding or preceding
+      // candidate create the best chance to find slp vectorization opportunity.
+      const int MaxLookDepth = std::max(E - Idx, Idx + 1);
+      IterCnt = 0;
+      for (int Offset = 1, F = MaxLookDepth; Offset < F; ++Offset)
+        if ((Idx >= Offset && FindConsecutiveAccess(Idx - Offset, Idx)) ||
+            (Idx + Offset < E && FindConsecutiveAccess(Idx + Offset, Idx)))
+          break;
+    }
   }
 
   // For stores that start but don't end a link in the chain:
@@ -10,13 +10,13 @@
 //
 //===----------------------------------------------------------------------===//
 #include "llvm/XRay/Trace.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/DataExtractor.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
-#include "llvm/XRay/BlockIndexer.h"
 #include "llvm/XRay/BlockVerifier.h"
-#include "llvm/XRay/FDRRecordConsumer.h"
 #include "llvm/XRay/FDRRecordProducer.h"
 #include "llvm/XRay/FDRRecords.h"
 #include "llvm/XRay/FDRTraceExpander.h"
@@ -278,66 +278,118 @@ Error loadFDRLog(StringRef Data, bool IsLittleEndian,
     return FileHeaderOrError.takeError();
   FileHeader = std::move(FileHeaderOrError.get());
 
-  // First we load the records into memory.
-  std::vector<std::unique_ptr<Record>> FDRRecords;
-
+  // To avoid materializing every record in the log at once, we load the log in
+  // two passes. The first pass streams through the records to index the blocks
+  // in the log: we find the extents of each block, verify its structure, and
+  // remember the process+thread it belongs to along with its wallclock time,
+  // discarding each record as soon as it has been seen. The second pass then
+  // re-reads the blocks of each thread in wallclock order and expands them
+  // directly into `Trace` records, so only a single record is materialized at
+  // any point in time. This trades an extra streaming pass over the
+  // (memory-mapped) log for a peak memory footprint proportional to the
+  // expanded trace instead of the raw log.
+  struct BlockDesc {
+    uint64_t StartOffset;
+    uint64_t EndOffset;
+    uint64_t WallclockSeconds;
+    uint32_t WallclockNanos;
+  };
+
+  // This maps the process + thread combination to the blocks associated with
+  // it, in the order they appear in the log.
+  DenseMap<std::pair<uint64_t, int32_t>, std::vector<BlockDesc>> Index;
+
+  // First we stream through the records to index and verify the blocks.
   {
     FileBasedRecordProducer P(FileHeader, DE, OffsetPtr);
-    LogBuilderConsumer C(FDRRecords);
+    BlockVerifier Verifier;
+    uint64_t ProcessID = 0;
+    int32_t ThreadID = 0;
+    uint64_t WallclockSeconds = 0;
+    uint32_t WallclockNanos = 0;
+    uint64_t BlockStart = OffsetPtr;
+    bool BlockEmpty = true;
+    // A BufferExtents record introducing a new block appears before the
+    // NewBuffer record; remember where it starts so that the new block's
+    // extent covers it.
+    Optional<uint64_t> PendingExtentsOffset;
+
+    auto FinalizeBlock = [&](uint64_t EndOffset) -> Error {
+      if (auto E = Verifier.verify())
+        return E;
+      Verifier.reset();
+      Index[{ProcessID, ThreadID}].push_back(
+          {BlockStart, EndOffset, WallclockSeconds, WallclockNanos});
+      ProcessID = 0;
+      ThreadID = 0;
+      WallclockSeconds = 0;
+      WallclockNanos = 0;
+      BlockEmpty = true;
+      return Error::success();
+    };
+
     while (DE.isValidOffsetForDataOfSize(OffsetPtr, 1)) {
+      auto PreReadOffset = OffsetPtr;
       auto R = P.produce();
       if (!R)
         return R.takeError();
-      if (auto E = C.consume(std::move(R.get())))
-        return E;
-    }
-  }
+      Record &Rec = *R.get();
 
-  // Next we index the records into blocks.
-  BlockIndexer::Index Index;
-  {
-    BlockIndexer Indexer(Index);
-    for (auto &R : FDRRecords)
-      if (auto E = R->apply(Indexer))
-        return E;
-    if (auto E = Indexer.flush())
-      return E;
-  }
+      // Buffer extents are not part of a block's record sequence, so we don't
+      // show them to the verifier.
+      if (isa<BufferExtents>(Rec)) {
+        PendingExtentsOffset = PreReadOffset;
+        continue;
+      }
 
-  // Then we verify the consistency of the blocks.
-  {
-    for (auto &PTB : Index) {
-      auto &Blocks = PTB.second;
-      for (auto &B : Blocks) {
-        BlockVerifier Verifier;
-        for (auto *R : B.Records)
-          if (auto E = R->apply(Verifier))
+      if (auto *NB = dyn_cast<NewBufferRecord>(&Rec)) {
+        uint64_t Boundary = PendingExtentsOffset.getValueOr(PreReadOffset);
+        if (!BlockEmpty)
+          if (auto E = FinalizeBlock(Boundary))
             return E;
-        if (auto E = Verifier.verify())
-          return E;
+        BlockStart = Boundary;
+        ThreadID = NB->tid();
+      } else if (auto *W = dyn_cast<WallclockRecord>(&Rec)) {
+        WallclockSeconds = W->seconds();
+        WallclockNanos = W->nanos();
+      } else if (auto *PR = dyn_cast<PIDRecord>(&Rec)) {
+        ProcessID = PR->pid();
       }
+      PendingExtentsOffset = None;
+      BlockEmpty = false;
+      if (auto E = Rec.apply(Verifier))
+        return E;
     }
+    if (!BlockEmpty)
+      if (auto E = FinalizeBlock(OffsetPtr))
+        return E;
   }
 
   // This is now the meat of the algorithm. Here we sort the blocks according to
   // the Walltime record in each of the blocks for the same thread. This allows
   // us to more consistently recreate the execution trace in temporal order.
-  // After the sort, we then reconstitute `Trace` records using a stateful
-  // visitor associated with a single process+thread pair.
+  // After the sort, we then reconstitute `Trace` records by re-reading each
+  // block and feeding it to a stateful visitor associated with a single
+  // process+thread pair.
   {
     for (auto &PTB : Index) {
       auto &Blocks = PTB.second;
-      llvm::sort(Blocks, [](const BlockIndexer::Block &L,
-                            const BlockIndexer::Block &R) {
-        return (L.WallclockTime->seconds() < R.WallclockTime->seconds() &&
-                L.WallclockTime->nanos() < R.WallclockTime->nanos());
+      llvm::sort(Blocks, [](const BlockDesc &L, const BlockDesc &R) {
+        return (L.WallclockSeconds < R.WallclockSeconds &&
+                L.WallclockNanos < R.WallclockNanos);
       });
       auto Adder = [&](const XRayRecord &R) { Records.push_back(R); };
       TraceExpander Expander(Adder, FileHeader.Version);
-      for (auto &B : Blocks) {
-        for (auto *R : B.Records)
-          if (auto E = R->apply(Expander))
+      for (const auto &B : Blocks) {
+        uint64_t BlockOffsetPtr = B.StartOffset;
+        FileBasedRecordProducer BlockProducer(FileHeader, DE, BlockOffsetPtr);
+        while (BlockOffsetPtr < B.EndOffset) {
+          auto R = BlockProducer.produce();
+          if (!R)
+            return R.takeError();
+          if (auto E = R.get()->apply(Expander))
             return E;
+        }
       }
       if (auto E = Expander.flush())
         return E;
@@ -0,0 +1,23 @@
+; RUN: opt < %s -passes='require<domtree>,simplifycfg' -simplifycfg-preserve-domtree \
+; RUN:   -debug-pass-manager -disable-output 2>&1 | FileCheck %s
+
+; With -simplifycfg-preserve-domtree, SimplifyCFG recomputes the dominator
+; tree itself instead of invalidating it for downstream users.
+
+; CHECK: Running analysis: DominatorTreeAnalysis
+; CHECK: Running pass: SimplifyCFGPass
+; CHECK-NOT: Invalidating analysis: DominatorTreeAnalysis
+
+define void @f(i1 %c) {
+entry:
+  br i1 %c, label %then, label %exit
+
+then:
+  br label %mid
+
+mid:
+  br label %exit
+
+exit:
+  ret void
+}
@@ -13,6 +13,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/CodeGen/CommandFlags.h"
@@ -21,6 +22,7 @@
 #include "llvm/CodeGen/MIRParser/MIRParser.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
 #include "llvm/IR/AutoUpgrade.h"
@@ -125,6 +127,14 @@ static cl::opt<bool> AsmVerbose("asm-verbose",
                                 cl::desc("Add comments to directives."),
                                 cl::init(true));
 
+static cl::opt<unsigned> SplitCodeGenParts(
+    "split-codegen",
+    cl::desc("Split the module into N partitions and run the codegen "
+             "pipeline for each partition on its own thread, writing one "
+             "output file per partition (<output>.0 ... <output>.N-1). "
+             "Implies -filetype=obj semantics for output naming."),
+    cl::value_desc("N"), cl::init(1u));
+
 static cl::opt<bool>
     CompileTwice("compile-twice", cl::Hidden,
                  cl::desc("Run everything twice, re-using the same pass "
@@ -533,6 +543,67 @@ static int compileModule(char **argv, LLVMContext &Context) {
   if (codegen::getFloatABIForCalls() != FloatABI::Default)
     Options.FloatABIType = codegen::getFloatABIForCalls();
 
+  // Parallel per-partition codegen. The post-ISel pipeline and the MC layer
+  // are not thread-safe within a single module, so we follow the LTO model:
+  // split the module into roughly balanced partitions and run a full codegen
+  // pipeline per partition on a ThreadPool, one output file per partition.
+  if (SplitCodeGenParts > 1) {
+    if (MIR || !RunPassNames->empty() || CompileTwice) {
+      WithColor::error(errs(), argv[0])
+          << "-split-codegen cannot be combined with MIR input, -run-pass or "
+             "-compile-twice.\n";
+      return 1;
+    }
+    if (codegen::getFileType() == CGFT_Null) {
+      WithColor::error(errs(), argv[0])
+          << "-split-codegen does not support -filetype=null.\n";
+      return 1;
+    }
+    if (OutputFilename.empty() || OutputFilename == "-") {
+      WithColor::error(errs(), argv[0])
+          << "-split-codegen requires an explicit output filename.\n";
+      return 1;
+    }
+
+    if (!NoVerify && verifyModule(*M, &errs())) {
+      std::string Prefix =
+          (Twine(argv[0]) + Twine(": ") + Twine(InputFilename)).str();
+      WithColor::error(errs(), Prefix) << "input module is broken!\n";
+      return 1;
+    }
+    codegen::setFunctionAttributes(CPUStr, FeaturesStr, *M);
+
+    sys::fs::OpenFlags OpenFlags = codegen::getFileType() == CGFT_AssemblyFile
+                                       ? sys::fs::OF_Text
+                                       : sys::fs::OF_None;
+    SmallVector<std::unique_ptr<ToolOutputFile>, 8> PartFiles;
+    SmallVector<raw_pwrite_stream *, 8> PartStreams;
+    for (unsigned I = 0; I != SplitCodeGenParts; ++I) {
+      std::error_code EC;
+      PartFiles.push_back(std::make_unique<ToolOutputFile>(
+          OutputFilename + "." + utostr(I), EC, OpenFlags));
+      if (EC) {
+        WithColor::error(errs(), argv[0]) << EC.message() << '\n';
+        return 1;
+      }
+      PartStreams.push_back(&PartFiles.back()->os());
+    }
+
+    const std::string TT = TheTriple.getTriple();
+    splitCodeGen(
+        std::move(M), PartStreams, {},
+        [&]() {
+          return std::unique_ptr<TargetMachine>(TheTarget->createTargetMachine(
+              TT, CPUStr, FeaturesStr, Options, RM,
+              codegen::getExplicitCodeModel(), OLvl));
+        },
+        codegen::getFileType());
+
+    for (std::unique_ptr<ToolOutputFile> &PartFile : PartFiles)
+      PartFile->keep();
+    return 0;
+  }
+
   // Figure out where we are going to send the output.
   std::unique_ptr<ToolOutputFile> Out =
       GetOutputStream(TheTarget->getName(), TheTriple.getOS(), argv[0]);
@@ -75,7 +75,6 @@ static bool shouldStripUnderscore() {
 }
 
 static std::string demangle(const std::string &Mangled) {
-  int Status;
   std::string Prefix;
 
   const char *DecoratedStr = Mangled.c_str();
@@ -84,22 +83,38 @@ static std::string demangle(const std::string &Mangled) {
       ++DecoratedStr;
   size_t DecoratedLength = strlen(DecoratedStr);
 
+  // Keep the demangler and its output buffer alive across calls, so the
+  // parser arena and the result buffer get reused from one symbol to the
+  // next instead of being allocated and freed per name. This matters when
+  // filtering large symbol lists.
+  static ItaniumPartialDemangler Parser;
+  static char *OutputBuf = nullptr;
+  static size_t OutputSize = 0;
+
+  auto ItaniumDemangle = [&](const char *Str) -> char * {
+    if (Parser.partialDemangle(Str))
+      return nullptr;
+    if (char *Demangled = Parser.finishDemangle(OutputBuf, &OutputSize)) {
+      OutputBuf = Demangled;
+      return Demangled;
+    }
+    return nullptr;
+  };
+
   char *Undecorated = nullptr;
 
   if (Types ||
       ((DecoratedLength >= 2 && strncmp(DecoratedStr, "_Z", 2) == 0) ||
        (DecoratedLength >= 4 && strncmp(DecoratedStr, "___Z", 4) == 0)))
-    Undecorated = itaniumDemangle(DecoratedStr, nullptr, nullptr, &Status);
+    Undecorated = ItaniumDemangle(DecoratedStr);
 
   if (!Undecorated &&
       (DecoratedLength > 6 && strncmp(DecoratedStr, "__imp_", 6) == 0)) {
     Prefix = "import thunk for ";
-    Undecorated = itaniumDemangle(DecoratedStr + 6, nullptr, nullptr, &Status);
+    Undecorated = ItaniumDemangle(DecoratedStr + 6);
   }
 
-  std::string Result(Undecorated ? Prefix + Undecorated : Mangled);
-  free(Undecorated);
-  return Result;
+  return Undecorated ? Prefix + Undecorated : Mangled;
 }
 
 // Split 'Source' on any character that fails to pass 'IsLegalChar'.  The
@@ -139,7 +154,8 @@ static bool IsLegalItaniumChar(char C) {
 // If 'Split' is true, then 'Mangled' is broken into individual words and each
 // word is demangled.  Otherwise, the entire string is treated as a single
 // mangled item.  The result is output to 'OS'.
-static void demangleLine(llvm::raw_ostream &OS, StringRef Mangled, bool Split) {
+static void demangleLine(llvm::raw_ostream &OS, StringRef Mangled, bool Split,
+                         bool FlushPerLine) {
   std::string Result;
   if (Split) {
     SmallVector<std::pair<StringRef, StringRef>, 16> Words;
@@ -149,7 +165,8 @@ static void demangleLine(llvm::raw_ostream &OS, StringRef Mangled, bool Split) {
   } else
     Result = ::demangle(std::string(Mangled));
   OS << Result << '\n';
-  OS.flush();
+  if (FlushPerLine)
+    OS.flush();
 }
 
 int main(int argc, char **argv) {
@@ -157,12 +174,18 @@ int main(int argc, char **argv) {
 
   cl::ParseCommandLineOptions(argc, argv, "llvm symbol undecoration tool\n");
 
+  // Terminals and pipes see each demangled line as soon as it is produced,
+  // so interactive and coprocess uses keep working. When the output is
+  // redirected to a regular file there is no concurrent reader, and letting
+  // the stream buffer avoids a write syscall per line on bulk symbol lists.
+  bool FlushPerLine = !llvm::outs().supportsSeeking();
+
   if (Decorated.empty())
     for (std::string Mangled; std::getline(std::cin, Mangled);)
-      demangleLine(llvm::outs(), Mangled, true);
+      demangleLine(llvm::outs(), Mangled, true, FlushPerLine);
   else
     for (const auto &Symbol : Decorated)
-      demangleLine(llvm::outs(), Symbol, false);
+      demangleLine(llvm::outs(), Symbol, false, FlushPerLine);
 
   return EXIT_SUCCESS;
 }
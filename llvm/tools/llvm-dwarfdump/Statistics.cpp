@@ -8,6 +8,7 @@
 
 #include "llvm-dwarfdump.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/DebugInfo/DIContext.h"
@@ -15,6 +16,7 @@
 #include "llvm/DebugInfo/DWARF/DWARFDebugLoc.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/Parallel.h"
 
 #define DEBUG_TYPE "dwarfdump"
 using namespace llvm;
@@ -142,6 +144,14 @@ struct LocationStats {
   /// Total number of local variables processed.
   unsigned NumVar = 0;
 };
+
+/// Statistics for one compile unit. The units are processed independently
+/// (possibly in parallel) and the per-unit results are merged afterwards.
+struct UnitStats {
+  StringMap<PerFunctionStats> FnStatMap;
+  GlobalStats GlobalStats;
+  LocationStats LocStats;
+};
 } // namespace
 
 /// Collect debug location statistics for one DIE.
@@ -491,6 +501,67 @@ static void collectStatsRecursive(DWARFDie Die, std::string FnPrefix,
   }
 }
 
+/// Accumulate the per-unit statistics into the totals. The merged result is
+/// identical to what a serial walk over all units would have produced.
+/// \{
+static void mergePerFunctionStats(PerFunctionStats &Total,
+                                  const PerFunctionStats &Unit) {
+  Total.NumFnInlined += Unit.NumFnInlined;
+  Total.NumFnOutOfLine += Unit.NumFnOutOfLine;
+  Total.NumAbstractOrigins += Unit.NumAbstractOrigins;
+  Total.TotalVarWithLoc += Unit.TotalVarWithLoc;
+  Total.ConstantMembers += Unit.ConstantMembers;
+  Total.NumArtificial += Unit.NumArtificial;
+  for (const auto &V : Unit.VarsInFunction)
+    Total.VarsInFunction.insert(V.getKey());
+  Total.IsFunction |= Unit.IsFunction;
+  Total.HasSourceLocation |= Unit.HasSourceLocation;
+  Total.NumParams += Unit.NumParams;
+  Total.NumParamSourceLocations += Unit.NumParamSourceLocations;
+  Total.NumParamTypes += Unit.NumParamTypes;
+  Total.NumParamLocations += Unit.NumParamLocations;
+  Total.NumLocalVars += Unit.NumLocalVars;
+  Total.NumLocalVarSourceLocations += Unit.NumLocalVarSourceLocations;
+  Total.NumLocalVarTypes += Unit.NumLocalVarTypes;
+  Total.NumLocalVarLocations += Unit.NumLocalVarLocations;
+}
+
+static void mergeGlobalStats(GlobalStats &Total, const GlobalStats &Unit) {
+  Total.TotalBytesCovered += Unit.TotalBytesCovered;
+  Total.ScopeBytesCovered += Unit.ScopeBytesCovered;
+  Total.ScopeBytes += Unit.ScopeBytes;
+  Total.ScopeEntryValueBytesCovered += Unit.ScopeEntryValueBytesCovered;
+  Total.ParamScopeBytesCovered += Unit.ParamScopeBytesCovered;
+  Total.ParamScopeBytes += Unit.ParamScopeBytes;
+  Total.ParamScopeEntryValueBytesCovered +=
+      Unit.ParamScopeEntryValueBytesCovered;
+  Total.LocalVarScopeBytesCovered += Unit.LocalVarScopeBytesCovered;
+  Total.LocalVarScopeBytes += Unit.LocalVarScopeBytes;
+  Total.LocalVarScopeEntryValueBytesCovered +=
+      Unit.LocalVarScopeEntryValueBytesCovered;
+  Total.CallSiteEntries += Unit.CallSiteEntries;
+  Total.CallSiteDIEs += Unit.CallSiteDIEs;
+  Total.CallSiteParamDIEs += Unit.CallSiteParamDIEs;
+  Total.FunctionSize += Unit.FunctionSize;
+  Total.InlineFunctionSize += Unit.InlineFunctionSize;
+}
+
+static void mergeLocationStats(LocationStats &Total,
+                               const LocationStats &Unit) {
+  for (int I = 0; I < NumOfCoverageCategories; ++I) {
+    Total.VarParamLocStats[I] += Unit.VarParamLocStats[I];
+    Total.VarParamNonEntryValLocStats[I] += Unit.VarParamNonEntryValLocStats[I];
+    Total.ParamLocStats[I] += Unit.ParamLocStats[I];
+    Total.ParamNonEntryValLocStats[I] += Unit.ParamNonEntryValLocStats[I];
+    Total.LocalVarLocStats[I] += Unit.LocalVarLocStats[I];
+    Total.LocalVarNonEntryValLocStats[I] += Unit.LocalVarNonEntryValLocStats[I];
+  }
+  Total.NumVarParam += Unit.NumVarParam;
+  Total.NumParam += Unit.NumParam;
+  Total.NumVar += Unit.NumVar;
+}
+/// \}
+
 /// Print human-readable output.
 /// \{
 static void printDatum(json::OStream &J, const char *Key, json::Value Value) {
@@ -558,10 +629,46 @@ bool dwarfdump::collectStatsForObjectFile(ObjectFile &Obj, DWARFContext &DICtx,
   GlobalStats GlobalStats;
   LocationStats LocStats;
   StringMap<PerFunctionStats> Statistics;
+
+  // Materialize all lazily-parsed state up front, while we are still running
+  // on one thread: extracting a unit's DIEs populates shared caches in the
+  // context (abbreviation sets, .dwo files), and the DIE walk below needs the
+  // line tables for the DIE identifiers it constructs. Afterwards the units
+  // can be visited concurrently without touching shared mutable state.
+  SmallVector<DWARFDie, 16> CUDies;
   for (const auto &CU : static_cast<DWARFContext *>(&DICtx)->compile_units())
-    if (DWARFDie CUDie = CU->getNonSkeletonUnitDIE(false))
+    if (DWARFDie CUDie = CU->getNonSkeletonUnitDIE(false)) {
+      DWARFUnit *U = CUDie.getDwarfUnit();
+      U->getContext().getLineTableForUnit(U);
+      CUDies.push_back(CUDie);
+    }
+  // Cross-unit references (DW_FORM_ref_addr) may resolve to units that are
+  // not compile units; extract their DIEs as well.
+  for (const auto &U : DICtx.normal_units())
+    U->getUnitDIE(false);
+
+  if (CUDies.size() > 1) {
+    // Collect statistics for each unit into its own accumulator in parallel,
+    // then merge. The merge is commutative, so the result does not depend on
+    // the order in which units finish.
+    std::vector<UnitStats> UnitStatistics(CUDies.size());
+    parallelForEachN(0, CUDies.size(), [&](size_t I) {
+      collectStatsRecursive(CUDies[I], "/", "g", 0, 0,
+                            UnitStatistics[I].FnStatMap,
+                            UnitStatistics[I].GlobalStats,
+                            UnitStatistics[I].LocStats);
+    });
+    for (const UnitStats &US : UnitStatistics) {
+      for (const auto &Entry : US.FnStatMap)
+        mergePerFunctionStats(Statistics[Entry.getKey()], Entry.getValue());
+      mergeGlobalStats(GlobalStats, US.GlobalStats);
+      mergeLocationStats(LocStats, US.LocStats);
+    }
+  } else {
+    for (DWARFDie CUDie : CUDies)
       collectStatsRecursive(CUDie, "/", "g", 0, 0, Statistics, GlobalStats,
                             LocStats);
+  }
 
   /// Collect the sizes of debug sections.
   SectionSizes Sizes;
@@ -0,0 +1,400 @@
+//===-- llvm-dwarfnames.cpp - Build .debug_names for existing binaries ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// A utility that builds a DWARF v5 .debug_names accelerator table for a
+// binary whose producer did not emit one. The output is the raw contents of
+// the section; attach it to the binary with:
+//
+//   llvm-objcopy --add-section .debug_names=<out> <binary>
+//
+// The emitted table matches what the in-tree AsmPrinter writer
+// (Dwarf5AccelTableWriter) produces: "LLVM0700" augmentation, case-folding
+// DJB hashes, and entries carrying DW_IDX_compile_unit (when there is more
+// than one unit) and a CU-relative DW_IDX_die_offset.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/BinaryFormat/Dwarf.h"
+#include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/DebugInfo/DWARF/DWARFDie.h"
+#include "llvm/DebugInfo/DWARF/DWARFFormValue.h"
+#include "llvm/DebugInfo/DWARF/DWARFUnit.h"
+#include "llvm/Object/ObjectFile.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/DJB.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+#include <vector>
+
+using namespace llvm;
+using namespace llvm::object;
+
+cl::OptionCategory DwarfNamesCategory("Specific Options");
+
+static cl::opt<std::string> InputFilename(cl::Positional,
+                                          cl::desc("<input object file>"),
+                                          cl::Required,
+                                          cl::cat(DwarfNamesCategory));
+
+static cl::opt<std::string>
+    OutputFilename("o", cl::Required,
+                   cl::desc("Write the raw section contents to <file>"),
+                   cl::value_desc("file"), cl::cat(DwarfNamesCategory));
+
+static cl::opt<unsigned>
+    NumThreads("num-threads",
+               cl::desc("Number of worker threads. Defaults to all cores."),
+               cl::init(0), cl::cat(DwarfNamesCategory));
+
+static void error(StringRef Prefix, Error E) {
+  if (!E)
+    return;
+  WithColor::error() << Prefix << ": " << toString(std::move(E)) << '\n';
+  exit(1);
+}
+
+static void error(StringRef Prefix, std::error_code EC) {
+  error(Prefix, errorCodeToError(EC));
+}
+
+namespace {
+
+/// One prospective accelerator table entry, collected per unit. \p DieOffset
+/// is relative to the start of the unit, matching DW_FORM_ref4 in the
+/// emitted entry pool.
+struct NameEntry {
+  uint32_t StrOffset;
+  StringRef Name;
+  uint32_t Hash;
+  uint32_t DieOffset;
+  dwarf::Tag Tag;
+};
+
+/// All entries sharing one .debug_str string, plus where its entry pool
+/// contribution starts.
+struct UniquedName {
+  StringRef Name;
+  uint32_t StrOffset;
+  uint32_t Hash;
+  std::vector<std::pair<uint32_t, NameEntry>> Entries; // (CU index, entry)
+  uint32_t EntryPoolOffset = 0;
+};
+
+} // anonymous namespace
+
+/// Tags the DWARF v5 specification asks an index to cover (section 6.1.1.1).
+static bool isIndexedTag(dwarf::Tag T) {
+  switch (T) {
+  case dwarf::DW_TAG_subprogram:
+  case dwarf::DW_TAG_inlined_subroutine:
+  case dwarf::DW_TAG_label:
+  case dwarf::DW_TAG_variable:
+  case dwarf::DW_TAG_namespace:
+  case dwarf::DW_TAG_base_type:
+  case dwarf::DW_TAG_class_type:
+  case dwarf::DW_TAG_enumeration_type:
+  case dwarf::DW_TAG_structure_type:
+  case dwarf::DW_TAG_typedef:
+  case dwarf::DW_TAG_union_type:
+  case dwarf::DW_TAG_unspecified_type:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/// Returns true if \p Die describes something a consumer would look up by
+/// name: a defined subprogram or label, a variable with a location, or a
+/// type/namespace that is not a mere declaration.
+static bool shouldIndexDie(const DWARFDie &Die) {
+  switch (Die.getTag()) {
+  case dwarf::DW_TAG_subprogram:
+  case dwarf::DW_TAG_label:
+    return Die.find(dwarf::DW_AT_low_pc).hasValue() ||
+           Die.find(dwarf::DW_AT_ranges).hasValue();
+  case dwarf::DW_TAG_variable:
+    return Die.find(dwarf::DW_AT_location).hasValue();
+  case dwarf::DW_TAG_inlined_subroutine:
+    return true;
+  default:
+    return !Die.find(dwarf::DW_AT_declaration).hasValue();
+  }
+}
+
+/// Resolves a name attribute to its .debug_str offset and contents. Names
+/// stored inline (DW_FORM_string) have no string table offset a v5 index can
+/// reference, so they are skipped.
+static Optional<std::pair<uint32_t, StringRef>>
+getIndexedName(const DWARFFormValue &FV) {
+  Optional<const char *> Str = FV.getAsCString();
+  if (!Str)
+    return None;
+  switch (FV.getForm()) {
+  case dwarf::DW_FORM_strp:
+    return std::make_pair(static_cast<uint32_t>(FV.getRawUValue()),
+                          StringRef(*Str));
+  case dwarf::DW_FORM_strx:
+  case dwarf::DW_FORM_strx1:
+  case dwarf::DW_FORM_strx2:
+  case dwarf::DW_FORM_strx3:
+  case dwarf::DW_FORM_strx4:
+  case dwarf::DW_FORM_GNU_str_index:
+    if (const DWARFUnit *U = FV.getUnit())
+      if (Optional<uint64_t> Off = U->getStringOffsetSectionItem(
+              static_cast<uint32_t>(FV.getRawUValue())))
+        return std::make_pair(static_cast<uint32_t>(*Off), StringRef(*Str));
+    return None;
+  default:
+    return None;
+  }
+}
+
+static void collectUnitNames(DWARFUnit &U, std::vector<NameEntry> &Out) {
+  uint64_t UnitOffset = U.getOffset();
+  for (unsigned I = 0, N = U.getNumDIEs(); I != N; ++I) {
+    DWARFDie Die = U.getDIEAtIndex(I);
+    if (!isIndexedTag(Die.getTag()) || !shouldIndexDie(Die))
+      continue;
+    uint32_t DieOffset = static_cast<uint32_t>(Die.getOffset() - UnitOffset);
+    // Index both the source name and the linkage name, following
+    // DW_AT_specification/DW_AT_abstract_origin chains so that out-of-line
+    // definitions and inlined instances pick up the names of the entities
+    // they refer to.
+    for (ArrayRef<dwarf::Attribute> Attrs :
+         {ArrayRef<dwarf::Attribute>(dwarf::DW_AT_name),
+          ArrayRef<dwarf::Attribute>({dwarf::DW_AT_linkage_name,
+                                      dwarf::DW_AT_MIPS_linkage_name})}) {
+      Optional<DWARFFormValue> FV = Die.findRecursively(Attrs);
+      if (!FV)
+        continue;
+      if (auto Name = getIndexedName(*FV))
+        Out.push_back({Name->first, Name->second,
+                       caseFoldingDjbHash(Name->second), DieOffset,
+                       Die.getTag()});
+    }
+  }
+}
+
+/// Mirrors the bucket count selection in AccelTable.cpp so that post-hoc and
+/// compiler-emitted tables hash identically.
+static uint32_t computeBucketCount(uint32_t UniqueHashCount) {
+  if (UniqueHashCount > 1024)
+    return UniqueHashCount / 4;
+  if (UniqueHashCount > 16)
+    return UniqueHashCount / 2;
+  return std::max<uint32_t>(UniqueHashCount, 1);
+}
+
+/// Picks the smallest data form that can hold a compile unit index, the same
+/// way DIEInteger::BestForm does for the in-tree writer.
+static dwarf::Form getCUIndexForm(uint32_t MaxIndex) {
+  if (MaxIndex <= 0xff)
+    return dwarf::DW_FORM_data1;
+  if (MaxIndex <= 0xffff)
+    return dwarf::DW_FORM_data2;
+  return dwarf::DW_FORM_data4;
+}
+
+static void writeCUIndex(support::endian::Writer &W, dwarf::Form Form,
+                         uint32_t Index) {
+  switch (Form) {
+  case dwarf::DW_FORM_data1:
+    W.write<uint8_t>(Index);
+    break;
+  case dwarf::DW_FORM_data2:
+    W.write<uint16_t>(Index);
+    break;
+  default:
+    W.write<uint32_t>(Index);
+    break;
+  }
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+
+  cl::HideUnrelatedOptions({&DwarfNamesCategory});
+  cl::ParseCommandLineOptions(
+      argc, argv,
+      "generate a DWARF v5 .debug_names section for an existing binary\n");
+  if (NumThreads)
+    parallel::strategy = hardware_concurrency(NumThreads);
+
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BuffOrErr =
+      MemoryBuffer::getFileOrSTDIN(InputFilename);
+  error(InputFilename, BuffOrErr.getError());
+  Expected<std::unique_ptr<Binary>> BinOrErr =
+      object::createBinary(**BuffOrErr);
+  error(InputFilename, BinOrErr.takeError());
+  auto *Obj = dyn_cast<ObjectFile>(BinOrErr->get());
+  if (!Obj)
+    error(InputFilename,
+          createStringError(std::errc::invalid_argument, "not an object file"));
+  std::unique_ptr<DWARFContext> DICtx = DWARFContext::create(*Obj);
+
+  // Force each unit's DIEs (and with them the abbreviation tables and string
+  // offset contributions) to be parsed up front; the lazy parsers in
+  // DWARFContext are not thread safe, but once everything is materialized the
+  // per-unit scan below only reads.
+  std::vector<DWARFUnit *> Units;
+  for (const std::unique_ptr<DWARFUnit> &U : DICtx->compile_units()) {
+    if (U->getFormParams().Format == dwarf::DWARF64)
+      error(InputFilename,
+            createStringError(std::errc::not_supported,
+                              "DWARF64 units are not supported"));
+    U->getUnitDIE(/*ExtractUnitDIEOnly=*/false);
+    Units.push_back(U.get());
+  }
+  if (Units.empty())
+    error(InputFilename, createStringError(std::errc::invalid_argument,
+                                           "no DWARF compile units found"));
+
+  std::vector<std::vector<NameEntry>> UnitEntries(Units.size());
+  parallelForEachN(0, Units.size(), [&](size_t I) {
+    collectUnitNames(*Units[I], UnitEntries[I]);
+  });
+
+  // Merge per-unit results, uniquing by string table offset. Iterating units
+  // in index order keeps the output deterministic regardless of scheduling.
+  MapVector<uint32_t, UniquedName> Names;
+  for (size_t I = 0, N = Units.size(); I != N; ++I) {
+    for (const NameEntry &E : UnitEntries[I]) {
+      UniquedName &U = Names[E.StrOffset];
+      if (U.Entries.empty()) {
+        U.Name = E.Name;
+        U.StrOffset = E.StrOffset;
+        U.Hash = E.Hash;
+      }
+      U.Entries.emplace_back(static_cast<uint32_t>(I), E);
+    }
+  }
+
+  uint32_t NameCount = Names.size();
+  SmallVector<uint32_t, 8> UniqueHashes;
+  for (const auto &KV : Names)
+    UniqueHashes.push_back(KV.second.Hash);
+  llvm::sort(UniqueHashes);
+  UniqueHashes.erase(std::unique(UniqueHashes.begin(), UniqueHashes.end()),
+                     UniqueHashes.end());
+  uint32_t BucketCount = computeBucketCount(UniqueHashes.size());
+
+  // Order names by bucket; ties are broken by hash and then string offset so
+  // that identical hashes stay adjacent as the format requires.
+  std::vector<UniquedName *> Ordered;
+  Ordered.reserve(NameCount);
+  for (auto &KV : Names)
+    Ordered.push_back(&KV.second);
+  llvm::stable_sort(Ordered, [&](const UniquedName *A, const UniquedName *B) {
+    if (A->Hash % BucketCount != B->Hash % BucketCount)
+      return A->Hash % BucketCount < B->Hash % BucketCount;
+    return A->Hash < B->Hash;
+  });
+
+  bool MultiCU = Units.size() > 1;
+  dwarf::Form CUForm = getCUIndexForm(Units.size() - 1);
+  support::endianness Endian =
+      DICtx->isLittleEndian() ? support::little : support::big;
+
+  // The entry pool and the abbreviation table are built into side buffers
+  // first; the header needs their sizes and each name needs its pool offset.
+  SmallVector<dwarf::Tag, 8> Tags;
+  SmallString<0> PoolStorage;
+  {
+    raw_svector_ostream PoolOS(PoolStorage);
+    support::endian::Writer PoolW(PoolOS, Endian);
+    for (UniquedName *N : Ordered) {
+      N->EntryPoolOffset = PoolStorage.size();
+      for (const auto &CUAndEntry : N->Entries) {
+        dwarf::Tag Tag = CUAndEntry.second.Tag;
+        if (!llvm::is_contained(Tags, Tag))
+          Tags.push_back(Tag);
+        encodeULEB128(Tag, PoolOS);
+        if (MultiCU)
+          writeCUIndex(PoolW, CUForm, CUAndEntry.first);
+        PoolW.write<uint32_t>(CUAndEntry.second.DieOffset);
+      }
+      PoolW.write<uint8_t>(0); // Terminate the list of entries for this name.
+    }
+  }
+  llvm::sort(Tags);
+
+  SmallString<0> AbbrevStorage;
+  {
+    raw_svector_ostream AbbrevOS(AbbrevStorage);
+    // As in the AsmPrinter writer, the abbreviation code is the DIE tag.
+    for (dwarf::Tag Tag : Tags) {
+      encodeULEB128(Tag, AbbrevOS);
+      encodeULEB128(Tag, AbbrevOS);
+      if (MultiCU) {
+        encodeULEB128(dwarf::DW_IDX_compile_unit, AbbrevOS);
+        encodeULEB128(CUForm, AbbrevOS);
+      }
+      encodeULEB128(dwarf::DW_IDX_die_offset, AbbrevOS);
+      encodeULEB128(dwarf::DW_FORM_ref4, AbbrevOS);
+      encodeULEB128(0, AbbrevOS);
+      encodeULEB128(0, AbbrevOS);
+    }
+    encodeULEB128(0, AbbrevOS);
+  }
+
+  std::error_code EC;
+  ToolOutputFile Out(OutputFilename, EC, sys::fs::OF_None);
+  error(OutputFilename, EC);
+  support::endian::Writer W(Out.os(), Endian);
+
+  StringRef Augmentation = "LLVM0700";
+  uint64_t UnitLength = 2 + 2 + 7 * 4 + Augmentation.size() +
+                        4 * Units.size() + 4 * BucketCount + 3 * 4 * NameCount +
+                        AbbrevStorage.size() + PoolStorage.size();
+  W.write<uint32_t>(UnitLength);
+  W.write<uint16_t>(5); // Version.
+  W.write<uint16_t>(0); // Padding.
+  W.write<uint32_t>(Units.size());
+  W.write<uint32_t>(0); // Local type unit count.
+  W.write<uint32_t>(0); // Foreign type unit count.
+  W.write<uint32_t>(BucketCount);
+  W.write<uint32_t>(NameCount);
+  W.write<uint32_t>(AbbrevStorage.size());
+  W.write<uint32_t>(Augmentation.size());
+  Out.os() << Augmentation;
+
+  for (const DWARFUnit *U : Units)
+    W.write<uint32_t>(static_cast<uint32_t>(U->getOffset()));
+
+  // Buckets hold the 1-based index of their first name, or 0 when empty.
+  std::vector<uint32_t> Buckets(BucketCount, 0);
+  for (uint32_t I = 0; I != NameCount; ++I) {
+    uint32_t Bucket = Ordered[I]->Hash % BucketCount;
+    if (!Buckets[Bucket])
+      Buckets[Bucket] = I + 1;
+  }
+  for (uint32_t B : Buckets)
+    W.write<uint32_t>(B);
+  for (const UniquedName *N : Ordered)
+    W.write<uint32_t>(N->Hash);
+  for (const UniquedName *N : Ordered)
+    W.write<uint32_t>(N->StrOffset);
+  for (const UniquedName *N : Ordered)
+    W.write<uint32_t>(N->EntryPoolOffset);
+  Out.os() << AbbrevStorage << PoolStorage;
+
+  Out.keep();
+  return 0;
+}
@@ -32,11 +32,13 @@
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/DataExtractor.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
@@ -88,13 +90,24 @@ static void writeStringsAndOffsets(MCStreamer &Out, DWPStringPool &Strings,
 
   Out.SwitchSection(StrOffsetSection);
 
+  // Batch the remapped offsets into a local buffer and emit them with a
+  // single emitBytes call; pushing one 4-byte value at a time through the
+  // streamer costs a fragment bookkeeping round trip per entry, which
+  // dominates when packaging many inputs.
+  SmallVector<char, 0> Remapped;
+  Remapped.reserve(CurStrOffsetSection.size());
+  bool IsLittleEndian = Out.getContext().getAsmInfo()->isLittleEndian();
   uint64_t Offset = 0;
   uint64_t Size = CurStrOffsetSection.size();
   while (Offset < Size) {
     auto OldOffset = Data.getU32(&Offset);
-    auto NewOffset = OffsetRemapping[OldOffset];
-    Out.emitIntValue(NewOffset, 4);
+    uint32_t NewOffset = OffsetRemapping[OldOffset];
+    char Buf[4];
+    support::endian::write32(Buf, NewOffset,
+                             IsLittleEndian ? support::little : support::big);
+    Remapped.append(Buf, Buf + 4);
   }
+  Out.emitBytes(StringRef(Remapped.data(), Remapped.size()));
 }
 
 static uint64_t getCUAbbrev(StringRef Abbrev, uint64_t AbbrCode) {
@@ -423,17 +436,44 @@ handleCompressedSection(std::deque<SmallString<32>> &UncompressedSections,
   return Error::success();
 }
 
+// The sections of one input file, gathered and pre-parsed off the main
+// thread. The serial emission loop in write() only copies bytes, assigns
+// running offsets, and fills in the unit indexes.
+struct ParsedInput {
+  OwningBinary<object::ObjectFile> Obj;
+  std::deque<SmallString<32>> UncompressedSections;
+
+  // Sections copied into the output verbatim, in input order.
+  std::vector<std::pair<MCSection *, StringRef>> PassthroughSections;
+
+  // Per-contribution lengths recorded by handleSection. Offsets are assigned
+  // during emission, once the sizes of all preceding inputs are known.
+  UnitIndexEntry Entry = {};
+  SmallVector<unsigned, 8> ContributionIndexes;
+
+  StringRef StrSection;
+  StringRef StrOffsetSection;
+  std::vector<StringRef> TypesSections;
+  StringRef InfoSection;
+  StringRef AbbrevSection;
+  StringRef CUIndexSection;
+  StringRef TUIndexSection;
+
+  // Unit identifiers parsed ahead of time: a single entry for a .dwo file,
+  // or one entry per CU index row with contributions for a .dwp file.
+  SmallVector<CompileUnitIdentifiers, 1> IDs;
+  DWARFUnitIndex CUIndex = DWARFUnitIndex(DW_SECT_INFO);
+  DWARFUnitIndex TUIndex = DWARFUnitIndex(DW_SECT_EXT_TYPES);
+
+  Error Err = Error::success();
+};
+
 static Error handleSection(
     const StringMap<std::pair<MCSection *, DWARFSectionKind>> &KnownSections,
     const MCSection *StrSection, const MCSection *StrOffsetSection,
     const MCSection *TypesSection, const MCSection *CUIndexSection,
-    const MCSection *TUIndexSection, const SectionRef &Section, MCStreamer &Out,
-    std::deque<SmallString<32>> &UncompressedSections,
-    uint32_t (&ContributionOffsets)[8], UnitIndexEntry &CurEntry,
-    StringRef &CurStrSection, StringRef &CurStrOffsetSection,
-    std::vector<StringRef> &CurTypesSection, StringRef &InfoSection,
-    StringRef &AbbrevSection, StringRef &CurCUIndexSection,
-    StringRef &CurTUIndexSection) {
+    const MCSection *TUIndexSection, const SectionRef &Section,
+    ParsedInput &Input) {
   if (Section.isBSS())
     return Error::success();
 
@@ -450,7 +490,8 @@ static Error handleSection(
     return ContentsOrErr.takeError();
   StringRef Contents = *ContentsOrErr;
 
-  if (auto Err = handleCompressedSection(UncompressedSections, Name, Contents))
+  if (auto Err =
+          handleCompressedSection(Input.UncompressedSections, Name, Contents))
     return Err;
 
   Name = Name.substr(Name.find_first_not_of("._"));
@@ -462,17 +503,16 @@ static Error handleSection(
   if (DWARFSectionKind Kind = SectionPair->second.second) {
     auto Index = getContributionIndex(Kind);
     if (Kind != DW_SECT_EXT_TYPES) {
-      CurEntry.Contributions[Index].Offset = ContributionOffsets[Index];
-      ContributionOffsets[Index] +=
-          (CurEntry.Contributions[Index].Length = Contents.size());
+      Input.Entry.Contributions[Index].Length = Contents.size();
+      Input.ContributionIndexes.push_back(Index);
     }
 
     switch (Kind) {
     case DW_SECT_INFO:
-      InfoSection = Contents;
+      Input.InfoSection = Contents;
       break;
     case DW_SECT_ABBREV:
-      AbbrevSection = Contents;
+      Input.AbbrevSection = Contents;
       break;
     default:
       break;
@@ -481,22 +521,108 @@ static Error handleSection(
 
   MCSection *OutSection = SectionPair->second.first;
   if (OutSection == StrOffsetSection)
-    CurStrOffsetSection = Contents;
+    Input.StrOffsetSection = Contents;
   else if (OutSection == StrSection)
-    CurStrSection = Contents;
+    Input.StrSection = Contents;
   else if (OutSection == TypesSection)
-    CurTypesSection.push_back(Contents);
+    Input.TypesSections.push_back(Contents);
   else if (OutSection == CUIndexSection)
-    CurCUIndexSection = Contents;
+    Input.CUIndexSection = Contents;
   else if (OutSection == TUIndexSection)
-    CurTUIndexSection = Contents;
-  else {
-    Out.SwitchSection(OutSection);
-    Out.emitBytes(Contents);
-  }
+    Input.TUIndexSection = Contents;
+  else
+    Input.PassthroughSections.emplace_back(OutSection, Contents);
   return Error::success();
 }
 
+// Open one input file and pre-parse everything that does not depend on the
+// output state: section classification, decompression, unit indexes, and the
+// compile unit identifiers. Any failure is stored in Input.Err and reported
+// by the serial emission loop, in input order.
+static void parseInput(
+    const StringMap<std::pair<MCSection *, DWARFSectionKind>> &KnownSections,
+    const MCSection *StrSection, const MCSection *StrOffsetSection,
+    const MCSection *TypesSection, const MCSection *CUIndexSection,
+    const MCSection *TUIndexSection, StringRef Filename, ParsedInput &Input) {
+  auto ErrOrObj = object::ObjectFile::createObjectFile(Filename);
+  if (!ErrOrObj) {
+    Input.Err = ErrOrObj.takeError();
+    return;
+  }
+  Input.Obj = std::move(*ErrOrObj);
+  auto &Obj = *Input.Obj.getBinary();
+
+  for (const auto &Section : Obj.sections())
+    if (auto Err =
+            handleSection(KnownSections, StrSection, StrOffsetSection,
+                          TypesSection, CUIndexSection, TUIndexSection,
+                          Section, Input)) {
+      Input.Err = std::move(Err);
+      return;
+    }
+
+  if (Input.InfoSection.empty())
+    return;
+
+  if (Input.CUIndexSection.empty()) {
+    Expected<CompileUnitIdentifiers> EID =
+        getCUIdentifiers(Input.AbbrevSection, Input.InfoSection,
+                         Input.StrOffsetSection, Input.StrSection);
+    if (!EID) {
+      Input.Err = createFileError(Filename, EID.takeError());
+      return;
+    }
+    Input.IDs.push_back(*EID);
+    return;
+  }
+
+  DataExtractor CUIndexData(Input.CUIndexSection, Obj.isLittleEndian(), 0);
+  if (!Input.CUIndex.parse(CUIndexData)) {
+    Input.Err = make_error<DWPError>("failed to parse cu_index");
+    return;
+  }
+  if (Input.CUIndex.getVersion() != 2) {
+    Input.Err = make_error<DWPError>(
+        "unsupported cu_index version: " + utostr(Input.CUIndex.getVersion()) +
+        " (only version 2 is supported)");
+    return;
+  }
+
+  for (const DWARFUnitIndex::Entry &E : Input.CUIndex.getRows()) {
+    if (!E.getContributions())
+      continue;
+    Expected<CompileUnitIdentifiers> EID = getCUIdentifiers(
+        getSubsection(Input.AbbrevSection, E, DW_SECT_ABBREV),
+        getSubsection(Input.InfoSection, E, DW_SECT_INFO),
+        getSubsection(Input.StrOffsetSection, E, DW_SECT_STR_OFFSETS),
+        Input.StrSection);
+    if (!EID) {
+      Input.Err = createFileError(Filename, EID.takeError());
+      return;
+    }
+    Input.IDs.push_back(*EID);
+  }
+
+  if (!Input.TypesSections.empty()) {
+    if (Input.TypesSections.size() != 1) {
+      Input.Err =
+          make_error<DWPError>("multiple type unit sections in .dwp file");
+      return;
+    }
+    DataExtractor TUIndexData(Input.TUIndexSection, Obj.isLittleEndian(), 0);
+    if (!Input.TUIndex.parse(TUIndexData)) {
+      Input.Err = make_error<DWPError>("failed to parse tu_index");
+      return;
+    }
+    if (Input.TUIndex.getVersion() != 2) {
+      Input.Err = make_error<DWPError>(
+          "unsupported tu_index version: " +
+          utostr(Input.TUIndex.getVersion()) + " (only version 2 is supported)");
+      return;
+    }
+  }
+}
+
 static Error
 buildDuplicateError(const std::pair<uint64_t, UnitIndexEntry> &PrevE,
                     const CompileUnitIdentifiers &ID, StringRef DWPName) {
@@ -561,116 +687,89 @@ static Error write(MCStreamer &Out, ArrayRef<std::string> Inputs) {
 
   DWPStringPool Strings(Out, StrSection);
 
-  SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
-  Objects.reserve(Inputs.size());
-
-  std::deque<SmallString<32>> UncompressedSections;
+  // Open and pre-parse all inputs in parallel; only the MCStreamer emission,
+  // the shared string pool, and the index maps below are inherently serial.
+  std::vector<ParsedInput> Parsed(Inputs.size());
+  parallelForEachN(0, Inputs.size(), [&](size_t I) {
+    parseInput(KnownSections, StrSection, StrOffsetSection, TypesSection,
+               CUIndexSection, TUIndexSection, Inputs[I], Parsed[I]);
+  });
+
+  // Report the first failure in input order; consume the others so they do
+  // not trip the unchecked-error assertion when Parsed is destroyed.
+  Error FirstErr = Error::success();
+  for (ParsedInput &PI : Parsed) {
+    if (FirstErr)
+      consumeError(std::move(PI.Err));
+    else
+      FirstErr = std::move(PI.Err);
+  }
+  if (FirstErr)
+    return FirstErr;
+
+  for (size_t I = 0, E = Inputs.size(); I != E; ++I) {
+    const auto &Input = Inputs[I];
+    ParsedInput &PI = Parsed[I];
+
+    // Now that the sizes of all preceding inputs are known, assign the
+    // contribution offsets and copy the sections through.
+    for (unsigned Index : PI.ContributionIndexes) {
+      PI.Entry.Contributions[Index].Offset = ContributionOffsets[Index];
+      ContributionOffsets[Index] += PI.Entry.Contributions[Index].Length;
+    }
+    for (const auto &P : PI.PassthroughSections) {
+      Out.SwitchSection(P.first);
+      Out.emitBytes(P.second);
+    }
+    const UnitIndexEntry &CurEntry = PI.Entry;
 
-  for (const auto &Input : Inputs) {
-    auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
-    if (!ErrOrObj)
-      return ErrOrObj.takeError();
-
-    auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
-
-    UnitIndexEntry CurEntry = {};
-
-    StringRef CurStrSection;
-    StringRef CurStrOffsetSection;
-    std::vector<StringRef> CurTypesSection;
-    StringRef InfoSection;
-    StringRef AbbrevSection;
-    StringRef CurCUIndexSection;
-    StringRef CurTUIndexSection;
-
-    for (const auto &Section : Obj.sections())
-      if (auto Err = handleSection(
-              KnownSections, StrSection, StrOffsetSection, TypesSection,
-              CUIndexSection, TUIndexSection, Section, Out,
-              UncompressedSections, ContributionOffsets, CurEntry,
-              CurStrSection, CurStrOffsetSection, CurTypesSection, InfoSection,
-              AbbrevSection, CurCUIndexSection, CurTUIndexSection))
-        return Err;
-
-    if (InfoSection.empty())
+    if (PI.InfoSection.empty())
       continue;
 
-    writeStringsAndOffsets(Out, Strings, StrOffsetSection, CurStrSection,
-                           CurStrOffsetSection);
+    writeStringsAndOffsets(Out, Strings, StrOffsetSection, PI.StrSection,
+                           PI.StrOffsetSection);
 
-    if (CurCUIndexSection.empty()) {
-      Expected<CompileUnitIdentifiers> EID = getCUIdentifiers(
-          AbbrevSection, InfoSection, CurStrOffsetSection, CurStrSection);
-      if (!EID)
-        return createFileError(Input, EID.takeError());
-      const auto &ID = *EID;
+    if (PI.CUIndexSection.empty()) {
+      const CompileUnitIdentifiers &ID = PI.IDs.front();
       auto P = IndexEntries.insert(std::make_pair(ID.Signature, CurEntry));
       if (!P.second)
         return buildDuplicateError(*P.first, ID, "");
       P.first->second.Name = ID.Name;
       P.first->second.DWOName = ID.DWOName;
-      addAllTypes(Out, TypeIndexEntries, TypesSection, CurTypesSection,
+      addAllTypes(Out, TypeIndexEntries, TypesSection, PI.TypesSections,
                   CurEntry,
                   ContributionOffsets[getContributionIndex(DW_SECT_EXT_TYPES)]);
       continue;
     }
 
-    DWARFUnitIndex CUIndex(DW_SECT_INFO);
-    DataExtractor CUIndexData(CurCUIndexSection, Obj.isLittleEndian(), 0);
-    if (!CUIndex.parse(CUIndexData))
-      return make_error<DWPError>("failed to parse cu_index");
-    if (CUIndex.getVersion() != 2)
-      return make_error<DWPError>(
-          "unsupported cu_index version: " + utostr(CUIndex.getVersion()) +
-          " (only version 2 is supported)");
-
-    for (const DWARFUnitIndex::Entry &E : CUIndex.getRows()) {
-      auto *I = E.getContributions();
-      if (!I)
+    size_t IDIndex = 0;
+    for (const DWARFUnitIndex::Entry &E : PI.CUIndex.getRows()) {
+      auto *CI = E.getContributions();
+      if (!CI)
         continue;
       auto P = IndexEntries.insert(std::make_pair(E.getSignature(), CurEntry));
-      Expected<CompileUnitIdentifiers> EID = getCUIdentifiers(
-          getSubsection(AbbrevSection, E, DW_SECT_ABBREV),
-          getSubsection(InfoSection, E, DW_SECT_INFO),
-          getSubsection(CurStrOffsetSection, E, DW_SECT_STR_OFFSETS),
-          CurStrSection);
-      if (!EID)
-        return createFileError(Input, EID.takeError());
-      const auto &ID = *EID;
+      const CompileUnitIdentifiers &ID = PI.IDs[IDIndex++];
       if (!P.second)
         return buildDuplicateError(*P.first, ID, Input);
       auto &NewEntry = P.first->second;
       NewEntry.Name = ID.Name;
       NewEntry.DWOName = ID.DWOName;
       NewEntry.DWPName = Input;
-      for (auto Kind : CUIndex.getColumnKinds()) {
+      for (auto Kind : PI.CUIndex.getColumnKinds()) {
         if (!isSupportedSectionKind(Kind))
           continue;
         auto &C = NewEntry.Contributions[getContributionIndex(Kind)];
-        C.Offset += I->Offset;
-        C.Length = I->Length;
-        ++I;
+        C.Offset += CI->Offset;
+        C.Length = CI->Length;
+        ++CI;
       }
     }
 
-    if (!CurTypesSection.empty()) {
-      if (CurTypesSection.size() != 1)
-        return make_error<DWPError>("multiple type unit sections in .dwp file");
-      DWARFUnitIndex TUIndex(DW_SECT_EXT_TYPES);
-      DataExtractor TUIndexData(CurTUIndexSection, Obj.isLittleEndian(), 0);
-      if (!TUIndex.parse(TUIndexData))
-        return make_error<DWPError>("failed to parse tu_index");
-      if (TUIndex.getVersion() != 2)
-        return make_error<DWPError>(
-            "unsupported tu_index version: " + utostr(TUIndex.getVersion()) +
-            " (only version 2 is supported)");
-
+    if (!PI.TypesSections.empty())
       addAllTypesFromDWP(
-          Out, TypeIndexEntries, TUIndex, TypesSection, CurTypesSection.front(),
-          CurEntry,
+          Out, TypeIndexEntries, PI.TUIndex, TypesSection,
+          PI.TypesSections.front(), CurEntry,
           ContributionOffsets[getContributionIndex(DW_SECT_EXT_TYPES)]);
-    }
   }
 
   // Lie about there being no info contributions so the TU index only includes
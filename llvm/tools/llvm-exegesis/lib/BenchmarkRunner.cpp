@@ -40,9 +40,10 @@ class FunctionExecutorImpl : public BenchmarkRunner::FunctionExecutor {
 public:
   FunctionExecutorImpl(const LLVMState &State,
                        object::OwningBinary<object::ObjectFile> Obj,
-                       BenchmarkRunner::ScratchSpace *Scratch)
+                       BenchmarkRunner::ScratchSpace *Scratch,
+                       StringMap<std::unique_ptr<pfm::Counter>> *CounterCache)
       : State(State), Function(State.createTargetMachine(), std::move(Obj)),
-        Scratch(Scratch) {}
+        Scratch(Scratch), CounterCache(CounterCache) {}
 
 private:
   Expected<int64_t> runAndMeasure(const char *Counters) const override {
@@ -74,12 +75,22 @@ private:
     const ExegesisTarget &ET = State.getExegesisTarget();
     for (auto &CounterName : CounterNames) {
       CounterName = CounterName.trim();
-      auto CounterOrError = ET.createCounter(CounterName, State);
 
-      if (!CounterOrError)
-        return CounterOrError.takeError();
+      // Reusable counters are kept in a cache owned by the BenchmarkRunner so
+      // that each perf event is only opened once per run instead of once per
+      // measurement. Counters with per-run kernel state are recreated.
+      std::unique_ptr<pfm::Counter> &CachedCounter =
+          (*CounterCache)[CounterName];
+      if (!CachedCounter || !CachedCounter->isReusable()) {
+        auto CounterOrError = ET.createCounter(CounterName, State);
 
-      pfm::Counter *Counter = CounterOrError.get().get();
+        if (!CounterOrError)
+          return CounterOrError.takeError();
+
+        CachedCounter = std::move(CounterOrError.get());
+      }
+
+      pfm::Counter *Counter = CachedCounter.get();
       if (Reserved == 0) {
         Reserved = Counter->numValues();
         CounterValues.reserve(Reserved);
@@ -129,6 +140,7 @@ private:
   const LLVMState &State;
   const ExecutableFunction Function;
   BenchmarkRunner::ScratchSpace *const Scratch;
+  StringMap<std::unique_ptr<pfm::Counter>> *const CounterCache;
 };
 } // namespace
 
@@ -214,7 +226,7 @@ Expected<InstructionBenchmark> BenchmarkRunner::runConfiguration(
     }
 
     const FunctionExecutorImpl Executor(State, std::move(ObjectFile),
-                                        Scratch.get());
+                                        Scratch.get(), &CounterCache);
     auto NewMeasurements = runMeasurements(Executor);
     if (Error E = NewMeasurements.takeError()) {
       if (!E.isA<SnippetCrash>())
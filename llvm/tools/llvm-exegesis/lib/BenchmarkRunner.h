@@ -22,6 +22,7 @@
 #include "MCInstrDescView.h"
 #include "SnippetRepetitor.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/MC/MCInst.h"
 #include "llvm/Support/Error.h"
 #include <cstdlib>
@@ -31,6 +32,10 @@
 namespace llvm {
 namespace exegesis {
 
+namespace pfm {
+class Counter;
+} // namespace pfm
+
 // Common code for all benchmark modes.
 class BenchmarkRunner {
 public:
@@ -85,6 +90,10 @@ private:
                                         const FillFunction &Fill) const;
 
   const std::unique_ptr<ScratchSpace> Scratch;
+
+  // Counters opened so far, keyed by counter name. Reusable counters are
+  // shared across snippets so each perf event is only opened once per run.
+  mutable StringMap<std::unique_ptr<pfm::Counter>> CounterCache;
 };
 
 } // namespace exegesis
@@ -113,7 +113,12 @@ Counter::Counter(PerfEvent &&E) : Event(std::move(E)){
 
 Counter::~Counter() { close(FileDescriptor); }
 
-void Counter::start() { ioctl(FileDescriptor, PERF_EVENT_IOC_RESET, 0); }
+void Counter::start() {
+  // Re-enable the event in case a previous measurement disabled it; the
+  // reset alone does not undo PERF_EVENT_IOC_DISABLE.
+  ioctl(FileDescriptor, PERF_EVENT_IOC_RESET, 0);
+  ioctl(FileDescriptor, PERF_EVENT_IOC_ENABLE, 0);
+}
 
 void Counter::stop() { ioctl(FileDescriptor, PERF_EVENT_IOC_DISABLE, 0); }
 
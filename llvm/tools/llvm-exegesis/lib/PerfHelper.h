@@ -84,6 +84,12 @@ public:
   /// Stops the measurement of the event.
   void stop();
 
+  /// Returns true if the counter tolerates repeated start/stop/read cycles.
+  /// Reusable counters may be cached by the benchmark runner and shared
+  /// across snippets, saving a perf_event_open per measurement. Counters
+  /// with per-run kernel state (e.g. sampling buffers) should return false.
+  virtual bool isReusable() const { return true; }
+
   /// Returns the current value of the counter or -1 if it cannot be read.
   int64_t read() const;
 
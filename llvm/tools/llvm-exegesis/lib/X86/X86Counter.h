@@ -41,6 +41,10 @@ public:
 
   void start() override;
 
+  // The sampling buffer is consumed while reading, so a fresh counter is
+  // needed for every measurement.
+  bool isReusable() const override { return false; }
+
   llvm::Expected<llvm::SmallVector<int64_t, 4>>
   readOrError(StringRef FunctionBytes) const override;
 
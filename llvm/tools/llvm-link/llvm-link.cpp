@@ -168,7 +168,6 @@ static std::unique_ptr<Module> loadArFile(const char *Argv0,
     if (Verbose)
       errs() << "Parsing member '" << ChildName
              << "' of archive library to module.\n";
-    SMDiagnostic ParseErr;
     Expected<MemoryBufferRef> MemBuf = C.getMemoryBufferRef();
     if (Error E = MemBuf.takeError()) {
       errs() << Argv0 << ": ";
@@ -188,7 +187,14 @@ static std::unique_ptr<Module> loadArFile(const char *Argv0,
       return nullptr;
     }
 
-    std::unique_ptr<Module> M = parseIR(MemBuf.get(), ParseErr, Context);
+    // Load the member lazily like any other input module. For debug-heavy
+    // archives this avoids materializing the bodies and metadata of members
+    // whose symbols are never needed; IRMover materializes what the link
+    // actually pulls in.
+    std::unique_ptr<Module> M = loadFile(
+        Argv0,
+        MemoryBuffer::getMemBuffer(MemBuf.get(), /*RequiresNullTerminator=*/false),
+        Context);
 
     if (!M.get()) {
       errs() << Argv0 << ": ";
@@ -350,6 +356,26 @@ static bool linkFiles(const char *argv0, LLVMContext &Context, Linker &L,
   unsigned ApplicableFlags = Flags & Linker::Flags::OverrideFromSrc;
   // Similar to some flags, internalization doesn't apply to the first file.
   bool InternalizeLinkedSymbols = false;
+
+  // If a module summary index is supplied, load it once up front so
+  // linkInModule can treat local functions/variables as exported and promote
+  // if necessary; re-reading it for every input file is wasteful when linking
+  // many modules.
+  std::unique_ptr<ModuleSummaryIndex> Index;
+  if (!SummaryIndex.empty()) {
+    Index = ExitOnErr(llvm::getModuleSummaryIndexForFile(SummaryIndex));
+
+    // Conservatively mark all internal values as promoted, since this tool
+    // does not do the ThinLink that would normally determine what values to
+    // promote.
+    for (auto &I : *Index) {
+      for (auto &S : I.second.SummaryList) {
+        if (GlobalValue::isLocalLinkage(S->linkage()))
+          S->setLinkage(GlobalValue::ExternalLinkage);
+      }
+    }
+  }
+
   for (const auto &File : Files) {
     std::unique_ptr<MemoryBuffer> Buffer =
         ExitOnErr(errorOrToExpected(MemoryBuffer::getFileOrSTDIN(File)));
@@ -374,27 +400,10 @@ static bool linkFiles(const char *argv0, LLVMContext &Context, Linker &L,
       return false;
     }
 
-    // If a module summary index is supplied, load it so linkInModule can treat
-    // local functions/variables as exported and promote if necessary.
-    if (!SummaryIndex.empty()) {
-      std::unique_ptr<ModuleSummaryIndex> Index =
-          ExitOnErr(llvm::getModuleSummaryIndexForFile(SummaryIndex));
-
-      // Conservatively mark all internal values as promoted, since this tool
-      // does not do the ThinLink that would normally determine what values to
-      // promote.
-      for (auto &I : *Index) {
-        for (auto &S : I.second.SummaryList) {
-          if (GlobalValue::isLocalLinkage(S->linkage()))
-            S->setLinkage(GlobalValue::ExternalLinkage);
-        }
-      }
-
-      // Promotion
-      if (renameModuleForThinLTO(*M, *Index,
-                                 /*ClearDSOLocalOnDeclarations=*/false))
-        return true;
-    }
+    // Promotion
+    if (Index && renameModuleForThinLTO(*M, *Index,
+                                        /*ClearDSOLocalOnDeclarations=*/false))
+      return true;
 
     if (Verbose)
       errs() << "Linking in '" << File << "'\n";
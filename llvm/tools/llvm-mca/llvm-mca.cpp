@@ -67,9 +67,10 @@ static mc::RegisterMCTargetOptionsFlags MOF;
 static cl::OptionCategory ToolOptions("Tool Options");
 static cl::OptionCategory ViewOptions("View Options");
 
-static cl::opt<std::string> InputFilename(cl::Positional,
-                                          cl::desc("<input file>"),
-                                          cl::cat(ToolOptions), cl::init("-"));
+static cl::list<std::string> InputFilenames(cl::Positional,
+                                            cl::desc("<input files>"),
+                                            cl::cat(ToolOptions),
+                                            cl::ZeroOrMore);
 
 static cl::opt<std::string> OutputFilename("o", cl::desc("Output filename"),
                                            cl::init("-"), cl::cat(ToolOptions),
@@ -315,12 +316,9 @@ int main(int argc, char **argv) {
   // For safety, reconstruct the Triple object.
   Triple TheTriple(TripleName);
 
-  ErrorOr<std::unique_ptr<MemoryBuffer>> BufferPtr =
-      MemoryBuffer::getFileOrSTDIN(InputFilename);
-  if (std::error_code EC = BufferPtr.getError()) {
-    WithColor::error() << InputFilename << ": " << EC.message() << '\n';
-    return 1;
-  }
+  // Default to reading from stdin when no inputs were given.
+  if (InputFilenames.empty())
+    InputFilenames.push_back("-");
 
   // Apply overrides to llvm-mca specific options.
   processViewOptions();
@@ -361,16 +359,6 @@ int main(int argc, char **argv) {
       TheTarget->createMCAsmInfo(*MRI, TripleName, MCOptions));
   assert(MAI && "Unable to create target asm info!");
 
-  MCObjectFileInfo MOFI;
-  SourceMgr SrcMgr;
-
-  // Tell SrcMgr about this buffer, which is what the parser will pick up.
-  SrcMgr.AddNewSourceBuffer(std::move(*BufferPtr), SMLoc());
-
-  MCContext Ctx(MAI.get(), MRI.get(), &MOFI, &SrcMgr);
-
-  MOFI.InitMCObjectFileInfo(TheTriple, /* PIC= */ false, Ctx);
-
   std::unique_ptr<buffer_ostream> BOS;
 
   std::unique_ptr<MCInstrInfo> MCII(TheTarget->createMCInstrInfo());
@@ -379,30 +367,6 @@ int main(int argc, char **argv) {
   std::unique_ptr<MCInstrAnalysis> MCIA(
       TheTarget->createMCInstrAnalysis(MCII.get()));
 
-  // Parse the input and create CodeRegions that llvm-mca can analyze.
-  mca::AsmCodeRegionGenerator CRG(*TheTarget, SrcMgr, Ctx, *MAI, *STI, *MCII);
-  Expected<const mca::CodeRegions &> RegionsOrErr = CRG.parseCodeRegions();
-  if (!RegionsOrErr) {
-    if (auto Err =
-            handleErrors(RegionsOrErr.takeError(), [](const StringError &E) {
-              WithColor::error() << E.getMessage() << '\n';
-            })) {
-      // Default case.
-      WithColor::error() << toString(std::move(Err)) << '\n';
-    }
-    return 1;
-  }
-  const mca::CodeRegions &Regions = *RegionsOrErr;
-
-  // Early exit if errors were found by the code region parsing logic.
-  if (!Regions.isValid())
-    return 1;
-
-  if (Regions.empty()) {
-    WithColor::error() << "no assembly instructions found.\n";
-    return 1;
-  }
-
   // Now initialize the output file.
   auto OF = getOutputStream();
   if (std::error_code EC = OF.getError()) {
@@ -410,22 +374,6 @@ int main(int argc, char **argv) {
     return 1;
   }
 
-  unsigned AssemblerDialect = CRG.getAssemblerDialect();
-  if (OutputAsmVariant >= 0)
-    AssemblerDialect = static_cast<unsigned>(OutputAsmVariant);
-  std::unique_ptr<MCInstPrinter> IP(TheTarget->createMCInstPrinter(
-      Triple(TripleName), AssemblerDialect, *MAI, *MCII, *MRI));
-  if (!IP) {
-    WithColor::error()
-        << "unable to create instruction printer for target triple '"
-        << TheTriple.normalize() << "' with assembly variant "
-        << AssemblerDialect << ".\n";
-    return 1;
-  }
-
-  // Set the display preference for hex vs. decimal immediates.
-  IP->setPrintImmHex(PrintImmHex);
-
   std::unique_ptr<ToolOutputFile> TOF = std::move(*OF);
 
   const MCSchedModel &SM = STI->getSchedModel();
@@ -440,133 +388,207 @@ int main(int argc, char **argv) {
                           RegisterFileSize, LoadQueueSize, StoreQueueSize,
                           AssumeNoAlias, EnableBottleneckAnalysis);
 
-  // Number each region in the sequence.
-  unsigned RegionIdx = 0;
-
-  std::unique_ptr<MCCodeEmitter> MCE(
-      TheTarget->createMCCodeEmitter(*MCII, *MRI, Ctx));
-  assert(MCE && "Unable to create code emitter!");
-
   std::unique_ptr<MCAsmBackend> MAB(TheTarget->createMCAsmBackend(
       *STI, *MRI, mc::InitMCTargetOptionsFromFlags()));
   assert(MAB && "Unable to create asm backend!");
 
-  for (const std::unique_ptr<mca::CodeRegion> &Region : Regions) {
-    // Skip empty code regions.
-    if (Region->empty())
-      continue;
-
-    // Don't print the header of this region if it is the default region, and
-    // it doesn't have an end location.
-    if (Region->startLoc().isValid() || Region->endLoc().isValid()) {
-      TOF->os() << "\n[" << RegionIdx++ << "] Code Region";
-      StringRef Desc = Region->getDescription();
-      if (!Desc.empty())
-        TOF->os() << " - " << Desc;
-      TOF->os() << "\n\n";
+  // All target and subtarget state above is shared across the input files;
+  // only the parsing and analysis state below is per file. Batching many
+  // inputs into one invocation amortizes the expensive setup, which matters
+  // when a driver script runs thousands of small analyses.
+  auto AnalyzeInput = [&](StringRef InputFilename) -> int {
+
+    ErrorOr<std::unique_ptr<MemoryBuffer>> BufferPtr =
+        MemoryBuffer::getFileOrSTDIN(InputFilename);
+    if (std::error_code EC = BufferPtr.getError()) {
+      WithColor::error() << InputFilename << ": " << EC.message() << '\n';
+      return 1;
     }
 
-    // Lower the MCInst sequence into an mca::Instruction sequence.
-    ArrayRef<MCInst> Insts = Region->getInstructions();
-    mca::CodeEmitter CE(*STI, *MAB, *MCE, Insts);
-    std::vector<std::unique_ptr<mca::Instruction>> LoweredSequence;
-    for (const MCInst &MCI : Insts) {
-      Expected<std::unique_ptr<mca::Instruction>> Inst =
-          IB.createInstruction(MCI);
-      if (!Inst) {
-        if (auto NewE = handleErrors(
-                Inst.takeError(),
-                [&IP, &STI](const mca::InstructionError<MCInst> &IE) {
-                  std::string InstructionStr;
-                  raw_string_ostream SS(InstructionStr);
-                  WithColor::error() << IE.Message << '\n';
-                  IP->printInst(&IE.Inst, 0, "", *STI, SS);
-                  SS.flush();
-                  WithColor::note()
-                      << "instruction: " << InstructionStr << '\n';
-                })) {
-          // Default case.
-          WithColor::error() << toString(std::move(NewE));
-        }
-        return 1;
+    MCObjectFileInfo MOFI;
+    SourceMgr SrcMgr;
+
+    // Tell SrcMgr about this buffer, which is what the parser will pick up.
+    SrcMgr.AddNewSourceBuffer(std::move(*BufferPtr), SMLoc());
+
+    MCContext Ctx(MAI.get(), MRI.get(), &MOFI, &SrcMgr);
+
+    MOFI.InitMCObjectFileInfo(TheTriple, /* PIC= */ false, Ctx);
+
+    // Parse the input and create CodeRegions that llvm-mca can analyze.
+    mca::AsmCodeRegionGenerator CRG(*TheTarget, SrcMgr, Ctx, *MAI, *STI, *MCII);
+    Expected<const mca::CodeRegions &> RegionsOrErr = CRG.parseCodeRegions();
+    if (!RegionsOrErr) {
+      if (auto Err =
+              handleErrors(RegionsOrErr.takeError(), [](const StringError &E) {
+                WithColor::error() << E.getMessage() << '\n';
+              })) {
+        // Default case.
+        WithColor::error() << toString(std::move(Err)) << '\n';
       }
+      return 1;
+    }
+    const mca::CodeRegions &Regions = *RegionsOrErr;
+
+    // Early exit if errors were found by the code region parsing logic.
+    if (!Regions.isValid())
+      return 1;
 
-      LoweredSequence.emplace_back(std::move(Inst.get()));
+    if (Regions.empty()) {
+      WithColor::error() << "no assembly instructions found.\n";
+      return 1;
     }
 
-    mca::SourceMgr S(LoweredSequence, PrintInstructionTables ? 1 : Iterations);
+    unsigned AssemblerDialect = CRG.getAssemblerDialect();
+    if (OutputAsmVariant >= 0)
+      AssemblerDialect = static_cast<unsigned>(OutputAsmVariant);
+    std::unique_ptr<MCInstPrinter> IP(TheTarget->createMCInstPrinter(
+        Triple(TripleName), AssemblerDialect, *MAI, *MCII, *MRI));
+    if (!IP) {
+      WithColor::error()
+          << "unable to create instruction printer for target triple '"
+          << TheTriple.normalize() << "' with assembly variant "
+          << AssemblerDialect << ".\n";
+      return 1;
+    }
 
-    if (PrintInstructionTables) {
-      //  Create a pipeline, stages, and a printer.
-      auto P = std::make_unique<mca::Pipeline>();
-      P->appendStage(std::make_unique<mca::EntryStage>(S));
-      P->appendStage(std::make_unique<mca::InstructionTables>(SM));
-      mca::PipelinePrinter Printer(*P);
+    // Set the display preference for hex vs. decimal immediates.
+    IP->setPrintImmHex(PrintImmHex);
+
+    // Number each region in the sequence.
+    unsigned RegionIdx = 0;
+
+    std::unique_ptr<MCCodeEmitter> MCE(
+        TheTarget->createMCCodeEmitter(*MCII, *MRI, Ctx));
+    assert(MCE && "Unable to create code emitter!");
+
+    // Separate the reports when analyzing several input files.
+    if (InputFilenames.size() > 1)
+      TOF->os() << "\n# file: " << InputFilename << "\n";
+
+    for (const std::unique_ptr<mca::CodeRegion> &Region : Regions) {
+      // Skip empty code regions.
+      if (Region->empty())
+        continue;
+
+      // Don't print the header of this region if it is the default region, and
+      // it doesn't have an end location.
+      if (Region->startLoc().isValid() || Region->endLoc().isValid()) {
+        TOF->os() << "\n[" << RegionIdx++ << "] Code Region";
+        StringRef Desc = Region->getDescription();
+        if (!Desc.empty())
+          TOF->os() << " - " << Desc;
+        TOF->os() << "\n\n";
+      }
 
-      // Create the views for this pipeline, execute, and emit a report.
-      if (PrintInstructionInfoView) {
-        Printer.addView(std::make_unique<mca::InstructionInfoView>(
-            *STI, *MCII, CE, ShowEncoding, Insts, *IP));
+      // Lower the MCInst sequence into an mca::Instruction sequence.
+      ArrayRef<MCInst> Insts = Region->getInstructions();
+      mca::CodeEmitter CE(*STI, *MAB, *MCE, Insts);
+      std::vector<std::unique_ptr<mca::Instruction>> LoweredSequence;
+      for (const MCInst &MCI : Insts) {
+        Expected<std::unique_ptr<mca::Instruction>> Inst =
+            IB.createInstruction(MCI);
+        if (!Inst) {
+          if (auto NewE = handleErrors(
+                  Inst.takeError(),
+                  [&IP, &STI](const mca::InstructionError<MCInst> &IE) {
+                    std::string InstructionStr;
+                    raw_string_ostream SS(InstructionStr);
+                    WithColor::error() << IE.Message << '\n';
+                    IP->printInst(&IE.Inst, 0, "", *STI, SS);
+                    SS.flush();
+                    WithColor::note()
+                        << "instruction: " << InstructionStr << '\n';
+                  })) {
+            // Default case.
+            WithColor::error() << toString(std::move(NewE));
+          }
+          return 1;
+        }
+
+        LoweredSequence.emplace_back(std::move(Inst.get()));
       }
-      Printer.addView(
-          std::make_unique<mca::ResourcePressureView>(*STI, *IP, Insts));
 
-      if (!runPipeline(*P))
-        return 1;
+      mca::SourceMgr S(LoweredSequence, PrintInstructionTables ? 1 : Iterations);
 
-      Printer.printReport(TOF->os());
-      continue;
-    }
+      if (PrintInstructionTables) {
+        //  Create a pipeline, stages, and a printer.
+        auto P = std::make_unique<mca::Pipeline>();
+        P->appendStage(std::make_unique<mca::EntryStage>(S));
+        P->appendStage(std::make_unique<mca::InstructionTables>(SM));
+        mca::PipelinePrinter Printer(*P);
 
-    // Create a basic pipeline simulating an out-of-order backend.
-    auto P = MCA.createDefaultPipeline(PO, S);
-    mca::PipelinePrinter Printer(*P);
+        // Create the views for this pipeline, execute, and emit a report.
+        if (PrintInstructionInfoView) {
+          Printer.addView(std::make_unique<mca::InstructionInfoView>(
+              *STI, *MCII, CE, ShowEncoding, Insts, *IP));
+        }
+        Printer.addView(
+            std::make_unique<mca::ResourcePressureView>(*STI, *IP, Insts));
 
-    if (PrintSummaryView)
-      Printer.addView(
-          std::make_unique<mca::SummaryView>(SM, Insts, DispatchWidth));
+        if (!runPipeline(*P))
+          return 1;
 
-    if (EnableBottleneckAnalysis) {
-      Printer.addView(std::make_unique<mca::BottleneckAnalysis>(
-          *STI, *IP, Insts, S.getNumIterations()));
-    }
+        Printer.printReport(TOF->os());
+        continue;
+      }
 
-    if (PrintInstructionInfoView)
-      Printer.addView(std::make_unique<mca::InstructionInfoView>(
-          *STI, *MCII, CE, ShowEncoding, Insts, *IP));
+      // Create a basic pipeline simulating an out-of-order backend.
+      auto P = MCA.createDefaultPipeline(PO, S);
+      mca::PipelinePrinter Printer(*P);
 
-    if (PrintDispatchStats)
-      Printer.addView(std::make_unique<mca::DispatchStatistics>());
+      if (PrintSummaryView)
+        Printer.addView(
+            std::make_unique<mca::SummaryView>(SM, Insts, DispatchWidth));
 
-    if (PrintSchedulerStats)
-      Printer.addView(std::make_unique<mca::SchedulerStatistics>(*STI));
+      if (EnableBottleneckAnalysis) {
+        Printer.addView(std::make_unique<mca::BottleneckAnalysis>(
+            *STI, *IP, Insts, S.getNumIterations()));
+      }
 
-    if (PrintRetireStats)
-      Printer.addView(std::make_unique<mca::RetireControlUnitStatistics>(SM));
+      if (PrintInstructionInfoView)
+        Printer.addView(std::make_unique<mca::InstructionInfoView>(
+            *STI, *MCII, CE, ShowEncoding, Insts, *IP));
 
-    if (PrintRegisterFileStats)
-      Printer.addView(std::make_unique<mca::RegisterFileStatistics>(*STI));
+      if (PrintDispatchStats)
+        Printer.addView(std::make_unique<mca::DispatchStatistics>());
 
-    if (PrintResourcePressureView)
-      Printer.addView(
-          std::make_unique<mca::ResourcePressureView>(*STI, *IP, Insts));
+      if (PrintSchedulerStats)
+        Printer.addView(std::make_unique<mca::SchedulerStatistics>(*STI));
 
-    if (PrintTimelineView) {
-      unsigned TimelineIterations =
-          TimelineMaxIterations ? TimelineMaxIterations : 10;
-      Printer.addView(std::make_unique<mca::TimelineView>(
-          *STI, *IP, Insts, std::min(TimelineIterations, S.getNumIterations()),
-          TimelineMaxCycles));
-    }
+      if (PrintRetireStats)
+        Printer.addView(std::make_unique<mca::RetireControlUnitStatistics>(SM));
 
-    if (!runPipeline(*P))
-      return 1;
+      if (PrintRegisterFileStats)
+        Printer.addView(std::make_unique<mca::RegisterFileStatistics>(*STI));
 
-    Printer.printReport(TOF->os());
+      if (PrintResourcePressureView)
+        Printer.addView(
+            std::make_unique<mca::ResourcePressureView>(*STI, *IP, Insts));
 
-    // Clear the InstrBuilder internal state in preparation for another round.
-    IB.clear();
-  }
+      if (PrintTimelineView) {
+        unsigned TimelineIterations =
+            TimelineMaxIterations ? TimelineMaxIterations : 10;
+        Printer.addView(std::make_unique<mca::TimelineView>(
+            *STI, *IP, Insts, std::min(TimelineIterations, S.getNumIterations()),
+            TimelineMaxCycles));
+      }
+
+      if (!runPipeline(*P))
+        return 1;
+
+      Printer.printReport(TOF->os());
+
+      // Clear the InstrBuilder internal state in preparation for another round.
+      IB.clear();
+    }
+
+    return 0;
+  };
+
+  for (const std::string &InputFilename : InputFilenames)
+    if (int Ret = AnalyzeInput(InputFilename))
+      return Ret;
 
   TOF->keep();
   return 0;
@@ -709,15 +709,21 @@ static Optional<std::string> demangle(StringRef Name, bool StripUnderscore) {
   if (!Name.startswith("_Z"))
     return None;
 
-  int Status;
-  char *Undecorated =
-      itaniumDemangle(Name.str().c_str(), nullptr, nullptr, &Status);
-  if (Status != 0)
+  // Keep the demangler and its output buffer alive across calls so that
+  // their allocations are reused for every symbol in the table instead of
+  // paying a parser construction and a malloc/free round-trip per name.
+  static ItaniumPartialDemangler Parser;
+  static char *OutputBuf = nullptr;
+  static size_t OutputSize = 0;
+
+  if (Parser.partialDemangle(Name.str().c_str()))
+    return None;
+  char *Undecorated = Parser.finishDemangle(OutputBuf, &OutputSize);
+  if (!Undecorated)
     return None;
 
-  std::string S(Undecorated);
-  free(Undecorated);
-  return S;
+  OutputBuf = Undecorated;
+  return std::string(Undecorated);
 }
 
 static bool symbolIsDefined(const NMSymbol &Sym) {
@@ -1245,15 +1251,28 @@ static void dumpSymbolNamesFromObject(SymbolicFile &Obj, bool printName,
       return;
   }
   if (!(MachO && DyldInfoOnly)) {
-    for (BasicSymbolRef Sym : Symbols) {
-      Expected<uint32_t> SymFlagsOrErr = Sym.getFlags();
-      if (!SymFlagsOrErr) {
-        error(SymFlagsOrErr.takeError(), Obj.getFileName());
-        return;
+    // Decode all symbol flags in one pass up front. For the common case of
+    // iterating the object's own symbol table this uses the format's bulk
+    // implementation instead of a virtual getSymbolFlags call per symbol.
+    std::vector<BasicSymbolDescriptor> Descriptors;
+    if (DynamicSyms) {
+      for (BasicSymbolRef Sym : Symbols) {
+        Expected<uint32_t> SymFlagsOrErr = Sym.getFlags();
+        if (!SymFlagsOrErr) {
+          error(SymFlagsOrErr.takeError(), Obj.getFileName());
+          return;
+        }
+        Descriptors.push_back({Sym, *SymFlagsOrErr});
       }
-      if (!DebugSyms && (*SymFlagsOrErr & SymbolRef::SF_FormatSpecific))
+    } else if (Error E = Obj.getSymbolDescriptors(Descriptors)) {
+      error(std::move(E), Obj.getFileName());
+      return;
+    }
+    for (const BasicSymbolDescriptor &Desc : Descriptors) {
+      BasicSymbolRef Sym = Desc.Symbol;
+      if (!DebugSyms && (Desc.Flags & SymbolRef::SF_FormatSpecific))
         continue;
-      if (WithoutAliases && (*SymFlagsOrErr & SymbolRef::SF_Indirect))
+      if (WithoutAliases && (Desc.Flags & SymbolRef::SF_Indirect))
         continue;
       // If a "-s segname sectname" option was specified and this is a Mach-O
       // file and this section appears in this file, Nsect will be non-zero then
@@ -42,7 +42,8 @@ static uint64_t getNextRVA(const Object &Obj) {
 static Expected<std::vector<uint8_t>>
 createGnuDebugLinkSectionContents(StringRef File) {
   ErrorOr<std::unique_ptr<MemoryBuffer>> LinkTargetOrErr =
-      MemoryBuffer::getFile(File);
+      MemoryBuffer::getFile(File, /*FileSize=*/-1,
+                            /*RequiresNullTerminator=*/false);
   if (!LinkTargetOrErr)
     return createFileError(File, LinkTargetOrErr.getError());
   auto LinkTarget = std::move(*LinkTargetOrErr);
@@ -233,7 +234,8 @@ static Error handleArgs(const CopyConfig &Config, Object &Obj) {
     StringRef SecName, FileName;
     std::tie(SecName, FileName) = Flag.split("=");
 
-    auto BufOrErr = MemoryBuffer::getFile(FileName);
+    auto BufOrErr = MemoryBuffer::getFile(FileName, /*FileSize=*/-1,
+                                          /*RequiresNullTerminator=*/false);
     if (!BufOrErr)
       return createFileError(FileName, errorCodeToError(BufOrErr.getError()));
     auto Buf = std::move(*BufOrErr);
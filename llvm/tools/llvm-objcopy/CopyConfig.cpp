@@ -600,7 +600,9 @@ parseObjcopyOptions(ArrayRef<const char *> ArgsArr,
   // checksum for every target file inside an archive by precomputing the CRC
   // here. This prevents a significant amount of I/O.
   if (!Config.AddGnuDebugLink.empty()) {
-    auto DebugOrErr = MemoryBuffer::getFile(Config.AddGnuDebugLink);
+    auto DebugOrErr = MemoryBuffer::getFile(Config.AddGnuDebugLink,
+                                            /*FileSize=*/-1,
+                                            /*RequiresNullTerminator=*/false);
     if (!DebugOrErr)
       return createFileError(Config.AddGnuDebugLink, DebugOrErr.getError());
     auto Debug = std::move(*DebugOrErr);
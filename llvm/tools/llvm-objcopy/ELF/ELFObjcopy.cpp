@@ -729,7 +729,8 @@ static Error handleArgs(const CopyConfig &Config, Object &Obj,
     StringRef SecName = SecPair.first;
     StringRef File = SecPair.second;
     ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
-        MemoryBuffer::getFile(File);
+        MemoryBuffer::getFile(File, /*FileSize=*/-1,
+                              /*RequiresNullTerminator=*/false);
     if (!BufOrErr)
       return createFileError(File, errorCodeToError(BufOrErr.getError()));
     std::unique_ptr<MemoryBuffer> Buf = std::move(*BufOrErr);
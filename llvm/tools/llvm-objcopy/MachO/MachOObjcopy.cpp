@@ -271,7 +271,8 @@ static Error dumpSectionToFile(StringRef SecName, StringRef Filename,
 
 static Error addSection(StringRef SecName, StringRef Filename, Object &Obj) {
   ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
-      MemoryBuffer::getFile(Filename);
+      MemoryBuffer::getFile(Filename, /*FileSize=*/-1,
+                            /*RequiresNullTerminator=*/false);
   if (!BufOrErr)
     return createFileError(Filename, errorCodeToError(BufOrErr.getError()));
   std::unique_ptr<MemoryBuffer> Buf = std::move(*BufOrErr);
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/LLVMContext.h"
@@ -308,21 +309,15 @@ static void writeInstrProfile(StringRef OutputFilename,
   }
 }
 
-static void mergeInstrProfile(const WeightedFileVector &Inputs,
-                              SymbolRemapper *Remapper,
-                              StringRef OutputFilename,
-                              ProfileFormat OutputFormat, bool OutputSparse,
-                              unsigned NumThreads, FailureMode FailMode) {
-  if (OutputFilename.compare("-") == 0)
-    exitWithError("Cannot write indexed profdata format to stdout.");
-
-  if (OutputFormat != PF_Binary && OutputFormat != PF_Compact_Binary &&
-      OutputFormat != PF_Ext_Binary && OutputFormat != PF_Text)
-    exitWithError("Unknown format is specified.");
-
-  std::mutex ErrorLock;
-  SmallSet<instrprof_error, 4> WriterErrorCodes;
-
+/// Load \p Inputs in parallel, merge them, and return the resulting writer
+/// context. Deferred errors are reported as warnings and counted in
+/// \p NumErrors.
+static std::unique_ptr<WriterContext>
+loadAndMergeInputs(const WeightedFileVector &Inputs, SymbolRemapper *Remapper,
+                   bool OutputSparse, unsigned NumThreads,
+                   std::mutex &ErrorLock,
+                   SmallSet<instrprof_error, 4> &WriterErrorCodes,
+                   unsigned &NumErrors) {
   // If NumThreads is not specified, auto-detect a good default.
   if (NumThreads == 0)
     NumThreads = std::min(hardware_concurrency().compute_thread_count(),
@@ -370,20 +365,82 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
     } while (Mid > 0);
   }
 
-  // Handle deferred errors encountered during merging. If the number of errors
-  // is equal to the number of inputs the merge failed.
-  unsigned NumErrors = 0;
+  // Handle deferred errors encountered during merging.
   for (std::unique_ptr<WriterContext> &WC : Contexts) {
     for (auto &ErrorPair : WC->Errors) {
       ++NumErrors;
       warn(toString(std::move(ErrorPair.first)), ErrorPair.second);
     }
+    WC->Errors.clear();
   }
+
+  return std::move(Contexts[0]);
+}
+
+static void mergeInstrProfile(const WeightedFileVector &Inputs,
+                              SymbolRemapper *Remapper,
+                              StringRef OutputFilename,
+                              ProfileFormat OutputFormat, bool OutputSparse,
+                              unsigned NumThreads, unsigned MergeBatchSize,
+                              FailureMode FailMode) {
+  if (OutputFilename.compare("-") == 0)
+    exitWithError("Cannot write indexed profdata format to stdout.");
+
+  if (OutputFormat != PF_Binary && OutputFormat != PF_Compact_Binary &&
+      OutputFormat != PF_Ext_Binary && OutputFormat != PF_Text)
+    exitWithError("Unknown format is specified.");
+
+  std::mutex ErrorLock;
+  SmallSet<instrprof_error, 4> WriterErrorCodes;
+  unsigned NumErrors = 0;
+
+  // With a bounded batch size, merge the inputs hierarchically: aggregate
+  // batches of MergeBatchSize inputs into temporary indexed profiles and
+  // repeat until one batch is left. Counts for identical functions collapse
+  // into a single record within each batch, so peak memory is proportional to
+  // the batch size rather than to the total number of inputs.
+  WeightedFileVector BatchedInputs;
+  std::vector<std::string> TempFiles;
+  const WeightedFileVector *CurInputs = &Inputs;
+  while (MergeBatchSize != 0 && CurInputs->size() > MergeBatchSize) {
+    WeightedFileVector NextInputs;
+    for (size_t Begin = 0, Size = CurInputs->size(); Begin < Size;
+         Begin += MergeBatchSize) {
+      size_t End = std::min(Begin + MergeBatchSize, Size);
+      WeightedFileVector Batch(CurInputs->begin() + Begin,
+                               CurInputs->begin() + End);
+      auto WC =
+          loadAndMergeInputs(Batch, Remapper, OutputSparse, NumThreads,
+                             ErrorLock, WriterErrorCodes, NumErrors);
+
+      SmallString<128> TempPath;
+      int TempFD;
+      if (std::error_code EC = sys::fs::createTemporaryFile(
+              "temporary-instrprof", "profdata", TempFD, TempPath))
+        exitWithErrorCode(EC, "create temporary profile");
+      raw_fd_ostream TempOut(TempFD, /*shouldClose=*/true);
+      WC->Writer.write(TempOut);
+      TempFiles.push_back(std::string(TempPath.str()));
+      NextInputs.push_back({TempFiles.back(), 1});
+    }
+    // The remapper has been applied to the original inputs already.
+    Remapper = nullptr;
+    BatchedInputs = std::move(NextInputs);
+    CurInputs = &BatchedInputs;
+  }
+
+  auto WC = loadAndMergeInputs(*CurInputs, Remapper, OutputSparse, NumThreads,
+                               ErrorLock, WriterErrorCodes, NumErrors);
+
+  for (const std::string &TempFile : TempFiles)
+    sys::fs::remove(TempFile);
+
+  // If the number of errors is equal to the number of inputs the merge failed.
   if (NumErrors == Inputs.size() ||
       (NumErrors > 0 && FailMode == failIfAnyAreInvalid))
     exitWithError("No profiles could be merged.");
 
-  writeInstrProfile(OutputFilename, OutputFormat, Contexts[0]->Writer);
+  writeInstrProfile(OutputFilename, OutputFormat, WC->Writer);
 }
 
 /// The profile entry for a function in instrumentation profile.
@@ -831,6 +888,12 @@ static int merge_main(int argc, const char *argv[]) {
       cl::desc("Number of merge threads to use (default: autodetect)"));
   cl::alias NumThreadsA("j", cl::desc("Alias for --num-threads"),
                         cl::aliasopt(NumThreads));
+  cl::opt<unsigned> MergeBatchSize(
+      "merge-batch-size", cl::init(0),
+      cl::desc("Merge inputs in batches of this size and combine the "
+               "intermediate results, bounding peak memory by the batch size "
+               "instead of the number of inputs (default: 0, i.e. load all "
+               "inputs at once; only meaningful for -instr)"));
   cl::opt<std::string> ProfileSymbolListFile(
       "prof-sym-list", cl::init(""),
       cl::desc("Path to file containing the list of function symbols "
@@ -909,7 +972,8 @@ static int merge_main(int argc, const char *argv[]) {
 
   if (ProfileKind == instr)
     mergeInstrProfile(WeightedInputs, Remapper.get(), OutputFilename,
-                      OutputFormat, OutputSparse, NumThreads, FailureMode);
+                      OutputFormat, OutputSparse, NumThreads, MergeBatchSize,
+                      FailureMode);
   else
     mergeSampleProfile(WeightedInputs, Remapper.get(), OutputFilename,
                        OutputFormat, ProfileSymbolListFile, CompressAllSections,
@@ -253,6 +253,11 @@ static cl::opt<unsigned> TimeTraceGranularity(
     cl::desc("Minimum time granularity (in microseconds) traced by time profiler"),
     cl::init(500), cl::Hidden);
 
+static cl::opt<bool> TimeTraceHWCounters(
+    "time-trace-hw-counters",
+    cl::desc("Record hardware performance counters (instructions retired, "
+             "cache misses) in the time trace, where supported"));
+
 static cl::opt<std::string>
     TimeTraceFile("time-trace-file",
                     cl::desc("Specify time trace file destination"),
@@ -441,8 +446,11 @@ void initializeExampleIRTransforms(llvm::PassRegistry &Registry);
 
 struct TimeTracerRAII {
   TimeTracerRAII(StringRef ProgramName) {
-    if (TimeTrace)
+    if (TimeTrace) {
+      if (TimeTraceHWCounters)
+        timeTraceProfilerEnableHardwareCounters();
       timeTraceProfilerInitialize(TimeTraceGranularity, ProgramName);
+    }
   }
   ~TimeTracerRAII() {
     if (TimeTrace) {
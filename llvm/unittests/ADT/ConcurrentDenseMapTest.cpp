@@ -0,0 +1,81 @@
+//===- llvm/unittest/ADT/ConcurrentDenseMapTest.cpp - Map tests -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/ConcurrentDenseMap.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(ConcurrentDenseMapTest, BasicOperations) {
+  ConcurrentDenseMap<int, int> Map;
+  EXPECT_EQ(0u, Map.size());
+  EXPECT_FALSE(Map.lookup(1).hasValue());
+  EXPECT_FALSE(Map.contains(1));
+
+  EXPECT_TRUE(Map.try_emplace(1, 10));
+  EXPECT_FALSE(Map.try_emplace(1, 20));
+  EXPECT_TRUE(Map.contains(1));
+  EXPECT_EQ(10, *Map.lookup(1));
+  EXPECT_EQ(1u, Map.size());
+
+  Map.set(1, 30);
+  EXPECT_EQ(30, *Map.lookup(1));
+
+  EXPECT_TRUE(Map.erase(1));
+  EXPECT_FALSE(Map.erase(1));
+  EXPECT_FALSE(Map.contains(1));
+
+  Map.try_emplace(2, 20);
+  Map.try_emplace(3, 30);
+  Map.clear();
+  EXPECT_EQ(0u, Map.size());
+}
+
+TEST(ConcurrentDenseMapTest, ForEach) {
+  ConcurrentDenseMap<int, int> Map;
+  for (int I = 0; I != 100; ++I)
+    Map.try_emplace(I, 2 * I);
+
+  int Sum = 0;
+  Map.forEach([&](int Key, int Value) {
+    EXPECT_EQ(2 * Key, Value);
+    Sum += Value;
+  });
+  EXPECT_EQ(9900, Sum);
+}
+
+TEST(ConcurrentDenseMapTest, ConcurrentInsertAndLookup) {
+  const unsigned NumThreads = 8;
+  const int KeysPerThread = 1000;
+  ConcurrentDenseMap<int, int> Map;
+
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T != NumThreads; ++T)
+    Threads.emplace_back([&Map, T] {
+      for (int I = 0; I != KeysPerThread; ++I) {
+        int Key = T * KeysPerThread + I;
+        Map.try_emplace(Key, Key + 1);
+        // Read back keys inserted by other threads as well as our own.
+        Optional<int> Value = Map.lookup(Key / 2);
+        if (Value)
+          EXPECT_EQ(Key / 2 + 1, *Value);
+      }
+    });
+  for (std::thread &T : Threads)
+    T.join();
+
+  EXPECT_EQ(size_t(NumThreads * KeysPerThread), Map.size());
+  for (int Key = 0; Key != int(NumThreads * KeysPerThread); ++Key)
+    EXPECT_EQ(Key + 1, *Map.lookup(Key));
+}
+
+} // end anonymous namespace
@@ -0,0 +1,70 @@
+//===- llvm/unittest/ADT/PagedVectorTest.cpp ------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// PagedVector unit tests.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/PagedVector.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+TEST(PagedVectorTest, EmptyTest) {
+  PagedVector<int, 10> V;
+  EXPECT_EQ(V.size(), 0u);
+  EXPECT_TRUE(V.empty());
+  EXPECT_EQ(V.count(0), 0u);
+}
+
+TEST(PagedVectorTest, ValueInitialized) {
+  PagedVector<int, 10> V;
+  V.resize(25);
+  EXPECT_EQ(V.size(), 25u);
+  // Elements of unmaterialized pages read as value-initialized.
+  for (size_t I = 0; I < 25; ++I)
+    EXPECT_EQ(V[I], 0);
+}
+
+TEST(PagedVectorTest, FillAndCount) {
+  PagedVector<int, 10> V;
+  V.resize(25);
+  V[7] = 3;
+  V[24] = 4;
+  EXPECT_EQ(V[7], 3);
+  EXPECT_EQ(V[24], 4);
+  // count() treats unmaterialized pages (here, the middle one) as holding
+  // value-initialized elements.
+  EXPECT_EQ(V.count(0), 23u);
+  EXPECT_EQ(V.count(3), 1u);
+  EXPECT_EQ(V.count(4), 1u);
+}
+
+TEST(PagedVectorTest, Grow) {
+  PagedVector<int, 10> V;
+  V.resize(5);
+  V[2] = 42;
+  V.resize(100);
+  EXPECT_EQ(V.size(), 100u);
+  EXPECT_EQ(V[2], 42);
+  EXPECT_EQ(V[99], 0);
+}
+
+TEST(PagedVectorTest, Clear) {
+  PagedVector<int, 10> V;
+  V.resize(15);
+  V[0] = 1;
+  V.clear();
+  EXPECT_EQ(V.size(), 0u);
+  V.resize(15);
+  EXPECT_EQ(V[0], 0);
+}
+
+} // namespace
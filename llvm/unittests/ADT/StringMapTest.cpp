@@ -280,6 +280,39 @@ TEST_F(StringMapTest, InsertRehashingPairTest) {
   EXPECT_EQ(42u, It->second);
 }
 
+TEST_F(StringMapTest, InsertRangeTest) {
+  std::vector<std::pair<StringRef, uint32_t>> Pairs = {
+      {"A", 1}, {"B", 2}, {"C", 3}, {"A", 4}};
+  StringMap<uint32_t> t;
+  t.insert(Pairs.begin(), Pairs.end());
+  EXPECT_EQ(3u, t.size());
+  EXPECT_EQ(1u, t["A"]); // First of the duplicate keys wins.
+  EXPECT_EQ(2u, t["B"]);
+  EXPECT_EQ(3u, t["C"]);
+
+  t.insert({{"C", 5}, {"D", 6}});
+  EXPECT_EQ(4u, t.size());
+  EXPECT_EQ(3u, t["C"]);
+  EXPECT_EQ(6u, t["D"]);
+}
+
+TEST_F(StringMapTest, ReserveTest) {
+  StringMap<uint32_t> t;
+  t.reserve(100);
+  unsigned Buckets = t.getNumBuckets();
+  EXPECT_GE(Buckets, 100u);
+  for (unsigned I = 0; I != 100; ++I)
+    t[Twine(I).str()] = I;
+  // No rehash may have happened while inserting the reserved-for entries.
+  EXPECT_EQ(Buckets, t.getNumBuckets());
+  for (unsigned I = 0; I != 100; ++I)
+    EXPECT_EQ(I, t[Twine(I).str()]);
+
+  // Reserving below the current size is a no-op.
+  t.reserve(1);
+  EXPECT_EQ(Buckets, t.getNumBuckets());
+}
+
 TEST_F(StringMapTest, InsertOrAssignTest) {
   struct A : CountCopyAndMove {
     A(int v) : v(v) {}
@@ -0,0 +1,84 @@
+//===--- JITLinkMemoryManagerTests.cpp - JITLink memory manager tests -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/JITLink/JITLinkMemoryManager.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::jitlink;
+
+static auto RWFlags =
+    sys::Memory::ProtectionFlags(sys::Memory::MF_READ | sys::Memory::MF_WRITE);
+
+TEST(JITLinkMemoryManagerTest, PooledAllocateAndFinalize) {
+  auto MemMgr = cantFail(PooledMemoryManager::Create());
+
+  JITLinkMemoryManager::SegmentsRequestMap Request;
+  Request[RWFlags] = {8, 128, 64};
+
+  auto Alloc = MemMgr->allocate(Request);
+  ASSERT_THAT_EXPECTED(Alloc, Succeeded());
+
+  auto WorkingMem = (*Alloc)->getWorkingMemory(RWFlags);
+  EXPECT_GE(WorkingMem.size(), 128U + 64U);
+  EXPECT_EQ(pointerToJITTargetAddress(WorkingMem.data()),
+            (*Alloc)->getTargetMemory(RWFlags));
+
+  // Zero-fill memory should have been zeroed out.
+  for (char C : WorkingMem.slice(128, 64))
+    EXPECT_EQ(C, 0);
+
+  memset(WorkingMem.data(), 0x2A, 128);
+  EXPECT_THAT_ERROR((*Alloc)->finalize(), Succeeded());
+  EXPECT_EQ(WorkingMem[0], 0x2A);
+
+  EXPECT_THAT_ERROR((*Alloc)->deallocate(), Succeeded());
+}
+
+TEST(JITLinkMemoryManagerTest, PooledAllocationsShareSlab) {
+  // Two small allocations should be carved from the same slab, and a
+  // deallocated block should be reused for a subsequent allocation.
+  auto MemMgr = cantFail(PooledMemoryManager::Create());
+
+  JITLinkMemoryManager::SegmentsRequestMap Request;
+  Request[RWFlags] = {8, 64, 0};
+
+  auto Alloc1 = MemMgr->allocate(Request);
+  ASSERT_THAT_EXPECTED(Alloc1, Succeeded());
+  auto Alloc2 = MemMgr->allocate(Request);
+  ASSERT_THAT_EXPECTED(Alloc2, Succeeded());
+
+  auto Addr1 = (*Alloc1)->getTargetMemory(RWFlags);
+  auto Addr2 = (*Alloc2)->getTargetMemory(RWFlags);
+  uint64_t PageSize = sys::Process::getPageSizeEstimate();
+  EXPECT_EQ(Addr2, Addr1 + PageSize);
+
+  EXPECT_THAT_ERROR((*Alloc1)->deallocate(), Succeeded());
+
+  auto Alloc3 = MemMgr->allocate(Request);
+  ASSERT_THAT_EXPECTED(Alloc3, Succeeded());
+  EXPECT_EQ((*Alloc3)->getTargetMemory(RWFlags), Addr1);
+  EXPECT_THAT_ERROR((*Alloc3)->deallocate(), Succeeded());
+  EXPECT_THAT_ERROR((*Alloc2)->deallocate(), Succeeded());
+}
+
+TEST(JITLinkMemoryManagerTest, PooledOversizedRequest) {
+  // Requests larger than the slab size get a dedicated mapping.
+  uint64_t PageSize = sys::Process::getPageSizeEstimate();
+  auto MemMgr = cantFail(PooledMemoryManager::Create(PageSize));
+
+  JITLinkMemoryManager::SegmentsRequestMap Request;
+  Request[RWFlags] = {8, 4 * PageSize, 0};
+
+  auto Alloc = MemMgr->allocate(Request);
+  ASSERT_THAT_EXPECTED(Alloc, Succeeded());
+  EXPECT_GE((*Alloc)->getWorkingMemory(RWFlags).size(), 4 * PageSize);
+  EXPECT_THAT_ERROR((*Alloc)->deallocate(), Succeeded());
+}
@@ -72,6 +72,29 @@ TEST_F(CoreAPIsStandardTest, EmptyLookup) {
   EXPECT_TRUE(OnCompletionRun) << "OnCompletion was not run for empty query";
 }
 
+TEST_F(CoreAPIsStandardTest, BatchLookup) {
+  cantFail(JD.define(absoluteSymbols({{Foo, FooSym}, {Bar, BarSym}})));
+
+  std::vector<ExecutionSession::BatchLookupQuery> Queries;
+  Queries.emplace_back(makeJITDylibSearchOrder(&JD), SymbolLookupSet(Foo));
+  Queries.emplace_back(makeJITDylibSearchOrder(&JD), SymbolLookupSet(Bar));
+  Queries.emplace_back(makeJITDylibSearchOrder(&JD), SymbolLookupSet(Baz));
+
+  auto Results = ES.lookupBatch(std::move(Queries));
+  ASSERT_EQ(Results.size(), 3U);
+
+  auto FooResult = cantFail(std::move(Results[0]));
+  EXPECT_EQ(FooResult.size(), 1U) << "Unexpected number of results";
+  EXPECT_EQ(FooResult.count(Foo), 1U) << "Missing result for \"foo\"";
+
+  auto BarResult = cantFail(std::move(Results[1]));
+  EXPECT_EQ(BarResult.size(), 1U) << "Unexpected number of results";
+  EXPECT_EQ(BarResult.count(Bar), 1U) << "Missing result for \"bar\"";
+
+  // Baz is not defined; its query fails without affecting the others.
+  EXPECT_THAT_EXPECTED(std::move(Results[2]), Failed());
+}
+
 TEST_F(CoreAPIsStandardTest, ResolveUnrequestedSymbol) {
   // Test that all symbols in a MaterializationUnit materialize corretly when
   // only a subset of symbols is looked up.
@@ -22,6 +22,8 @@
 #include "llvm/IR/Verifier.h"
 #include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
+#include <thread>
+#include <vector>
 using namespace llvm;
 
 namespace {
@@ -1089,6 +1091,36 @@ TEST_F(DILocationTest, discriminatorSpecialCases) {
   EXPECT_EQ(None, L4->cloneByMultiplyingDuplicationFactor(0x1000));
 }
 
+TEST_F(DILocationTest, concurrentUniquing) {
+  DISubprogram *N = getSubprogram();
+
+  // Nodes uniqued before enabling the sharded mode must stay visible.
+  DILocation *Before = DILocation::get(Context, 1, 7, N);
+  EXPECT_FALSE(Context.hasConcurrentDILocationUniquing());
+  Context.enableConcurrentDILocationUniquing();
+  EXPECT_TRUE(Context.hasConcurrentDILocationUniquing());
+  EXPECT_EQ(Before, DILocation::get(Context, 1, 7, N));
+
+  // Threads requesting the same (line, column, scope) must agree on one node.
+  constexpr unsigned NumThreads = 8;
+  constexpr unsigned NumLines = 64;
+  std::vector<std::vector<DILocation *>> Got(
+      NumThreads, std::vector<DILocation *>(NumLines));
+  {
+    std::vector<std::thread> Threads;
+    for (unsigned T = 0; T != NumThreads; ++T)
+      Threads.emplace_back([&, T] {
+        for (unsigned Line = 0; Line != NumLines; ++Line)
+          Got[T][Line] = DILocation::get(Context, Line, 0, N);
+      });
+    for (std::thread &Thread : Threads)
+      Thread.join();
+  }
+  for (unsigned T = 1; T != NumThreads; ++T)
+    for (unsigned Line = 0; Line != NumLines; ++Line)
+      EXPECT_EQ(Got[0][Line], Got[T][Line]);
+}
+
 
 typedef MetadataTest GenericDINodeTest;
 
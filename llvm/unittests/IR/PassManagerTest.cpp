@@ -10,7 +10,10 @@
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/AnalysisCacheSnapshot.h"
+#include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassManagerImpl.h"
@@ -946,4 +949,39 @@ TEST_F(PassManagerTest, FunctionPassCFGCheckerWrapped) {
   FPM.addPass(TestSimplifyCFGWrapperPass(InnerFPM));
   FPM.run(*F, FAM);
 }
+
+TEST_F(PassManagerTest, AnalysisCacheSnapshot) {
+  FunctionAnalysisManager FAM(/*DebugLogging*/ true);
+  int FunctionAnalysisRuns = 0;
+  FAM.registerPass([&] { return TestFunctionAnalysis(FunctionAnalysisRuns); });
+  FAM.registerPass([&] { return PassInstrumentationAnalysis(); });
+
+  // Prime the cache for all three functions.
+  for (Function &F : *M)
+    (void)FAM.getResult<TestFunctionAnalysis>(F);
+  EXPECT_EQ(3, FunctionAnalysisRuns);
+
+  FunctionAnalysisCacheSnapshot Snapshot;
+  Snapshot.take(*M);
+
+  // Nothing changed, so nothing is invalidated and cached results are reused.
+  EXPECT_EQ(0u, Snapshot.refresh(*M, FAM));
+  for (Function &F : *M)
+    (void)FAM.getResult<TestFunctionAnalysis>(F);
+  EXPECT_EQ(3, FunctionAnalysisRuns);
+
+  // Mutate @g behind the analysis manager's back, as a JIT patching IR
+  // between optimization rounds would.
+  Function *G = M->getFunction("g");
+  Type *I32Ty = Type::getInt32Ty(Context);
+  BinaryOperator::CreateAdd(ConstantInt::get(I32Ty, 1),
+                            ConstantInt::get(I32Ty, 2), "x",
+                            G->getEntryBlock().getTerminator());
+
+  // Only @g's cached analyses are dropped and recomputed.
+  EXPECT_EQ(1u, Snapshot.refresh(*M, FAM));
+  for (Function &F : *M)
+    (void)FAM.getResult<TestFunctionAnalysis>(F);
+  EXPECT_EQ(4, FunctionAnalysisRuns);
+}
 }
@@ -0,0 +1,87 @@
+//===- ValueArenaTest.cpp - Arena-backed Value allocation tests -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/User.h"
+#include "gtest/gtest.h"
+using namespace llvm;
+
+namespace {
+
+TEST(ValueArenaTest, enableValueArena) {
+  LLVMContext Context;
+  EXPECT_EQ(nullptr, User::getThreadLocalValueArena());
+  Context.enableValueArena();
+  EXPECT_NE(nullptr, User::getThreadLocalValueArena());
+  Context.disableValueArena();
+  EXPECT_EQ(nullptr, User::getThreadLocalValueArena());
+}
+
+TEST(ValueArenaTest, ArenaAllocatedIR) {
+  LLVMContext Context;
+  Context.enableValueArena();
+
+  auto M = std::make_unique<Module>("arena", Context);
+  FunctionType *FTy =
+      FunctionType::get(Type::getVoidTy(Context), /*isVarArg=*/false);
+  Function *F = Function::Create(FTy, Function::ExternalLinkage, "f", M.get());
+  BasicBlock *BB = BasicBlock::Create(Context, "entry", F);
+  IRBuilder<> Builder(BB);
+
+  // Exercise fixed-operand Users, hung-off Users (PHIs) and hung-off use list
+  // growth; everything must come out of the installed arena.
+  BumpPtrAllocator *Arena = User::getThreadLocalValueArena();
+  Value *Add = Builder.CreateAdd(ConstantInt::get(Type::getInt32Ty(Context), 1),
+                                 ConstantInt::get(Type::getInt32Ty(Context), 2));
+  PHINode *PHI = Builder.CreatePHI(Type::getInt32Ty(Context), 1);
+  for (unsigned I = 0; I != 8; ++I)
+    PHI->addIncoming(Add, BB);
+  Builder.CreateRetVoid();
+
+  EXPECT_TRUE(Arena->identifyObject(PHI).hasValue());
+
+  // Deleting arena-backed IR runs destructors but must not free arena memory.
+  size_t Allocated = Arena->getBytesAllocated();
+  M.reset();
+  EXPECT_EQ(Allocated, Arena->getBytesAllocated());
+
+  Context.disableValueArena();
+}
+
+TEST(ValueArenaTest, ContextDestroyedWithOwnedModule) {
+  // A module that is never explicitly deleted is destroyed by the context
+  // destructor. The arena must still be installed at that point so that the
+  // module's arena-backed User storage is recognized and not individually
+  // freed.
+  auto Context = std::make_unique<LLVMContext>();
+  Context->enableValueArena();
+
+  Module *M = new Module("arena", *Context);
+  FunctionType *FTy =
+      FunctionType::get(Type::getVoidTy(*Context), /*isVarArg=*/false);
+  Function *F = Function::Create(FTy, Function::ExternalLinkage, "f", M);
+  BasicBlock *BB = BasicBlock::Create(*Context, "entry", F);
+  IRBuilder<> Builder(BB);
+  Value *Add =
+      Builder.CreateAdd(ConstantInt::get(Type::getInt32Ty(*Context), 1),
+                        ConstantInt::get(Type::getInt32Ty(*Context), 2));
+  PHINode *PHI = Builder.CreatePHI(Type::getInt32Ty(*Context), 1);
+  for (unsigned I = 0; I != 8; ++I)
+    PHI->addIncoming(Add, BB);
+  Builder.CreateRetVoid();
+
+  // Destroying the context deletes the still-owned module from inside
+  // ~LLVMContextImpl; this must not free interior arena pointers.
+  Context.reset();
+}
+
+} // end anonymous namespace
@@ -201,6 +201,45 @@ TEST_F(LinkModuleTest, TypeMerge) {
             M1->getNamedGlobal("t2")->getType());
 }
 
+TEST_F(LinkModuleTest, RecursiveTypeMerge) {
+  LLVMContext C;
+  SMDiagnostic Err;
+
+  const char *M1Str = "%t = type {%t*, i32}\n"
+                      "@t1 = weak global %t zeroinitializer\n";
+  std::unique_ptr<Module> M1 = parseAssemblyString(M1Str, Err, C);
+
+  const char *M2Str = "%t = type {%t*, i32}\n"
+                      "@t2 = weak global %t zeroinitializer\n";
+  std::unique_ptr<Module> M2 = parseAssemblyString(M2Str, Err, C);
+
+  Ctx.setDiagnosticHandlerCallBack(expectNoDiags);
+  Linker::linkModules(*M1, std::move(M2));
+
+  EXPECT_EQ(M1->getNamedGlobal("t1")->getType(),
+            M1->getNamedGlobal("t2")->getType());
+}
+
+TEST_F(LinkModuleTest, NoTypeMerge) {
+  LLVMContext C;
+  SMDiagnostic Err;
+
+  // Same-named but structurally different types must stay distinct.
+  const char *M1Str = "%t = type {i32}\n"
+                      "@t1 = weak global %t zeroinitializer\n";
+  std::unique_ptr<Module> M1 = parseAssemblyString(M1Str, Err, C);
+
+  const char *M2Str = "%t = type {i64}\n"
+                      "@t2 = weak global %t zeroinitializer\n";
+  std::unique_ptr<Module> M2 = parseAssemblyString(M2Str, Err, C);
+
+  Ctx.setDiagnosticHandlerCallBack(expectNoDiags);
+  Linker::linkModules(*M1, std::move(M2));
+
+  EXPECT_NE(M1->getNamedGlobal("t1")->getType(),
+            M1->getNamedGlobal("t2")->getType());
+}
+
 TEST_F(LinkModuleTest, NewCAPISuccess) {
   std::unique_ptr<Module> DestM(getExternal(Ctx, "foo"));
   std::unique_ptr<Module> SourceM(getExternal(Ctx, "bar"));
@@ -138,6 +138,31 @@ TEST_P(MaybeSparseInstrProfTest, get_function_counts) {
   ASSERT_TRUE(ErrorEquals(instrprof_error::unknown_function, std::move(E2)));
 }
 
+// getFunctionCounts skips the deserialization of value profile data attached
+// to the record. Check that the counts are still read correctly and that a
+// subsequent full lookup sees the value profile data.
+TEST_P(MaybeSparseInstrProfTest, get_function_counts_with_vp_data) {
+  NamedInstrProfRecord Record("caller", 0x1234, {1, 2});
+  Record.reserveSites(IPVK_IndirectCallTarget, 1);
+  InstrProfValueData VD0[] = {{1000, 1}, {2000, 2}};
+  Record.addValueData(IPVK_IndirectCallTarget, 0, VD0, 2, nullptr);
+  Writer.addRecord(std::move(Record), Err);
+  auto Profile = Writer.writeBuffer();
+  readProfile(std::move(Profile));
+
+  std::vector<uint64_t> Counts;
+  EXPECT_THAT_ERROR(Reader->getFunctionCounts("caller", 0x1234, Counts),
+                    Succeeded());
+  ASSERT_EQ(2U, Counts.size());
+  ASSERT_EQ(1U, Counts[0]);
+  ASSERT_EQ(2U, Counts[1]);
+
+  Expected<InstrProfRecord> R = Reader->getInstrProfRecord("caller", 0x1234);
+  EXPECT_THAT_ERROR(R.takeError(), Succeeded());
+  ASSERT_EQ(1U, R->getNumValueSites(IPVK_IndirectCallTarget));
+  ASSERT_EQ(2U, R->getNumValueDataForSite(IPVK_IndirectCallTarget, 0));
+}
+
 // Profile data is copied from general.proftext
 TEST_F(InstrProfTest, get_profile_summary) {
   Writer.addRecord({"func1", 0x1234, {97531}}, Err);
@@ -222,6 +222,50 @@ TEST(BitstreamRemarks, Contents) {
   EXPECT_TRUE(errorToBool(std::move(E))); // Check for parsing errors.
 }
 
+TEST(BitstreamRemarks, SeekToRemark) {
+  remarks::StringTable BSStrTab;
+  remarks::Remark R;
+  R.RemarkType = remarks::Type::Missed;
+  R.PassName = "inline";
+  R.RemarkName = "NoDefinition";
+  R.FunctionName = "foo";
+  BSStrTab.internalize(R);
+  std::string BSBuf;
+  raw_string_ostream BSStream(BSBuf);
+  Expected<std::unique_ptr<remarks::RemarkSerializer>> BSSerializer =
+      remarks::createRemarkSerializer(remarks::Format::Bitstream,
+                                      remarks::SerializerMode::Standalone,
+                                      BSStream, std::move(BSStrTab));
+  EXPECT_FALSE(errorToBool(BSSerializer.takeError()));
+  (*BSSerializer)->emit(R);
+
+  Expected<std::unique_ptr<remarks::RemarkParser>> MaybeParser =
+      remarks::createRemarkParser(remarks::Format::Bitstream, BSStream.str());
+  EXPECT_FALSE(errorToBool(MaybeParser.takeError()));
+  remarks::RemarkParser &Parser = **MaybeParser;
+
+  // The standalone container does not provide a remark index.
+  Expected<Optional<ArrayRef<uint64_t>>> MaybeOffsets =
+      Parser.getRemarkOffsetsFor("foo");
+  EXPECT_FALSE(errorToBool(MaybeOffsets.takeError()));
+  EXPECT_EQ(*MaybeOffsets, None);
+
+  // Parse the only remark, then hit the end of the stream.
+  Expected<std::unique_ptr<remarks::Remark>> First = Parser.next();
+  EXPECT_FALSE(errorToBool(First.takeError()));
+  EXPECT_EQ(**First, R);
+  Expected<std::unique_ptr<remarks::Remark>> End = Parser.next();
+  Error E = End.takeError();
+  EXPECT_TRUE(E.isA<remarks::EndOfFileError>());
+  EXPECT_TRUE(errorToBool(std::move(E)));
+
+  // Seek back to the first remark and parse it again.
+  EXPECT_FALSE(errorToBool(Parser.seekToRemark(0)));
+  Expected<std::unique_ptr<remarks::Remark>> Again = Parser.next();
+  EXPECT_FALSE(errorToBool(Again.takeError()));
+  EXPECT_EQ(**Again, R);
+}
+
 static inline StringRef checkStr(LLVMRemarkStringRef Str,
                                  unsigned ExpectedLen) {
   const char *StrData = LLVMRemarkStringGetData(Str);
@@ -99,6 +99,7 @@ TEST(BitstreamRemarkSerializer, SeparateRemarkFileNoOptionals) {
         "'remark\\x00pass\\x00function\\x00'\n"
         "  <External File codeid=4 abbrevid=6/> blob data = "
         "'" EXTERNALFILETESTPATH"'\n"
+        "  <Remark index codeid=10 abbrevid=7 op0=2 op1=0/>\n"
         "</Meta>\n");
 }
 
@@ -128,6 +129,7 @@ TEST(BitstreamRemarkSerializer, SeparateRemarkFileNoOptionalsSeparateStrTab) {
         "'function\\x00pass\\x00remark\\x00'\n"
         "  <External File codeid=4 abbrevid=6/> blob data = "
         "'" EXTERNALFILETESTPATH"'\n"
+        "  <Remark index codeid=10 abbrevid=7 op0=0 op1=0/>\n"
         "</Meta>\n",
         std::move(StrTab));
 }
@@ -159,6 +161,7 @@ TEST(BitstreamRemarkSerializer, SeparateRemarkFileDebugLoc) {
         "'remark\\x00pass\\x00function\\x00path\\x00'\n"
         "  <External File codeid=4 abbrevid=6/> blob data = "
         "'" EXTERNALFILETESTPATH"'\n"
+        "  <Remark index codeid=10 abbrevid=7 op0=2 op1=0/>\n"
         "</Meta>\n");
 }
 
@@ -186,6 +189,7 @@ TEST(BitstreamRemarkSerializer, SeparateRemarkFileHotness) {
         "'remark\\x00pass\\x00function\\x00'\n"
         "  <External File codeid=4 abbrevid=6/> blob data = "
         "'" EXTERNALFILETESTPATH"'\n"
+        "  <Remark index codeid=10 abbrevid=7 op0=2 op1=0/>\n"
         "</Meta>\n");
 }
 
@@ -215,6 +219,7 @@ TEST(BitstreamRemarkSerializer, SeparateRemarkFileArgNoDebugLoc) {
         "'remark\\x00pass\\x00function\\x00key\\x00value\\x00'\n"
         "  <External File codeid=4 abbrevid=6/> blob data = "
         "'" EXTERNALFILETESTPATH"'\n"
+        "  <Remark index codeid=10 abbrevid=7 op0=2 op1=0/>\n"
         "</Meta>\n");
 }
 
@@ -249,6 +254,7 @@ TEST(BitstreamRemarkSerializer, SeparateRemarkFileArgDebugLoc) {
         "'remark\\x00pass\\x00function\\x00key\\x00value\\x00path\\x00'\n"
         "  <External File codeid=4 abbrevid=6/> blob data = "
         "'" EXTERNALFILETESTPATH"'\n"
+        "  <Remark index codeid=10 abbrevid=7 op0=2 op1=0/>\n"
         "</Meta>\n");
 }
 
@@ -290,6 +296,7 @@ TEST(BitstreamRemarkSerializer, SeparateRemarkFileAll) {
         "'remark\\x00pass\\x00function\\x00path\\x00key\\x00value\\x00argpa"
         "th\\x00'\n  <External File codeid=4 abbrevid=6/> blob data = "
         "'" EXTERNALFILETESTPATH"'\n"
+        "  <Remark index codeid=10 abbrevid=7 op0=2 op1=0/>\n"
         "</Meta>\n");
 }
 
@@ -65,6 +65,47 @@ TEST(CompressionTest, Zlib) {
   TestZlibCompression(BinaryDataStr, zlib::DefaultCompression);
 }
 
+// Compress a buffer in independent shards, reassemble them into a single
+// zlib stream and check that a plain uncompress round-trips it.
+void TestZlibSharded(StringRef Input, size_t ShardSize, int Level) {
+  size_t NumShards = std::max<size_t>(1, (Input.size() + ShardSize - 1) / ShardSize);
+  SmallString<32> Stream;
+  Stream.push_back(0x78); // CMF: DEFLATE with a 32K window.
+  Stream.push_back(0x01); // FLG: fastest; (CMF * 256 + FLG) % 31 == 0.
+
+  uint32_t Checksum = 1; // Initial Adler-32 value.
+  for (size_t I = 0; I != NumShards; ++I) {
+    StringRef Shard = Input.substr(I * ShardSize, ShardSize);
+    SmallString<32> Compressed;
+    Error E = zlib::compressShard(Shard, Compressed, Level,
+                                  /*LastShard=*/I + 1 == NumShards);
+    EXPECT_FALSE(E);
+    consumeError(std::move(E));
+    Stream.append(Compressed);
+    Checksum = zlib::adler32Combine(Checksum, zlib::adler32(Shard),
+                                    Shard.size());
+  }
+  for (int Shift = 24; Shift >= 0; Shift -= 8)
+    Stream.push_back((Checksum >> Shift) & 0xff);
+
+  SmallString<32> Uncompressed;
+  Error E = zlib::uncompress(Stream, Uncompressed, Input.size());
+  EXPECT_FALSE(E);
+  consumeError(std::move(E));
+  EXPECT_EQ(Input, Uncompressed);
+}
+
+TEST(CompressionTest, ZlibSharded) {
+  std::string Input;
+  for (size_t I = 0; I < 4096; ++I)
+    Input.push_back(I * 7919 & 255);
+
+  TestZlibSharded(Input, 1024, zlib::BestSpeedCompression);
+  TestZlibSharded(Input, 1000, zlib::DefaultCompression);
+  TestZlibSharded(Input, 8192, zlib::DefaultCompression);
+  TestZlibSharded("", 1024, zlib::DefaultCompression);
+}
+
 TEST(CompressionTest, ZlibCRC32) {
   EXPECT_EQ(
       0x414FA339U,
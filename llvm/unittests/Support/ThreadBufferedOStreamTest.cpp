@@ -0,0 +1,85 @@
+//===- ThreadBufferedOStreamTest.cpp --------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ThreadBufferedOStream.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Twine.h"
+#include "gtest/gtest.h"
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(ThreadBufferedOStreamTest, BuffersUntilEmit) {
+  std::string Out;
+  raw_string_ostream Target(Out);
+  std::mutex Lock;
+
+  thread_buffered_ostream TBO(Target, Lock);
+  TBO << "hello " << 42;
+  EXPECT_EQ("", Target.str());
+
+  TBO.emitBuffer();
+  EXPECT_EQ("hello 42", Target.str());
+
+  // The buffer is cleared after an emit, so nothing is written twice.
+  TBO.emitBuffer();
+  TBO << "!";
+  TBO.emitBuffer();
+  EXPECT_EQ("hello 42!", Target.str());
+}
+
+TEST(ThreadBufferedOStreamTest, EmitsOnDestruction) {
+  std::string Out;
+  raw_string_ostream Target(Out);
+  std::mutex Lock;
+  {
+    thread_buffered_ostream TBO(Target, Lock);
+    TBO << "pending";
+  }
+  EXPECT_EQ("pending", Target.str());
+}
+
+TEST(ThreadBufferedOStreamTest, NoInterleavingAcrossThreads) {
+  std::string Out;
+  raw_string_ostream Target(Out);
+  std::mutex Lock;
+
+  constexpr unsigned NumThreads = 4;
+  constexpr unsigned NumMessages = 64;
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T != NumThreads; ++T)
+    Threads.emplace_back([&, T] {
+      thread_buffered_ostream TBO(Target, Lock);
+      for (unsigned I = 0; I != NumMessages; ++I) {
+        TBO << "thread " << T << " message " << I << "\n";
+        TBO.emitBuffer();
+      }
+    });
+  for (std::thread &Thread : Threads)
+    Thread.join();
+
+  // Every message must appear on a line of its own, i.e. messages from
+  // different threads never interleave.
+  SmallVector<StringRef, 0> Lines;
+  StringRef(Target.str()).split(Lines, '\n');
+  ASSERT_EQ(NumThreads * NumMessages + 1, Lines.size());
+  for (unsigned T = 0; T != NumThreads; ++T)
+    for (unsigned I = 0; I != NumMessages; ++I) {
+      std::string Message =
+          ("thread " + Twine(T) + " message " + Twine(I)).str();
+      EXPECT_EQ(1, count(Lines, StringRef(Message)));
+    }
+}
+
+} // namespace
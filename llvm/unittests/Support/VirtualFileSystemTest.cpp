@@ -179,6 +179,16 @@ class ErrorDummyFileSystem : public DummyFileSystem {
   }
 };
 
+class StatCountingFileSystem : public DummyFileSystem {
+public:
+  unsigned NumStatusCalls = 0;
+
+  ErrorOr<vfs::Status> status(const Twine &Path) override {
+    ++NumStatusCalls;
+    return DummyFileSystem::status(Path);
+  }
+};
+
 /// Replace back-slashes by front-slashes.
 std::string getPosixPath(std::string S) {
   SmallString<128> Result;
@@ -227,6 +237,38 @@ TEST(VirtualFileSystemTest, StatusQueries) {
   EXPECT_FALSE(Status->equivalent(*Status2));
 }
 
+TEST(VirtualFileSystemTest, StatCache) {
+  IntrusiveRefCntPtr<StatCountingFileSystem> Counting(
+      new StatCountingFileSystem());
+  Counting->addRegularFile("/foo");
+  IntrusiveRefCntPtr<vfs::StatCacheFileSystem> Cache(
+      new vfs::StatCacheFileSystem(Counting));
+
+  // Successful statuses are cached.
+  ErrorOr<vfs::Status> Status = Cache->status("/foo");
+  ASSERT_FALSE(Status.getError());
+  EXPECT_TRUE(Status->isRegularFile());
+  EXPECT_FALSE(Cache->status("/foo").getError());
+  EXPECT_EQ(1u, Counting->NumStatusCalls);
+
+  // Failed statuses are cached too.
+  EXPECT_EQ(Cache->status("/bar").getError(), errc::no_such_file_or_directory);
+  EXPECT_EQ(Cache->status("/bar").getError(), errc::no_such_file_or_directory);
+  EXPECT_EQ(2u, Counting->NumStatusCalls);
+
+  // Changes in the underlying file system only become visible after
+  // invalidation.
+  Counting->addRegularFile("/bar");
+  EXPECT_TRUE(Cache->status("/bar").getError());
+  Cache->invalidateEntry("/bar");
+  EXPECT_FALSE(Cache->status("/bar").getError());
+  EXPECT_EQ(3u, Counting->NumStatusCalls);
+
+  Cache->clearStatCache();
+  EXPECT_FALSE(Cache->status("/foo").getError());
+  EXPECT_EQ(4u, Counting->NumStatusCalls);
+}
+
 TEST(VirtualFileSystemTest, BaseOnlyOverlay) {
   IntrusiveRefCntPtr<DummyFileSystem> D(new DummyFileSystem());
   ErrorOr<vfs::Status> Status((std::error_code()));
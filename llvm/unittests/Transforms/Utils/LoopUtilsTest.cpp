@@ -93,3 +93,52 @@ TEST(LoopUtils, DeleteDeadLoopNest) {
         EXPECT_EQ(BI->getSuccessor(0)->getName(), "for.end");
       });
 }
+
+TEST(LoopUtils, GetSmallConstantTripCountWithoutSCEV) {
+  LLVMContext C;
+  std::unique_ptr<Module> M =
+      parseIR(C, "define void @foo() {\n"
+                 "entry:\n"
+                 "  br label %loop\n"
+                 "loop:\n"
+                 "  %i = phi i32 [ 0, %entry ], [ %inc, %loop ]\n"
+                 "  %inc = add nsw i32 %i, 1\n"
+                 "  %cmp = icmp slt i32 %inc, 16\n"
+                 "  br i1 %cmp, label %loop, label %exit\n"
+                 "exit:\n"
+                 "  ret void\n"
+                 "}\n");
+
+  run(*M, "foo",
+      [&](Function &F, DominatorTree &DT, ScalarEvolution &SE, LoopInfo &LI) {
+        Loop *L = *LI.begin();
+        Optional<unsigned> TripCount = getSmallConstantTripCountWithoutSCEV(L);
+        ASSERT_TRUE(TripCount.hasValue());
+        // The fast path must agree with SCEV's exact latch trip count.
+        EXPECT_EQ(*TripCount, 16u);
+        EXPECT_EQ(*TripCount,
+                  SE.getSmallConstantTripCount(L, L->getLoopLatch()));
+      });
+}
+
+TEST(LoopUtils, GetSmallConstantTripCountWithoutSCEVNonConstant) {
+  LLVMContext C;
+  std::unique_ptr<Module> M =
+      parseIR(C, "define void @foo(i32 %n) {\n"
+                 "entry:\n"
+                 "  br label %loop\n"
+                 "loop:\n"
+                 "  %i = phi i32 [ 0, %entry ], [ %inc, %loop ]\n"
+                 "  %inc = add nsw i32 %i, 1\n"
+                 "  %cmp = icmp slt i32 %inc, %n\n"
+                 "  br i1 %cmp, label %loop, label %exit\n"
+                 "exit:\n"
+                 "  ret void\n"
+                 "}\n");
+
+  run(*M, "foo",
+      [&](Function &F, DominatorTree &DT, ScalarEvolution &SE, LoopInfo &LI) {
+        Loop *L = *LI.begin();
+        EXPECT_FALSE(getSmallConstantTripCountWithoutSCEV(L).hasValue());
+      });
+}
@@ -722,12 +722,18 @@ void GICombinerEmitter::generateCodeForTree(raw_ostream &OS,
                                             StringRef Indent) const {
   if (Tree.getPartitioner() != nullptr) {
     Tree.getPartitioner()->generatePartitionSelectorCode(OS, Indent);
+    // Dispatch on the partition index rather than testing each index in
+    // turn. For the common opcode partitioner this compiles down to a jump
+    // table keyed (indirectly) on the opcode, so the cost of trying a large
+    // ruleset no longer grows with the number of partitions.
+    OS << Indent << "switch (Partition) {\n";
     for (const auto &EnumChildren : enumerate(Tree.children())) {
-      OS << Indent << "if (Partition == " << EnumChildren.index() << " /* "
-         << format_partition_name(Tree, EnumChildren.index()) << " */) {\n";
+      OS << Indent << "case " << EnumChildren.index() << ": { /* "
+         << format_partition_name(Tree, EnumChildren.index()) << " */\n";
       generateCodeForTree(OS, EnumChildren.value(), (Indent + "  ").str());
-      OS << Indent << "}\n";
+      OS << Indent << "  break;\n" << Indent << "}\n";
     }
+    OS << Indent << "}\n";
     return;
   }
 
@@ -69,8 +69,8 @@ cl::opt<bool> EmitLongStrLiterals(
 } // end namespace llvm
 
 namespace {
-cl::opt<ActionType> Action(
-    cl::desc("Action to perform:"),
+cl::list<ActionType> Actions(
+    cl::desc("Action to perform (repeatable; pair each action with a -o):"),
     cl::values(
         clEnumValN(PrintRecords, "print-records",
                    "Print all records to stdout (default)"),
@@ -145,7 +145,22 @@ cl::opt<std::string> Class("class", cl::desc("Print Enum list for this class"),
                            cl::value_desc("class name"),
                            cl::cat(PrintEnumsCat));
 
+// Index of the next action to run. TableGenMain calls LLVMTableGenMain once
+// per output file, all sharing one RecordKeeper, so that several emitters can
+// run from a single parse of the .td tree.
+unsigned ActionsRun = 0;
+
 bool LLVMTableGenMain(raw_ostream &OS, RecordKeeper &Records) {
+  ActionType Action = PrintRecords;
+  if (!Actions.empty()) {
+    if (ActionsRun >= Actions.size()) {
+      errs() << "error: more output files than actions\n";
+      return true;
+    }
+    Action = Actions[ActionsRun];
+  }
+  ++ActionsRun;
+
   switch (Action) {
   case PrintRecords:
     OS << Records;              // No argument, dump all contents
@@ -282,7 +297,18 @@ int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
   cl::ParseCommandLineOptions(argc, argv);
 
-  return TableGenMain(argv[0], &LLVMTableGenMain);
+  int Ret = TableGenMain(argv[0], &LLVMTableGenMain);
+
+  // When several actions are requested, each must have been paired with an
+  // output file. ActionsRun stays zero if the run was skipped entirely, e.g.
+  // by the content cache.
+  if (!Ret && ActionsRun != 0 && ActionsRun < Actions.size()) {
+    errs() << argv[0] << ": error: " << Actions.size()
+           << " actions requested, but only " << ActionsRun
+           << " output files were given\n";
+    return 1;
+  }
+  return Ret;
 }
 
 #ifndef __has_feature
@@ -24,6 +24,9 @@ template <bool IsPostDom> class DominanceInfoBase {
   using base = llvm::DominatorTreeBase<Block, IsPostDom>;
 
 public:
+  /// Construct dominance info without computing it for any region. Dominator
+  /// trees may then be built selectively with recalculate(Region *).
+  DominanceInfoBase() = default;
   DominanceInfoBase(Operation *op) { recalculate(op); }
   DominanceInfoBase(DominanceInfoBase &&) = default;
   DominanceInfoBase &operator=(DominanceInfoBase &&) = default;
@@ -34,6 +37,10 @@ public:
   /// Recalculate the dominance info.
   void recalculate(Operation *op);
 
+  /// Recalculate the dominance info for the provided region only, leaving the
+  /// information computed for any other region untouched.
+  void recalculate(Region *region);
+
   /// Finds the nearest common dominator block for the two given blocks a
   /// and b. If no common dominator can be found, this function will return
   /// nullptr.
@@ -63,6 +63,14 @@ public:
   /// Walk all of the patterns within the applicator.
   void walkAllPatterns(function_ref<void(const Pattern &)> walk);
 
+  /// Returns true if there is any pattern that could conceivably match an
+  /// operation of the given type. This is a cheap filter that drivers can use
+  /// to skip `matchAndRewrite` entirely for operations with no candidate
+  /// patterns. It is only valid after a cost model has been applied.
+  bool hasAnyPatternFor(OperationName op) const {
+    return !anyOpPatterns.empty() || mutableByteCodeState || patterns.count(op);
+  }
+
 private:
   /// The list that owns the patterns used within this applicator.
   const FrozenRewritePatternList &frozenPatternList;
@@ -18,6 +18,7 @@
 #include "mlir/IR/Dialect.h"
 #include "mlir/IR/DialectInterface.h"
 #include "mlir/Interfaces/FoldInterfaces.h"
+#include "llvm/ADT/DenseSet.h"
 
 namespace mlir {
 class Operation;
@@ -135,6 +136,13 @@ private:
   /// given that many dialects may generate the same constant.
   DenseMap<Operation *, SmallVector<Dialect *, 2>> referencedDialects;
 
+  /// Fingerprints of operations that are known not to fold, used to avoid
+  /// repeatedly invoking fold hooks that cannot succeed. Only operations
+  /// whose fold behavior is a deterministic function of the fingerprinted
+  /// state are recorded. The fingerprints are built from uniqued attributes
+  /// and types, so entries remain valid for the lifetime of the folder.
+  DenseSet<uint64_t> knownUnfoldable;
+
   /// A collection of dialect folder interfaces.
   DialectInterfaceCollection<DialectFoldInterface> interfaces;
 };
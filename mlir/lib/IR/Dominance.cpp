@@ -68,6 +68,22 @@ void DominanceInfoBase<IsPostDom>::recalculate(Operation *op) {
   });
 }
 
+template <bool IsPostDom>
+void DominanceInfoBase<IsPostDom>::recalculate(Region *region) {
+  Operation *op = region->getParentOp();
+  // If the region is empty or does not have SSA dominance, all values in it
+  // are live anywhere in the region, which is represented by the absence of
+  // an entry in the dominanceInfos map.
+  if (region->empty() || !hasSSADominance(op, region->getRegionNumber())) {
+    dominanceInfos.erase(region);
+    return;
+  }
+
+  auto opDominance = std::make_unique<base>();
+  opDominance->recalculate(*region);
+  dominanceInfos[region] = std::move(opDominance);
+}
+
 /// Walks up the list of containers of the given block and calls the
 /// user-defined traversal function for every pair of a region and block that
 /// could be found during traversal. If the user-defined function returns true
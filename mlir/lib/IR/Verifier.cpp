@@ -26,14 +26,17 @@
 
 #include "mlir/IR/Verifier.h"
 #include "mlir/IR/Attributes.h"
+#include "mlir/IR/Diagnostics.h"
 #include "mlir/IR/Dialect.h"
 #include "mlir/IR/Dominance.h"
 #include "mlir/IR/Operation.h"
 #include "mlir/IR/RegionKindInterface.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Regex.h"
+#include <atomic>
 
 using namespace mlir;
 
@@ -59,6 +62,16 @@ private:
   LogicalResult verifyBlock(Block &block);
   LogicalResult verifyOperation(Operation &op);
 
+  /// Verify the given operation nested within a block. Operations that are
+  /// known to be isolated from above are not verified here, but deferred to
+  /// `opsWithIsolatedRegions` so that they can be verified as independent
+  /// units afterwards.
+  LogicalResult verifyOperationInBlock(Operation &op);
+
+  /// Verify the operations deferred to `opsWithIsolatedRegions`, in parallel
+  /// if multi-threading is enabled in the context.
+  LogicalResult verifyIsolatedSubtrees();
+
   /// Verify the dominance property of operations within the given Region.
   LogicalResult verifyDominance(Region &region);
 
@@ -80,7 +93,14 @@ private:
   MLIRContext *ctx;
 
   /// Dominance information for this operation, when checking dominance.
-  DominanceInfo *domInfo = nullptr;
+  /// Dominator trees are built per-region as the regions are visited, so
+  /// that none are computed for the deferred isolated subtrees.
+  DominanceInfo domInfo;
+
+  /// Operations that are known to be isolated from above, collected during
+  /// the structural walk. The subtree rooted at each of these operations is
+  /// independently verifiable and is processed as a separate unit.
+  SmallVector<Operation *, 8> opsWithIsolatedRegions;
 
   /// Mapping between dialect namespace and if that dialect supports
   /// unregistered operations.
@@ -90,7 +110,8 @@ private:
 
 /// Verify the given operation.
 LogicalResult OperationVerifier::verify(Operation &op) {
-  // Verify the operation first.
+  // Verify the operation first, deferring any nested operations that are
+  // isolated from above to `opsWithIsolatedRegions`.
   if (failed(verifyOperation(op)))
     return failure();
 
@@ -98,13 +119,13 @@ LogicalResult OperationVerifier::verify(Operation &op) {
   // check for any nested regions. We do this as a second pass since malformed
   // CFG's can cause dominator analysis constructure to crash and we want the
   // verifier to be resilient to malformed code.
-  DominanceInfo theDomInfo(&op);
-  domInfo = &theDomInfo;
   if (failed(verifyDominanceOfContainedRegions(op)))
     return failure();
 
-  domInfo = nullptr;
-  return success();
+  // Finally verify the subtrees deferred during the structural walk. Each of
+  // them forms an independent unit, so when multi-threading is enabled they
+  // are verified in parallel.
+  return verifyIsolatedSubtrees();
 }
 
 LogicalResult OperationVerifier::verifyRegion(Region &region) {
@@ -140,12 +161,12 @@ LogicalResult OperationVerifier::verifyBlock(Block &block) {
       return op.emitError(
           "operation with block successors must terminate its parent block");
 
-    if (failed(verifyOperation(op)))
+    if (failed(verifyOperationInBlock(op)))
       return failure();
   }
 
   // Verify the terminator.
-  if (failed(verifyOperation(block.back())))
+  if (failed(verifyOperationInBlock(block.back())))
     return failure();
   if (block.back().isKnownNonTerminator())
     return block.back().emitError("block with no terminator");
@@ -160,6 +181,22 @@ LogicalResult OperationVerifier::verifyBlock(Block &block) {
   return success();
 }
 
+LogicalResult OperationVerifier::verifyOperationInBlock(Operation &op) {
+  // Defer operations that are known to be isolated from above so that their
+  // subtrees can be verified as independent units. Their operands still
+  // belong to the enclosing unit, so check them for nullness here: the
+  // dominance pass relies on structural verification having rejected null
+  // operands.
+  if (op.getNumRegions() != 0 && op.isKnownIsolatedFromAbove()) {
+    for (auto operand : op.getOperands())
+      if (!operand)
+        return op.emitError("null operand found");
+    opsWithIsolatedRegions.push_back(&op);
+    return success();
+  }
+  return verifyOperation(op);
+}
+
 LogicalResult OperationVerifier::verifyOperation(Operation &op) {
   // Check that operands are non-nil and structurally ok.
   for (auto operand : op.getOperands())
@@ -246,16 +283,20 @@ LogicalResult OperationVerifier::verifyOperation(Operation &op) {
 }
 
 LogicalResult OperationVerifier::verifyDominance(Region &region) {
+  // Build the dominator tree for this region on demand; regions of deferred
+  // isolated operations are never visited here and so never pay for one.
+  domInfo.recalculate(&region);
+
   // Verify the dominance of each of the held operations.
   for (Block &block : region) {
     // Dominance is only meaningful inside reachable blocks.
-    if (domInfo->isReachableFromEntry(&block))
+    if (domInfo.isReachableFromEntry(&block))
       for (Operation &op : block)
         // Check that operands properly dominate this use.
         for (unsigned operandNo = 0, e = op.getNumOperands(); operandNo != e;
              ++operandNo) {
           auto operand = op.getOperand(operandNo);
-          if (domInfo->properlyDominates(operand, &op))
+          if (domInfo.properlyDominates(operand, &op))
             continue;
 
           auto diag = op.emitError("operand #")
@@ -266,10 +307,12 @@ LogicalResult OperationVerifier::verifyDominance(Region &region) {
         }
     // Recursively verify dominance within each operation in the
     // block, even if the block itself is not reachable, or we are in
-    // a region which doesn't respect dominance.
+    // a region which doesn't respect dominance. Operations isolated from
+    // above were deferred and have their regions verified independently.
     for (Operation &op : block)
-      if (failed(verifyDominanceOfContainedRegions(op)))
-        return failure();
+      if (op.getNumRegions() != 0 && !op.isKnownIsolatedFromAbove())
+        if (failed(verifyDominanceOfContainedRegions(op)))
+          return failure();
   }
   return success();
 }
@@ -284,6 +327,45 @@ OperationVerifier::verifyDominanceOfContainedRegions(Operation &op) {
   return success();
 }
 
+/// Verify the operations deferred to `opsWithIsolatedRegions`. Each of these
+/// operations is isolated from above and therefore verifiable without any
+/// context from the enclosing unit, allowing the subtrees to be processed in
+/// parallel.
+LogicalResult OperationVerifier::verifyIsolatedSubtrees() {
+  if (opsWithIsolatedRegions.empty())
+    return success();
+
+  // Verify inline if multi-threading is disabled or there is nothing to
+  // parallelize.
+  if (!ctx->isMultithreadingEnabled() || opsWithIsolatedRegions.size() == 1) {
+    for (Operation *op : opsWithIsolatedRegions)
+      if (failed(OperationVerifier(ctx).verify(*op)))
+        return failure();
+    return success();
+  }
+
+  // A parallel diagnostic handler that provides deterministic diagnostic
+  // ordering.
+  ParallelDiagnosticHandler diagHandler(ctx);
+
+  // An atomic failure variable for the async executors.
+  std::atomic<bool> anyFailed(false);
+  llvm::parallelForEachN(0, opsWithIsolatedRegions.size(), [&](size_t idx) {
+    if (anyFailed)
+      return;
+
+    // Set the order id for this thread in the diagnostic handler.
+    diagHandler.setOrderIDForThread(idx);
+
+    // Verify the subtree with a fresh verifier, as the verifier state cannot
+    // be shared across threads.
+    if (failed(OperationVerifier(ctx).verify(*opsWithIsolatedRegions[idx])))
+      anyFailed = true;
+    diagHandler.eraseOrderIDForThread();
+  });
+  return failure(anyFailed);
+}
+
 //===----------------------------------------------------------------------===//
 // Entrypoint
 //===----------------------------------------------------------------------===//
@@ -29,6 +29,21 @@ static bool isPunct(char c) {
   return c == '$' || c == '.' || c == '_' || c == '-';
 }
 
+// Returns true if 'c' can appear past the first character of a bare
+// identifier: (letter|digit|[_$.]). The identifier scanning loops are the
+// hottest part of the lexer on large modules, so use the locale-independent
+// inline predicates rather than the <ctype.h> functions, which on common
+// libc implementations cost a function call per character.
+static bool isBareIdentifierChar(char c) {
+  return llvm::isAlnum(c) || c == '_' || c == '$' || c == '.';
+}
+
+// Returns true if 'c' can appear past the first character of a suffix-id:
+// (letter|digit|id-punct).
+static bool isSuffixIdentifierChar(char c) {
+  return llvm::isAlnum(c) || isPunct(c);
+}
+
 Lexer::Lexer(const llvm::SourceMgr &sourceMgr, MLIRContext *context)
     : sourceMgr(sourceMgr), context(context) {
   auto bufferID = sourceMgr.getMainFileID();
@@ -61,7 +76,7 @@ Token Lexer::lexToken() {
     switch (*curPtr++) {
     default:
       // Handle bare identifiers.
-      if (isalpha(curPtr[-1]))
+      if (llvm::isAlpha(curPtr[-1]))
         return lexBareIdentifierOrKeyword(tokStart);
 
       // Unknown character, emit an error.
@@ -176,12 +191,11 @@ Token Lexer::lexAtIdentifier(const char *tokStart) {
   }
 
   // Otherwise, these always start with a letter or underscore.
-  if (!isalpha(cur) && cur != '_')
+  if (!llvm::isAlpha(cur) && cur != '_')
     return emitError(curPtr - 1,
                      "@ identifier expected to start with letter or '_'");
 
-  while (isalpha(*curPtr) || isdigit(*curPtr) || *curPtr == '_' ||
-         *curPtr == '$' || *curPtr == '.')
+  while (isBareIdentifierChar(*curPtr))
     ++curPtr;
   return formToken(Token::at_identifier, tokStart);
 }
@@ -193,8 +207,7 @@ Token Lexer::lexAtIdentifier(const char *tokStart) {
 ///
 Token Lexer::lexBareIdentifierOrKeyword(const char *tokStart) {
   // Match the rest of the identifier regex: [0-9a-zA-Z_.$]*
-  while (isalpha(*curPtr) || isdigit(*curPtr) || *curPtr == '_' ||
-         *curPtr == '$' || *curPtr == '.')
+  while (isBareIdentifierChar(*curPtr))
     ++curPtr;
 
   // Check to see if this identifier is a keyword.
@@ -269,24 +282,24 @@ Token Lexer::lexEllipsis(const char *tokStart) {
 ///   float-literal ::= [-+]?[0-9]+[.][0-9]*([eE][-+]?[0-9]+)?
 ///
 Token Lexer::lexNumber(const char *tokStart) {
-  assert(isdigit(curPtr[-1]));
+  assert(llvm::isDigit(curPtr[-1]));
 
   // Handle the hexadecimal case.
   if (curPtr[-1] == '0' && *curPtr == 'x') {
     // If we see stuff like 0xi32, this is a literal `0` followed by an
     // identifier `xi32`, stop after `0`.
-    if (!isxdigit(curPtr[1]))
+    if (!llvm::isHexDigit(curPtr[1]))
       return formToken(Token::integer, tokStart);
 
     curPtr += 2;
-    while (isxdigit(*curPtr))
+    while (llvm::isHexDigit(*curPtr))
       ++curPtr;
 
     return formToken(Token::integer, tokStart);
   }
 
   // Handle the normal decimal case.
-  while (isdigit(*curPtr))
+  while (llvm::isDigit(*curPtr))
     ++curPtr;
 
   if (*curPtr != '.')
@@ -294,15 +307,14 @@ Token Lexer::lexNumber(const char *tokStart) {
   ++curPtr;
 
   // Skip over [0-9]*([eE][-+]?[0-9]+)?
-  while (isdigit(*curPtr))
+  while (llvm::isDigit(*curPtr))
     ++curPtr;
 
   if (*curPtr == 'e' || *curPtr == 'E') {
-    if (isdigit(static_cast<unsigned char>(curPtr[1])) ||
-        ((curPtr[1] == '-' || curPtr[1] == '+') &&
-         isdigit(static_cast<unsigned char>(curPtr[2])))) {
+    if (llvm::isDigit(curPtr[1]) ||
+        ((curPtr[1] == '-' || curPtr[1] == '+') && llvm::isDigit(curPtr[2]))) {
       curPtr += 2;
-      while (isdigit(*curPtr))
+      while (llvm::isDigit(*curPtr))
         ++curPtr;
     }
   }
@@ -343,15 +355,15 @@ Token Lexer::lexPrefixedIdentifier(const char *tokStart) {
   }
 
   // Parse suffix-id.
-  if (isdigit(*curPtr)) {
+  if (llvm::isDigit(*curPtr)) {
     // If suffix-id starts with a digit, the rest must be digits.
-    while (isdigit(*curPtr)) {
+    while (llvm::isDigit(*curPtr)) {
       ++curPtr;
     }
-  } else if (isalpha(*curPtr) || isPunct(*curPtr)) {
+  } else if (llvm::isAlpha(*curPtr) || isPunct(*curPtr)) {
     do {
       ++curPtr;
-    } while (isalpha(*curPtr) || isdigit(*curPtr) || isPunct(*curPtr));
+    } while (isSuffixIdentifierChar(*curPtr));
   } else {
     return emitError(curPtr - 1, errorKind);
   }
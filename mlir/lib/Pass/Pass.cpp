@@ -26,6 +26,7 @@
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/ToolOutputFile.h"
+#include <numeric>
 
 using namespace mlir;
 using namespace mlir::detail;
@@ -542,6 +543,27 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
     }
   }
 
+  // Schedule the largest operations first. The executors hand out operations
+  // dynamically, so a huge operation that happens to appear late in the module
+  // would otherwise start last and leave the other threads idle for the
+  // duration of its entire pipeline. The nested operation count is only a
+  // proxy for the pipeline cost, but it is cheap to compute and shrinks the
+  // tail considerably in practice. The original operation index is kept so
+  // that diagnostics remain ordered by the position in the module.
+  std::vector<unsigned> opOrder(opAMPairs.size());
+  std::iota(opOrder.begin(), opOrder.end(), 0);
+  if (opAMPairs.size() > 1) {
+    std::vector<unsigned> opSizes(opAMPairs.size());
+    for (unsigned i = 0, e = opAMPairs.size(); i != e; ++i) {
+      unsigned size = 0;
+      opAMPairs[i].first->walk([&](Operation *) { ++size; });
+      opSizes[i] = size;
+    }
+    std::stable_sort(
+        opOrder.begin(), opOrder.end(),
+        [&](unsigned lhs, unsigned rhs) { return opSizes[lhs] > opSizes[rhs]; });
+  }
+
   // A parallel diagnostic handler that provides deterministic diagnostic
   // ordering.
   ParallelDiagnosticHandler diagHandler(&getContext());
@@ -563,9 +585,10 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
       [&](MutableArrayRef<OpPassManager> pms) {
         for (auto e = opAMPairs.size(); !passFailed && opIt < e;) {
           // Get the next available operation index.
-          unsigned nextID = opIt++;
-          if (nextID >= e)
+          unsigned idx = opIt++;
+          if (idx >= e)
             break;
+          unsigned nextID = opOrder[idx];
 
           // Set the order id for this thread in the diagnostic handler.
           diagHandler.setOrderIDForThread(nextID);
@@ -68,6 +68,37 @@ static Operation *materializeConstant(Dialect *dialect, OpBuilder &builder,
   return nullptr;
 }
 
+/// Compute a fingerprint of the state that can affect the outcome of folding
+/// the given operation, or None if no reliable fingerprint can be built. A
+/// fingerprint is only produced for registered operations without regions or
+/// successors whose operands are all constant: for those the fold hook is a
+/// function of the operation name, the attributes, the operand constants, and
+/// the operand and result types, all of which are captured below. Note that a
+/// colliding fingerprint can only suppress a fold attempt, it can never cause
+/// an incorrect fold.
+static Optional<uint64_t>
+computeFoldFingerprint(Operation *op, ArrayRef<Attribute> operandConstants) {
+  if (!op->isRegistered() || op->getNumRegions() != 0 ||
+      op->getNumSuccessors() != 0)
+    return llvm::None;
+  if (llvm::any_of(operandConstants, [](Attribute attr) { return !attr; }))
+    return llvm::None;
+
+  llvm::hash_code hash =
+      llvm::hash_combine(op->getName(), op->getAttrDictionary());
+  for (auto it : llvm::zip(operandConstants, op->getOperandTypes()))
+    hash = llvm::hash_combine(hash, std::get<0>(it), std::get<1>(it));
+  for (Type type : op->getResultTypes())
+    hash = llvm::hash_combine(hash, type);
+
+  // Make sure the fingerprint does not clash with the DenseSet sentinels.
+  uint64_t fingerprint = hash;
+  if (fingerprint == llvm::DenseMapInfo<uint64_t>::getEmptyKey() ||
+      fingerprint == llvm::DenseMapInfo<uint64_t>::getTombstoneKey())
+    return llvm::None;
+  return fingerprint;
+}
+
 //===----------------------------------------------------------------------===//
 // OperationFolder
 //===----------------------------------------------------------------------===//
@@ -182,9 +213,21 @@ LogicalResult OperationFolder::tryToFold(
   for (unsigned i = 0, e = op->getNumOperands(); i != e; ++i)
     matchPattern(op->getOperand(i), m_Constant(&operandConstants[i]));
 
+  // If an identical operation has already failed to fold, skip the fold hook
+  // entirely; repeated canonicalization runs otherwise re-attempt the same
+  // unfoldable signatures over and over.
+  Optional<uint64_t> fingerprint =
+      computeFoldFingerprint(op, operandConstants);
+  if (fingerprint && knownUnfoldable.count(*fingerprint))
+    return failure();
+
   // Attempt to constant fold the operation.
-  if (failed(op->fold(operandConstants, foldResults)))
+  if (failed(op->fold(operandConstants, foldResults))) {
+    // Remember that this signature is known not to fold.
+    if (fingerprint)
+      knownUnfoldable.insert(*fingerprint);
     return failure();
+  }
 
   // Check to see if the operation was just updated in place.
   if (foldResults.empty())
@@ -196,8 +196,12 @@ bool GreedyPatternRewriteDriver::simplify(MutableArrayRef<Region> regions,
       }
 
       // Try to match one of the patterns. The rewriter is automatically
-      // notified of any necessary changes, so there is nothing else to do here.
-      changed |= succeeded(matcher.matchAndRewrite(op, *this));
+      // notified of any necessary changes, so there is nothing else to do
+      // here. Skip operations for which no pattern could possibly match; the
+      // worklist is dominated by such operations once the hot patterns have
+      // been applied.
+      if (matcher.hasAnyPatternFor(op->getName()))
+        changed |= succeeded(matcher.matchAndRewrite(op, *this));
     }
 
     // After applying patterns, make sure that the CFG of each of the regions is
@@ -344,7 +348,8 @@ LogicalResult OpPatternRewriteDriver::simplifyLocally(Operation *op,
 
     // Try to match one of the patterns. The rewriter is automatically
     // notified of any necessary changes, so there is nothing else to do here.
-    changed |= succeeded(matcher.matchAndRewrite(op, *this));
+    if (matcher.hasAnyPatternFor(op->getName()))
+      changed |= succeeded(matcher.matchAndRewrite(op, *this));
     if ((erased = opErasedViaPatternRewrites))
       return success();
   } while (changed && ++i < maxIterations);
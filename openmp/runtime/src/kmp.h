@@ -2153,6 +2153,10 @@ typedef enum kmp_tasking_mode {
 extern kmp_tasking_mode_t
     __kmp_tasking_mode; /* determines how/when to execute tasks */
 extern int __kmp_task_stealing_constraint;
+// Number of consecutive thread ids forming a locality domain that is
+// preferred when picking a steal victim; 0 (default) selects victims
+// uniformly at random across the whole team.
+extern int __kmp_task_stealing_span;
 extern int __kmp_enable_task_throttling;
 extern kmp_int32 __kmp_default_device; // Set via OMP_DEFAULT_DEVICE if
 // specified, defaults to 0 otherwise
@@ -2930,6 +2934,9 @@ extern kmp_uint32 __kmp_barrier_gather_branch_bits[bs_last_barrier];
 extern kmp_uint32 __kmp_barrier_release_branch_bits[bs_last_barrier];
 extern kmp_bar_pat_e __kmp_barrier_gather_pattern[bs_last_barrier];
 extern kmp_bar_pat_e __kmp_barrier_release_pattern[bs_last_barrier];
+// Teams with at most this many threads use the flat linear barrier
+// regardless of the configured patterns; 0 (default) disables the override.
+extern int __kmp_barrier_flat_threshold;
 extern char const *__kmp_barrier_branch_bit_env_name[bs_last_barrier];
 extern char const *__kmp_barrier_pattern_env_name[bs_last_barrier];
 extern char const *__kmp_barrier_type_name[bs_last_barrier];
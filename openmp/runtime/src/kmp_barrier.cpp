@@ -39,6 +39,20 @@
 
 void __kmp_print_structure(void); // Forward declaration
 
+// Teams with at most KMP_BARRIER_FLAT_THRESHOLD threads use the flat linear
+// barrier regardless of the configured pattern: for a handful of threads the
+// single set of arrive/go flags beats the tree-structured algorithms' extra
+// flag hops. All threads of a team observe the same team size, so they agree
+// on the selected algorithm. The fork barrier is exempt because a worker does
+// not reliably know the new team's size while waiting to be released.
+static kmp_bar_pat_e __kmp_select_barrier_pattern(kmp_team_t *team,
+                                                  kmp_bar_pat_e pattern) {
+  if (__kmp_barrier_flat_threshold > 0 &&
+      team->t.t_nproc <= __kmp_barrier_flat_threshold)
+    return bp_linear_bar;
+  return pattern;
+}
+
 // ---------------------------- Barrier Algorithms ----------------------------
 
 // Linear Barrier
@@ -1392,7 +1406,8 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
       cancelled = __kmp_linear_barrier_gather_cancellable(
           bt, this_thr, gtid, tid, reduce USE_ITT_BUILD_ARG(itt_sync_obj));
     } else {
-      switch (__kmp_barrier_gather_pattern[bt]) {
+      switch (__kmp_select_barrier_pattern(team,
+                                           __kmp_barrier_gather_pattern[bt])) {
       case bp_hyper_bar: {
         // don't set branch bits to 0; use linear
         KMP_ASSERT(__kmp_barrier_gather_branch_bits[bt]);
@@ -1505,7 +1520,8 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
         cancelled = __kmp_linear_barrier_release_cancellable(
             bt, this_thr, gtid, tid, FALSE USE_ITT_BUILD_ARG(itt_sync_obj));
       } else {
-        switch (__kmp_barrier_release_pattern[bt]) {
+        switch (__kmp_select_barrier_pattern(
+            team, __kmp_barrier_release_pattern[bt])) {
         case bp_hyper_bar: {
           KMP_ASSERT(__kmp_barrier_release_branch_bits[bt]);
           __kmp_hyper_barrier_release(bt, this_thr, gtid, tid,
@@ -1635,7 +1651,8 @@ void __kmp_end_split_barrier(enum barrier_type bt, int gtid) {
   ANNOTATE_BARRIER_BEGIN(&team->t.t_bar);
   if (!team->t.t_serialized) {
     if (KMP_MASTER_GTID(gtid)) {
-      switch (__kmp_barrier_release_pattern[bt]) {
+      switch (__kmp_select_barrier_pattern(team,
+                                           __kmp_barrier_release_pattern[bt])) {
       case bp_hyper_bar: {
         KMP_ASSERT(__kmp_barrier_release_branch_bits[bt]);
         __kmp_hyper_barrier_release(bt, this_thr, gtid, tid,
@@ -1781,7 +1798,8 @@ void __kmp_join_barrier(int gtid) {
     __kmp_itt_barrier_starting(gtid, itt_sync_obj);
 #endif /* USE_ITT_BUILD */
 
-  switch (__kmp_barrier_gather_pattern[bs_forkjoin_barrier]) {
+  switch (__kmp_select_barrier_pattern(
+      team, __kmp_barrier_gather_pattern[bs_forkjoin_barrier])) {
   case bp_hyper_bar: {
     KMP_ASSERT(__kmp_barrier_gather_branch_bits[bs_forkjoin_barrier]);
     __kmp_hyper_barrier_gather(bs_forkjoin_barrier, this_thr, gtid, tid,
@@ -87,6 +87,7 @@ kmp_uint32 __kmp_barrier_gather_branch_bits[bs_last_barrier] = {0};
 kmp_uint32 __kmp_barrier_release_branch_bits[bs_last_barrier] = {0};
 kmp_bar_pat_e __kmp_barrier_gather_pattern[bs_last_barrier] = {bp_linear_bar};
 kmp_bar_pat_e __kmp_barrier_release_pattern[bs_last_barrier] = {bp_linear_bar};
+int __kmp_barrier_flat_threshold = 0;
 char const *__kmp_barrier_branch_bit_env_name[bs_last_barrier] = {
     "KMP_PLAIN_BARRIER", "KMP_FORKJOIN_BARRIER"
 #if KMP_FAST_REDUCTION_BARRIER
@@ -335,6 +336,7 @@ omp_memspace_handle_t const omp_low_lat_mem_space =
 KMP_BUILD_ASSERT(sizeof(kmp_tasking_flags_t) == 4);
 
 int __kmp_task_stealing_constraint = 1; /* Constrain task stealing by default */
+int __kmp_task_stealing_span = 0; /* Uniform random victims by default */
 int __kmp_enable_task_throttling = 1;
 
 #ifdef DEBUG_SUSPEND
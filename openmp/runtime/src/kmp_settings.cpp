@@ -1211,6 +1211,17 @@ static void __kmp_stg_print_task_stealing(kmp_str_buf_t *buffer,
   __kmp_stg_print_int(buffer, name, __kmp_task_stealing_constraint);
 } // __kmp_stg_print_task_stealing
 
+static void __kmp_stg_parse_task_stealing_span(char const *name,
+                                               char const *value, void *data) {
+  __kmp_stg_parse_int(name, value, 0, KMP_MAX_NTH,
+                      (int *)&__kmp_task_stealing_span);
+} // __kmp_stg_parse_task_stealing_span
+
+static void __kmp_stg_print_task_stealing_span(kmp_str_buf_t *buffer,
+                                               char const *name, void *data) {
+  __kmp_stg_print_int(buffer, name, __kmp_task_stealing_span);
+} // __kmp_stg_print_task_stealing_span
+
 static void __kmp_stg_parse_max_active_levels(char const *name,
                                               char const *value, void *data) {
   kmp_uint64 tmp_dflt = 0;
@@ -1655,6 +1666,22 @@ static void __kmp_stg_print_barrier_pattern(kmp_str_buf_t *buffer,
   }
 } // __kmp_stg_print_barrier_pattern
 
+// -----------------------------------------------------------------------------
+// KMP_BARRIER_FLAT_THRESHOLD
+
+static void __kmp_stg_parse_barrier_flat_threshold(char const *name,
+                                                   char const *value,
+                                                   void *data) {
+  __kmp_stg_parse_int(name, value, 0, KMP_MAX_NTH,
+                      &__kmp_barrier_flat_threshold);
+} // __kmp_stg_parse_barrier_flat_threshold
+
+static void __kmp_stg_print_barrier_flat_threshold(kmp_str_buf_t *buffer,
+                                                   char const *name,
+                                                   void *data) {
+  __kmp_stg_print_int(buffer, name, __kmp_barrier_flat_threshold);
+} // __kmp_stg_print_barrier_flat_threshold
+
 // -----------------------------------------------------------------------------
 // KMP_ABORT_DELAY
 
@@ -4802,6 +4829,8 @@ static kmp_setting_t __kmp_stg_table[] = {
      0},
     {"KMP_TASK_STEALING_CONSTRAINT", __kmp_stg_parse_task_stealing,
      __kmp_stg_print_task_stealing, NULL, 0, 0},
+    {"KMP_TASK_STEALING_SPAN", __kmp_stg_parse_task_stealing_span,
+     __kmp_stg_print_task_stealing_span, NULL, 0, 0},
     {"OMP_MAX_ACTIVE_LEVELS", __kmp_stg_parse_max_active_levels,
      __kmp_stg_print_max_active_levels, NULL, 0, 0},
     {"OMP_DEFAULT_DEVICE", __kmp_stg_parse_default_device,
@@ -4876,6 +4905,8 @@ static kmp_setting_t __kmp_stg_table[] = {
      __kmp_stg_print_barrier_branch_bit, NULL, 0, 0},
     {"KMP_PLAIN_BARRIER_PATTERN", __kmp_stg_parse_barrier_pattern,
      __kmp_stg_print_barrier_pattern, NULL, 0, 0},
+    {"KMP_BARRIER_FLAT_THRESHOLD", __kmp_stg_parse_barrier_flat_threshold,
+     __kmp_stg_print_barrier_flat_threshold, NULL, 0, 0},
     {"KMP_FORKJOIN_BARRIER", __kmp_stg_parse_barrier_branch_bit,
      __kmp_stg_print_barrier_branch_bit, NULL, 0, 0},
     {"KMP_FORKJOIN_BARRIER_PATTERN", __kmp_stg_parse_barrier_pattern,
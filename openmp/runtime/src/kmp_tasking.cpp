@@ -2817,6 +2817,7 @@ static inline int __kmp_execute_tasks_template(
   std::atomic<kmp_int32> *unfinished_threads;
   kmp_int32 nthreads, victim_tid = -2, use_own_tasks = 1, new_victim = 0,
                       tid = thread->th.th_info.ds.ds_tid;
+  kmp_int32 steal_failures = 0;
 
   KMP_DEBUG_ASSERT(__kmp_tasking_mode != tskm_immediate_exec);
   KMP_DEBUG_ASSERT(thread == __kmp_threads[gtid]);
@@ -2862,9 +2863,30 @@ static inline int __kmp_execute_tasks_template(
             // Pick a random thread. Initial plan was to cycle through all the
             // threads, and only return if we tried to steal from every thread,
             // and failed.  Arch says that's not such a great idea.
-            victim_tid = __kmp_get_random(thread) % (nthreads - 1);
-            if (victim_tid >= tid) {
-              ++victim_tid; // Adjusts random distribution to exclude self
+            kmp_int32 span = __kmp_task_stealing_span;
+            if (span > 1 && span < nthreads && steal_failures < span) {
+              // Prefer victims from the block of `span` consecutive thread
+              // ids containing this thread; with a compact affinity mapping
+              // consecutive ids share cores and caches, so this keeps stolen
+              // tasks on the same core/CCX/socket. Fall back to team-wide
+              // selection once nearby victims keep coming up empty.
+              kmp_int32 base = (tid / span) * span;
+              kmp_int32 size = span;
+              if (base + size > nthreads)
+                size = nthreads - base;
+              if (size > 1) {
+                victim_tid = base + __kmp_get_random(thread) % (size - 1);
+              } else { // self is the only thread in the trailing block
+                victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+              }
+              if (victim_tid >= tid) {
+                ++victim_tid; // Adjusts random distribution to exclude self
+              }
+            } else {
+              victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+              if (victim_tid >= tid) {
+                ++victim_tid; // Adjusts random distribution to exclude self
+              }
             }
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
@@ -2901,6 +2923,7 @@ static inline int __kmp_execute_tasks_template(
                                   is_constrained);
         }
         if (task != NULL) { // set last stolen to victim
+          steal_failures = 0;
           if (threads_data[tid].td.td_deque_last_stolen != victim_tid) {
             threads_data[tid].td.td_deque_last_stolen = victim_tid;
             // The pre-refactored code did not try more than 1 successful new
@@ -2911,6 +2934,7 @@ static inline int __kmp_execute_tasks_template(
         } else { // No tasks found; unset last_stolen
           KMP_CHECK_UPDATE(threads_data[tid].td.td_deque_last_stolen, -1);
           victim_tid = -2; // no successful victim found
+          ++steal_failures;
         }
       }
 
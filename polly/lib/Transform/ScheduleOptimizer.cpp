@@ -54,6 +54,7 @@
 #include "polly/ScopInfo.h"
 #include "polly/ScopPass.h"
 #include "polly/Simplify.h"
+#include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
@@ -104,6 +105,12 @@ static cl::opt<int> MaxCoefficient(
     cl::desc("The maximal coefficient allowed (-1 is unlimited)"), cl::Hidden,
     cl::init(20), cl::ZeroOrMore, cl::cat(PollyCategory));
 
+static cl::opt<long> ScheduleComputeOut(
+    "polly-schedule-computeout",
+    cl::desc("Bound the scheduler by maximal amount of computational steps "
+             "(0 means no bound)"),
+    cl::Hidden, cl::init(300000), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 static cl::opt<std::string> FusionStrategy(
     "polly-opt-fusion", cl::desc("The fusion strategy to choose (min/max)"),
     cl::Hidden, cl::init("min"), cl::ZeroOrMore, cl::cat(PollyCategory));
@@ -271,6 +278,8 @@ static cl::opt<bool> OptimizedScops(
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
+STATISTIC(ScheduleOutOfQuota,
+          "Number of schedule computations exceeding the operations budget");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
 STATISTIC(NumBoxedLoopsOptimized, "Number of boxed loops optimized");
@@ -1596,7 +1605,21 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
   SC = SC.set_proximity(Proximity);
   SC = SC.set_validity(Validity);
   SC = SC.set_coincidence(Validity);
-  auto Schedule = SC.compute_schedule();
+
+  // Bound the time the scheduler spends searching for a schedule. On
+  // pathological inputs the search is combinatorial; when the operations
+  // budget is exhausted the scheduler returns a null schedule and we keep the
+  // original one.
+  isl::schedule Schedule;
+  {
+    IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
+    Schedule = SC.compute_schedule();
+    if (MaxOpGuard.hasQuotaExceeded()) {
+      ScheduleOutOfQuota++;
+      LLVM_DEBUG(
+          dbgs() << "Schedule optimizer calculation exceeds ISL quota\n");
+    }
+  }
   isl_options_set_on_error(Ctx, OnErrorStatus);
 
   walkScheduleTreeForStatistics(Schedule, 1);